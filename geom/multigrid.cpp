@@ -425,6 +425,7 @@ void MultiGridCL::UnrefineGrid (Uint Level)
 
 void MultiGridCL::RefineGrid (Uint Level)
 {
+    DROPS_PROFILE_REGION("MultiGridCL::RefineGrid");
     Comment("Refining grid " << Level << std::endl, DebugRefineEasyC);
 
 #ifdef _PAR
@@ -482,6 +483,7 @@ void MultiGridCL::RefineGrid (Uint Level)
 
 void MultiGridCL::Refine()
 {
+    DROPS_PROFILE_REGION("MultiGridCL::Refine");
 #ifndef _PAR
     PeriodicEdgesCL perEdges( *this);
 #endif
@@ -760,6 +762,7 @@ void MultiGridCL::SplitMultiBoundaryTetras()
     }
 
     FinalizeModify();
+    IncrementVersion();
 
     // std::cerr << "Split " << count << " tetras.\n";
 }
@@ -1316,16 +1319,28 @@ void ColorClassesCL::compute_neighbors (MultiGridCL::const_TriangTetraIteratorCL
     }
 }
 
+/// \brief Orders positions in the triangulation by the address of the tetras
+class TetraAddressLessCL
+{
+  private:
+    MultiGridCL::const_TriangTetraIteratorCL begin_;
+
+  public:
+    TetraAddressLessCL (MultiGridCL::const_TriangTetraIteratorCL begin) : begin_( begin) {}
+    bool operator() (size_t i, size_t j) const { return &*(begin_ + i) < &*(begin_ + j); }
+};
+
 void ColorClassesCL::fill_pointer_arrays (
     const std::list<ColorFreqT>& color_list, const std::vector<int>& color,
     MultiGridCL::const_TriangTetraIteratorCL begin, MultiGridCL::const_TriangTetraIteratorCL end)
 {
-    colors_.resize( color_list.size());
+    colors_.assign( color_list.size(), ColorClassT());
+    positions_.assign( color_list.size(), PositionT());
     for (std::list<ColorFreqT>::const_iterator it= color_list.begin(); it != color_list.end(); ++it)
-        colors_[it->first].reserve( it->second);
+        positions_[it->first].reserve( it->second);
     const size_t num_tetra= std::distance( begin, end);
     for (size_t j= 0; j < num_tetra; ++j)
-        colors_[color[j]].push_back( &*(begin + j));
+        positions_[color[j]].push_back( j);
 
 #ifndef DROPS_WIN
     size_t j;
@@ -1334,8 +1349,12 @@ void ColorClassesCL::fill_pointer_arrays (
 #endif
     // tetra sorting for better memory access pattern
     #pragma omp parallel for
-    for (j= 0; j < num_colors(); ++j)
-        sort( colors_[j].begin(), colors_[j].end());
+    for (j= 0; j < num_colors(); ++j) {
+        sort( positions_[j].begin(), positions_[j].end(), TetraAddressLessCL( begin));
+        colors_[j].resize( positions_[j].size());
+        for (size_t k= 0; k < positions_[j].size(); ++k)
+            colors_[j][k]= &*(begin + positions_[j][k]);
+    }
 }
 
 void ColorClassesCL::compute_color_classes (MultiGridCL::const_TriangTetraIteratorCL begin,
@@ -364,10 +364,12 @@ class ColorClassesCL
 {
   public:
     typedef std::vector<const TetraCL*> ColorClassT;
+    typedef std::vector<size_t>         PositionT;   ///< positions of the tetras of a color class in the triangulation
     typedef std::vector<ColorClassT>::const_iterator const_iterator;
 
   private:
     std::vector<ColorClassT> colors_;
+    std::vector<PositionT>   positions_;
 
     typedef std::vector<size_t> TetraNumVecT;
     typedef std::pair<size_t, size_t> ColorFreqT;
@@ -391,6 +393,8 @@ class ColorClassesCL
     size_t num_colors () const { return colors_.size(); }
     const_iterator begin () const { return colors_.begin(); }
     const_iterator end   () const { return colors_.end(); }
+    /// \brief Positions in the triangulation of the tetras in the color class *cit; positions( cit)[j] belongs to (*cit)[j].
+    const PositionT& positions (const_iterator cit) const { return positions_[cit - colors_.begin()]; }
 };
 
 
@@ -42,7 +42,11 @@
 #  include "parallel/distributeddatatypes.h"
 #  include <compiler.h>
 #  include <map>
-#  include <parmetis.h>   // for indextype
+#  ifdef _PARMETIS
+#    include <parmetis.h>   // for idxtype
+#  else
+typedef int idxtype;       ///< index type of the graph partitioners, as defined by parmetis.h
+#  endif
 #endif
 
 namespace DROPS
@@ -95,6 +95,8 @@ template <class DistFctT>
     }
 #ifdef _PAR
     modified= ProcCL::GlobalOr(modified);
+    if (lb && !modified)
+        lb= lb_.NeedsMigration();   // without grid changes, migrate only if the measured imbalance pays off
 #endif
     if (modified || lb) {
         notify_pre_refine();
@@ -57,6 +57,30 @@ TimeDisc2PhaseCL::~TimeDisc2PhaseCL()
     delete curv_; delete old_curv_;
 }
 
+bool TimeStepControlCL::Check( double dt, double err, int iter, bool converged)
+{
+    err_= err;
+    double fac= facmax_;
+    if (err > 0.)
+        fac= std::min( fac, safety_*std::pow( tol_/err, 1.0/(order_ + 1)));
+    else if (err < 0.) // no error estimate: do not increase the step size
+        fac= std::min( fac, 1.);
+    if (!converged)
+        fac= std::min( fac, 0.5);
+    else if (iter > targetiter_)
+        fac= std::min( fac, static_cast<double>( targetiter_)/iter);
+    fac= std::max( fac, facmin_);
+
+    const bool atmin= dt <= dtmin_*(1. + 1e-10),
+               accept= (converged && err <= tol_) || atmin;
+    dt_= std::min( std::max( fac*dt, dtmin_), dtmax_);
+    if (accept) ++accepted_; else ++rejected_;
+    std::cout << "TimeStepControlCL: dt " << dt << ", error estimate " << err << ", " << iter << " coupling iterations: "
+              << (accept ? "accepted" : "rejected") << (accept && atmin && (!converged || err > tol_) ? " (minimal step size)" : "")
+              << ", next dt " << dt_ << std::endl;
+    return accept;
+}
+
 void cplDeltaSquaredPolicyCL::Update( VecDescCL& v)
 {
     if (firststep_) {
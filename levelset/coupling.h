@@ -29,7 +29,9 @@
 #include "levelset/levelset.h"
 #include "num/MGsolver.h"
 #include "num/nssolver.h"
+#include "num/initialguess.h"
 #include <vector>
+#include <limits>
 #ifdef _PAR
 #include "num/parstokessolver.h"
 #endif
@@ -39,6 +41,53 @@ namespace DROPS
 
 typedef InstatNavierStokes2PhaseP2P1CL StokesT;
 
+/// \brief Step size controller for the coupled time discretizations.
+///
+/// The error of a step is estimated by the relative difference of the computed solution and
+/// its extrapolation from the previous time levels (predictor-corrector estimate). A step is
+/// rejected, if this estimate exceeds the tolerance or if the coupling iteration does not
+/// converge; then the step is repeated with a smaller step size. The new step size follows
+/// dt*safety*(tol/err)^(1/(order+1)); it is not increased, if the coupling iteration needed more
+/// than the target number of iterations or if there is no error estimate yet, e.g. in the first
+/// steps and after a grid change. Steps with the minimal step size are always accepted. No step
+/// goes beyond the final time.
+class TimeStepControlCL
+{
+  private:
+    double tol_,            ///< tolerance for the relative error estimate
+           dtmin_, dtmax_,  ///< bounds for the step size
+           safety_,         ///< safety factor
+           facmin_, facmax_;///< bounds for the change of the step size
+    int    order_,          ///< order of the error estimate
+           targetiter_;     ///< desired number of coupling iterations
+    double dt_,             ///< proposed step size
+           err_,            ///< last error estimate, -1 if not available
+           tend_;           ///< final time
+    int    accepted_, rejected_;
+
+  public:
+    TimeStepControlCL( double tol, double dtmin, double dtmax, int targetiter= 5, int order= 1,
+        double safety= 0.9, double facmin= 0.2, double facmax= 2.0)
+        : tol_( tol), dtmin_( dtmin), dtmax_( dtmax), safety_( safety), facmin_( facmin), facmax_( facmax),
+          order_( order), targetiter_( targetiter), dt_( dtmax), err_( -1.),
+          tend_( std::numeric_limits<double>::max()), accepted_( 0), rejected_( 0) {}
+
+    /// \brief Decide on a step of size dt with error estimate err (negative if not available)
+    ///     which needed iter coupling iterations; computes the proposal for the next step size.
+    bool Check( double dt, double err, int iter, bool converged);
+
+    /// \brief Steps starting at time t are shortened to end at the final time.
+    void   SetFinalTime( double tend) { tend_= tend; }
+    double GetFinalTime()    const { return tend_; }
+    /// \brief The step size for a step starting at time t with the proposed step size dt.
+    double Limit( double t, double dt) const { return std::min( dt, tend_ - t); }
+
+    double GetTimeStep()     const { return dt_; }
+    double GetErrEstimate()  const { return err_; }
+    int    GetNumAccepted()  const { return accepted_; }
+    int    GetNumRejected()  const { return rejected_; }
+};
+
 class TimeDisc2PhaseCL
 {
   protected:
@@ -63,6 +112,9 @@ class TimeDisc2PhaseCL
 
     SchurPreBaseCL* ispc_;             // pointer to preconditioner for the schur complement
 
+    InitialGuessCL stokesguess_,       // history of the solutions (v,p) resp. v for XFEM-pressure
+                   lsetguess_;         // history of the solutions of the level set system
+
   public:
     TimeDisc2PhaseCL( StokesT& Stokes, LevelsetP2CL& ls, LevelsetModifyCL& lsetmod, double dt, double nonlinear=1.);
     virtual ~TimeDisc2PhaseCL();
@@ -88,6 +140,22 @@ class TimeDisc2PhaseCL
     virtual void Update() = 0;
     
     void SetSchurPrePtr( SchurPreBaseCL* ptr) { ispc_ = ptr; }
+
+    /// \brief Choose the step size adaptively by ctrl; not supported by all schemes.
+    virtual void SetTimeStepControl( TimeStepControlCL* ctrl) {
+        if (ctrl != 0)
+            throw DROPSErrCL("TimeDisc2PhaseCL::SetTimeStepControl: adaptive time steps are not supported by this scheme");
+    }
+
+    /// \name Initial guesses from the solution history; not used by all schemes
+    //@{
+    InitialGuessCL& GetStokesGuess() { return stokesguess_; }
+    InitialGuessCL& GetLsetGuess()   { return lsetguess_; }
+    void SetInitialGuess( InitialGuessCL::MethodT method, size_t size= 3, size_t order= 1) {
+        stokesguess_.SetMethod( method); stokesguess_.SetSize( size); stokesguess_.SetOrder( order);
+        lsetguess_.SetMethod( method);   lsetguess_.SetSize( size);   lsetguess_.SetOrder( order);
+    }
+    //@}
 };
 
 template <class LsetSolverT>
@@ -194,6 +262,11 @@ class CoupledTimeDisc2PhaseBaseCL: public TimeDisc2PhaseCL
     double         stab_;
     double         alpha_;
 
+    TimeStepControlCL* tsctrl_;
+
+    VectorCL vpred_, ppred_, phipred_; // predictions of the solution history; empty, if there is none
+    bool     firstiter_;               // true in the first coupling iteration of a time step
+
     virtual void InitStep();
     virtual void CommitStep();
     virtual void SetupNavStokesSystem() = 0;
@@ -201,7 +274,10 @@ class CoupledTimeDisc2PhaseBaseCL: public TimeDisc2PhaseCL
 
     void DoProjectionStep( const VectorCL&);
     void MaybeStabilize  ( VectorCL&);
+    void PredictSolution ();
     void EvalLsetNavStokesEquations();
+    bool DoFixedPointIter( int maxFPiter, int& iter);
+    void SetAdaptiveTimeStep( double dt);
     void SetupStokesMatVec();
 
   public:
@@ -212,6 +288,21 @@ class CoupledTimeDisc2PhaseBaseCL: public TimeDisc2PhaseCL
 
     void DoStep( int maxFPiter= -1);
 
+    /// \brief Choose the step size adaptively in DoStep(); 0 switches the control off.
+    ///
+    /// Rejected steps are repeated from the saved velocity, pressure and level set. Switches on the
+    /// extrapolation of the solution history, which serves as predictor for the error estimate.
+    /// Only for one-step schemes; the substeps of the composed schemes are not controlled.
+    virtual void SetTimeStepControl( TimeStepControlCL* ctrl) {
+        tsctrl_= ctrl;
+        if (tsctrl_ != 0) {
+            if (stokesguess_.GetMethod() == InitialGuessCL::IG_None)
+                SetInitialGuess( InitialGuessCL::IG_Extrapolation, 2, 1);
+            SetAdaptiveTimeStep( dt_);
+        }
+    }
+    const TimeStepControlCL* GetTimeStepControl() const { return tsctrl_; }
+
     virtual void Update();
 };
 
@@ -491,6 +582,11 @@ class CrankNicolsonScheme2PhaseCL: public BaseMethod<LsetSolverT, RelaxationPoli
             DoSubStep( maxFPiter);
     }
 
+    void SetTimeStepControl( TimeStepControlCL* ctrl) {
+        if (ctrl != 0)
+            throw DROPSErrCL("CrankNicolsonScheme2PhaseCL::SetTimeStepControl: adaptive time steps are not supported by this scheme");
+    }
+
     void Update() { substep_ = 0; base_::Update(); }
 
 };
@@ -544,6 +640,11 @@ class FracStepScheme2PhaseCL : public BaseMethod<LsetSolverT, RelaxationPolicyT>
         DoSubStep( maxFPiter);
     }
 
+    void SetTimeStepControl( TimeStepControlCL* ctrl) {
+        if (ctrl != 0)
+            throw DROPSErrCL("FracStepScheme2PhaseCL::SetTimeStepControl: adaptive time steps are not supported by this scheme");
+    }
+
     void Update() { base_::SetTimeStep( GetSubTimeStep(), GetSubTheta()); base_::Update(); }
 };
 
@@ -615,6 +716,11 @@ class Frac2StepScheme2PhaseCL : public BaseMethod<LsetSolverT, RelaxationPolicyT
         DoSubStep( maxFPiter);
     }
 
+    void SetTimeStepControl( TimeStepControlCL* ctrl) {
+        if (ctrl != 0)
+            throw DROPSErrCL("Frac2StepScheme2PhaseCL::SetTimeStepControl: adaptive time steps are not supported by this scheme");
+    }
+
     void Update() { base_::SetTimeStep( GetSubTimeStep(), GetSubTheta()); base_::Update(); }
 };
 
@@ -61,11 +61,15 @@ void LinThetaScheme2PhaseCL<LsetSolverT>::SolveLsNs()
     time.Reset();
 
     // operators are computed for old level set
-    MLTetraAccumulatorTupleCL accus( Stokes_.A.Data.size());
-    accumulate( Stokes_.system1_accu( accus, &Stokes_.A, &Stokes_.M, old_b_, cplA_, cplM_, LvlSet_, Stokes_.v.t),
-                Stokes_.GetMG(), Stokes_.vel_idx.TriangLevel(), Stokes_.vel_idx.GetMatchingFunction(), Stokes_.vel_idx.GetBndInfo());
-    Stokes_.SetupPrStiff( &Stokes_.prA, LvlSet_);
-    Stokes_.SetupPrMass( &Stokes_.prM, LvlSet_);
+    if (implCurv_) {
+        // The MatrixBuilderCL's method of determining when to reuse the pattern
+        // is not save for matrix LB_
+        LB_.Data.clear();
+        LB_.Data.resize( Stokes_.A.Data.size());
+        LB_.SetIdx( &Stokes_.vel_idx, &Stokes_.vel_idx);
+    }
+    Stokes_.SetupStep( &Stokes_.A, &Stokes_.M, old_b_, cplA_, cplM_, /*B*/ 0, 0, /*N*/ 0, 0, 0,
+                       &Stokes_.prA, &Stokes_.prM, implCurv_ ? &LB_ : 0, &cplLB_, LvlSet_, Stokes_.v.t);
 
     if (!implCurv_)
         mat_->LinComb( 1./dt_, Stokes_.M.Data, stk_theta_, Stokes_.A.Data);
@@ -73,12 +77,6 @@ void LinThetaScheme2PhaseCL<LsetSolverT>::SolveLsNs()
     {
         MLMatrixCL mat0;
         mat0.LinComb( 1./dt_, Stokes_.M.Data, stk_theta_, Stokes_.A.Data);
-        // The MatrixBuilderCL's method of determining when to reuse the pattern
-        // is not save for matrix LB_
-        LB_.Data.clear();
-        LB_.Data.resize( Stokes_.A.Data.size());
-        LB_.SetIdx( &Stokes_.vel_idx, &Stokes_.vel_idx);
-        Stokes_.SetupLB( &LB_, &cplLB_, LvlSet_, Stokes_.v.t);
         mat_->LinComb( 1., mat0, dt_, LB_.Data);
     }
     time.Stop();
@@ -96,7 +94,7 @@ void LinThetaScheme2PhaseCL<LsetSolverT>::SolveLsNs()
     std::cout << "Discretizing Levelset took " << duration << " sec.\n";
     time.Reset();
 
-    lsetsolver_.Solve( *L_, LvlSet_.Phi.Data, ls_rhs_);
+    LvlSet_.SolveSystem( lsetsolver_, *L_, LvlSet_.Phi.Data, ls_rhs_);
     std::cout << "res = " << lsetsolver_.GetResid() << ", iter = " << lsetsolver_.GetIter() <<std::endl;
 
     time.Stop();
@@ -220,10 +218,8 @@ void LinThetaScheme2PhaseCL<LsetSolverT>::Update()
     LvlSet_.AccumulateBndIntegral( *old_curv_);
     LvlSet_.SetupSystem( Stokes_.GetVelSolution(), dt_);
 
-    MLTetraAccumulatorTupleCL updates( Stokes_.A.Data.size());
-    Stokes_.system2_accu( updates, &Stokes_.B, &Stokes_.c, LvlSet_, Stokes_.v.t);
-    Stokes_.nonlinear_accu( updates, &Stokes_.N, &Stokes_.v, old_cplN_, LvlSet_, Stokes_.v.t);
-    accumulate( updates, Stokes_.GetMG(), Stokes_.vel_idx.TriangLevel(), Stokes_.vel_idx.GetMatchingFunction(), Stokes_.vel_idx.GetBndInfo());
+    Stokes_.SetupStep( /*A, M*/ 0, 0, 0, 0, 0, &Stokes_.B, &Stokes_.c, &Stokes_.N, &Stokes_.v, old_cplN_,
+                       /*prA, prM*/ 0, 0, /*LB*/ 0, 0, LvlSet_, Stokes_.v.t);
 
     time.Stop();
     duration=time.GetTime();
@@ -309,7 +305,7 @@ void OperatorSplitting2PhaseCL<LsetSolverT>::DoStokesFPIter()
     time.Stop();
     std::cout << "Discretizing Levelset took "<<time.GetTime()<<" sec.\n";
     time.Reset();
-    lsetsolver_.Solve( *L_, LvlSet_.Phi.Data, VectorCL( LvlSet_.E*ls_rhs_));
+    LvlSet_.SolveSystem( lsetsolver_, *L_, LvlSet_.Phi.Data, VectorCL( LvlSet_.E*ls_rhs_));
     std::cout << "res = " << lsetsolver_.GetResid() << ", iter = " << lsetsolver_.GetIter() <<std::endl;
     time.Stop();
     std::cout << "Solving Levelset took "<<time.GetTime()<<" sec.\n";
@@ -361,7 +357,7 @@ void OperatorSplitting2PhaseCL<LsetSolverT>::DoNonlinearFPIter()
     time.Stop();
     std::cout << "Discretizing Levelset took "<<time.GetTime()<<" sec.\n";
     time.Reset();
-    lsetsolver_.Solve( *L_, LvlSet_.Phi.Data, VectorCL( LvlSet_.E*ls_rhs_));
+    LvlSet_.SolveSystem( lsetsolver_, *L_, LvlSet_.Phi.Data, VectorCL( LvlSet_.E*ls_rhs_));
     std::cout << "res = " << lsetsolver_.GetResid() << ", iter = " << lsetsolver_.GetIter() <<std::endl;
     time.Stop();
     std::cout << "Solving Levelset took "<<time.GetTime()<<" sec.\n";
@@ -469,11 +465,8 @@ void OperatorSplitting2PhaseCL<LsetSolverT>::Update()
 
     // Diskretisierung
     LvlSet_.SetupSystem( Stokes_.GetVelSolution(), dt_);
-    Stokes_.SetupSystem1( &Stokes_.A, &Stokes_.M, b_, old_cplA_, old_cplM_, LvlSet_, Stokes_.v.t);
-    Stokes_.SetupSystem2( &Stokes_.B, &Stokes_.c, LvlSet_, Stokes_.v.t);
-    Stokes_.SetupNonlinear( &Stokes_.N, &Stokes_.v, old_cplN_, LvlSet_, Stokes_.v.t);
-    Stokes_.SetupPrStiff( &Stokes_.prA, LvlSet_);
-    Stokes_.SetupPrMass( &Stokes_.prM, LvlSet_);
+    Stokes_.SetupStep( &Stokes_.A, &Stokes_.M, b_, old_cplA_, old_cplM_, &Stokes_.B, &Stokes_.c,
+                       &Stokes_.N, &Stokes_.v, old_cplN_, &Stokes_.prA, &Stokes_.prM, /*LB*/ 0, 0, LvlSet_, Stokes_.v.t);
 
     time.Stop();
     std::cout << "Discretizing took " << time.GetTime() << " sec.\n";
@@ -489,7 +482,8 @@ CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::CoupledTimeDisc2Phas
     ( StokesT& Stokes, LevelsetP2CL& ls, StokesSolverT& solver, LsetSolverT& lsetsolver, LevelsetModifyCL& lsetmod, double dt, double tol,
             double nonlinear, bool withProjection, double stab)
   : base_( Stokes, ls, lsetmod, dt, nonlinear),
-    solver_( solver), lsetsolver_( lsetsolver), tol_(tol), withProj_( withProjection), stab_( stab), alpha_( nonlinear_)
+    solver_( solver), lsetsolver_( lsetsolver), tol_(tol), withProj_( withProjection), stab_( stab), alpha_( nonlinear_),
+    tsctrl_( 0), firstiter_( false)
 {
     Update();
 }
@@ -530,6 +524,25 @@ void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::InitStep()
     LvlSet_.Phi.t+= dt_;
 }
 
+template <class LsetSolverT, class RelaxationPolicyT>
+void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::PredictSolution()
+// extrapolate v, p and phi to the new time level; called after InitStep(). The predictions are only
+// used as start vectors of the solvers in the first coupling iteration: v, p and phi keep the values of
+// the old time level, as the level set system is set up with the old velocity.
+{
+    vpred_.resize( Stokes_.v.Data.size());
+    ppred_.resize( Stokes_.UsesXFEM() ? 0 : Stokes_.p.Data.size()); // the extended pressure unknowns change with the interface
+    if (!(Stokes_.UsesXFEM() ? stokesguess_.Extrapolate( vpred_, Stokes_.v.t)
+                             : stokesguess_.Extrapolate( vpred_, ppred_, Stokes_.v.t))) {
+        vpred_.resize( 0);
+        ppred_.resize( 0);
+    }
+    phipred_.resize( LvlSet_.Phi.Data.size());
+    if (!lsetguess_.Extrapolate( phipred_, LvlSet_.Phi.t))
+        phipred_.resize( 0);
+    firstiter_= true;
+}
+
 template <class LsetSolverT, class RelaxationPolicyT>
 void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::DoProjectionStep( const VectorCL& /*rhscurv*/)
 // perform preceding projection step
@@ -559,7 +572,13 @@ void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::EvalLsetNavStok
 
     time.Reset();
 
-    lsetsolver_.Solve( *L_, LvlSet_.Phi.Data, ls_rhs_);
+    if (firstiter_) { // start from the prediction; later iterations start from the last iterate
+        if (phipred_.size() == LvlSet_.Phi.Data.size())
+            LvlSet_.Phi.Data= phipred_;
+        lsetguess_.Project( *L_, LvlSet_.Phi.Data, ls_rhs_);
+    }
+    LvlSet_.SolveSystem( lsetsolver_, *L_, LvlSet_.Phi.Data, ls_rhs_);
+    lsetguess_.Push( LvlSet_.Phi.Data, LvlSet_.Phi.t);
     std::cout << "res = " << lsetsolver_.GetResid() << ", iter = " << lsetsolver_.GetIter() << std::endl;
 
     time.Stop();
@@ -580,9 +599,22 @@ void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::EvalLsetNavStok
 
     time.Reset();
 
+    if (firstiter_) {
+        if (vpred_.size() == Stokes_.v.Data.size())
+            Stokes_.v.Data= vpred_;
+        if (ppred_.size() != 0 && ppred_.size() == Stokes_.p.Data.size())
+            Stokes_.p.Data= ppred_;
+        if (alpha_ == 0. && !Stokes_.UsesXFEM()) // the projection does not know the convection term
+            stokesguess_.Project( *mat_, Stokes_.B.Data, Stokes_.v.Data, Stokes_.p.Data, rhs_, Stokes_.c.Data);
+        firstiter_= false;
+    }
     solver_.Solve( *mat_, Stokes_.B.Data,
         Stokes_.v, Stokes_.p.Data,
         rhs_, *cplN_, Stokes_.c.Data, alpha_);
+    if (Stokes_.UsesXFEM()) // the extended pressure unknowns change with the interface
+        stokesguess_.Push( Stokes_.v.Data, Stokes_.v.t);
+    else
+        stokesguess_.Push( Stokes_.v.Data, Stokes_.p.Data, Stokes_.v.t);
     time.Stop();
     duration=time.GetTime();
     std::cout << "Solving NavierStokes: residual: " << solver_.GetResid()
@@ -597,7 +629,6 @@ void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::SetupStokesMatV
     curv_->Clear( Stokes_.v.t);
     LvlSet_.AccumulateBndIntegral( *curv_);
 
-    Stokes_.SetupSystem1( &Stokes_.A, &Stokes_.M, b_, b_, cplM_, LvlSet_, Stokes_.v.t);
     if (Stokes_.UsesXFEM()) {
         Stokes_.UpdateXNumbering( &Stokes_.pr_idx, LvlSet_);
         Stokes_.UpdatePressure( &Stokes_.p);
@@ -610,12 +641,11 @@ void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::SetupStokesMatV
         Stokes_.B.Data.clear();
         Stokes_.prA.Data.clear();
         Stokes_.prM.Data.clear();
-        Stokes_.SetupSystem2( &Stokes_.B, &Stokes_.c, LvlSet_, Stokes_.v.t);
     }
     else
         Stokes_.SetupRhs2( &Stokes_.c, LvlSet_, Stokes_.v.t);
-    Stokes_.SetupPrStiff( &Stokes_.prA, LvlSet_);
-    Stokes_.SetupPrMass ( &Stokes_.prM, LvlSet_);
+    Stokes_.SetupStep( &Stokes_.A, &Stokes_.M, b_, b_, cplM_, Stokes_.UsesXFEM() ? &Stokes_.B : 0, &Stokes_.c,
+                       /*N*/ 0, 0, 0, &Stokes_.prA, &Stokes_.prM, /*LB*/ 0, 0, LvlSet_, Stokes_.v.t);
 }
 
 template <class LsetSolverT, class RelaxationPolicyT>
@@ -629,27 +659,24 @@ void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::CommitStep()
 }
 
 template <class LsetSolverT, class RelaxationPolicyT>
-void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::DoStep( int maxFPiter)
+bool CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::DoFixedPointIter( int maxFPiter, int& iter)
+// perform the coupling iteration; returns true, if it has converged
 {
-    if (maxFPiter==-1)
-        maxFPiter= 99;
-
-    InitStep();
     RelaxationPolicyT relax;
 #ifdef _PAR
     const bool useAccur=true;
     ExchangeCL& ExVel  = Stokes_.v.RowIdx->GetEx();
 #endif
     double res_u = 0.0;
-    for (int i=0; i<maxFPiter; ++i)
+    for (iter=1; iter<=maxFPiter; ++iter)
     {
-        std::cout << "~~~~~~~~~~~~~~~~ FP-Iter " << i+1 << '\n';
+        std::cout << "~~~~~~~~~~~~~~~~ FP-Iter " << iter << '\n';
         const VectorCL v( Stokes_.v.Data);
         EvalLsetNavStokesEquations();
         if (solver_.GetIter()==0 && lsetsolver_.GetResid()<lsetsolver_.GetTol()) // no change of vel -> no change of Phi
         {
-            std::cout << "Convergence after " << i+1 << " fixed point iterations!" << std::endl;
-            break;
+            std::cout << "Convergence after " << iter << " fixed point iterations!" << std::endl;
+            return true;
         }
         Stokes_.v.Data = v - Stokes_.v.Data;
 
@@ -667,11 +694,90 @@ void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::DoStep( int max
         Stokes_.v.Data = v - Stokes_.v.Data;
 
         if (res_u < tol_) {
-            std::cout << "Convergence after " << i+1 << " fixed point iterations!" << std::endl;
+            std::cout << "Convergence after " << iter << " fixed point iterations!" << std::endl;
+            return true;
+        }
+    }
+    iter= maxFPiter;
+    return false;
+}
+
+template <class LsetSolverT, class RelaxationPolicyT>
+void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::SetAdaptiveTimeStep( double dt)
+// set the step size chosen by the step size control; the weights of the Schur
+// complement preconditioner depend on dt
+{
+    SetTimeStep( dt);
+    if (ispc_)
+        ispc_->SetWeights( 1.0/dt, ispc_->GetKM());
+}
+
+template <class LsetSolverT, class RelaxationPolicyT>
+void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::DoStep( int maxFPiter)
+{
+    if (maxFPiter==-1)
+        maxFPiter= 99;
+
+    int iter;
+    if (tsctrl_ == 0) {
+        InitStep();
+        PredictSolution();
+        DoFixedPointIter( maxFPiter, iter);
+        CommitStep();
+        return;
+    }
+
+    // adaptive step size: save the state for a rollback of rejected steps
+    const double t0= Stokes_.v.t;
+    const VectorCL v0( Stokes_.v.Data), p0( Stokes_.p.Data), phi0( LvlSet_.Phi.Data);
+#ifdef _PAR
+    const bool useAccur=true;
+    ExchangeCL& ExVel= Stokes_.v.RowIdx->GetEx();
+    ExchangeCL& ExLset= LvlSet_.Phi.RowIdx->GetEx();
+#endif
+    for (;;) {
+        if (tsctrl_->Limit( t0, dt_) < dt_) // do not step beyond the final time
+            SetAdaptiveTimeStep( tsctrl_->Limit( t0, dt_));
+        const bool hashistory= stokesguess_.size() > 1 && lsetguess_.size() > 1;
+        InitStep();
+        PredictSolution();
+        const bool haspredictor= hashistory && vpred_.size() == Stokes_.v.Data.size() && phipred_.size() == LvlSet_.Phi.Data.size();
+        const VectorCL vpred( vpred_), phipred( phipred_);
+        const bool converged= DoFixedPointIter( maxFPiter, iter) || maxFPiter == 1;
+
+        double err= -1.;
+        if (haspredictor) {
+#ifndef _PAR
+            const double errv= norm( VectorCL( Stokes_.v.Data - vpred))/std::max( norm( Stokes_.v.Data), 1e-15),
+                         errphi= norm( VectorCL( LvlSet_.Phi.Data - phipred))/std::max( norm( LvlSet_.Phi.Data), 1e-15);
+#else
+            const double errv= ExVel.Norm( VectorCL( Stokes_.v.Data - vpred), true, useAccur)/std::max( ExVel.Norm( Stokes_.v.Data, true, useAccur), 1e-15),
+                         errphi= ExLset.Norm( VectorCL( LvlSet_.Phi.Data - phipred), true, useAccur)/std::max( ExLset.Norm( LvlSet_.Phi.Data, true, useAccur), 1e-15);
+#endif
+            std::cout << "error estimate: velocity " << errv << ", level set " << errphi << '\n';
+            err= std::max( errv, errphi);
+        }
+        if (tsctrl_->Check( dt_, err, iter, converged))
             break;
+
+        // rollback; the schemes keep their own copies of the operators of the old time level,
+        // see SpaceTimeDiscTheta2PhaseCL::InitStep
+        Stokes_.v.t= Stokes_.p.t= LvlSet_.Phi.t= t0;
+        Stokes_.v.Data= v0;
+        LvlSet_.Phi.Data= phi0;
+        if (Stokes_.UsesXFEM()) { // the extended pressure unknowns depend on the level set
+            Stokes_.UpdateXNumbering( &Stokes_.pr_idx, LvlSet_);
+            Stokes_.UpdatePressure( &Stokes_.p);
         }
+        if (Stokes_.p.Data.size() == p0.size())
+            Stokes_.p.Data= p0;
+        stokesguess_.Discard( t0);
+        lsetguess_.Discard( t0);
+        lsetmod_.rollback();
+        SetAdaptiveTimeStep( tsctrl_->GetTimeStep());
     }
     CommitStep();
+    SetAdaptiveTimeStep( tsctrl_->GetTimeStep());
 }
 
 template <class LsetSolverT, class RelaxationPolicyT>
@@ -692,6 +798,9 @@ void CoupledTimeDisc2PhaseBaseCL<LsetSolverT,RelaxationPolicyT>::Update()
 
     rhs_.resize   ( vidx->NumUnknowns());
     ls_rhs_.resize( LvlSet_.idx.NumUnknowns());
+
+    stokesguess_.Clear();
+    lsetguess_.Clear();
 }
 
 // ==============================================
@@ -825,8 +934,9 @@ template <class LsetSolverT, class RelaxationPolicyT>
 void SpaceTimeDiscTheta2PhaseCL<LsetSolverT,RelaxationPolicyT>::InitStep()
 {
     base_::InitStep();
-    fixed_ls_rhs_ = (1./dt_) * (LvlSet_.E * oldphi_)    + phidot_;
-    fixed_rhs_    = (1./dt_) * (Stokes_.M.Data * oldv_) + vdot_;
+    // E and M of the old time level; after a rejected step, LvlSet_.E and Stokes_.M belong to the new interface
+    fixed_ls_rhs_ = (1./dt_) * ((*Eold_) * oldphi_) + phidot_;
+    fixed_rhs_    = (1./dt_) * ((*Mold_) * oldv_)   + vdot_;
     if (!implicitpressure_)              // Just to have a better starting-value for p.
         Stokes_.p.Data *= stk_theta_;
 }
@@ -884,13 +994,9 @@ void SpaceTimeDiscTheta2PhaseCL<LsetSolverT,RelaxationPolicyT>::Update()
     // Diskretisierung
     LvlSet_.AccumulateBndIntegral( *old_curv_);
     LvlSet_.SetupSystem( Stokes_.GetVelSolution(), dt_);
-    Stokes_.SetupSystem1( &Stokes_.A, &Stokes_.M, old_b_, old_b_, old_cplM_, LvlSet_, Stokes_.v.t);
-    Stokes_.SetupSystem2( &Stokes_.B, &Stokes_.c, LvlSet_, Stokes_.v.t);
-    Stokes_.SetupNonlinear( &Stokes_.N, &Stokes_.v, old_cplN_, LvlSet_, Stokes_.v.t);
-
-    // Vorkonditionierer
-    Stokes_.SetupPrStiff( &Stokes_.prA, LvlSet_);
-    Stokes_.SetupPrMass( &Stokes_.prM, LvlSet_);
+    // including the matrices for the preconditioner
+    Stokes_.SetupStep( &Stokes_.A, &Stokes_.M, old_b_, old_b_, old_cplM_, &Stokes_.B, &Stokes_.c,
+                       &Stokes_.N, &Stokes_.v, old_cplN_, &Stokes_.prA, &Stokes_.prM, /*LB*/ 0, 0, LvlSet_, Stokes_.v.t);
 
     ComputeDots();
     time.Stop();
@@ -1110,13 +1216,9 @@ void RecThetaScheme2PhaseCL<LsetSolverT,RelaxationPolicyT>::Update()
     // Diskretisierung
     LvlSet_.AccumulateBndIntegral( *old_curv_);
     LvlSet_.SetupSystem( Stokes_.GetVelSolution(), dt_);
-    Stokes_.SetupSystem1( &Stokes_.A, &Stokes_.M, old_b_, old_b_, old_cplM_, LvlSet_, Stokes_.v.t);
-    Stokes_.SetupSystem2( &Stokes_.B, &Stokes_.c, LvlSet_, Stokes_.v.t);
-    Stokes_.SetupNonlinear( &Stokes_.N, &Stokes_.v, old_cplN_, LvlSet_, Stokes_.v.t);
-
-    // Vorkonditionierer
-    Stokes_.SetupPrStiff( &Stokes_.prA, LvlSet_);
-    Stokes_.SetupPrMass( &Stokes_.prM, LvlSet_);
+    // including the matrices for the preconditioner
+    Stokes_.SetupStep( &Stokes_.A, &Stokes_.M, old_b_, old_b_, old_cplM_, &Stokes_.B, &Stokes_.c,
+                       &Stokes_.N, &Stokes_.v, old_cplN_, &Stokes_.prA, &Stokes_.prM, /*LB*/ 0, 0, LvlSet_, Stokes_.v.t);
 
     // initialer Druck
     ComputePressure();
@@ -1106,7 +1106,10 @@ void FastmarchingCL::DetermineDistances()
         elemClose= std::max( elemClose, close_.size());
 #endif
         // remark: next < size_   =>   Map not needed for next
-        next= close_.GetNearest().second;
+        const DistIdxT nearest= close_.GetNearest();
+        if (data_.bandWidth > 0. && nearest.first >= data_.bandWidth)
+            break; // narrow band: all remaining vertices are farther away than bandWidth; they are clipped later
+        next= nearest.second;
         data_.typ[next] = data_.Finished;
 
         std::set<IdxT> neighVerts;
@@ -1119,6 +1122,10 @@ void FastmarchingCL::DetermineDistances()
         }
         neigh_[next].clear(); // will not be needed anymore
     }
+    if (data_.bandWidth > 0.) // narrow band: vertices not reached are at least bandWidth away
+        for (size_t i=0; i<data_.phi.Data.size(); ++i)
+            if ( data_.typ[i] != data_.Finished)
+                data_.phi.Data[i]= data_.bandWidth;
 
 #ifdef COUNTMEM
     usedMem_=  elemClose*memPerClose                // elements in close
@@ -1403,6 +1410,127 @@ void FastmarchingOnMasterCL::Perform()
 }
 #endif      // of _PAR
 
+// F R O N T I E R  T R E E  C L
+//------------------------------
+
+/// \brief Minimum of |p-q|+val(q) over the numNeigh nearest neighbors q of p in tree
+inline double MinDistanceInTree( const FrontierTreeCL::TreeT& tree, const VectorCL& vals, const Point3DCL& p, size_t numNeigh)
+{
+    typedef KDTree::SearchNearestNeighborsCL<2,double,3,12> SearcherT;
+    SearcherT searcher( tree, Addr(p), numNeigh);
+    searcher.search();
+    const SearcherT::result_type& result= searcher.result();
+    double dist= std::numeric_limits<double>::max();
+    for ( size_t n=0; n<result.size(); ++n)
+        dist= std::min( dist, result[n].distance() + vals[ tree.get_orig(result[n].get_idx())]);
+    return dist;
+}
+
+void FrontierTreeCL::Clear()
+{
+    delete tree_;  tree_=0;
+    delete delta_; delta_=0;
+    vals_.resize( 0); deltaVals_.resize( 0);
+    treePos_.clear(); keyPos_.clear();
+    numUpdates_= 0;
+}
+
+void FrontierTreeCL::Rebuild( const VectorCL& front, const VectorCL& vals, const KeyVecT& keys)
+{
+    Clear();
+    numChanged_= vals.size();
+    if ( vals.size()==0)
+        return;
+    tree_= new TreeT();
+    KDTree::TreeBuilderCL<double, 3>( *tree_).build( front);
+    vals_.resize( vals.size()); vals_= vals;
+
+    // merged (identical) points are not contained in the tree
+    treePos_.assign( vals.size(), NoIdx);
+    for ( size_t i=0; i<tree_->size(); ++i)
+        treePos_[ tree_->get_orig( i)]= i;
+    keyPos_.assign( *std::max_element( keys.begin(), keys.end())+1, NoIdx);
+    for ( size_t i=0; i<keys.size(); ++i)
+        keyPos_[ keys[i]]= i;
+}
+
+void FrontierTreeCL::Update( const VectorCL& front, const VectorCL& vals, const KeyVecT& keys)
+/** Points with a key of the last rebuild keep their place in the tree, moved points are
+    handled by refitting the bounding boxes. Points with unknown keys are put into the
+    second tree delta_, points of the last rebuild which are not given any more are
+    removed by setting their value to +inf. Note, that removed points still occupy
+    places in the result of a nearest neighbor search.
+*/
+{
+    if ( tree_==0 || numUpdates_>=maxUpdates_){
+        Rebuild( front, vals, keys);
+        return;
+    }
+
+    const double inf= std::numeric_limits<double>::max();
+    VectorCL newVals( inf, vals_.size());
+    KeyVecT  inserted;
+    bool     moved= false;
+    for ( size_t i=0; i<vals.size(); ++i){
+        const size_t pos= keys[i]<keyPos_.size() ? keyPos_[keys[i]] : NoIdx;
+        if ( pos==NoIdx || treePos_[pos]==NoIdx || newVals[pos]!=inf){
+            inserted.push_back( i);
+            continue;
+        }
+        double* x= tree_->addr( treePos_[pos]);
+        for ( int j=0; j<3; ++j){
+            if ( x[j]!=front[3*i+j]){
+                x[j]= front[3*i+j];
+                moved= true;
+            }
+        }
+        newVals[pos]= vals[i];
+    }
+    size_t removed= 0;
+    for ( size_t pos=0; pos<newVals.size(); ++pos)
+        if ( treePos_[pos]!=NoIdx && newVals[pos]==inf)
+            ++removed;
+
+    numChanged_= inserted.size() + removed;
+    if ( numChanged_ > rebuildFraction_*vals.size()){
+        Rebuild( front, vals, keys);
+        return;
+    }
+
+    vals_= newVals;
+    if ( moved)
+        tree_->refit();
+    delete delta_; delta_=0;
+    deltaVals_.resize( inserted.size());
+    if ( !inserted.empty()){
+        VectorCL deltaFront( 3*inserted.size());
+        for ( size_t i=0; i<inserted.size(); ++i){
+            for ( int j=0; j<3; ++j)
+                deltaFront[3*i+j]= front[3*inserted[i]+j];
+            deltaVals_[i]= vals[inserted[i]];
+        }
+        delta_= new TreeT();
+        KDTree::TreeBuilderCL<double, 3>( *delta_).build( deltaFront);
+    }
+    ++numUpdates_;
+}
+
+double FrontierTreeCL::MinDistance( const Point3DCL& p, size_t numNeigh) const
+{
+    double dist= std::numeric_limits<double>::max();
+    if ( tree_!=0)
+        dist= MinDistanceInTree( *tree_, vals_, p, numNeigh);
+    if ( delta_!=0)
+        dist= std::min( dist, MinDistanceInTree( *delta_, deltaVals_, p, numNeigh));
+    return dist;
+}
+
+size_t FrontierTreeCL::memory() const
+{
+    return (tree_ ? tree_->memory() : 0) + (delta_ ? delta_->memory() : 0)
+         + sizeof(double)*(vals_.size()+deltaVals_.size()) + sizeof(size_t)*(treePos_.size()+keyPos_.size());
+}
+
 // D I R E C T  D I S T A N C E  C L
 //----------------------------------
 
@@ -1426,6 +1554,7 @@ void DirectDistanceCL::InitFrontVector()
     // and store distance of each frontier vertex
     front_.resize(0); front_.resize( 3*numFront);
     vals_.resize(0);  vals_.resize( numFront);
+    keys_.resize( numFront);
     size_t pos=0;
     size_t posDist=0;
     for ( size_t i=0; i<augm_size; ++i){
@@ -1434,15 +1563,18 @@ void DirectDistanceCL::InitFrontVector()
             for ( int j=0; j<3; ++j){
                 front_[ pos++]= data_.coord[i][j];
             }
+            keys_[ posDist]= i;
             vals_[ posDist++]= data_.phi.Data[MapI];
         }
     }
+    size_t posPerp= posDist;
     for ( size_t i=0; i<data_.perpFoot.size() && data_.UsePerp(); ++i){
         if ( data_.perpFoot[i]!=0){
             for ( int j=0; j<3; ++j){
                 front_[ pos++]= (*data_.perpFoot[i])[j];
             }
             // we do not need to set distance to 0, because std::valarray is initialized by 0
+            keys_[ posPerp++]= augm_size + i;
         }
     }
 #ifndef _PAR
@@ -1454,13 +1586,16 @@ void DirectDistanceCL::InitFrontVector()
 }
 
 void DirectDistanceCL::BuildKDTree()
-/** Take the elements out of front_ and build a kd-tree representing this set
+/** Take the elements out of front_ and build a kd-tree representing this set. If
+    the tree of the previous reparametrization is kept (ReparamDataCL::frontTree),
+    it is only updated, as long as the frontier set has not changed too much.
     \pre InitFrontVector has to be called
  */
 {
-    kdTree_= new KDTree::TreeCL<double,3>();
-    KDTree::TreeBuilderCL<double, 3> kd_tree_builder( *kdTree_);
-    kd_tree_builder.build( front_);
+    FrontierTreeCL& tree= Tree();
+    tree.Update( front_, vals_, keys_);
+    if ( !tree.WasRebuilt())
+        std::cout << " * Updated kd-tree, " << tree.NumChanged() << " frontier points changed" << std::endl;
 }
 
 void DirectDistanceCL::DetermineDistances()
@@ -1468,22 +1603,17 @@ void DirectDistanceCL::DetermineDistances()
     frontier vertex or perpendicular foot to phi
 */
 {
-#pragma omp parallel for
+    const FrontierTreeCL& tree= Tree();
+    if ( tree.Empty())
+        return;
+    // the costs of the queries differ, and each dof is written by exactly one thread
+#pragma omp parallel for schedule(dynamic,256)
     for ( int dof=0; dof<(int)data_.phi.Data.size(); ++dof) {
         if ( data_.typ[dof]!=ReparamDataCL::Finished && data_.typ[dof]!=ReparamDataCL::Handled) {
             double newPhi= std::numeric_limits<double>::max();
             const Point3DCL coord= data_.coord[dof];
-            for (ReparamDataCL::perDirSetT::const_iterator dir= data_.perDir.begin(), end= data_.perDir.end(); dir!=end; ++dir) {
-                const Point3DCL p= coord + *dir;
-                typedef KDTree::SearchNearestNeighborsCL<2,double,3,12> SearcherT;
-                SearcherT searcher( *kdTree_, Addr(p), numNeigh_);
-                searcher.search();
-                SearcherT::result_type result= searcher.result();
-                for ( size_t n=0; n<result.size(); ++n){
-                    newPhi= std::min( newPhi, result[n].distance() + vals_[ kdTree_->get_orig(result[n].get_idx())]);
-                }
-            }
-#pragma omp critical
+            for (ReparamDataCL::perDirSetT::const_iterator dir= data_.perDir.begin(), end= data_.perDir.end(); dir!=end; ++dir)
+                newPhi= std::min( newPhi, tree.MinDistance( coord + *dir, numNeigh_));
             data_.phi.Data[dof]= newPhi;
         }
     }
@@ -1492,7 +1622,7 @@ void DirectDistanceCL::DetermineDistances()
 void DirectDistanceCL::DisplayMem() const
 {
     const size_t memFront= front_.size()*8, memVals= vals_.size()*8;
-    const size_t memKDTree= kdTree_->memory();
+    const size_t memKDTree= Tree().memory();
     const size_t memData= (8+3*8+1)* data_.phi.Data.size();
     const size_t memByte= memData+memFront+memVals+memKDTree;
     const double mem=double(memByte)/1024/1024;
@@ -1508,7 +1638,7 @@ void DirectDistanceCL::Perform()
     BuildKDTree();
     DetermineDistances();
     DisplayMem();
-    delete kdTree_; kdTree_=0;
+    localTree_.Clear();
 }
 
 // P A R  D I R E C T  D I S T A N C E  C L
@@ -1578,22 +1708,103 @@ void ParDirectDistanceCL::CommunicateFrontierSetOnProcBnd()
 }
 
 void ParDirectDistanceCL::GatherFrontier()
-/** Call of MPI function Allgatherv
+/** Instead of gathering the whole frontier set on all processes, a process only receives
+    those frontier vertices and perpendicular feet of other processes, which may be closer
+    to one of its vertices than its own frontier set. Therefore, the distance d(x) of each
+    off-site vertex x to the own frontier set is determined by the nearest neighbor. Only
+    points within the ball around x with radius d(x) (at most the width of the narrow
+    band) may be closer. The bounding box of all these balls is exchanged among all
+    processes, and each process sends its frontier points located in the bounding box of
+    another process to this process.
     \pre To gather the frontier and vertices and perpendicular feet, this information must
     be collected by calling base::InitFrontVector
 */
 {
-    //call MPI_Allgatherv to gather values and frontier vertices
-    VectorCL allVals ( ProcCL::Gatherv( base::vals_,  -1)),
-             allFront( ProcCL::Gatherv( base::front_, -1));
+    const int    me= ProcCL::MyRank(), size= ProcCL::Size();
+    const double inf= std::numeric_limits<double>::max();
+
+    // bounding box (min x,y,z, max x,y,z) of the balls around the own off-site vertices
+    FrontierTreeCL ownFront;
+    ownFront.Update( front_, vals_, keys_);
+    double box[6]= { inf, inf, inf, -inf, -inf, -inf };
+    for ( size_t dof=0; dof<data_.phi.Data.size(); ++dof) {
+        if ( data_.typ[dof]==ReparamDataCL::Finished || data_.typ[dof]==ReparamDataCL::Handled)
+            continue;
+        for (ReparamDataCL::perDirSetT::const_iterator dir= data_.perDir.begin(), end= data_.perDir.end(); dir!=end; ++dir) {
+            const Point3DCL p= data_.coord[dof] + *dir;
+            double r= ownFront.Empty() ? inf : ownFront.MinDistance( p, 1);
+            if ( data_.bandWidth>0.)
+                r= std::min( r, data_.bandWidth);
+            for ( int j=0; j<3; ++j){
+                box[j]  = std::min( box[j],   p[j]-r);
+                box[3+j]= std::max( box[3+j], p[j]+r);
+            }
+        }
+    }
+    ownFront.Clear();
+    std::vector<double> allBoxes( 6*size);
+    ProcCL::Gather( box, Addr(allBoxes), 6, -1);
+
+    // collect own frontier points (x,y,z,value) within the bounding boxes of other processes
+    std::vector<std::vector<double> > sendBuf( size);
+    std::vector<int> sendCnt( size, 0);
+    for ( int p=0; p<size; ++p) {
+        if ( p==me)
+            continue;
+        const double* b= &allBoxes[6*p];
+        for ( size_t i=0; i<vals_.size(); ++i) {
+            const double* x= &front_[3*i];
+            if ( x[0]>=b[0] && x[1]>=b[1] && x[2]>=b[2] && x[0]<=b[3] && x[1]<=b[4] && x[2]<=b[5]) {
+                sendBuf[p].insert( sendBuf[p].end(), x, x+3);
+                sendBuf[p].push_back( vals_[i]);
+            }
+        }
+        sendCnt[p]= sendBuf[p].size();
+    }
+    // allCnt[p*size+q] is the number of entries sent from p to q
+    std::vector<int> allCnt( size*size);
+    ProcCL::Gather( Addr(sendCnt), Addr(allCnt), size, -1);
+
+    std::vector<std::valarray<double> > recvBuf( size);
+    std::vector<ProcCL::RequestT> req;
+    for ( int p=0; p<size; ++p) {
+        if ( p!=me && sendCnt[p]>0)
+            req.push_back( ProcCL::Isend( sendBuf[p], p, 1502));
+        if ( p!=me && allCnt[p*size+me]>0) {
+            recvBuf[p].resize( allCnt[p*size+me]);
+            req.push_back( ProcCL::Irecv( recvBuf[p], p, 1502));
+        }
+    }
+    ProcCL::WaitAll( req);
 
-    // local sets are not need any more ...
+    // append received points; their keys follow the keys of the own points
+    const size_t numOwn= vals_.size();
+    size_t numRecv= 0;
+    for ( int p=0; p<size; ++p)
+        numRecv+= recvBuf[p].size()/4;
+    VectorCL allFront( 3*(numOwn+numRecv)), allVals( numOwn+numRecv);
+    for ( size_t i=0; i<3*numOwn; ++i)
+        allFront[i]= front_[i];
+    for ( size_t i=0; i<numOwn; ++i)
+        allVals[i]= vals_[i];
+    keys_.resize( numOwn+numRecv);
+    const size_t firstKey= data_.phi.Data.size() + data_.map.size() + data_.perpFoot.size();
+    size_t pos= numOwn;
+    for ( int p=0; p<size; ++p) {
+        for ( size_t k=0; k<recvBuf[p].size()/4; ++k, ++pos) {
+            for ( int j=0; j<3; ++j)
+                allFront[3*pos+j]= recvBuf[p][4*k+j];
+            allVals[pos]= recvBuf[p][4*k+3];
+            keys_[pos]= firstKey + pos - numOwn;
+        }
+    }
     base::vals_.resize( allVals.size()); vals_=allVals;
     base::front_.resize( allFront.size()); front_=allFront;
 
     Uint numLsetUnk= ProcCL::GlobalSum(data_.phi.Data.size());
     std::cout << " * Lset unk " << numLsetUnk
-              << ", frontier and perpendicular feet " << vals_.size() << std::endl;
+              << ", frontier and perpendicular feet " << ProcCL::GlobalSum(numOwn)
+              << ", received " << ProcCL::GlobalSum(numRecv) << std::endl;
 }
 
 void ParDirectDistanceCL::CleanUp()
@@ -1609,7 +1820,7 @@ void ParDirectDistanceCL::Perform()
     GatherFrontier();
     base::BuildKDTree();
     base::DetermineDistances();
-    delete kdTree_; kdTree_=0;
+    localTree_.Clear();
 }
 #endif
 
@@ -1649,6 +1860,17 @@ void ReparamCL::RestoreSigns()
     }
 }
 
+void ReparamCL::ClipToBand()
+{
+    if (data_.bandWidth <= 0.)
+        return;
+    const double w= data_.bandWidth;
+#pragma omp parallel for schedule(static)
+    for ( int i=0; i<(int)data_.phi.Data.size(); ++i)
+        if ( data_.phi.Data[i]>w)
+            data_.phi.Data[i]= w;
+}
+
 void ReparamCL::Perform()
 {
     std::cout << "Reparametrize level set function\n";
@@ -1676,6 +1898,7 @@ void ReparamCL::Perform()
     propagate_->Perform();
     timer.Stop();
     std::cout << " * Propagation by " << propagate_->GetName() << " took " << timer.GetTime() << " sec." << std::endl;
+    ClipToBand();
     RestoreSigns();
 
     alltimer.Stop();
@@ -43,6 +43,9 @@
 namespace DROPS
 {
 
+// fwd declaration
+class FrontierTreeCL;
+
 /// \brief Store all data needed by reparametrization classes
 class ReparamDataCL
 {
@@ -72,6 +75,8 @@ class ReparamDataCL
     const BndDataCL<>*       bnd;         ///< boundary for level set function
     perMapVecT               map;         ///< mapping of periodic boundary conditions
     perDirSetT               perDir;      ///< set of directions to be considered in case of periodic boundaries (only used by DirectDistanceCL)
+    double                   bandWidth;   ///< if > 0, distances are only computed up to bandWidth; values beyond are clipped to bandWidth (narrow band)
+    FrontierTreeCL*          frontTree;   ///< if not 0, k-d tree of the frontier set kept between reparametrizations (only used by DirectDistanceCL)
 
   public:
     // \brief Allocate memory, store references and init coordinates as well as map periodic boundary dofs
@@ -79,7 +84,7 @@ class ReparamDataCL
         : gatherPerp(GatherPerp), mg( MG), phi( Phi), old( phi.Data),
           coord( Phi.Data.size()), typ( Far, Phi.Data.size()), 
           perpFoot( (Point3DCL*)0, GatherPerp ? Phi.Data.size() : 0),
-          per( Periodic), augmIdx( 0), bnd( Bnd), map( 0), perDir( 1, Point3DCL())
+          per( Periodic), augmIdx( 0), bnd( Bnd), map( 0), perDir( 1, Point3DCL()), bandWidth( 0.), frontTree( 0)
     { InitPerMap(); InitCoord(); }
     /// \brief Delete all perpendicular feet
     ~ReparamDataCL();
@@ -533,6 +538,61 @@ extern "C" int HandlerFinishedScatterEdgeC(OBJT objp, void* buf);
 //@}
 #endif
 
+/// \brief k-d tree of frontier vertices and perpendicular feet which can be updated incrementally
+/** Each point of the frontier set is identified by a key, e.g., the index of the
+    frontier vertex. If the interface moves only a little between two reparametrizations,
+    most of the points are kept. Then the tree of the last rebuild is updated:
+    - points which are not contained any more get the value +inf,
+    - points with the same key, but other coordinates are moved within the tree (see KDTree::TreeCL::refit),
+    - new points are stored in a second, small tree.
+    The tree is rebuilt, if more than a fraction of the points has been inserted or removed,
+    or after a maximal number of updates.
+*/
+class FrontierTreeCL
+{
+  public:
+    typedef KDTree::TreeCL<double, 3> TreeT;
+    typedef std::vector<size_t>       KeyVecT;
+
+  private:
+    TreeT*   tree_;             ///< k-d tree of the frontier set of the last rebuild
+    TreeT*   delta_;            ///< k-d tree of the points inserted since the last rebuild
+    VectorCL vals_;             ///< values on the points of tree_, +inf for removed points
+    VectorCL deltaVals_;        ///< values on the points of delta_
+    KeyVecT  treePos_;          ///< position of the points of the last rebuild within tree_, NoIdx for merged points
+    KeyVecT  keyPos_;           ///< maps a key to the position of the point in the last rebuild, NoIdx if not contained
+    double   rebuildFraction_;  ///< rebuild, if more points than this fraction are inserted or removed
+    Uint     maxUpdates_;       ///< rebuild after this number of updates
+    Uint     numUpdates_;       ///< number of updates since the last rebuild
+    size_t   numChanged_;       ///< number of inserted and removed points by the last update
+
+    void Rebuild( const VectorCL& front, const VectorCL& vals, const KeyVecT& keys);
+    FrontierTreeCL& operator=( const FrontierTreeCL&);
+
+  public:
+    FrontierTreeCL( double rebuildFraction=0.1, Uint maxUpdates=10)
+        : tree_( 0), delta_( 0), rebuildFraction_( rebuildFraction), maxUpdates_( maxUpdates),
+          numUpdates_( 0), numChanged_( 0) {}
+    /// \brief Copies only the parameters, the tree is built by the next update
+    FrontierTreeCL( const FrontierTreeCL& t)
+        : tree_( 0), delta_( 0), rebuildFraction_( t.rebuildFraction_), maxUpdates_( t.maxUpdates_),
+          numUpdates_( 0), numChanged_( 0) {}
+    ~FrontierTreeCL() { Clear(); }
+
+    /// \brief Free all memory; the next update rebuilds the tree
+    void Clear();
+    /// \brief Represent the points front (3 coordinates each) with values vals and keys keys
+    void Update( const VectorCL& front, const VectorCL& vals, const KeyVecT& keys);
+    /// \brief Minimum of |p-q|+val(q) over the numNeigh nearest points q of p
+    double MinDistance( const Point3DCL& p, size_t numNeigh) const;
+
+    bool   Empty()      const { return tree_==0 && delta_==0; }
+    /// \brief True, if the last update has rebuilt the tree
+    bool   WasRebuilt() const { return numUpdates_==0; }
+    size_t NumChanged() const { return numChanged_; }
+    size_t memory()     const;
+};
+
 /// \brief Determine distances by direct distance computing to frontier vertices and
 ///        perpendicular feet
 class DirectDistanceCL : public PropagateCL
@@ -541,21 +601,25 @@ class DirectDistanceCL : public PropagateCL
     typedef PropagateCL base;
 
   protected:
-    KDTree::TreeCL<double, 3>* kdTree_;      ///< k-d tree to search for nearest neighbors
-    size_t                     numNeigh_;    ///< number of neighbors
-    VectorCL                   front_;       ///< coordinates of frontier vertices and perpendicular feet
-    VectorCL                   vals_;        ///< values of phi on frontier vertices and perpendicular feet
-
-    /// \brief Initialize the vectors front_ and vals_
+    FrontierTreeCL          localTree_;   ///< k-d tree to search for nearest neighbors, if data_.frontTree is not set
+    size_t                  numNeigh_;    ///< number of neighbors
+    VectorCL                front_;       ///< coordinates of frontier vertices and perpendicular feet
+    VectorCL                vals_;        ///< values of phi on frontier vertices and perpendicular feet
+    FrontierTreeCL::KeyVecT keys_;        ///< keys of frontier vertices and perpendicular feet
+
+    /// \brief k-d tree to search for nearest neighbors
+    FrontierTreeCL&       Tree()       { return data_.frontTree ? *data_.frontTree : localTree_; }
+    const FrontierTreeCL& Tree() const { return data_.frontTree ? *data_.frontTree : localTree_; }
+    /// \brief Initialize the vectors front_, vals_ and keys_
     void InitFrontVector();
-    /// \brief Build the KD-Tree of front_
+    /// \brief Build or update the KD-Tree of front_
     void BuildKDTree();
     /// \brief Determine distances by using the kd-tree
     void DetermineDistances();
 
   public:
     DirectDistanceCL( ReparamDataCL& data, size_t numNeigh=100)
-        : base( data, "Direct Distance"), kdTree_(0), numNeigh_( numNeigh), front_(0), vals_(0) {}
+        : base( data, "Direct Distance"), numNeigh_( numNeigh), front_(0), vals_(0) {}
     /// \brief Determine unsigned distances by the direct computing of distances
     virtual void Perform();
     /// \brief Show memory
@@ -581,7 +645,7 @@ class ParDirectDistanceCL : public DirectDistanceCL
     /// \brief Communicate values and perpendicular feet on frontier vertices located at
     ///    process boundaries
     void CommunicateFrontierSetOnProcBnd();
-    /// \brief Communicate all values and perpendicular feet of all processes
+    /// \brief Communicate values and perpendicular feet of other processes within the bounding box of the own vertices plus search radius
     void GatherFrontier();
     /// \brief Clean up memory
     void CleanUp();
@@ -627,11 +691,17 @@ class ReparamCL
 
     /// \brief Restore all signs
     void RestoreSigns();
+    /// \brief Clip the values to [-bandWidth, bandWidth], if a narrow band is used
+    void ClipToBand();
 
   public:
     /// \brief Constructor
     ReparamCL( MultiGridCL& mg, VecDescCL& phi, bool gatherPerp, bool periodic=false, const BndDataCL<>* bnd=0);
     ~ReparamCL();
+    /// \brief Compute distances only within |phi| < width (narrow band); width <= 0 means the whole domain
+    void SetBandWidth( double width) { data_.bandWidth= width; }
+    /// \brief Keep the k-d tree of the frontier set in tree between reparametrizations (DirectDistanceCL only)
+    void SetFrontierTree( FrontierTreeCL* tree) { data_.frontTree= tree; }
     /// \brief Perform the reparametrization
     void Perform();
 };
@@ -228,8 +228,8 @@ int ParInitZeroExactCL::ExecGatherDistTriang(OBJT obj)
     if ( sp->Unknowns.Exist() && sp->Unknowns.Exist( idx)){
         const IdxT dof= sp->Unknowns( idx);
         if ( !(*distTriangs_)[dof].empty()){
-            const ExchangeCL::ProcNumCT neighs= actualData_->phi.RowIdx->GetEx().GetProcs(dof);
-            for ( typename ExchangeCL::ProcNumCT::const_iterator it=neighs.begin(); it!=neighs.end(); ++it)
+            const ExchangeCL& ex= actualData_->phi.RowIdx->GetEx();
+            for ( ExchangeCL::ProcNum_const_iterator it=ex.GetProcsBegin(dof); it!=ex.GetProcsEnd(dof); ++it)
                 toSend_->insert( (*distTriangs_)[dof].begin(), (*distTriangs_)[dof].end());
             maxTriangsPerDOF_= std::max( maxTriangsPerDOF_, (*distTriangs_)[dof].size());
         }
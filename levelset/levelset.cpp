@@ -535,6 +535,164 @@ void MarkInterface ( const LevelsetP2CL::const_DiscSolCL& lset, double width, Mu
 }
 
 
+//*****************************************************************************
+//                               NarrowBandCL
+//*****************************************************************************
+
+void NarrowBandCL::Build (const MultiGridCL& mg, const VecDescCL& phi, const LsetBndDataCL& bnd)
+{
+    const size_t n= phi.Data.size();
+    global2tube_.resize( n);
+    tube2global_.clear();
+    for (size_t i= 0; i < n; ++i)
+        if (std::abs( phi.Data[i]) < width_) {
+            global2tube_[i]= tube2global_.size();
+            tube2global_.push_back( i);
+        }
+        else
+            global2tube_[i]= NoIdx;
+
+    // Collect the band tetras and the inner dofs next to the edge layer.
+    VectorBaseCL<byte> near_edge( byte( 0), n);
+    LocalNumbP2CL numb;
+    tetras_.clear();
+    DROPS_FOR_TRIANG_CONST_TETRA( mg, phi.RowIdx->TriangLevel(), it) {
+        numb.assign( *it, *phi.RowIdx, bnd);
+        if (!IsBandTetra( numb.num))
+            continue;
+        tetras_.push_back( &*it);
+        bool touches_edge= false;
+        for (int i= 0; i < 10; ++i)
+            if (numb.WithUnknowns( i))
+                touches_edge= touches_edge || !IsInner( numb.num[i]);
+        if (touches_edge)
+            for (int i= 0; i < 10; ++i)
+                if (numb.WithUnknowns( i) && IsInner( numb.num[i]))
+                    near_edge[numb.num[i]]= 1;
+    }
+
+    near_edge_.clear();
+    for (size_t i= 0; i < n; ++i)
+        if (near_edge[i])
+            near_edge_.push_back( i);
+    built_= true;
+
+#ifndef _PAR
+    __UNUSED__ const size_t allnum_inner= NumInnerUnknowns();
+#else
+    __UNUSED__ const size_t allnum_inner= ProcCL::GlobalSum( NumInnerUnknowns());
+#endif
+    Comment("NarrowBandCL::Build: " << allnum_inner << " inner dofs in the band.\n", DebugDiscretizeC);
+}
+
+bool NarrowBandCL::NeedsRebuild (const VectorCL& phi) const
+{
+    bool rebuild= !built_ || phi.size() != global2tube_.size();
+    for (size_t i= 0; !rebuild && i < near_edge_.size(); ++i)
+        rebuild= std::abs( phi[near_edge_[i]]) < rebuild_fraction_*width_;
+#ifdef _PAR
+    rebuild= ProcCL::GlobalOr( rebuild);
+#endif
+    return rebuild;
+}
+
+void NarrowBandCL::Restrict (const MatrixCL& A, const VectorCL& x, const VectorCL& b, MatrixCL& Ab, VectorCL& bb) const
+{
+    const size_t nb= NumInnerUnknowns();
+    const size_t*  row= A.raw_row();
+    const size_t*  col= A.raw_col();
+    const double*  val= A.raw_val();
+
+    size_t nnz= 0;
+    for (size_t k= 0; k < nb; ++k)
+        for (size_t l= row[tube2global_[k]]; l < row[tube2global_[k] + 1]; ++l)
+            nnz+= IsInner( col[l]);
+    Ab.resize( nb, nb, nnz);
+    bb.resize( nb);
+
+    // the tube numbering is monotone, hence the columns of Ab stay sorted
+    size_t* rowb= Ab.raw_row();
+    size_t* colb= Ab.raw_col();
+    double* valb= Ab.raw_val();
+    rowb[0]= 0;
+    for (size_t k= 0, pos= 0; k < nb; ++k) {
+        const IdxT i= tube2global_[k];
+        double sum= b[i];
+        for (size_t l= row[i]; l < row[i + 1]; ++l)
+            if (IsInner( col[l])) {
+                colb[pos]= global2tube_[col[l]];
+                valb[pos++]= val[l];
+            }
+            else
+                sum-= val[l]*x[col[l]];
+        bb[k]= sum;
+        rowb[k + 1]= pos;
+    }
+}
+
+void NarrowBandCL::Restrict (const VectorCL& x, VectorCL& xb) const
+{
+    xb.resize( NumInnerUnknowns());
+    for (size_t k= 0; k < xb.size(); ++k)
+        xb[k]= x[tube2global_[k]];
+}
+
+void NarrowBandCL::Prolongate (const VectorCL& xb, VectorCL& x) const
+{
+    for (size_t k= 0; k < xb.size(); ++k)
+        x[tube2global_[k]]= xb[k];
+}
+
+//*****************************************************************************
+//                               LevelsetDiagnosticsST
+//*****************************************************************************
+
+void LevelsetDiagnosticsST::Clear ()
+{
+    maxGradPhi= -1.;
+    minGradPhi= 1e99;
+    volume= surfArea= 0.;
+    bary= vel= Point3DCL();
+    minCoord= Point3DCL( 1e99);
+    maxCoord= Point3DCL( -1e99);
+}
+
+void LevelsetDiagnosticsST::Combine (const LevelsetDiagnosticsST& d)
+{
+    maxGradPhi= std::max( maxGradPhi, d.maxGradPhi);
+    minGradPhi= std::min( minGradPhi, d.minGradPhi);
+    volume+= d.volume;
+    surfArea+= d.surfArea;
+    bary+= d.bary;
+    vel+= d.vel;
+    for (int j= 0; j < 3; ++j) {
+        minCoord[j]= std::min( minCoord[j], d.minCoord[j]);
+        maxCoord[j]= std::max( maxCoord[j], d.maxCoord[j]);
+    }
+}
+
+void LevelsetDiagnosticsST::Pack (double* buf) const
+{
+    buf[0]= maxGradPhi; buf[1]= minGradPhi; buf[2]= volume; buf[3]= surfArea;
+    for (int j= 0; j < 3; ++j) {
+        buf[4+j]=  bary[j];
+        buf[7+j]=  vel[j];
+        buf[10+j]= minCoord[j];
+        buf[13+j]= maxCoord[j];
+    }
+}
+
+void LevelsetDiagnosticsST::Unpack (const double* buf)
+{
+    maxGradPhi= buf[0]; minGradPhi= buf[1]; volume= buf[2]; surfArea= buf[3];
+    for (int j= 0; j < 3; ++j) {
+        bary[j]=     buf[4+j];
+        vel[j]=      buf[7+j];
+        minCoord[j]= buf[10+j];
+        maxCoord[j]= buf[13+j];
+    }
+}
+
 //*****************************************************************************
 //                               LevelsetP2CL
 //*****************************************************************************
@@ -571,7 +729,20 @@ void LevelsetP2CL::Reparam( int method, bool Periodic)
 */
 {
     std::auto_ptr<ReparamCL> reparam= ReparamFactoryCL::GetReparam( MG_, Phi, method, Periodic, &BndData_, perDirections);
+    if (UsesNarrowBand())
+        reparam->SetBandWidth( band_.GetWidth());
+    reparam->SetFrontierTree( &frontTree_);
     reparam->Perform();
+    if (UsesNarrowBand()) // phi is a distance in the band now; recenter the band on the interface
+        band_.Build( MG_, Phi, BndData_);
+}
+
+bool LevelsetP2CL::UpdateNarrowBand()
+{
+    if (!UsesNarrowBand() || !band_.NeedsRebuild( Phi.Data))
+        return false;
+    band_.Build( MG_, Phi, BndData_);
+    return true;
 }
 
 void LevelsetP2CL::AccumulateBndIntegral( VecDescCL& f) const
@@ -766,8 +937,16 @@ void LevelsetP2CL::GetMaxMinGradPhi(double& maxGradPhi, double& minGradPhi) cons
     double maxNorm;
     double minNorm;
 
+    const bool band= UsesNarrowBand() && band_.IsBuilt() && band_.NumInnerUnknowns() > 0 && Phi.Data.size() == idx.NumUnknowns();
+    LocalNumbP2CL numb;
+
     DROPS_FOR_TRIANG_TETRA( MG_, MG_.GetLastLevel(), it)
     {
+        if (band) { // the frozen values outside the band are irrelevant
+            numb.assign_indices_only( *it, idx);
+            if (!band_.IsBandTetra( numb.num))
+                continue;
+        }
         GetTrafoTr( T, det, *it);
         P2DiscCL::GetGradients( Grad, GradRef, T); // Gradienten auf aktuellem Tetraeder
         patch.Init( *it, Phi, BndData_);
@@ -830,6 +1009,8 @@ LevelsetRepairCL::post_refine ()
     ls_.idx.swap( loc_lidx);
     phi.SetIdx( &ls_.idx);
     phi.Data= loc_phi.Data;
+    ls_.InvalidateNarrowBand();
+    ls_.InvalidateFrontierTree();
 }
 
 } // end of namespace DROPS
@@ -35,6 +35,7 @@
 #include "levelset/surfacetension.h"
 #include "num/interfacePatch.h"
 #include "num/renumber.h"
+#include "levelset/fastmarch.h"
 #include <vector>
 
 #ifdef _PAR
@@ -63,6 +64,101 @@ class LevelsetCoeffCL {
 
 };
 
+/// \brief Narrow band around the interface for the transport and reparametrization of the level set function.
+///
+/// Build() marks the dofs with |phi| < width as inner dofs and numbers them consecutively: this is the tube
+/// numbering. The band tetras are the tetras with at least one inner dof. The dofs of band tetras, which are
+/// not inner, form the edge layer: Their values are frozen and act as boundary values for the inner dofs. All
+/// tetras containing an inner dof are band tetras, hence the equations of the inner dofs are complete.
+/// The assembly visits the band tetras only; Restrict() extracts the system of the inner dofs in the tube
+/// numbering, on which the level set solver works, Prolongate() writes its solution back.
+/// NeedsRebuild() detects an interface approaching the edge layer.
+class NarrowBandCL
+{
+  public:
+    typedef std::vector<const TetraCL*>::const_iterator const_tetra_iterator;
+
+  private:
+    double width_,            ///< inner dofs satisfy |phi| < width_
+           rebuild_fraction_; ///< rebuild, if |phi| < rebuild_fraction_*width_ on an inner dof next to the edge layer
+    bool   built_;
+
+    VectorBaseCL<IdxT> global2tube_;  ///< tube number of a dof, NoIdx for dofs, which are not inner
+    std::vector<IdxT>  tube2global_;  ///< the inner dofs in ascending order
+    std::vector<IdxT>  near_edge_;    ///< inner dofs sharing a tetra with the edge layer
+    std::vector<const TetraCL*> tetras_; ///< the band tetras
+
+  public:
+    NarrowBandCL (double width= 0., double rebuild_fraction= 0.5)
+        : width_( width), rebuild_fraction_( rebuild_fraction), built_( false) {}
+
+    /// \brief Compute the band for the level set function phi.
+    void Build (const MultiGridCL& mg, const VecDescCL& phi, const LsetBndDataCL& bnd);
+    /// \brief Forget the band, e.g. after the numbering of phi has changed.
+    void Invalidate () { built_= false; }
+    /// \brief True, if the band is not built for a numbering of size phi.size() or if the interface approaches the edge layer.
+    bool NeedsRebuild (const VectorCL& phi) const;
+
+    bool   IsBuilt   () const { return built_; }
+    double GetWidth  () const { return width_; }
+    void   SetWidth  (double width) { width_= width; built_= false; }
+
+    /// \brief True, iff dof is an inner dof; only the equations of these dofs are solved.
+    bool IsInner (IdxT dof) const { return global2tube_[dof] != NoIdx; }
+    /// \brief True, iff the tetra with the dofs num[0..9] is a band tetra.
+    bool IsBandTetra (const IdxT num[10]) const {
+        for (int i= 0; i < 10; ++i)
+            if (num[i] != NoIdx && IsInner( num[i])) return true;
+        return false;
+    }
+    /// \brief Size of the numbering of phi, for which the band was built.
+    size_t NumUnknowns () const { return global2tube_.size(); }
+    /// \brief Number of inner dofs on this proc, i.e., the size of the tube numbering.
+    size_t NumInnerUnknowns () const { return tube2global_.size(); }
+    /// \name Tube numbering
+    ///@{
+    IdxT ToTube   (IdxT dof) const { return global2tube_[dof]; }
+    IdxT ToGlobal (IdxT k)   const { return tube2global_[k]; }
+    ///@}
+    /// \brief The band tetras of the last Build().
+    const_tetra_iterator GetTetraBegin () const { return tetras_.begin(); }
+    const_tetra_iterator GetTetraEnd   () const { return tetras_.end(); }
+
+    /// \brief Restrict the system A x= b to the inner dofs: Ab is the block of the inner dofs in the tube
+    /// numbering, bb the rhs of the inner dofs, where the couplings to the frozen values of x are subtracted.
+    void Restrict (const MatrixCL& A, const VectorCL& x, const VectorCL& b, MatrixCL& Ab, VectorCL& bb) const;
+    /// \brief Values of the inner dofs of x in the tube numbering.
+    void Restrict (const VectorCL& x, VectorCL& xb) const;
+    /// \brief Write the values xb of the inner dofs into x; the frozen values of x are not changed.
+    void Prolongate (const VectorCL& xb, VectorCL& x) const;
+};
+
+/// \brief Diagnostic quantities of the level set function and the approximate interface, see LevelsetP2CL::GetDiagnostics.
+struct LevelsetDiagnosticsST
+{
+    enum { NumValuesC= 16 };  ///< number of doubles exchanged by Pack/Unpack
+
+    double    maxGradPhi,     ///< maximal 2-norm of the gradient of phi
+              minGradPhi,     ///< minimal 2-norm of the gradient of phi on tetras intersected by the interface
+              volume,         ///< volume inside the approximate interface
+              surfArea;       ///< area of the approximate interface
+    Point3DCL bary,           ///< barycenter of the droplet
+              vel,            ///< velocity of the barycenter of the droplet
+              minCoord,       ///< minimal x, y and z coordinates of the approximate interface
+              maxCoord;       ///< maximal x, y and z coordinates of the approximate interface
+
+    LevelsetDiagnosticsST() { Clear(); }
+    /// \brief Neutral element of Combine().
+    void Clear ();
+    /// \brief Add the partial sums and extrema of d; bary and vel are not normalized.
+    void Combine (const LevelsetDiagnosticsST& d);
+    /// \brief Copy all values to buf[0..NumValuesC-1] and back.
+    ///@{
+    void Pack   (double* buf) const;
+    void Unpack (const double* buf);
+    ///@}
+};
+
 class LevelsetP2CL : public ProblemCL< LevelsetCoeffCL, LsetBndDataCL>
 /// P2-discretization and solution of the level set equation for two phase flow problems. Bnd_ will be used to impose boundary data on the inflow boundary.
 /// At the moment setting all boundary conditions to NoBC is the only valid case.
@@ -87,6 +183,8 @@ class LevelsetP2CL : public ProblemCL< LevelsetCoeffCL, LsetBndDataCL>
     SurfaceForceT       SF_;
 
     SurfaceTensionCL&   sf_;      ///< data for surface tension
+    NarrowBandCL        band_;    ///< narrow band, active iff band_.GetWidth() > 0
+    FrontierTreeCL      frontTree_; ///< kd-tree of the frontier set, kept between reparametrizations by direct distances
     void SetupSmoothSystem ( MatrixCL&, MatrixCL&)               const;
     void SmoothPhi( VectorCL& SmPhi, double diff)                const;
     double GetVolume_Composite( double translation, int l)    const;
@@ -115,16 +213,43 @@ class LevelsetP2CL : public ProblemCL< LevelsetCoeffCL, LsetBndDataCL>
     void Init( scalar_fun_ptr);
 
     /// \remarks call SetupSystem \em before calling SetTimeStep!
+    /// In narrow band mode, only the band tetras are visited and only the rows of the inner dofs are assembled; the rows of the other dofs are set to (E: identity, H: zero), which freezes these dofs. The matrices keep the size of phi for the products of the time discretizations, the systems are solved by SolveSystem().
     template<class DiscVelSolT>
     void SetupSystem( const DiscVelSolT&, const double);
-    /// Reparametrization of the level set function.
+    /// \brief Solve L phi= rhs with the level set solver; in narrow band mode, only the system of the inner dofs is solved in the tube numbering.
+    /// The start vector is phi. In parallel runs, the full system is solved, as the tube numbering has no exchange.
+    template<class SolverT>
+    void SolveSystem( SolverT& solver, const MatrixCL& L, VectorCL& phi, const VectorCL& rhs) const;
+    /// Reparametrization of the level set function. In narrow band mode, the distance is computed within the band only and clipped to +-width outside.
     void Reparam( int method=03, bool Periodic= false);
 
+    /// \name Narrow band mode
+    ///@{
+    /// \brief Restrict transport and reparametrization to dofs with |phi| < width; width <= 0 switches the narrow band mode off.
+    /// The band is rebuilt automatically, when |phi| < rebuild_fraction*width next to the edge layer.
+    void SetNarrowBand( double width, double rebuild_fraction= 0.5)
+        { band_= NarrowBandCL( width, rebuild_fraction); }
+    bool UsesNarrowBand() const { return band_.GetWidth() > 0.; }
+    const NarrowBandCL& GetNarrowBand() const { return band_; }
+    /// \brief Rebuild the band, if necessary. Returns true, if the band has been rebuilt.
+    bool UpdateNarrowBand();
+    /// \brief Force a rebuild of the band at the next UpdateNarrowBand(); called after a change of the numbering.
+    void InvalidateNarrowBand() { band_.Invalidate(); }
+    /// \brief Rebuild the kd-tree of the frontier set at the next reparametrization; called after a change of the numbering.
+    void InvalidateFrontierTree() { frontTree_.Clear(); }
+    ///@}
+
     /// \brief Perform downwind numbering
     template <class DiscVelSolT>
     PermutationT downwind_numbering (const DiscVelSolT& vel, IteratedDownwindCL dw);
+    /// \brief Perform downwind numbering; dw reuses its last numbering, if it is still downwind
+    template <class DiscVelSolT>
+    PermutationT downwind_numbering (const DiscVelSolT& vel, CachedDownwindCL& dw);
 
-    /// returns information about level set function and interface.
+    /// returns information about level set function and interface computed in one parallel sweep over the tetras.
+    template<class DiscVelSolT>
+    LevelsetDiagnosticsST GetDiagnostics( const DiscVelSolT& vel_sol) const;
+    /// returns information about level set function and interface (see GetDiagnostics).
     template<class DiscVelSolT>
     void   GetInfo( double& maxGradPhi, double& Volume, Point3DCL& bary, Point3DCL& vel, const DiscVelSolT& vel_sol, Point3DCL& minCoord, Point3DCL& maxCoord, double& surfArea) const;
     /// returns the maximum and minimum of the gradient of phi
@@ -256,6 +381,10 @@ public:
     void init() {
         step_++;
     }
+    /// undo init() for a rejected time step
+    void rollback() {
+        step_--;
+    }
 };
 
 
@@ -29,99 +29,137 @@ namespace DROPS
 {
 
 template<class DiscVelSolT>
-void LevelsetP2CL::GetInfo( double& maxGradPhi, double& Volume, Point3DCL& bary, Point3DCL& vel, const DiscVelSolT& velsol, Point3DCL& minCoord, Point3DCL& maxCoord, double& surfArea) const
+LevelsetDiagnosticsST LevelsetP2CL::GetDiagnostics( const DiscVelSolT& velsol) const
 /**
- * - \p maxGradPhi is the maximal 2-norm of the gradient of the level set function. This can be used as an indicator to decide
- *   whether a reparametrization should be applied.
- * - \p Volume is the volume inside the approximate interface consisting of planar segments.
- * - \p bary is the barycenter of the droplet.
- * - \p vel is the velocity of the barycenter of the droplet.
- * - The entries of \p minCoord store the minimal x, y and z coordinates of the approximative interface, respectively.
- * - The entries of \p maxCoord store the maximal x, y and z coordinates of the approximative interface, respectively.
- * - \p surfArea is the surface area of the approximative interface
+ * Computes all quantities of LevelsetDiagnosticsST in a single sweep over the tetras. The tetras are split
+ * into blocks of fixed size, which are processed in parallel; the partial results of the blocks are
+ * combined in the order of the blocks. Hence, the result does not depend on the number of threads.
+ * In parallel runs, the partial results of all processes are gathered by a single collective operation
+ * and combined in the order of the ranks.
+ * If a narrow band is used, the gradient of phi is only evaluated on band tetras.
  */
 {
-    Quad2CL<Point3DCL> Grad[10], GradRef[10];
-    SMatrixCL<3,3> T;
-    double det, absdet;
-    InterfaceTetraCL tetra;
-    InterfaceTriangleCL triangle;
+    enum { BlockSizeC= 256 };
 
+    Quad2CL<Point3DCL> GradRef[10];
     P2DiscCL::GetGradientsOnRef( GradRef);
-    maxGradPhi= -1.;
-    Volume= 0.;
-    surfArea= 0.;
-    bary[0]= bary[1]= bary[2]= 0;
-    vel[0]= vel[1]= vel[2]= 0;
-    minCoord[0]= minCoord[1]= minCoord[2]= 1e99;
-    maxCoord[0]= maxCoord[1]= maxCoord[2]= -1e99;
-    LocalP2CL<double> ones( 1.);
-    LocalP2CL<Point3DCL> Coord, Vel;
+    const bool band= UsesNarrowBand() && band_.IsBuilt() && band_.NumInnerUnknowns() > 0 && Phi.Data.size() == idx.NumUnknowns();
 
+    std::vector<const TetraCL*> tetras;
     for (MultiGridCL::const_TriangTetraIteratorCL it=const_cast<const MultiGridCL&>(MG_).GetTriangTetraBegin(), end=const_cast<const MultiGridCL&>(MG_).GetTriangTetraEnd();
         it!=end; ++it)
-    {
-        GetTrafoTr( T, det, *it);
-        absdet= std::abs( det);
-        P2DiscCL::GetGradients( Grad, GradRef, T); // Gradienten auf aktuellem Tetraeder
+        tetras.push_back( &*it);
+    const int num_blocks= (tetras.size() + BlockSizeC - 1)/BlockSizeC;
+    std::vector<LevelsetDiagnosticsST> blocks( num_blocks);
 
-        tetra.Init( *it, Phi, BndData_);
-        triangle.Init( *it, Phi, BndData_);
+#pragma omp parallel
+{
+    Quad2CL<Point3DCL> Grad[10];
+    SMatrixCL<3,3> T;
+    double det, absdet;
+    InterfaceTetraCL tetra;
+    InterfaceTriangleCL triangle;
+    LocalP2CL<double> ones( 1.);
+    LocalP2CL<Point3DCL> Coord, Vel;
+    LocalNumbP2CL numb;
+
+#pragma omp for schedule(dynamic)
+    for (int b= 0; b < num_blocks; ++b) {
+        LevelsetDiagnosticsST& d= blocks[b];
+        const size_t last= std::min( tetras.size(), size_t( b + 1)*BlockSizeC);
+        for (size_t t= size_t( b)*BlockSizeC; t < last; ++t) {
+            const TetraCL& tet= *tetras[t];
+            GetTrafoTr( T, det, tet);
+            absdet= std::abs( det);
+
+            tetra.Init( tet, Phi, BndData_);
+            triangle.Init( tet, Phi, BndData_);
+
+            // compute maximal and minimal norm of grad Phi
+            if (!band || (numb.assign_indices_only( tet, idx), band_.IsBandTetra( numb.num))) {
+                P2DiscCL::GetGradients( Grad, GradRef, T);
+                Quad2CL<Point3DCL> gradPhi;
+                for (int v=0; v<10; ++v)
+                    gradPhi+= tetra.GetPhi(v)*Grad[v];
+                for (int v=0; v<5; ++v) {
+                    const double normGrad= norm( gradPhi[v]);
+                    d.maxGradPhi= std::max( d.maxGradPhi, normGrad);
+                    if (triangle.Intersects())
+                        d.minGradPhi= std::min( d.minGradPhi, normGrad);
+                }
+            }
 
-        // compute maximal norm of grad Phi
-        Quad2CL<Point3DCL> gradPhi;
-        for (int v=0; v<10; ++v) // init gradPhi, Coord
-        {
-            gradPhi+= tetra.GetPhi(v)*Grad[v];
-            Coord[v]= v<4 ? it->GetVertex(v)->GetCoord() : GetBaryCenter( *it->GetEdge(v-4));
-        }
-        Vel.assign( *it, velsol);
-        VectorCL normGrad( 5);
-        for (int v=0; v<5; ++v) // init normGrad
-            normGrad[v]= norm( gradPhi[v]);
-        const double maxNorm= normGrad.max();
-        if (maxNorm > maxGradPhi) maxGradPhi= maxNorm;
-
-        for (int ch=0; ch<8; ++ch)
-        {
-            // compute volume, barycenter and velocity
-            tetra.ComputeCutForChild(ch);
-            Volume+= tetra.quad( ones, absdet, false);
-            bary+= tetra.quad( Coord, absdet, false);
-            vel+= tetra.quad( Vel, absdet, false);
-
-            // find minimal/maximal coordinates of interface
-            if (!triangle.ComputeForChild(ch)) // no patch for this child
-                continue;
-            for (int tri=0; tri<triangle.GetNumTriangles(); ++tri)
-                surfArea+= triangle.GetAbsDet(tri);
-            for (Uint i=0; i<triangle.GetNumPoints(); ++i)
-            {
-                const Point3DCL p= triangle.GetPoint(i);
-                for (int j=0; j<3; ++j)
-                {
-                    if (p[j] < minCoord[j]) minCoord[j]= p[j];
-                    if (p[j] > maxCoord[j]) maxCoord[j]= p[j];
+            for (int v=0; v<10; ++v)
+                Coord[v]= v<4 ? tet.GetVertex(v)->GetCoord() : GetBaryCenter( *tet.GetEdge(v-4));
+            Vel.assign( tet, velsol);
+            for (int ch=0; ch<8; ++ch) {
+                // compute volume, barycenter and velocity
+                tetra.ComputeCutForChild(ch);
+                d.volume+= tetra.quad( ones, absdet, false);
+                d.bary+= tetra.quad( Coord, absdet, false);
+                d.vel+= tetra.quad( Vel, absdet, false);
+
+                // find minimal/maximal coordinates of interface
+                if (!triangle.ComputeForChild(ch)) // no patch for this child
+                    continue;
+                for (int tri=0; tri<triangle.GetNumTriangles(); ++tri)
+                    d.surfArea+= triangle.GetAbsDet(tri);
+                for (Uint i=0; i<triangle.GetNumPoints(); ++i) {
+                    const Point3DCL p= triangle.GetPoint(i);
+                    for (int j=0; j<3; ++j) {
+                        d.minCoord[j]= std::min( d.minCoord[j], p[j]);
+                        d.maxCoord[j]= std::max( d.maxCoord[j], p[j]);
+                    }
                 }
             }
         }
     }
+}
+    LevelsetDiagnosticsST info;
+    for (int b= 0; b < num_blocks; ++b)
+        info.Combine( blocks[b]);
+
 #ifdef _PAR
-    // Globalization of  data
-    // -----
-    const Point3DCL local_bary(bary), local_vel(vel), local_minCoord(minCoord), local_maxCoord(maxCoord);
-    maxGradPhi= ProcCL::GlobalMax(maxGradPhi);
-    Volume    = ProcCL::GlobalSum(Volume);
-    surfArea  = ProcCL::GlobalSum(surfArea);
-    ProcCL::GlobalSum(Addr(local_bary), Addr(bary), 3);
-    ProcCL::GlobalSum(Addr(local_vel), Addr(vel), 3);
-    ProcCL::GlobalMin(Addr(local_minCoord), Addr(minCoord), 3);
-    ProcCL::GlobalMax(Addr(local_maxCoord), Addr(maxCoord), 3);
+    // Globalization of data by one collective operation
+    double local[LevelsetDiagnosticsST::NumValuesC];
+    info.Pack( local);
+    std::vector<double> all( ProcCL::Size()*LevelsetDiagnosticsST::NumValuesC);
+    ProcCL::Gather( local, Addr( all), LevelsetDiagnosticsST::NumValuesC, -1);
+    info.Clear();
+    LevelsetDiagnosticsST proc;
+    for (int p= 0; p < ProcCL::Size(); ++p) {
+        proc.Unpack( &all[p*LevelsetDiagnosticsST::NumValuesC]);
+        info.Combine( proc);
+    }
 #endif
 
-    bary/= Volume;
-    vel/= Volume;
-    surfArea*= 0.5;
+    info.bary/= info.volume;
+    info.vel/= info.volume;
+    info.surfArea*= 0.5;
+    return info;
+}
+
+template<class DiscVelSolT>
+void LevelsetP2CL::GetInfo( double& maxGradPhi, double& Volume, Point3DCL& bary, Point3DCL& vel, const DiscVelSolT& velsol, Point3DCL& minCoord, Point3DCL& maxCoord, double& surfArea) const
+/**
+ * - \p maxGradPhi is the maximal 2-norm of the gradient of the level set function. This can be used as an indicator to decide
+ *   whether a reparametrization should be applied.
+ * - \p Volume is the volume inside the approximate interface consisting of planar segments.
+ * - \p bary is the barycenter of the droplet.
+ * - \p vel is the velocity of the barycenter of the droplet.
+ * - The entries of \p minCoord store the minimal x, y and z coordinates of the approximative interface, respectively.
+ * - The entries of \p maxCoord store the maximal x, y and z coordinates of the approximative interface, respectively.
+ * - \p surfArea is the surface area of the approximative interface
+ */
+{
+    const LevelsetDiagnosticsST info= GetDiagnostics( velsol);
+    maxGradPhi= info.maxGradPhi;
+    Volume=     info.volume;
+    bary=       info.bary;
+    vel=        info.vel;
+    minCoord=   info.minCoord;
+    maxCoord=   info.maxCoord;
+    surfArea=   info.surfArea;
 }
 
 /// \brief Accumulator to set up the matrices E and H for the level set equation.
@@ -131,6 +169,7 @@ class LevelsetAccumulator_P2CL : public TetraAccumulatorCL
     LevelsetP2CL& ls_;
     const DiscVelSolT& vel_;
     const double SD_;
+    const NarrowBandCL* band_; ///< if not 0, only band tetras and rows of inner dofs are assembled
     SparseMatBuilderCL<double> *bE_, *bH_;
 
     Quad5CL<Point3DCL> Grad[10], GradRef[10], u_loc;
@@ -139,8 +178,9 @@ class LevelsetAccumulator_P2CL : public TetraAccumulatorCL
     LocalNumbP2CL n;
 
   public:
-    LevelsetAccumulator_P2CL( LevelsetP2CL& ls, const DiscVelSolT& vel, double SD, __UNUSED__ double dt)
-      : ls_(ls), vel_(vel), SD_(SD)
+    /// \remarks With a band, visit() expects band tetras, see LevelsetP2CL::SetupSystem.
+    LevelsetAccumulator_P2CL( LevelsetP2CL& ls, const DiscVelSolT& vel, double SD, __UNUSED__ double dt, const NarrowBandCL* band= 0)
+      : ls_(ls), vel_(vel), SD_(SD), band_( band)
     { P2DiscCL::GetGradientsOnRef( GradRef); }
 
     ///\brief Initializes matrix-builders and load-vectors
@@ -171,6 +211,10 @@ void LevelsetAccumulator_P2CL<DiscVelSolT>::begin_accumulation ()
 template<class DiscVelSolT>
 void LevelsetAccumulator_P2CL<DiscVelSolT>::finalize_accumulation ()
 {
+    if (band_ != 0) // freeze the dofs outside the band: E_ii= 1, H_ii= 0
+        for (size_t i= 0, num_unks= ls_.Phi.RowIdx->NumUnknowns(); i < num_unks; ++i)
+            if (!band_->IsInner( i))
+                (*bE_)( i, i)= 1.;
     bE_->Build();
     delete bE_;
     bH_->Build();
@@ -189,15 +233,15 @@ void LevelsetAccumulator_P2CL<DiscVelSolT>::visit (const TetraCL& t)
    \todo: implementation of other boundary conditions
 */
 {
+    // save information about the edges and verts of the tetra in Numb
+    n.assign( t, *ls_.Phi.RowIdx, ls_.GetBndData());
+
     double det;
     GetTrafoTr( T, det, t);
     P2DiscCL::GetGradients( Grad, GradRef, T);
     const double absdet= std::fabs( det),
             h_T= std::pow( absdet, 1./3.);
 
-    // save information about the edges and verts of the tetra in Numb
-    n.assign( t, *ls_.Phi.RowIdx, ls_.GetBndData());
-
     // save velocities inside tetra for quadrature in u_loc
     u_loc.assign( t, vel_);
 
@@ -213,7 +257,9 @@ void LevelsetAccumulator_P2CL<DiscVelSolT>::visit (const TetraCL& t)
     //double maxV= 1; // no scaling
 
     SparseMatBuilderCL<double> &bE= *bE_, &bH= *bH_;
-    for(int i=0; i<10; ++i)    // assemble row Numb[i]
+    for(int i=0; i<10; ++i) {  // assemble row Numb[i]
+        if (band_ != 0 && !band_->IsInner( n.num[i]))
+            continue;
         for(int j=0; j<10; ++j)
         {
             // E is of mass matrix type:    E_ij = ( v_j       , v_i + SD * u grad v_i )
@@ -224,20 +270,53 @@ void LevelsetAccumulator_P2CL<DiscVelSolT>::visit (const TetraCL& t)
             bH( n.num[i], n.num[j])+= u_Grad[j].quadP2(i, absdet)
                                  + Quad5CL<>(u_Grad[i]*u_Grad[j]).quad( absdet) * SD_/maxV*h_T;
         }
+    }
 }
 
 template<class DiscVelSolT>
 void LevelsetP2CL::SetupSystem( const DiscVelSolT& vel, __UNUSED__ const double dt)
 /// Setup level set matrices E, H
 {
-    LevelsetAccumulator_P2CL<DiscVelSolT> accu( *this, vel, SD_, dt);
+    UpdateNarrowBand();
+    LevelsetAccumulator_P2CL<DiscVelSolT> accu( *this, vel, SD_, dt, UsesNarrowBand() ? &band_ : 0);
+    if (UsesNarrowBand()) { // visit the band tetras only
+        accu.begin_accumulation();
+        for (NarrowBandCL::const_tetra_iterator it= band_.GetTetraBegin(), end= band_.GetTetraEnd(); it != end; ++it)
+            accu.visit( **it);
+        accu.finalize_accumulation();
+        return;
+    }
     TetraAccumulatorTupleCL accus;
     accus.push_back( &accu);
     accumulate( accus, MG_, Phi.RowIdx->TriangLevel(), Phi.RowIdx->GetMatchingFunction(), Phi.RowIdx->GetBndInfo());
 }
 
+template<class SolverT>
+void LevelsetP2CL::SolveSystem( SolverT& solver, const MatrixCL& L, VectorCL& phi, const VectorCL& rhs) const
+{
+#ifndef _PAR
+    if (UsesNarrowBand() && band_.IsBuilt() && band_.NumInnerUnknowns() > 0 && band_.NumUnknowns() == phi.size()) {
+        MatrixCL Lb;
+        VectorCL rhsb, phib;
+        band_.Restrict( L, phi, rhs, Lb, rhsb);
+        band_.Restrict( phi, phib);
+        solver.Solve( Lb, phib, rhsb);
+        band_.Prolongate( phib, phi);
+        return;
+    }
+#endif
+    solver.Solve( L, phi, rhs);
+}
+
 template <class DiscVelSolT>
 PermutationT LevelsetP2CL::downwind_numbering (const DiscVelSolT& vel, IteratedDownwindCL dw)
+{
+    CachedDownwindCL cdw( dw);
+    return downwind_numbering( vel, cdw);
+}
+
+template <class DiscVelSolT>
+PermutationT LevelsetP2CL::downwind_numbering (const DiscVelSolT& vel, CachedDownwindCL& dw)
 {
     std::cout << "LevelsetP2CL::downwind_numbering:\n";
     std::cout << "...accumulating convection matrix...\n";
@@ -41,6 +41,7 @@
 #include "surfactant/ifacetransp.h"
 //function map
 #include "misc/bndmap.h"
+#include "misc/profiler.h"
 //solver factory for stokes
 #include "num/stokessolverfactory.h"
 #ifndef _PAR
@@ -105,6 +106,8 @@ void Strategy( InstatNavierStokes2PhaseP2P1CL& Stokes, LsetBndDataCL& lsetbnddat
     SurfaceTensionCL sf( sigmap);
 
     LevelsetP2CL lset( MG, lsetbnddata, sf, P.get<double>("Levelset.SD"), P.get<double>("Levelset.CurvDiff"));
+    if (P.get<double>("Levelset.NarrowBand.Width") > 0.)
+        lset.SetNarrowBand( P.get<double>("Levelset.NarrowBand.Width"), P.get<double>("Levelset.NarrowBand.RebuildFraction"));
 
     if (is_periodic) //CL: Anyone a better idea? perDirection from ParameterFile?
     {
@@ -180,13 +183,13 @@ void Strategy( InstatNavierStokes2PhaseP2P1CL& Stokes, LsetBndDataCL& lsetbnddat
     Stokes.InitVel( &Stokes.v, ZeroVel);
     SetInitialConditions( Stokes, lset, MG, P);
 
-    IteratedDownwindCL navstokes_downwind( P.get_child( "NavStokes.Downwind"));
+    CachedDownwindCL navstokes_downwind( P.get_child( "NavStokes.Downwind"));
     if (P.get<int>( "NavStokes.Downwind.Frequency") > 0) {
         if (StokesSolverFactoryHelperCL().VelMGUsed( P))
             throw DROPSErrCL( "Strategy: Multigrid-solver and downwind-numbering cannot be used together. Sorry.\n");
         vel_downwind= Stokes.downwind_numbering( lset, navstokes_downwind);
     }
-    IteratedDownwindCL levelset_downwind( P.get_child( "Levelset.Downwind"));
+    CachedDownwindCL levelset_downwind( P.get_child( "Levelset.Downwind"));
     if (P.get<int>( "Levelset.Downwind.Frequency") > 0)
         lset_downwind= lset.downwind_numbering( Stokes.GetVelSolution(), levelset_downwind);
 
@@ -237,6 +240,9 @@ void Strategy( InstatNavierStokes2PhaseP2P1CL& Stokes, LsetBndDataCL& lsetbnddat
             ReadFEFromFile( massTransp->ct, MG, P.get<std::string>("DomainCond.InitialFile")+"concentrationTransf");
 
         massTransp->Update();
+        massTransp->GetInitialGuess().SetMethod( static_cast<InitialGuessCL::MethodT>( P.get<int>("Time.InitialGuess.Method", 0)));
+        massTransp->GetInitialGuess().SetSize( P.get<int>("Time.InitialGuess.Size", 3));
+        massTransp->GetInitialGuess().SetOrder( P.get<int>("Time.InitialGuess.Order", 1));
         std::cout << massTransp->c.Data.size() << " concentration unknowns,\n";
     }
 
@@ -265,8 +271,12 @@ void Strategy( InstatNavierStokes2PhaseP2P1CL& Stokes, LsetBndDataCL& lsetbnddat
     NSSolverBaseCL<InstatNavierStokes2PhaseP2P1CL>* navstokessolver = 0;
     if (P.get<double>("NavStokes.Nonlinear")==0.0)
         navstokessolver = new NSSolverBaseCL<InstatNavierStokes2PhaseP2P1CL>(Stokes, *stokessolver);
-    else
-        navstokessolver = new AdaptFixedPtDefectCorrCL<InstatNavierStokes2PhaseP2P1CL>(Stokes, *stokessolver, P.get<int>("NavStokes.Iter"), P.get<double>("NavStokes.Tol"), P.get<double>("NavStokes.Reduction"));
+    else {
+        AdaptFixedPtDefectCorrCL<InstatNavierStokes2PhaseP2P1CL>* nssolver= new AdaptFixedPtDefectCorrCL<InstatNavierStokes2PhaseP2P1CL>(Stokes, *stokessolver, P.get<int>("NavStokes.Iter"), P.get<double>("NavStokes.Tol"), P.get<double>("NavStokes.Reduction"));
+        nssolver->SetLinearization( NSLinearizationT( P.get<int>("NavStokes.Newton", 0)), P.get<double>("NavStokes.NewtonSwitch", 0.1));
+        nssolver->SetEisenstatWalker( P.get<int>("NavStokes.EisenstatWalker", 0) != 0);
+        navstokessolver= nssolver;
+    }
 
     // Level-Set-Solver
 #ifndef _PAR
@@ -300,6 +310,28 @@ void Strategy( InstatNavierStokes2PhaseP2P1CL& Stokes, LsetBndDataCL& lsetbnddat
                                          &Stokes.M.Data, &Stokes.prM.Data, &Stokes.pr_idx);
     }
 
+    // adaptive time step size
+    TimeStepControlCL tsctrl( P.get<double>("Time.Adaptivity.Tol", 0.),
+        P.get<double>("Time.Adaptivity.MinStep", 0.01*P.get<double>("Time.StepSize")),
+        P.get<double>("Time.Adaptivity.MaxStep", 10.*P.get<double>("Time.StepSize")),
+        P.get<int>("Time.Adaptivity.TargetIter", 5));
+    const bool adaptivedt= timedisc && P.get<double>("Time.Adaptivity.Tol", 0.) > 0.;
+    // with adaptive step sizes, the number of steps is not known in advance: integrate up to the final time
+    const double tend= P.get<double>("Time.FinalTime", Stokes.v.t + P.get<int>("Time.NumSteps")*P.get<double>("Time.StepSize"));
+    tsctrl.SetFinalTime( tend);
+    if (adaptivedt)
+        timedisc->SetTimeStepControl( &tsctrl);
+
+    // drop the solution histories for the initial guesses, if the grid is modified
+    InitialGuessRepairCL guessrepair;
+    if (timedisc) {
+        guessrepair.push_back( &timedisc->GetStokesGuess());
+        guessrepair.push_back( &timedisc->GetLsetGuess());
+    }
+    if (massTransp)
+        guessrepair.push_back( &massTransp->GetInitialGuess());
+    adap.push_back( &guessrepair);
+
     UpdateProlongationCL PVel( Stokes.GetMG(), stokessolverfactory.GetPVel(), &Stokes.vel_idx, &Stokes.vel_idx);
     adap.push_back( &PVel);
     UpdateProlongationCL PPr ( Stokes.GetMG(), stokessolverfactory.GetPPr(), &Stokes.pr_idx, &Stokes.pr_idx);
@@ -365,6 +397,8 @@ void Strategy( InstatNavierStokes2PhaseP2P1CL& Stokes, LsetBndDataCL& lsetbnddat
                                  P.get<int>("Time.NumSteps")/P.get("VTK.VTKOut", 0)+1,
                                  P.get<std::string>("VTK.VTKDir"), P.get<std::string>("VTK.VTKName"),
                                  P.get<int>("VTK.Binary"));
+        if (P.get<int>("VTK.Collective",0))
+            vtkwriter->SetCollectiveOut();
         vtkwriter->Register( make_VTKVector( Stokes.GetVelSolution(), "velocity") );
         vtkwriter->Register( make_VTKScalar( Stokes.GetPrSolution(), "pressure") );
         if (P.get<int>("VTK.AddP1XPressure",0))
@@ -385,17 +419,23 @@ void Strategy( InstatNavierStokes2PhaseP2P1CL& Stokes, LsetBndDataCL& lsetbnddat
     //     ser.Write();
 
     const int nsteps = P.get<int>("Time.NumSteps");
-    const double dt = P.get<double>("Time.StepSize");
-    for (int step= 1; step<=nsteps; ++step)
+    for (int step= 1; adaptivedt ? Stokes.v.t < tend - 1e-10*P.get<double>("Time.StepSize") : step<=nsteps; ++step)
     {
         std::cout << "============================================================ step " << step << std::endl;
         const double time_old = Stokes.v.t;
-        const double time_new = Stokes.v.t + dt;
         IFInfo.Update( lset, Stokes.GetVelSolution());
         IFInfo.Write(time_old);
 
         if (P.get("SurfTransp.DoTransp", 0)) surfTransp.InitOld();
-        timedisc->DoStep( P.get<int>("Coupling.Iter"));
+        {
+            DROPS_PROFILE_REGION("TimeDisc2PhaseCL::DoStep");
+            timedisc->DoStep( P.get<int>("Coupling.Iter"));
+        }
+        const double time_new = Stokes.v.t;
+        if (adaptivedt) { // the step size has been chosen by timedisc
+            if (massTransp) massTransp->SetTimeStep( time_new - time_old);
+            surfTransp.SetTimeStep( time_new - time_old);
+        }
         if (massTransp) massTransp->DoStep( time_new);
         if (P.get("SurfTransp.DoTransp", 0)) {
             surfTransp.DoStep( time_new);
@@ -409,9 +449,14 @@ void Strategy( InstatNavierStokes2PhaseP2P1CL& Stokes, LsetBndDataCL& lsetbnddat
         const bool doGridMod= P.get<int>("AdaptRef.Freq") && step%P.get<int>("AdaptRef.Freq") == 0;
         bool gridChanged= false;
         if (doGridMod) {
+            DROPS_PROFILE_REGION("AdapTriangCL::UpdateTriang");
             adap.UpdateTriang( lset);
             gridChanged= adap.WasModified();
         }
+        if (gridChanged) { // the stored downwind numberings refer to the old numbering
+            navstokes_downwind.Invalidate();
+            levelset_downwind.Invalidate();
+        }
         // downwind-numbering for Navier-Stokes
         const bool doNSDownwindNumbering= P.get<int>("NavStokes.Downwind.Frequency")
             && step%P.get<int>("NavStokes.Downwind.Frequency") == 0;
@@ -446,7 +491,17 @@ void Strategy( InstatNavierStokes2PhaseP2P1CL& Stokes, LsetBndDataCL& lsetbnddat
             vtkwriter->Write( time_new);
         if (P.get("Restart.Serialization", 0) && step%P.get("Restart.Serialization", 0)==0)
             ser.Write();
+        if (P.get<int>("Profiler.ReportFreq") && step%P.get<int>("Profiler.ReportFreq")==0) {
+            std::ostringstream title;
+            title << "of steps " << step-P.get<int>("Profiler.ReportFreq")+1 << "-" << step;
+            DROPS::ProfilerCL::Instance().Report( std::cout, title.str());
+            DROPS::ProfilerCL::Instance().Reset();
+        }
     }
+    if (P.get<int>("Profiler.Enable") && !P.get<int>("Profiler.ReportFreq"))
+        DROPS::ProfilerCL::Instance().Report( std::cout, "of the run");
+    if (P.get<int>("Profiler.Trace"))
+        DROPS::ProfilerCL::Instance().WriteTrace( P.get<std::string>("Profiler.TraceFile"));
     IFInfo.Update( lset, Stokes.GetVelSolution());
     IFInfo.Write(Stokes.v.t);
     std::cout << std::endl;
@@ -474,10 +529,20 @@ void SetMissingParameters(DROPS::ParamCL& P){
     P.put_if_unset<double>("NavStokes.Downwind.MaxRelComponentSize", 0.05);
     P.put_if_unset<double>("NavStokes.Downwind.WeakEdgeRatio", 0.2);
     P.put_if_unset<double>("NavStokes.Downwind.CrosswindLimit", std::cos( M_PI/6.));
+    P.put_if_unset<double>("NavStokes.Downwind.MaxChangedRatio", 0.05);
     P.put_if_unset<int>("Levelset.Downwind.Frequency", 0);
     P.put_if_unset<double>("Levelset.Downwind.MaxRelComponentSize", 0.05);
     P.put_if_unset<double>("Levelset.Downwind.WeakEdgeRatio", 0.2);
     P.put_if_unset<double>("Levelset.Downwind.CrosswindLimit", std::cos( M_PI/6.));
+    P.put_if_unset<double>("Levelset.Downwind.MaxChangedRatio", 0.05);
+    P.put_if_unset<double>("Levelset.NarrowBand.Width", 0.);
+    P.put_if_unset<double>("Levelset.NarrowBand.RebuildFraction", 0.5);
+    P.put_if_unset<double>("AdaptRef.ImbalanceTol", 0.);
+    P.put_if_unset<int>("AdaptRef.BulkUnknowns", 0);
+    P.put_if_unset<int>("Profiler.Enable", 0);
+    P.put_if_unset<int>("Profiler.ReportFreq", 0);
+    P.put_if_unset<int>("Profiler.Trace", 0);
+    P.put_if_unset<std::string>("Profiler.TraceFile", "trace.json");
 }
 
 int main (int argc, char** argv)
@@ -513,6 +578,9 @@ int main (int argc, char** argv)
 
     std::cout << P << std::endl;
 
+    if (P.get<int>("Profiler.Enable"))
+        DROPS::ProfilerCL::Instance().Enable( P.get<int>("Profiler.Trace"));
+
     DROPS::MatchMap & matchmap = DROPS::MatchMap::getInstance();
     bool is_periodic = P.get<std::string>("DomainCond.PeriodicMatching", "none") != "none";
     DROPS::match_fun periodic_match = is_periodic ? matchmap[P.get<std::string>("DomainCond.PeriodicMatching", "periodicx")] : 0;
@@ -566,11 +634,17 @@ int main (int argc, char** argv)
     std::cout << DROPS::SanityMGOutCL(*mg) << std::endl;
 #ifdef _PAR
     adap.GetLb().GetLB().SetWeightFnct(1);
+    adap.GetLb().SetMeasuredCost( P.get<double>("AdaptRef.ImbalanceTol"));
+    DROPS::ParMultiGridCL::SetBulkUnknowns( P.get<int>("AdaptRef.BulkUnknowns"));
     if (DROPS::ProcCL::Check( CheckParMultiGrid( adap.GetPMG())))
         std::cout << "As far as I can tell the ParMultigridCl is sane\n";
 #endif
 
     DROPS::InstatNavierStokes2PhaseP2P1CL prob( *mg, DROPS::TwoPhaseFlowCoeffCL(P), bnddata, P.get<double>("Stokes.XFEMStab")<0 ? DROPS::P1_FE : DROPS::P1X_FE, P.get<double>("Stokes.XFEMStab"));
+#ifdef _PAR
+    if (adap.GetLb().GetImbalanceTol()>0.)
+        prob.SetCostRecorder( &adap.GetLb().GetLB().GetCost());
+#endif
 
     Strategy( prob, *lsetbnddata, adap);    // do all the stuff
 
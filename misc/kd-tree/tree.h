@@ -67,6 +67,8 @@ namespace KDTree{
         //@{
         /// \brief Determine recursively the minimal and maximal level of a node.
         void level_info_rec( size_t&, size_t&, size_t&, const size_t, const node_type * const) const;
+        /// \brief Determine recursively the bounding boxes of a subtree.
+        void refit_rec( node_type * const);
         //@}
 
     public:  // ------- member functions ------- 
@@ -85,6 +87,13 @@ namespace KDTree{
         inline index_vec_type& origidx() { return p_origidx; }              ///< access to the index array
         //@}
 
+        /// \brief delete all nodes and points, so the tree can be built again
+        void clear() { delete p_root; p_root=0; p_data.clear(); p_origidx.clear(); }
+        /// \brief Address of a point for moving it; call refit afterwards
+        T* addr( size_t i) { return &p_data[0]+K*i; }
+        /// \brief Determine all bounding boxes after points have been moved
+        void refit() { if ( p_root!=0) refit_rec( p_root); }
+
         /// \brief get the number of points stored by the tree
         inline size_t size() const { return data().size()/K; }
         /// \brief get the memory used for storing the tree
@@ -134,6 +143,45 @@ namespace KDTree{
     }
 
 
+    /** Points may be moved after the tree has been built. Then the bounding boxes
+        of the leaves are determined from the points in their buckets and the
+        bounding box of an internal node is the union of the boxes of its children.
+        The split values are not changed; since the search only prunes by bounding
+        boxes, the search stays exact, but it becomes slower if the points move
+        far away from their initial positions. In this case, the tree should be
+        built again.
+        \param node    root of the subtree
+    */
+    template <typename T, usint K, int BucketSize>
+    void TreeCL<T,K,BucketSize>::refit_rec( node_type * const node)
+    {
+        internal::BoundingBoxCL<T,K>& bb= node->bounding_box();
+        if ( node->isLeaf()){                                       // leaf node, use the points of the bucket
+            const internal::BucketCL<BucketSize>& bucket= node->bucket();
+            for ( usint j=0; j<K; ++j){
+                bb[2*j]  = addr(bucket[0])[j];
+                bb[2*j+1]= addr(bucket[0])[j];
+            }
+            for ( int i=1; i<BucketSize && bucket[i]!=NoIdx; ++i){
+                for ( usint j=0; j<K; ++j){
+                    bb[2*j]  = std::min( bb[2*j],   addr(bucket[i])[j]);
+                    bb[2*j+1]= std::max( bb[2*j+1], addr(bucket[i])[j]);
+                }
+            }
+        }
+        else {                                                      // internal node, unite the boxes of the children
+            refit_rec( node->left());
+            refit_rec( node->right());
+            const internal::BoundingBoxCL<T,K>& bb_left = node->left()->bounding_box();
+            const internal::BoundingBoxCL<T,K>& bb_right= node->right()->bounding_box();
+            for ( usint j=0; j<K; ++j){
+                bb[2*j]  = std::min( bb_left[2*j],   bb_right[2*j]);
+                bb[2*j+1]= std::max( bb_left[2*j+1], bb_right[2*j+1]);
+            }
+        }
+    }
+
+
     /** Get the point that belongs to the index idx.
         \param idx  index of the point in the rearranged data
         \return point belonging to idx
@@ -525,10 +525,14 @@ namespace KDTree{
     void TreeBuilderCL<T,K,BucketSize>::build( T const * data, const size_t n)
     {
         p_data= data; p_skipped= 0;
+        p_tree.clear();                 // the tree may be built again
+        if ( n==0)
+            return;
 
         // construct the index vector
         p_idxvec.resize( n);
-        for ( size_t i=0; i<n; ++i) 
+#pragma omp parallel for schedule(static)
+        for ( int i=0; i<(int)n; ++i)
             p_idxvec[i]= i;
 
         // for each thread a single queue is used
@@ -537,7 +541,8 @@ namespace KDTree{
         // build the hat (= "widend" root) of the tree
         buildRoot( queues, n);
 
-#pragma omp parallel for
+        // the sub trees below the hat differ in size, so distribute them dynamically
+#pragma omp parallel for schedule(dynamic,1)
         for ( int thread=0; thread<get_num_threads(); ++thread){
             while ( !queues[thread].empty()){
                 BuildTask task( queues[thread].front());
@@ -548,7 +553,7 @@ namespace KDTree{
 
         // optimize the data
         p_tree.data().resize( (n-p_skipped)*K);
-        p_tree.origidx().resize( (n-p_skipped)*K);
+        p_tree.origidx().resize( n-p_skipped);
         size_t first_free=0;
         optimize( first_free, p_tree.root());
         
@@ -0,0 +1,432 @@
+/// \file profiler.h
+/// \brief hierarchical region profiler with per-thread buffers and cross-rank reports
+/// \author LNM RWTH Aachen
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2011 LNM/SC RWTH Aachen, Germany
+*/
+
+#ifndef DROPS_PROFILER_H
+#define DROPS_PROFILER_H
+
+#include <vector>
+#include <map>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include "misc/utils.h"
+#ifdef _OPENMP
+#  include <omp.h>
+#else
+#  include <sys/time.h>
+#endif
+#ifdef _PAR
+#  include "parallel/parallel.h"
+#endif
+
+namespace DROPS
+{
+
+/****************************************************************************
+* P R O F I L E R  C L A S S                                                *
+****************************************************************************/
+/// \brief Hierarchical region profiler
+/** Regions are opened and closed by ProfileRegionCL, usually by the macro
+    DROPS_PROFILE_REGION. Each thread records its regions into its own tree
+    (and, if tracing is switched on, into its own event buffer), so entering
+    and leaving a region neither locks nor allocates once the tree has been
+    built. Regions entered by the worker threads of an OpenMP team are
+    attached to the region that was open on the master thread when the team
+    was forked.
+
+    Report() reduces the trees over the threads (time: maximum, calls: sum)
+    and over the processes (time: min/avg/max, calls: sum) and prints the
+    result as a tree together with the imbalance factor max/avg. WriteTrace()
+    dumps all recorded events as one Chrome trace file (JSON), which can be
+    inspected by chrome://tracing or similar tools. Both are collective
+    operations in the parallel version.
+
+    The profiler is inactive until Enable() is called; an inactive profiler
+    costs one branch per region.
+*/
+/****************************************************************************
+* P R O F I L E R  C L A S S                                                *
+****************************************************************************/
+class ProfilerCL
+{
+  private:
+    struct RegionST                                 ///< node of the region tree of a thread
+    {
+        const char* name;
+        int    parent, child, sibling;              ///< indices in the region tree, -1 if not present
+        double begin, time;                         ///< time stamp of the last entry, accumulated time
+        size_t calls;
+        RegionST( const char* n, int p)
+            : name( n), parent( p), child( -1), sibling( -1), begin( 0.), time( 0.), calls( 0) {}
+    };
+    struct EventST                                  ///< entry of the Chrome trace
+    {
+        const char* name;
+        double begin, end;
+        EventST( const char* n, double b, double e) : name( n), begin( b), end( e) {}
+    };
+    struct ThreadST                                 ///< all data of a thread
+    {
+        std::vector<RegionST> region;               ///< region[0] is the root
+        std::vector<EventST>  event;
+        int    cur;                                 ///< currently open region
+        size_t depth;                               ///< number of open regions of this thread
+        size_t forkGen;                             ///< generation of the fork path forkNode belongs to
+        int    forkNode;                            ///< region corresponding to the fork path
+        ThreadST() : region( 1, RegionST( "", -1)), cur( 0), depth( 0), forkGen( 0), forkNode( 0) {}
+    };
+    typedef std::map<std::string, std::pair<double, double> > FlatT; ///< path -> (time, calls)
+
+    std::vector<ThreadST*>   thread_;
+    bool                     active_, trace_;
+    double                   t0_;
+    std::vector<const char*> forkPath_;             ///< regions open on the master thread outside of parallel regions
+    size_t                   forkGen_;
+
+    ProfilerCL() : active_( false), trace_( false), t0_( 0.), forkGen_( 1) {}
+    ProfilerCL( const ProfilerCL&);                 // not defined
+    ProfilerCL& operator=( const ProfilerCL&);      // not defined
+
+    static int ThreadNum() {
+#ifdef _OPENMP
+        return omp_get_thread_num();
+#else
+        return 0;
+#endif
+    }
+    static bool InParallel() {
+#ifdef _OPENMP
+        return omp_in_parallel();
+#else
+        return false;
+#endif
+    }
+    inline int  FindChild( ThreadST&, int, const char*);
+    inline int  ForkNode( ThreadST&);
+    inline void Flatten( const ThreadST&, int, const std::string&, FlatT&) const;
+    inline void WriteJSONString( std::ostream&, const char*) const;
+
+  public:
+    ~ProfilerCL() { for (size_t i= 0; i < thread_.size(); ++i) delete thread_[i]; }
+
+    /// \brief The profiler of this process
+    static ProfilerCL& Instance() { static ProfilerCL profiler; return profiler; }
+    /// \brief Time stamp in seconds
+    static double Now() {
+#ifdef _OPENMP
+        return omp_get_wtime();
+#else
+        timeval tv;
+        gettimeofday( &tv, 0);
+        return tv.tv_sec + 1e-6*tv.tv_usec;
+#endif
+    }
+
+    /// \brief Start recording; record events for WriteTrace(), if trace is set. Must not be called inside a region.
+    inline void Enable( bool trace= false);
+    /// \brief Stop recording
+    void Disable() { active_= false; }
+    bool Active() const { return active_; }
+    bool Tracing() const { return trace_; }
+
+    /// \brief Open the region name as a child of the current region of the calling thread; returns false, if nothing is recorded.
+    inline bool Enter( const char* name);
+    /// \brief Close the current region of the calling thread
+    inline void Leave();
+
+    /// \brief Discard all recorded times, e.g., after a report per time step; the events for WriteTrace() are kept. Must not be called inside a region.
+    inline void Reset();
+    /// \brief Print the region tree with min/avg/max times over the processes on the master (collective)
+    inline void Report( std::ostream& os= std::cout, const std::string& title= "") const;
+    /// \brief Write all recorded events to the Chrome trace file filename (collective)
+    inline void WriteTrace( const std::string& filename) const;
+};
+
+/// \brief Opens a region of ProfilerCL on construction and closes it on destruction
+class ProfileRegionCL
+{
+  private:
+    bool on_;
+
+  public:
+    ProfileRegionCL( const char* name)
+        : on_( ProfilerCL::Instance().Active() && ProfilerCL::Instance().Enter( name)) {}
+    ~ProfileRegionCL() { if (on_) ProfilerCL::Instance().Leave(); }
+};
+
+/// \name Profiling macros
+/// DROPS_PROFILE_REGION(name) profiles the enclosing scope as region name,
+/// which must be a string literal or otherwise outlive the profiler.
+/// Defining DROPS_NO_PROFILE removes all regions at compile time.
+//@{
+#define DROPS_PROFILE_CONCAT_(a,b) a##b
+#define DROPS_PROFILE_CONCAT(a,b) DROPS_PROFILE_CONCAT_(a,b)
+#ifndef DROPS_NO_PROFILE
+#  define DROPS_PROFILE_REGION(name) \
+    DROPS::ProfileRegionCL DROPS_PROFILE_CONCAT(drops_profile_region_, __LINE__)( name)
+#else
+#  define DROPS_PROFILE_REGION(name)
+#endif
+//@}
+
+
+/****************************************************************************
+* P R O F I L E R  C L A S S  (inline functions)                            *
+****************************************************************************/
+
+void ProfilerCL::Enable( bool trace)
+{
+#ifdef _OPENMP
+    const size_t num_threads= omp_get_max_threads();
+#else
+    const size_t num_threads= 1;
+#endif
+    for (size_t i= thread_.size(); i < num_threads; ++i)
+        thread_.push_back( new ThreadST);
+    if (!active_ && t0_ == 0.)
+        t0_= Now();
+    trace_= trace;
+    active_= true;
+}
+
+int ProfilerCL::FindChild( ThreadST& t, int node, const char* name)
+{
+    int last= -1;
+    for (int c= t.region[node].child; c != -1; last= c, c= t.region[c].sibling)
+        if (t.region[c].name == name || std::strcmp( t.region[c].name, name) == 0)
+            return c;
+    const int c= t.region.size();
+    t.region.push_back( RegionST( name, node));
+    if (last == -1)
+        t.region[node].child= c;
+    else
+        t.region[last].sibling= c;
+    return c;
+}
+
+int ProfilerCL::ForkNode( ThreadST& t)
+/** forkPath_ is modified by the master thread outside of parallel regions only,
+    hence it can be read by all threads of a team without synchronization.*/
+{
+    if (t.forkGen != forkGen_) {
+        int node= 0;
+        for (size_t i= 0; i < forkPath_.size(); ++i)
+            node= FindChild( t, node, forkPath_[i]);
+        t.forkNode= node;
+        t.forkGen= forkGen_;
+    }
+    return t.forkNode;
+}
+
+bool ProfilerCL::Enter( const char* name)
+{
+    const size_t tid= ThreadNum();
+    if (tid >= thread_.size())
+        return false;
+    ThreadST& t= *thread_[tid];
+    if (t.depth == 0 && tid != 0)
+        t.cur= ForkNode( t);
+    t.cur= FindChild( t, t.cur, name);
+    ++t.depth;
+    if (tid == 0 && !InParallel()) {
+        forkPath_.push_back( name);
+        ++forkGen_;
+    }
+    t.region[t.cur].begin= Now();
+    return true;
+}
+
+void ProfilerCL::Leave()
+{
+    const double end= Now();
+    const size_t tid= ThreadNum();
+    ThreadST& t= *thread_[tid];
+    RegionST& r= t.region[t.cur];
+    r.time+= end - r.begin;
+    ++r.calls;
+    if (trace_)
+        t.event.push_back( EventST( r.name, r.begin, end));
+    t.cur= r.parent;
+    --t.depth;
+    if (tid == 0 && !InParallel() && !forkPath_.empty()) {
+        forkPath_.pop_back();
+        ++forkGen_;
+    }
+}
+
+void ProfilerCL::Reset()
+{
+    for (size_t i= 0; i < thread_.size(); ++i) {
+        for (size_t j= 0; j < thread_[i]->region.size(); ++j) {
+            thread_[i]->region[j].time= 0.;
+            thread_[i]->region[j].calls= 0;
+        }
+    }
+}
+
+void ProfilerCL::Flatten( const ThreadST& t, int node, const std::string& prefix, FlatT& flat) const
+/** The path of a region is the sequence of the names of its ancestors separated
+    by '\\1', which sorts the children of a region directly behind the region.*/
+{
+    for (int c= t.region[node].child; c != -1; c= t.region[c].sibling) {
+        const std::string path= prefix.empty() ? std::string( t.region[c].name) : prefix + '\1' + t.region[c].name;
+        std::pair<double, double>& entry= flat[path];
+        entry.first=  std::max( entry.first, t.region[c].time);
+        entry.second+= t.region[c].calls;
+        Flatten( t, c, path, flat);
+    }
+}
+
+void ProfilerCL::Report( std::ostream& os, const std::string& title) const
+{
+    FlatT flat;
+    for (size_t i= 0; i < thread_.size(); ++i)
+        Flatten( *thread_[i], 0, "", flat);
+
+    // all processes have to know the union of the paths
+    std::vector<std::string> paths;
+#ifdef _PAR
+    std::vector<char> mypaths;
+    for (FlatT::const_iterator it= flat.begin(); it != flat.end(); ++it) {
+        mypaths.insert( mypaths.end(), it->first.begin(), it->first.end());
+        mypaths.push_back( '\0');
+    }
+    std::valarray<char> allpaths= ProcCL::Gatherv( mypaths, -1);
+    for (size_t pos= 0; pos < allpaths.size(); ) {
+        const std::string path( &allpaths[pos]);
+        paths.push_back( path);
+        pos+= path.size() + 1;
+    }
+    std::sort( paths.begin(), paths.end());
+    paths.erase( std::unique( paths.begin(), paths.end()), paths.end());
+    const int num_procs= ProcCL::Size();
+#else
+    for (FlatT::const_iterator it= flat.begin(); it != flat.end(); ++it)
+        paths.push_back( it->first);
+    const int num_procs= 1;
+#endif
+
+    const size_t n= paths.size();
+    std::valarray<double> time( 0., n), calls( 0., n);
+    for (size_t i= 0; i < n; ++i) {
+        const FlatT::const_iterator it= flat.find( paths[i]);
+        if (it != flat.end()) {
+            time[i]=  it->second.first;
+            calls[i]= it->second.second;
+        }
+    }
+#ifdef _PAR
+    const std::valarray<double> tmin= ProcCL::GlobalMin( time, Drops_MasterC),
+                                tmax= ProcCL::GlobalMax( time, Drops_MasterC),
+                                tsum= ProcCL::GlobalSum( time, Drops_MasterC),
+                                csum= ProcCL::GlobalSum( calls, Drops_MasterC);
+#else
+    const std::valarray<double>& tmin= time, & tmax= time, & tsum= time, & csum= calls;
+#endif
+
+    IF_MASTER {
+        os << "Profile" << (title.empty() ? std::string() : " " + title) << " (" << num_procs << " process(es)):\n"
+           << std::left << std::setw( 40) << "region" << std::right
+           << std::setw( 12) << "calls" << std::setw( 12) << "min [s]" << std::setw( 12) << "avg [s]"
+           << std::setw( 12) << "max [s]" << std::setw( 9) << "imbal" << '\n';
+        for (size_t i= 0; i < n; ++i) {
+            const size_t depth= std::count( paths[i].begin(), paths[i].end(), '\1'),
+                         start= paths[i].rfind( '\1');
+            const std::string name= std::string( 2*depth, ' ') + paths[i].substr( start == std::string::npos ? 0 : start + 1);
+            const double avg= tsum[i]/num_procs;
+            os << std::left << std::setw( 40) << name << std::right
+               << std::setw( 12) << static_cast<size_t>( csum[i])
+               << std::scientific << std::setprecision( 3)
+               << std::setw( 12) << tmin[i] << std::setw( 12) << avg << std::setw( 12) << tmax[i]
+               << std::fixed << std::setprecision( 2)
+               << std::setw( 9) << (avg > 0. ? tmax[i]/avg : 1.) << '\n';
+        }
+        os.flush();
+        os.unsetf( std::ios_base::floatfield);
+        os << std::setprecision( 6);
+    }
+}
+
+void ProfilerCL::WriteJSONString( std::ostream& os, const char* s) const
+{
+    os << '"';
+    for ( ; *s != '\0'; ++s) {
+        if (*s == '"' || *s == '\\')
+            os << '\\';
+        os << *s;
+    }
+    os << '"';
+}
+
+void ProfilerCL::WriteTrace( const std::string& filename) const
+/** Each process writes its events (pid: rank, tid: thread, times in microseconds
+    relative to Enable()) behind the events of the processes with lower rank.*/
+{
+#ifdef _PAR
+    const int rank= ProcCL::MyRank(), num_procs= ProcCL::Size();
+#else
+    const int rank= 0, num_procs= 1;
+#endif
+    std::ostringstream out;
+    out << std::fixed << std::setprecision( 3);
+    if (rank == 0)
+        out << "{\"traceEvents\":[\n";
+    else
+        out << ",\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+        << ",\"args\":{\"name\":\"process " << rank << "\"}}";
+    for (size_t i= 0; i < thread_.size(); ++i)
+        for (std::vector<EventST>::const_iterator it= thread_[i]->event.begin(); it != thread_[i]->event.end(); ++it) {
+            out << ",\n{\"name\":";
+            WriteJSONString( out, it->name);
+            out << ",\"ph\":\"X\",\"pid\":" << rank << ",\"tid\":" << i
+                << ",\"ts\":" << 1e6*(it->begin - t0_) << ",\"dur\":" << 1e6*(it->end - it->begin) << '}';
+        }
+    if (rank == num_procs - 1)
+        out << "\n]}\n";
+    const std::string data= out.str();
+
+#ifdef _PAR
+    const std::vector<int> sizes= ProcCL::Gather( static_cast<int>( data.size()), -1);
+    ProcCL::OffsetT offset= 0;
+    for (int p= 0; p < rank; ++p)
+        offset+= sizes[p];
+    ProcCL::FileT file= ProcCL::FileOpenWrite( filename);
+    ProcCL::FileWriteAtAll( file, offset, data.data(), data.size());
+    ProcCL::FileClose( file);
+#else
+    std::ofstream file( filename.c_str());
+    if (!file)
+        throw DROPSErrCL( "ProfilerCL::WriteTrace: Cannot open file " + filename);
+    file << data;
+#endif
+}
+
+} // end of namespace DROPS
+
+#endif
@@ -147,15 +147,22 @@ class LocalNonlConvSystemTwoPhase_P2CL
     double rho (int sign) const                   { return sign > 0 ? rho_p : rho_n; }
 
     void setup (const SMatrixCL<3,3>& T, double absdet, const LocalP2CL<Point3DCL> & velp2, const LocalP2CL<>& ls, LocalNonlConvDataCL& loc);
+    /// \brief Same as above with the partition of the principal lattice of degree 2 given.
+    void setup (const SMatrixCL<3,3>& T, double absdet, const LocalP2CL<Point3DCL> & velp2, const TetraPartitionCL& p, LocalNonlConvDataCL& loc);
 };
 
 void LocalNonlConvSystemTwoPhase_P2CL::setup (const SMatrixCL<3,3>& T, double absdet, const LocalP2CL<Point3DCL> & velp2, const LocalP2CL<>& ls, LocalNonlConvDataCL& loc)
 {
-    P2DiscCL::GetGradients( Grad, GradRef, T);
-
     evaluate_on_vertexes( ls, lat, Addr( ls_loc));
     partition.make_partition<SortedVertexPolicyCL, MergeCutPolicyCL>( lat, ls_loc);
-    make_CompositeQuad5Domain( q5dom, partition);
+    setup( T, absdet, velp2, partition, loc);
+}
+
+void LocalNonlConvSystemTwoPhase_P2CL::setup (const SMatrixCL<3,3>& T, double absdet, const LocalP2CL<Point3DCL> & velp2, const TetraPartitionCL& p, LocalNonlConvDataCL& loc)
+{
+    P2DiscCL::GetGradients( Grad, GradRef, T);
+
+    make_CompositeQuad5Domain( q5dom, p);
     GridFunctionCL<Point3DCL> velocity;
     resize_and_evaluate_on_vertexes( velp2, q5dom, velocity);
     for (int i= 0; i < 10; ++i) {
@@ -204,6 +211,9 @@ class NonlConvSystemAccumulator_P2CL : public TetraAccumulatorCL
 
     Point3DCL dirichlet_val[10]; ///< Used to transfer boundary-values from local_setup() update_global_system().
 
+    const TwoPhaseTetraContextCL* ctx_; ///< if not 0, the geometry, the level set and its partition are taken from here
+    int tid_;                           ///< clone id for ctx_
+
     ///\brief Computes the mapping from local to global data "n", the local matrices in loc and, if required, the Dirichlet-values needed to eliminate the boundary-dof from the global system.
     void local_setup (const TetraCL& tet);
     ///\brief Update the global system.
@@ -212,7 +222,7 @@ class NonlConvSystemAccumulator_P2CL : public TetraAccumulatorCL
   public:
     NonlConvSystemAccumulator_P2CL (const TwoPhaseFlowCoeffCL& Coeff, const MultiGridCL& MG_, const StokesBndDataCL& BndData_, 
                                     const VelVecDescCL& vel_, const LevelsetP2CL& ls, IdxDescCL& RowIdx_, 
-                                    MatrixCL& N_, VecDescCL* cplN_, double t, bool smoothed=false);
+                                    MatrixCL& N_, VecDescCL* cplN_, double t, bool smoothed=false, const TwoPhaseTetraContextCL* ctx= 0);
 
     ///\brief Initializes matrix-builders and load-vectors
     void begin_accumulation ();
@@ -221,17 +231,17 @@ class NonlConvSystemAccumulator_P2CL : public TetraAccumulatorCL
 
     void visit (const TetraCL& sit);
 
-    TetraAccumulatorCL* clone (int /*tid*/) { return new NonlConvSystemAccumulator_P2CL ( *this); };
+    TetraAccumulatorCL* clone (int tid) { NonlConvSystemAccumulator_P2CL* p= new NonlConvSystemAccumulator_P2CL ( *this); p->tid_= tid; return p; };
 };
 
 NonlConvSystemAccumulator_P2CL::NonlConvSystemAccumulator_P2CL (const TwoPhaseFlowCoeffCL& Coeff_, const MultiGridCL& MG_, const StokesBndDataCL& BndData_,
                                                                 const VelVecDescCL& vel_, const LevelsetP2CL& lset_arg, IdxDescCL& RowIdx_, 
-                                                                MatrixCL& N_, VecDescCL* cplN_, double t_, bool smoothed_)
+                                                                MatrixCL& N_, VecDescCL* cplN_, double t_, bool smoothed_, const TwoPhaseTetraContextCL* ctx)
     : smoothed(smoothed_), Coeff( Coeff_), BndData( BndData_), MG(MG_),
       vel(vel_), lset( lset_arg), t( t_),
       RowIdx( RowIdx_), N( N_), cplN( cplN_), 
       local_twophase( Coeff.rho( 1.0), Coeff.rho( -1.0)),
-      local_smoothed_twophase( Coeff.rho)
+      local_smoothed_twophase( Coeff.rho), ctx_( ctx), tid_( 0)
 {}
 
 void NonlConvSystemAccumulator_P2CL::begin_accumulation ()
@@ -264,20 +274,31 @@ void NonlConvSystemAccumulator_P2CL::visit (const TetraCL& tet)
 
 void NonlConvSystemAccumulator_P2CL::local_setup (const TetraCL& tet)
 {
-    GetTrafoTr( T, det, tet);
-    absdet= std::fabs( det);
+    const TwoPhaseTetraDataCL* d= ctx_ != 0 ? ctx_->get( tet, tid_) : 0;
+    if (d != 0) {
+        T= d->T;
+        det= d->det;
+        absdet= d->absdet;
+        ls_loc= d->ls;
+    }
+    else {
+        GetTrafoTr( T, det, tet);
+        absdet= std::fabs( det);
+        ls_loc.assign( tet, lset.Phi, lset.GetBndData());
+    }
 
     n.assign( tet, RowIdx, BndData.Vel);
 
-    ls_loc.assign( tet, lset.Phi, lset.GetBndData());
     vel_loc.assign( tet, vel, BndData.Vel);
-    if (equal_signs( ls_loc)) {
+    if (d != 0 ? !d->cut : equal_signs( ls_loc)) {
         local_onephase.velocity( vel_loc);
         local_onephase.rho( local_twophase.rho( sign( ls_loc[0])));
         local_onephase.setup( T, absdet, loc);
     }
     else {
-        if (!smoothed)
+        if (!smoothed && d != 0)
+            local_twophase.setup( T, absdet, vel_loc, ctx_->partition( tid_).partition, loc);
+        else if (!smoothed)
             local_twophase.setup( T, absdet, vel_loc, ls_loc, loc);
         else {
             local_smoothed_twophase.velocity( vel_loc);
@@ -315,6 +336,180 @@ void NonlConvSystemAccumulator_P2CL::update_global_system ()
         }
 }
 
+/// \brief Local element matrix of the derivative of the convection term with respect to the convecting velocity
+struct LocalNonlConvJacobianDataCL
+{
+    SMatrixCL<3,3> R [10][10];
+};
+
+/// \brief Setup of the local matrix R(u)_ij= int( rho phi_i phi_j grad u ) on a tetra in one phase or on an intersected tetra.
+///
+/// On intersected tetras, the integration rule is exact w.r.t. the approximated interface, as in LocalNonlConvSystemTwoPhase_P2CL.
+class LocalNonlConvJacobian_P2CL
+{
+  private:
+    const PrincipalLatticeCL& lat;
+
+    const double rho_p, rho_n;
+
+    Quad5CL<Point3DCL> Grad[10], GradRef[10];
+    Quad5CL<> phi[10], gradu[3][3];
+
+    LocalP1CL<Point3DCL> GradRefP1[10], GradP1[10];
+    LocalP2CL<> p2;
+    std::valarray<double> ls_loc; //level set values in partition int. points
+    TetraPartitionCL partition;   //the partitioning
+    QuadDomainCL q5dom;
+    std::valarray<double> qshape[10], qgradu[3][3];
+    GridFunctionCL<Point3DCL> qdshape[10];
+
+  public:
+    LocalNonlConvJacobian_P2CL (double rhop, double rhon)
+        : lat( PrincipalLatticeCL::instance( 2)), rho_p( rhop), rho_n( rhon), ls_loc( 10)
+    {
+        P2DiscCL::GetGradientsOnRef( GradRef);
+        P2DiscCL::GetGradientsOnRef( GradRefP1);
+        for (int i= 0; i < 10; ++i) {
+            p2= 0.; p2[i]= 1.;
+            phi[i].assign( p2);
+        }
+    }
+
+    double rho (int sign) const { return sign > 0 ? rho_p : rho_n; }
+
+    void setup_onephase (const SMatrixCL<3,3>& T, double absdet, const LocalP2CL<Point3DCL>& velp2, double rho, LocalNonlConvJacobianDataCL& loc);
+    void setup_twophase (const SMatrixCL<3,3>& T, double absdet, const LocalP2CL<Point3DCL>& velp2, const LocalP2CL<>& ls, LocalNonlConvJacobianDataCL& loc);
+};
+
+void LocalNonlConvJacobian_P2CL::setup_onephase (const SMatrixCL<3,3>& T, double absdet, const LocalP2CL<Point3DCL>& velp2, double rho, LocalNonlConvJacobianDataCL& loc)
+{
+    P2DiscCL::GetGradients( Grad, GradRef, T);
+    for (int k= 0; k < 3; ++k)
+        for (int l= 0; l < 3; ++l) { // gradu[k][l] = d_l u_k
+            gradu[k][l]= 0.;
+            for (int m= 0; m < 10; ++m)
+                for (Uint q= 0; q < Quad5DataCL::NumNodesC; ++q)
+                    gradu[k][l][q]+= velp2[m][k]*Grad[m][q][l];
+        }
+    for (int i= 0; i < 10; ++i)
+        for (int j= 0; j <= i; ++j) {
+            for (int k= 0; k < 3; ++k)
+                for (int l= 0; l < 3; ++l)
+                    loc.R[i][j]( k, l)= rho*Quad5CL<>( phi[j]*gradu[k][l]).quadP2( i, absdet);
+            loc.R[j][i]= loc.R[i][j];
+        }
+}
+
+void LocalNonlConvJacobian_P2CL::setup_twophase (const SMatrixCL<3,3>& T, double absdet, const LocalP2CL<Point3DCL>& velp2, const LocalP2CL<>& ls, LocalNonlConvJacobianDataCL& loc)
+{
+    P2DiscCL::GetGradients( GradP1, GradRefP1, T);
+
+    evaluate_on_vertexes( ls, lat, Addr( ls_loc));
+    partition.make_partition<SortedVertexPolicyCL, MergeCutPolicyCL>( lat, ls_loc);
+    make_CompositeQuad5Domain( q5dom, partition);
+    for (int i= 0; i < 10; ++i) {
+        p2= 0.; p2[i]= 1.;
+        resize_and_evaluate_on_vertexes( p2,        q5dom,  qshape[i]); // shape
+        resize_and_evaluate_on_vertexes( GradP1[i], q5dom, qdshape[i]); // gradient shape
+    }
+    const size_t nq= qshape[0].size();
+    for (int k= 0; k < 3; ++k)
+        for (int l= 0; l < 3; ++l) { // qgradu[k][l] = d_l u_k
+            qgradu[k][l].resize( nq);
+            qgradu[k][l]= 0.;
+            for (int m= 0; m < 10; ++m)
+                for (size_t q= 0; q < nq; ++q)
+                    qgradu[k][l][q]+= velp2[m][k]*qdshape[m][q][l];
+        }
+    double intpos, intneg;
+    for (int i= 0; i < 10; ++i)
+        for (int j= 0; j <= i; ++j) {
+            const std::valarray<double> phiphi( qshape[i]*qshape[j]);
+            for (int k= 0; k < 3; ++k)
+                for (int l= 0; l < 3; ++l) {
+                    quad( std::valarray<double>( phiphi*qgradu[k][l]), absdet, q5dom, intneg, intpos);
+                    loc.R[i][j]( k, l)= rho_p*intpos + rho_n*intneg;
+                }
+            loc.R[j][i]= loc.R[i][j];
+        }
+}
+
+/// \brief Accumulator to set up the matrix R(u) of the derivative of the convection term for two-phase flow.
+class NonlConvJacobianAccumulator_P2CL : public TetraAccumulatorCL
+{
+  private:
+    const StokesBndDataCL& BndData;
+    const VelVecDescCL & vel;
+    const LevelsetP2CL& lset;
+
+    IdxDescCL& RowIdx;
+    MatrixCL& R;
+
+    SparseMatBuilderCL<double, SMatrixCL<3,3> >* mR_;
+
+    LocalNonlConvJacobian_P2CL local_jac;
+    LocalNonlConvJacobianDataCL loc;
+
+    LocalNumbP2CL n; ///< global numbering of the P2-unknowns
+
+    SMatrixCL<3,3> T;
+    double det, absdet;
+    LocalP2CL<> ls_loc;
+    LocalP2CL<Point3DCL> vel_loc;
+
+  public:
+    NonlConvJacobianAccumulator_P2CL (const TwoPhaseFlowCoeffCL& Coeff, const StokesBndDataCL& BndData_,
+                                      const VelVecDescCL& vel_, const LevelsetP2CL& ls, IdxDescCL& RowIdx_, MatrixCL& R_)
+        : BndData( BndData_), vel( vel_), lset( ls), RowIdx( RowIdx_), R( R_), mR_( 0),
+          local_jac( Coeff.rho( 1.0), Coeff.rho( -1.0)) {}
+
+    ///\brief Initializes matrix-builders
+    void begin_accumulation () {
+        const size_t num_unks_vel= RowIdx.NumUnknowns();
+        mR_= new SparseMatBuilderCL<double, SMatrixCL<3,3> >( &R, num_unks_vel, num_unks_vel);
+    }
+    ///\brief Builds the matrices
+    void finalize_accumulation() {
+        mR_->Build();
+        delete mR_;
+    }
+
+    void visit (const TetraCL& tet);
+
+    TetraAccumulatorCL* clone (int /*tid*/) { return new NonlConvJacobianAccumulator_P2CL ( *this); };
+};
+
+void NonlConvJacobianAccumulator_P2CL::visit (const TetraCL& tet)
+{
+    GetTrafoTr( T, det, tet);
+    absdet= std::fabs( det);
+
+    n.assign( tet, RowIdx, BndData.Vel);
+
+    ls_loc.assign( tet, lset.Phi, lset.GetBndData());
+    vel_loc.assign( tet, vel, BndData.Vel);
+    if (equal_signs( ls_loc))
+        local_jac.setup_onephase( T, absdet, vel_loc, local_jac.rho( sign( ls_loc[0])), loc);
+    else
+        local_jac.setup_twophase( T, absdet, vel_loc, ls_loc, loc);
+
+    // Newton corrections vanish on the Dirichlet boundary: no right-hand side
+    SparseMatBuilderCL<double, SMatrixCL<3,3> >& mR= *mR_;
+    for(int i= 0; i < 10; ++i)
+        if (n.WithUnknowns( i))
+            for(int j= 0; j < 10; ++j)
+                if (n.WithUnknowns( j))
+                    mR( n.num[i], n.num[j])+= loc.R[i][j];
+}
+
+void InstatNavierStokes2PhaseP2P1CL::SetupNonlinearJacobian(MatrixCL& R, const VelVecDescCL* vel, IdxDescCL& RowIdx) const
+{
+    NonlConvJacobianAccumulator_P2CL accu( Coeff_, BndData_, *vel, *ls_, RowIdx, R);
+    TetraAccumulatorTupleCL accus;
+    accus.push_back( &accu);
+    accumulate( accus, MG_, RowIdx.TriangLevel(), RowIdx.GetMatchingFunction(), RowIdx.GetBndInfo());
+}
+
 void InstatNavierStokes2PhaseP2P1CL::SetupNonlinear_P2(MatrixCL& N, const VelVecDescCL* vel, VelVecDescCL* cplN, const LevelsetP2CL& lset, IdxDescCL& RowIdx, double t) const
 /// Set up matrix N
 {
@@ -342,17 +537,61 @@ void InstatNavierStokes2PhaseP2P1CL::SetupNonlinear
 }
 
 MLTetraAccumulatorTupleCL&
-InstatNavierStokes2PhaseP2P1CL::nonlinear_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* N, const VelVecDescCL* vel, VelVecDescCL* cplN, const LevelsetP2CL& lset, double t) const
+InstatNavierStokes2PhaseP2P1CL::nonlinear_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* N, const VelVecDescCL* vel, VelVecDescCL* cplN, const LevelsetP2CL& lset, double t, const MLTwoPhaseTetraContextCL* ctx) const
 {
+    const MLTwoPhaseTetraContextCL      ctxs   = context_levels( accus, ctx);
     MLMatrixCL::iterator                itN    = N->Data.begin();
     MLIdxDescCL::iterator               it     = N->RowIdx->begin();
     MLTetraAccumulatorTupleCL::iterator it_accu= accus.begin();
-    for (size_t lvl=0; lvl < N->Data.size(); ++lvl, ++itN, ++it, ++it_accu)
-        it_accu->push_back_acquire( new NonlConvSystemAccumulator_P2CL( Coeff_, MG_, BndData_, *vel, lset, *it, *itN, lvl == N->Data.size()-1 ? cplN : 0, t));
+    MLTwoPhaseTetraContextCL::const_iterator itctx= ctxs.begin();
+    for (size_t lvl=0; lvl < N->Data.size(); ++lvl, ++itN, ++it, ++it_accu, ++itctx)
+        it_accu->push_back_acquire( new NonlConvSystemAccumulator_P2CL( Coeff_, MG_, BndData_, *vel, lset, *it, *itN, lvl == N->Data.size()-1 ? cplN : 0, t, false, *itctx));
     return accus;
 }
 
-PermutationT InstatNavierStokes2PhaseP2P1CL::downwind_numbering (const LevelsetP2CL&, IteratedDownwindCL dw)
+void InstatNavierStokes2PhaseP2P1CL::SetupStep
+    ( MLMatDescCL* A, MLMatDescCL* M, VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM,
+      MLMatDescCL* B, VecDescCL* c, MLMatDescCL* N, const VelVecDescCL* vel, VelVecDescCL* cplN,
+      MLMatDescCL* prA, MLMatDescCL* prM, MLMatDescCL* LB, VecDescCL* cplLB,
+      const LevelsetP2CL& lset, double t) const
+{
+    const bool velP2= GetVelFE() == vecP2_FE,
+               prP1 = GetPrFE() == P1_FE || GetPrFE() == P1X_FE;
+
+    MLTetraAccumulatorTupleCL accus( vel_idx.size());
+    MLTwoPhaseTetraContextCL ctx;
+    context_accu( accus, ctx, lset);
+    if (A != 0) {
+        if (velP2) system1_accu( accus, A, M, b, cplA, cplM, lset, t, &ctx);
+        else       SetupSystem1( A, M, b, cplA, cplM, lset, t);
+    }
+    if (B != 0) {
+        if (velP2 && prP1) system2_accu( accus, B, c, lset, t, &ctx);
+        else               SetupSystem2( B, c, lset, t);
+    }
+    if (N != 0)
+        nonlinear_accu( accus, N, vel, cplN, lset, t, &ctx);
+    if (prA != 0) {
+        if (prP1) prstiff_accu( accus, prA, lset, &ctx);
+        else      SetupPrStiff( prA, lset);
+    }
+    if (prM != 0) {
+        if (prP1) prmass_accu( accus, prM, lset, &ctx);
+        else      SetupPrMass( prM, lset);
+    }
+    if (LB != 0)
+        lb_accu( accus, LB, cplLB, lset, t, &ctx);
+    accus.GetFinest().set_cost_recorder( cost_);
+    accumulate( accus, MG_, vel_idx.TriangLevel(), vel_idx.GetMatchingFunction(), vel_idx.GetBndInfo());
+}
+
+PermutationT InstatNavierStokes2PhaseP2P1CL::downwind_numbering (const LevelsetP2CL& lset, IteratedDownwindCL dw)
+{
+    CachedDownwindCL cdw( dw);
+    return downwind_numbering( lset, cdw);
+}
+
+PermutationT InstatNavierStokes2PhaseP2P1CL::downwind_numbering (const LevelsetP2CL&, CachedDownwindCL& dw)
 {
     std::cout << "InstatNavierStokes2PhaseP2P1CL::downwind_numbering:\n";
     // std::cout << "...Setting indices...\n";
@@ -56,7 +56,7 @@ class InstatNavierStokes2PhaseP2P1CL : public InstatStokes2PhaseP2P1CL
     //@{
     /// \brief Set up matrix for nonlinearity
     void SetupNonlinear(MLMatDescCL* matN, const VelVecDescCL* vel, VelVecDescCL* cplN, const LevelsetP2CL& lset, double t) const;
-    MLTetraAccumulatorTupleCL& nonlinear_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* matN, const VelVecDescCL* vel, VelVecDescCL* cplN, const LevelsetP2CL& lset, double t) const;
+    MLTetraAccumulatorTupleCL& nonlinear_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* matN, const VelVecDescCL* vel, VelVecDescCL* cplN, const LevelsetP2CL& lset, double t, const MLTwoPhaseTetraContextCL* ctx= 0) const;
     /// \brief Set up matrix for nonlinearity at the time in the base-class using the registered Levelset-object.
     void SetupNonlinear(MLMatDescCL* matN, const VelVecDescCL* vel, VelVecDescCL* cplN) const {
         this->SetupNonlinear( matN, vel, cplN, *ls_, vel->t);
@@ -64,6 +64,22 @@ class InstatNavierStokes2PhaseP2P1CL : public InstatStokes2PhaseP2P1CL
     void SetupNonlinear(MatrixCL& N, const VelVecDescCL* vel, VelVecDescCL* cplN, IdxDescCL& RowIdx) const {
         this->SetupNonlinear_P2( N, vel, cplN, *ls_, RowIdx, vel->t);
     }
+    /// \brief Set up R(u) with (R(u)w)_i= int( rho phi_i (w*grad)u ) using the registered Levelset-object.
+    ///
+    /// The Jacobian of the convection term N(u)u is N(u) + R(u). The Dirichlet unknowns are eliminated
+    /// without right-hand side, as Newton corrections vanish on the Dirichlet boundary.
+    void SetupNonlinearJacobian(MatrixCL& R, const VelVecDescCL* vel, IdxDescCL& RowIdx) const;
+    /// \brief Set up the operators of a time step in one sweep over the tetras of each level.
+    ///
+    /// Sets up A and M with b, cplA, cplM, if A != 0; B with c, if B != 0; N with cplN for the velocity vel,
+    /// if N != 0; prA and prM, if not 0; the Laplace-Beltrami matrix LB with cplLB, if LB != 0. The geometry
+    /// and the level set of each tetra are computed once for all accumulators. Matrices, for whose finite
+    /// elements there is no accumulator, are set up by the corresponding Setup-routine instead. The cost of each
+    /// tetra of the finest level is recorded, if a recorder has been set by SetCostRecorder.
+    void SetupStep(MLMatDescCL* A, MLMatDescCL* M, VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM,
+                   MLMatDescCL* B, VecDescCL* c, MLMatDescCL* N, const VelVecDescCL* vel, VelVecDescCL* cplN,
+                   MLMatDescCL* prA, MLMatDescCL* prM, MLMatDescCL* LB, VecDescCL* cplLB,
+                   const LevelsetP2CL& lset, double t) const;
     //@}
 
     /// \brief Register a Levelset-object for use in SetupNonlinear; this is needed for Navier-Stokes-solvers.
@@ -75,6 +91,8 @@ class InstatNavierStokes2PhaseP2P1CL : public InstatStokes2PhaseP2P1CL
 
     /// \brief Perform downwind numbering for the velocity FE-space. The permutation is returned.
     PermutationT downwind_numbering (const LevelsetP2CL& lset, IteratedDownwindCL dw);
+    /// \brief Perform downwind numbering; dw reuses its last numbering, if it is still downwind
+    PermutationT downwind_numbering (const LevelsetP2CL& lset, CachedDownwindCL& dw);
 };
 
 } // end of namespace DROPS
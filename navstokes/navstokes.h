@@ -39,6 +39,7 @@ class NavierStokesP2P1CL : public StokesP2P1CL<Coeff>
   private:
     typedef StokesP2P1CL<Coeff> base_;
     void SetupNonlinear_P2( MatrixCL&, const VelVecDescCL*, VelVecDescCL*, IdxDescCL&, double) const;
+    void SetupNonlinearJacobian_P2( MatrixCL&, const VelVecDescCL*, IdxDescCL&) const;
 
   public:
     using                            base_::MG_;
@@ -73,6 +74,11 @@ class NavierStokesP2P1CL : public StokesP2P1CL<Coeff>
     { this->SetupNonlinear(matN, velvec, vecb, v.t); }
     void SetupNonlinear(MatrixCL& N, const VelVecDescCL* vel, VelVecDescCL* cplN, IdxDescCL& RowIdx) const
     { this->SetupNonlinear_P2( N, vel, cplN, RowIdx, v.t); }
+    // Set up the matrix R(u) with (R(u)w)_i= int( phi_i (w*grad)u ) for the velocity u in vel;
+    // the Jacobian of the convection term N(u)u is N(u) + R(u). Dirichlet unknowns are eliminated
+    // without right-hand side, as Newton corrections vanish on the Dirichlet boundary.
+    void SetupNonlinearJacobian(MatrixCL& R, const VelVecDescCL* vel, IdxDescCL& RowIdx) const
+    { this->SetupNonlinearJacobian_P2( R, vel, RowIdx); }
 
     // Set time for use with stationary NavStokes-Solvers. This shall be the new time t_old+dt!!!!!!!!!!!!!!!!!!
     void SetTime (double tt) { v.t= tt; }
@@ -337,6 +337,69 @@ template <class Coeff>
     N.Build();
 }
 
+template <class Coeff>
+  void
+  NavierStokesP2P1CL<Coeff>::SetupNonlinearJacobian_P2( MatrixCL& matR, const VelVecDescCL* velvec,
+                                                        IdxDescCL& RowIdx) const
+// Sets up the derivative of the nonlinear term with respect to the velocity in the convection field.
+{
+    const IdxT num_unks_vel= RowIdx.NumUnknowns();
+    MatrixBuilderCL R( &matR, num_unks_vel, num_unks_vel);
+
+    typename base_::const_DiscVelSolCL u( velvec, &BndData_.Vel, &MG_);
+    const Uint lvl    = RowIdx.TriangLevel();
+    LocalNumbP2CL n;
+
+    const IdxT stride= 1;   // stride between unknowns on same simplex, which
+                            // depends on numbering of the unknowns
+
+    Quad5CL<Point3DCL> Grad[10], GradRef[10];
+    Quad5CL<> phi[10], gradu[3][3]; // shape functions and velocity gradient in the quadrature points
+    LocalP2CL<Point3DCL> u_loc;
+    LocalP2CL<> p2;
+    SMatrixCL<3,3> T;
+    double det, absdet, R_ij[3][3];
+
+    P2DiscCL::GetGradientsOnRef( GradRef);
+    for (int i= 0; i < 10; ++i) {
+        p2= 0.; p2[i]= 1.;
+        phi[i].assign( p2);
+    }
+
+    for (MultiGridCL::const_TriangTetraIteratorCL sit=const_cast<const MultiGridCL&>( MG_).GetTriangTetraBegin(lvl),
+                                                 send=const_cast<const MultiGridCL&>( MG_).GetTriangTetraEnd(lvl);
+         sit != send; ++sit)
+    {
+        GetTrafoTr(T,det,*sit);
+        P2DiscCL::GetGradients(Grad, GradRef, T);
+        absdet= std::fabs(det);
+        u_loc.assign( *sit, u);
+        for (int k= 0; k < 3; ++k)
+            for (int l= 0; l < 3; ++l) { // gradu[k][l] = d_l u_k
+                gradu[k][l]= 0.;
+                for (int m= 0; m < 10; ++m)
+                    for (Uint q= 0; q < Quad5DataCL::NumNodesC; ++q)
+                        gradu[k][l][q]+= u_loc[m][k]*Grad[m][q][l];
+            }
+
+        n.assign( *sit, RowIdx, BndData_.Vel);
+
+        for (int i= 0; i < 10; ++i) // assemble row n.num[i]
+            if (n.WithUnknowns( i)) // vert/edge i is not on a Dirichlet boundary
+                for (int j= 0; j < 10; ++j)
+                    if (n.WithUnknowns( j)) // vert/edge j is not on a Dirichlet boundary
+                    { // R(u)_ij = int( phi_i phi_j grad u )
+                        for (int k= 0; k < 3; ++k)
+                            for (int l= 0; l < 3; ++l)
+                                R_ij[k][l]= Quad5CL<>( phi[j]*gradu[k][l]).quadP2( i, absdet);
+                        for (int k= 0; k < 3; ++k)
+                            for (int l= 0; l < 3; ++l)
+                                R( n.num[i] + k*stride, n.num[j] + l*stride)+= R_ij[k][l];
+                    }
+    }
+    R.Build();
+}
+
 template <class Coeff>
   void
   NavierStokesP2P1CL<Coeff>::SetupNonlinear(MLMatDescCL* matN, const VelVecDescCL* velvec,
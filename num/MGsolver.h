@@ -29,6 +29,7 @@
 #include "num/solver.h"
 
 #include <list>
+#include <map>
 #include <cstring>
 
 namespace DROPS
@@ -69,6 +70,36 @@ void MG(const MLMatrixCL& MGData, const ProlongationT& Prolong, const SmootherCL
         const bool residerr= true, Uint sm=1, int lvl=-1);
 
 
+/// \brief Coarse grid operators computed as Galerkin products P^T*A*P
+/** The finest level is a copy of the finest level of the given matrix. The
+    coarse levels are computed by two sparse matrix-matrix products per level.
+    If neither the finest matrix (address and version) nor the prolongations
+    have changed since the last update, the stored operators are returned
+    as they are. If only the values of the finest matrix have changed, only
+    the numeric phase of the products is performed.*/
+class GalerkinHierarchyCL
+{
+  private:
+    MLMatrixCL          A_;         ///< Galerkin operators
+    MLMatrixCL          AP_;        ///< A*P for each level
+    MLMatrixCL          Pt_;        ///< P^T for each level
+    std::vector<size_t> PVersion_;  ///< versions of the prolongations used for Pt_
+    const MatrixCL*     fineA_;     ///< finest matrix used for the last update
+    size_t              fineVersion_; ///< version of *fineA_ at the last update
+
+  public:
+    GalerkinHierarchyCL() : fineA_( 0), fineVersion_( 0) {}
+
+    /// \brief Compute the Galerkin operators for the finest matrix of A and the prolongations P
+    inline const MLMatrixCL& Update( const MLMatrixCL& A, const MLMatrixCL& P);
+    /// \brief Galerkin products need the prolongations as matrices
+    template <class ProlongationT>
+    const MLMatrixCL& Update( const MLMatrixCL&, const ProlongationT&)
+    { throw DROPSErrCL( "GalerkinHierarchyCL::Update: prolongations must be given as MLMatrixCL"); }
+
+    const MLMatrixCL& GetMatrices() const { return A_; }
+};
+
 /*******************************************************************
 *   M G S o l v e r  C L                                           *
 *******************************************************************/
@@ -88,6 +119,8 @@ class MGSolverCL : public SolverBaseCL
     const bool        residerr_;         ///< controls the error measuring: false : two-norm of dx, true: two-norm of residual
     Uint              smoothSteps_;      ///< number of smoothing steps
     int               usedLevels_;       ///< number of used levels (-1 = all)
+    bool              galerkin_;         ///< use Galerkin products P^T*A*P as coarse grid operators
+    GalerkinHierarchyCL galerkinA_;      ///< coarse grid operators, if galerkin_ is set
 
   public:
     /// constructor for MGSolverCL
@@ -101,15 +134,18 @@ class MGSolverCL : public SolverBaseCL
     MGSolverCL( const SmootherT& sm, DirectSolverT& ds, int maxiter,
                 double tol, const bool residerr= true, Uint smsteps= 1, int lvl= -1 )
         : SolverBaseCL(maxiter,tol), smoother_(sm), directSolver_(ds),
-          residerr_(residerr), smoothSteps_(smsteps), usedLevels_(lvl) {}
+          residerr_(residerr), smoothSteps_(smsteps), usedLevels_(lvl), galerkin_( false) {}
 
     ProlongationT* GetProlongation() { return &P; }
+    /// \brief Compute the coarse grid operators as P^T*A*P instead of using the assembled ones
+    void SetGalerkin( bool galerkin) { galerkin_= galerkin; }
+    bool GetGalerkin() const         { return galerkin_; }
     /// solve function: calls the MultiGrid-routine
     void Solve(const MLMatrixCL& A, VectorCL& x, const VectorCL& b)
     {
         _res=  _tol;
         _iter= _maxiter;
-        MG( A, P, smoother_, directSolver_, x, b, _iter, _res, residerr_, smoothSteps_, usedLevels_);
+        MG( galerkin_ ? galerkinA_.Update( A, P) : A, P, smoother_, directSolver_, x, b, _iter, _res, residerr_, smoothSteps_, usedLevels_);
     }
     void Solve(const MatrixCL&, VectorCL&, const VectorCL&)
     {
@@ -172,7 +208,18 @@ class DummySmootherCL
     problems. These local problems are solved via an schur method with
     different approximations of A^{-1} or via a LR decomposition
     Method from "A comparative study for efficient terative solvers for
-    generalized Stokes equations", Larin, Reusken. */
+    generalized Stokes equations", Larin, Reusken.
+
+    The index sets of the local problems (patches) are given by the rows of B.
+    For each pair of matrices A, B the local problems are factorized once and
+    stored packed in one array; they are set up again, if the version of A or
+    B or the method changes. The patches are colored, such that patches of
+    the same color do neither share velocity unknowns nor are coupled by A.
+    Thus, the patches of one color are smoothed in parallel by OpenMP and the
+    result does not depend on the number of threads. The colors are processed
+    one after another, i.e., the smoother is a multiplicative Schwarz method
+    with the patches ordered by color.
+    \pre The sparsity pattern of A is symmetric. */
 /*******************************************************************
 *   P V a n k a S m o o t h e r  C L                               *
 ********************************************************************/
@@ -181,16 +228,39 @@ class PVankaSmootherCL
   private:
     int vanka_method_;           ///< method for solving the local problems: 0, 3, 4: schur method with diagonal/Gauss-Seidel/symmetrical Gauss-Seidel approximation of A^{-1}, 2: LR decomposition of the local problems
     double tau_;                 ///< relaxation parameter
-    typedef std::vector<size_t>  NodeListVelT;
 
-    template <typename Mat>                 ///< constructs local saddle point matrix
-    DMatrixCL<double>  SetupLocalProblem (Uint id, NodeListVelT& NodeListVel, const Mat& A, const Mat& B) const;
-    template <typename Mat, typename Vec>
-    void DiagSmoother(Uint id, NodeListVelT& NodeListVel, const Mat& A, const Mat& B, Vec& v, size_t id2) const;
-    template <typename Mat, typename Vec>
-    void GSSmoother(Uint id, NodeListVelT& NodeListVel, const Mat& A, const Mat& B, Vec& v) const;
-    template <typename Mat, typename Vec>
-    void LRSmoother(Uint id, NodeListVelT& NodeListVel, const Mat& A, const Mat& B, Vec& v) const;
+    /// \brief Colored patches and factorized local problems for one pair of matrices A, B
+    struct PatchesT
+    {
+        const void*         A;          ///< matrix A, the local problems have been set up for
+        size_t              Annz,       ///< number of non-zeros of A
+                            Aversion,   ///< version of A
+                            Bversion,   ///< version of B
+                            numPatches, ///< number of patches
+                            maxDim;     ///< maximal number of velocity unknowns of a patch
+        int                 method;     ///< vanka_method_ used for the set up
+        const IdxDescCL*    p1x;        ///< extended pressure index or 0
+        std::vector<size_t> patch,      ///< patches sorted by color
+                            colorBeg,   ///< patches of color c are patch[colorBeg[c]], ..., patch[colorBeg[c+1]-1]
+                            dataBeg,    ///< begin of the packed local data of each patch in data
+                            pivot;      ///< pivots of the LR decompositions (method 2)
+        std::vector<double> data;       ///< packed local data, see SetupPatch_
+
+        PatchesT() : A( 0), Annz( 0), Aversion( 0), Bversion( 0), numPatches( 0), maxDim( 0), method( -1), p1x( 0) {}
+    };
+    typedef std::map<const void*, PatchesT> PatchMapT;
+    mutable PatchMapT patches_;  ///< local problems for each matrix B
+
+    template <typename Mat>                 ///< returns the up to date local problems for A, B
+    const PatchesT& GetPatches_ (const Mat& A, const Mat& B, const Mat& BT, const IdxDescCL* p1x) const;
+    template <typename Mat>                 ///< greedy coloring of the patches
+    void ColorPatches_ (PatchesT& P, const Mat& A, const Mat& B, const Mat& BT) const;
+    /// \brief number of doubles of the packed local data of a patch
+    inline size_t PatchDataSize_ (size_t dim, size_t id2) const;
+    template <typename Mat>                 ///< computes the packed local data of patch id
+    void SetupPatch_ (const PatchesT& P, size_t id, size_t id2, const Mat& A, const Mat& B, double* data, size_t* pivot) const;
+    template <typename Mat>                 ///< solves the local problem of patch id in place
+    void SolvePatch_ (const PatchesT& P, size_t id, size_t id2, const Mat& B, double* v) const;
 
     const MLIdxDescCL* idx_;   ///< If not zero, the standard- and the extended- pressure-dof in a vertex are treated as a block system (only for the DiagSmoother.
 
@@ -209,7 +279,14 @@ class PVankaSmootherCL
     void SetVankaMethod( int method) {vanka_method_ = method;}  ///< change the method for solving the local problems
     int  GetVankaMethod()            {return vanka_method_;}    ///< get the number of the method for solving the local problems
 
-    void Setidx (const MLIdxDescCL* idx) { idx_= idx; }
+    void Setidx (const MLIdxDescCL* idx) { idx_= idx; patches_.clear(); }
+    /// \brief Free the stored local problems, e.g., after the multigrid hierarchy has been rebuilt
+    void ClearPatches () { patches_.clear(); }
+    /// \brief Number of colors of the patches for the matrix B (0, if Apply has not been called for B)
+    size_t GetNumColors (const MatrixCL& B) const {
+        PatchMapT::const_iterator it= patches_.find( &B);
+        return it==patches_.end() ? 0 : it->second.colorBeg.size() - 1;
+    }
 };
 
 /*******************************************************************
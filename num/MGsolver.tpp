@@ -95,6 +95,48 @@ void MG(const MLMatrixCL& MGData, const ProlongationT& Prolong, const SmootherCL
     tol= resid;
 }
 
+inline const MLMatrixCL& GalerkinHierarchyCL::Update( const MLMatrixCL& A, const MLMatrixCL& P)
+{
+    Assert( A.size()==P.size(), DROPSErrCL("GalerkinHierarchyCL::Update: different number of levels"), DebugNumericC);
+    bool sameP= A_.size()==A.size() && PVersion_.size()==P.size();
+    MLMatrixCL::const_iterator p= P.begin();
+    for (Uint lvl= 0; sameP && p!=P.end(); ++lvl, ++p)
+        sameP= PVersion_[lvl]==p->Version();
+    if (sameP && fineA_==&A.GetFinest() && fineVersion_==A.GetFinest().Version())
+        return A_; // nothing has changed since the last update
+
+    const bool reuse= sameP && same_pattern( A_.GetFinest(), A.GetFinest());
+    if (!reuse) {
+        A_.resize( A.size());
+        AP_.resize( A.size());
+        Pt_.resize( A.size());
+        PVersion_.resize( P.size());
+        p= P.begin();
+        for (Uint lvl= 0; p!=P.end(); ++lvl, ++p)
+            PVersion_[lvl]= p->Version();
+    }
+
+    A_.GetFinest()= A.GetFinest();
+    MLMatrixCL::iterator fine= A_.GetFinestIter(), ap= AP_.GetFinestIter(), pt= Pt_.GetFinestIter();
+    p= P.GetFinestIter();
+    for (; fine!=A_.begin(); --fine, --ap, --pt, --p) {
+        MLMatrixCL::iterator coarse= fine;
+        --coarse;
+        if (reuse) {
+            ap->MatMulValues( *fine, *p);
+            coarse->MatMulValues( *pt, *ap);
+        }
+        else {
+            transpose( *p, *pt);
+            ap->MatMul( *fine, *p);
+            coarse->MatMul( *pt, *ap);
+        }
+    }
+    fineA_= &A.GetFinest();
+    fineVersion_= A.GetFinest().Version();
+    return A_;
+}
+
 template<class StokesSmootherCL, class StokesDirectSolverCL, class ProlongItT1, class ProlongItT2>
 void StokesMGM( const MLMatrixCL::const_iterator& beginA,  const MLMatrixCL::const_iterator& fineA,
                 const MLMatrixCL::const_iterator& fineB,   const MLMatrixCL::const_iterator& fineBT, 
@@ -157,26 +199,6 @@ void StokesMGM( const MLMatrixCL::const_iterator& beginA,  const MLMatrixCL::con
     }
 }
 
-// TODO effizenter implementieren (CRS-Struktur ausnutzen)
-template <typename Mat>
-DMatrixCL<double> PVankaSmootherCL::SetupLocalProblem (Uint id, NodeListVelT& NodeListVel, const Mat& A, const Mat& B) const
-{
-    const size_t dim = NodeListVel.size();
-    DMatrixCL<double> M(dim+1, dim+1);
-    for ( size_t i=0; i<dim; ++i )
-    {
-        const int irow = NodeListVel[i];
-        for ( size_t j=0; j<dim; ++j )
-        {
-            const int jcol = NodeListVel[j];
-            M(i,j) = A(irow,jcol);
-        }
-        M(i,dim) = M(dim,i) = B(id,irow);
-    }
-    M(dim,dim) = 0.0;
-    return M;
-}
-
 inline void
 Solve2x2 (const SMatrixCL<2,2>& A, double& x0, double& x1)
 {
@@ -186,217 +208,360 @@ Solve2x2 (const SMatrixCL<2,2>& A, double& x0, double& x1)
     x1= (A(0,0)*x1-A(1,0)*b0)/det;
 }
 
-template <typename Mat, typename Vec>
-void PVankaSmootherCL::DiagSmoother(Uint id, NodeListVelT& NodeListVel, const Mat& A, const Mat& B, Vec& v, size_t id2) const
+/// \brief LR decomposition with partial pivoting of the n x n matrix M, which is stored column by column; the row exchanges are stored in piv
+inline void
+FactorLR (double* M, size_t* piv, size_t n)
 {
-    const size_t dim = v.size() - (id2 == NoIdx ? 1 : 2);
-    Vec DiagA( dim);
-    Vec Block( dim);
-    Vec Block2( dim);
-
-   // Direct solver: constructing the local problem Mx=v
-    for (size_t i= 0; i < dim; ++i) {
-        const int irow = NodeListVel[i];
-        DiagA[i] = A( irow, irow);
+    for (size_t i=0; i<n; ++i) {
+        size_t ind_max= i;
+        for (size_t l=i+1; l<n; ++l)
+            if (std::fabs( M[i*n+l]) > std::fabs( M[i*n+ind_max]))
+                ind_max= l;
+        if (M[i*n+ind_max] == 0.0) throw DROPSErrCL("FactorLR: Matrix is singular.");
+        piv[i]= ind_max;
+        if (ind_max != i)
+            for (size_t k=0; k<n; ++k)
+                std::swap( M[k*n+i], M[k*n+ind_max]);
+        const double piv_inv= 1./M[i*n+i];
+        for (size_t j=i+1; j<n; ++j)
+            M[i*n+j]*= piv_inv;
+        for (size_t k=i+1; k<n; ++k)
+            for (size_t j=i+1; j<n; ++j)
+                M[k*n+j]-= M[i*n+j]*M[k*n+i];
     }
+}
 
-    const size_t n= B.row_beg( id + 1) - B.row_beg( id);
-    std::memcpy( Addr(Block), B.raw_val() + B.row_beg( id), n*sizeof(typename Vec::value_type));
-    if (id2 != NoIdx) { // copy the row for id2
-        const size_t* idbeg=  B.GetFirstCol( id);
-        const size_t* id2beg= B.GetFirstCol( id2);
-        const double* idvalbeg=  B.GetFirstVal( id);
-        const double* id2valbeg= B.GetFirstVal( id2);
-        for (size_t pos= 0; idbeg < B.GetFirstCol( id + 1); ++pos, ++idbeg, ++idvalbeg) {
-            if (*idbeg < *id2beg)
-                Block2[pos]= 0.;
-            else {
-                Block2[pos]= *id2valbeg++;
-                ++id2beg;
-            }
-        }
-    }
-    
-    // Solve Mx=v
-    if (id2 == NoIdx) {
-        double S=0.0;
-        for ( size_t i=0; i<dim; ++i ){
-            v[i] /= DiagA[i];
-            v[dim] -= Block[i]*v[i];
-            S += Block[i]*Block[i]/DiagA[i];
-        }
-        v[dim] /= -S;
-        for ( size_t i=0; i<dim; ++i )
-            v[i]-=v[dim]*Block[i]/DiagA[i];
+/// \brief Solves LRx=Pb in place for the factors computed by FactorLR
+inline void
+SolveLR (const double* M, const size_t* piv, double* x, size_t n)
+{
+    for (size_t i=0; i<n; ++i)
+        std::swap( x[i], x[piv[i]]);
+    for (size_t i=0; i<n; ++i) {
+        for (size_t j=i+1; j<n; ++j)
+            x[j]-= M[i*n+j]*x[i];
     }
-    else {
-        SMatrixCL<2,2> S;
-        for ( size_t i=0; i<dim; ++i ){
-            S( 0, 0) += Block[i]*Block[i]/DiagA[i];
-            S( 1, 0) += Block[i]*Block2[i]/DiagA[i];
-            S( 1, 1) += Block2[i]*Block2[i]/DiagA[i];
-        }
-        S( 0, 1)= S( 1, 0);
-        S*= -1.;
-        v[std::slice( 0, dim, 1)]/= DiagA;
-        v[dim]    -= dot( Block,  Vec( v[std::slice( 0, dim, 1)]));
-        v[dim + 1]-= dot( Block2, Vec( v[std::slice( 0, dim, 1)]));
-        Solve2x2( S, v[dim], v[dim + 1]);
-        for (size_t i= 0; i < dim; ++i)
-            v[i]-= (Block[i]*v[dim] + Block2[i]*v[dim + 1])/DiagA[i];
+    for (size_t i=n-1; i<n; --i) {
+        x[i]/= M[i*n+i];
+        for (size_t j=0; j<i; ++j)
+            x[j]-= M[i*n+j]*x[i];
     }
 }
 
-template <typename Mat, typename Vec>
-void GaussSeidel(const Mat& M, Vec& x, const Vec& rhs)
+/// \brief One Gauss-Seidel step with start value 0 for the n x n matrix M, which is stored column by column
+inline void
+GaussSeidel (const double* M, double* x, const double* rhs, size_t n)
 {
-    const size_t dim = rhs.size();
-    x = rhs;
-    for ( size_t i=0; i<dim; ++i )
-    {
-        for ( size_t j=0; j<i; ++j )
-            x[i]-=M(i,j)*x[j];
-        x[i]/=M(i,i);
+    for (size_t i=0; i<n; ++i) {
+        x[i]= rhs[i];
+        for (size_t j=0; j<i; ++j)
+            x[i]-= M[j*n+i]*x[j];
+        x[i]/= M[i*n+i];
     }
 }
 
-template <typename Mat, typename Vec>
-void SymmetricGaussSeidel(const Mat& M, Vec& x, const Vec& rhs)
+/// \brief One symmetric Gauss-Seidel step with start value 0 for the n x n matrix M, which is stored column by column
+inline void
+SymmetricGaussSeidel (const double* M, double* x, const double* rhs, size_t n)
 {
-    const size_t dim = rhs.size();
-    x = rhs;
-    for ( size_t i=0; i<dim; ++i )
-    {
-        for ( size_t j=0; j<i; ++j )
-            x[i]-=M(i,j)*x[j];
-        x[i]/=M(i,i);
-    }
-
-    double tmp=0.;
-    for ( size_t i=dim-1; i<dim; --i)
-    {
-        tmp=rhs[i];
-        for (size_t j=0; j<dim; ++j)
-            tmp-= M(i,j)*x[j];
-        x[i]+=tmp/M(i,i);
+    GaussSeidel( M, x, rhs, n);
+    for (size_t i=n-1; i<n; --i) {
+        double tmp= rhs[i];
+        for (size_t j=0; j<n; ++j)
+            tmp-= M[j*n+i]*x[j];
+        x[i]+= tmp/M[i*n+i];
     }
 }
 
-template <typename Mat, typename Vec>
-void Jacobi(const Mat& M, Vec& x, const Vec& rhs)
+/// The packed local data of a patch with dim velocity unknowns is
+/// - method 0: the inverse diagonal of A (dim), the extended row of B (dim, only with extended pressure) and the schur complement (1 or 3 entries)
+/// - method 2: the LR decomposition of the local saddle point matrix ((dim+1)^2)
+/// - method 3, 4: the local matrix A (dim^2), the approximation of A^{-1}B^T (dim) and the schur complement (1)
+inline size_t PVankaSmootherCL::PatchDataSize_ (size_t dim, size_t id2) const
 {
-    const size_t dim = rhs.size();
-    x = rhs;
-    for ( size_t i=0; i<dim; ++i )
-        x[i]/=M(i,i);
+    switch (vanka_method_) {
+        case 0:         return id2 == NoIdx ? dim + 1 : 2*dim + 3;
+        case 2:         return (dim + 1)*(dim + 1);
+        case 3: case 4: return dim*dim + dim + 1;
+    }
+    throw DROPSErrCL("PVankaSmootherCL: unknown method for the local problems");
 }
 
-
-// exact schur method with A^{-1} = one step (symmetric) Gauss Seidel
-template <typename Mat, typename Vec>
-void PVankaSmootherCL::GSSmoother(Uint id, NodeListVelT& NodeListVel, const Mat& A, const Mat& B, Vec& v) const
+template <typename Mat>
+void PVankaSmootherCL::SetupPatch_ (const PatchesT& P, size_t id, size_t id2, const Mat& A, const Mat& B, double* data, size_t* pivot) const
 {
-    const int dim = v.size() - 1;
-    DMatrixCL<double> M(SetupLocalProblem(id, NodeListVel, A, B));
-    Vec rhs (dim), x(dim), y(dim);
+    const size_t   dim=   B.row_beg( id + 1) - B.row_beg( id);
+    const size_t*  col=   B.raw_col() + B.row_beg( id);
+    const double*  Block= B.raw_val() + B.row_beg( id);
 
-    for ( int i=0; i<dim; ++i )
-        rhs[i]=M(i,dim);
-
-    //A*y=B^T
-    //Jacobi(M, y, rhs);
-    switch (vanka_method_)
-    {
-        case 3 : GaussSeidel(M, y, rhs);          break;
-        case 4 : SymmetricGaussSeidel(M, y, rhs); break;
+    if (P.method == 0) {
+        double* DiagInv= data;
+        for (size_t i= 0; i < dim; ++i)
+            DiagInv[i]= 1./A( col[i], col[i]);
+        if (id2 == NoIdx) {
+            double S= 0.0;
+            for (size_t i= 0; i < dim; ++i)
+                S+= Block[i]*Block[i]*DiagInv[i];
+            data[dim]= S;
+        }
+        else { // copy the row for id2
+            double* Block2= data + dim;
+            const size_t* id2beg= B.GetFirstCol( id2);
+            const double* id2valbeg= B.GetFirstVal( id2);
+            for (size_t i= 0; i < dim; ++i) {
+                if (id2beg == B.GetFirstCol( id2 + 1) || col[i] < *id2beg)
+                    Block2[i]= 0.;
+                else {
+                    Block2[i]= *id2valbeg++;
+                    ++id2beg;
+                }
+            }
+            double* S= data + 2*dim;
+            S[0]= S[1]= S[2]= 0.;
+            for (size_t i= 0; i < dim; ++i) {
+                S[0]-= Block[i]*Block[i]*DiagInv[i];
+                S[1]-= Block[i]*Block2[i]*DiagInv[i];
+                S[2]-= Block2[i]*Block2[i]*DiagInv[i];
+            }
+        }
+        return;
     }
 
-    double schur=0.0;
-    for ( int i=0; i<dim; ++i )
-        schur += M(dim,i)*y[i];
+    // local matrix A: merge the sorted rows of A with the sorted column indices of the patch
+    const size_t n= P.method == 2 ? dim + 1 : dim;
+    std::fill( data, data + n*n, 0.);
+    for (size_t i= 0; i < dim; ++i) {
+        const size_t* acol= A.GetFirstCol( col[i]);
+        const size_t* aend= A.GetFirstCol( col[i] + 1);
+        const double* aval= A.GetFirstVal( col[i]);
+        for (size_t j= 0; j < dim && acol != aend; )
+            if (*acol < col[j]) { ++acol; ++aval; }
+            else if (col[j] < *acol) ++j;
+            else { data[j*n+i]= *aval; ++j; ++acol; ++aval; }
+    }
 
-    for ( int i=0; i<dim; ++i )
-        rhs[i]=v[i];
+    if (P.method == 2) {
+        for (size_t i= 0; i < dim; ++i)
+            data[dim*n+i]= data[i*n+dim]= Block[i];
+        data[dim*n+dim]= 0.0;
+        FactorLR( data, pivot, n);
+    }
+    else {
+        // A*y=B^T
+        double* y= data + dim*dim;
+        if (P.method == 3) GaussSeidel( data, y, Block, dim);
+        else               SymmetricGaussSeidel( data, y, Block, dim);
+        double schur= 0.0;
+        for (size_t i= 0; i < dim; ++i)
+            schur+= Block[i]*y[i];
+        y[dim]= schur;
+    }
+}
 
-    //Jacobi(M, x, rhs);
-    switch (vanka_method_)
-    {
-        case 3 : GaussSeidel(M, x, rhs);          break;
-        case 4 : SymmetricGaussSeidel(M, x, rhs); break;
+template <typename Mat>
+void PVankaSmootherCL::SolvePatch_ (const PatchesT& P, size_t id, size_t id2, const Mat& B, double* v) const
+{
+    const size_t   dim=   B.row_beg( id + 1) - B.row_beg( id);
+    const double*  Block= B.raw_val() + B.row_beg( id);
+    const double*  data=  Addr( P.data) + P.dataBeg[id];
+
+    switch (P.method) {
+      case 0: {
+        const double* DiagInv= data;
+        if (id2 == NoIdx) {
+            for (size_t i= 0; i < dim; ++i) {
+                v[i]*= DiagInv[i];
+                v[dim]-= Block[i]*v[i];
+            }
+            v[dim]/= -data[dim];
+            for (size_t i= 0; i < dim; ++i)
+                v[i]-= v[dim]*Block[i]*DiagInv[i];
+        }
+        else {
+            const double* Block2= data + dim;
+            SMatrixCL<2,2> S;
+            S( 0, 0)= data[2*dim];
+            S( 1, 0)= S( 0, 1)= data[2*dim + 1];
+            S( 1, 1)= data[2*dim + 2];
+            for (size_t i= 0; i < dim; ++i) {
+                v[i]*= DiagInv[i];
+                v[dim]    -= Block[i]*v[i];
+                v[dim + 1]-= Block2[i]*v[i];
+            }
+            Solve2x2( S, v[dim], v[dim + 1]);
+            for (size_t i= 0; i < dim; ++i)
+                v[i]-= (Block[i]*v[dim] + Block2[i]*v[dim + 1])*DiagInv[i];
+        }
+      } break;
+      case 2: {
+        SolveLR( data, Addr( P.pivot) + B.row_beg( id) + id, v, dim + 1);
+      } break;
+      case 3: case 4: {
+        const double* y= data + dim*dim;
+        double* x= v + dim + 1;
+        if (P.method == 3) GaussSeidel( data, x, v, dim);
+        else               SymmetricGaussSeidel( data, x, v, dim);
+        double rhsd= 0.0;
+        for (size_t i= 0; i < dim; ++i)
+            rhsd+= Block[i]*x[i];
+        rhsd-= v[dim];
+        v[dim]= rhsd/y[dim];
+        for (size_t i= 0; i < dim; ++i)
+            v[i]= x[i] - v[dim]*y[i];
+      } break;
     }
+}
 
-    double rhsd=0.0;
-    for ( int i=0; i<dim; ++i )
-        rhsd += M(dim,i)*x[i];
-    rhsd -= v[dim];
-    v[dim] = rhsd/schur;
+/// Two patches p, q conflict, if the unknowns of q are coupled by A with the
+/// unknowns of p. For each patch the colors of the conflicting patches, which
+/// have been colored before, are marked and the smallest free color is chosen.
+template <typename Mat>
+void PVankaSmootherCL::ColorPatches_ (PatchesT& P, const Mat& A, const Mat& B, const Mat& BT) const
+{
+    std::vector<size_t> patchOf( B.num_rows(), NoIdx);
+    for (size_t id= 0; id < P.numPatches; ++id) {
+        patchOf[id]= id;
+        if (P.p1x)
+            patchOf[P.p1x->GetXidx()[id]]= id;
+    }
 
-    for ( int i=0; i<dim; ++i )
-        v[i]=x[i]-v[dim]*y[i];//M(i,dim);
+    std::vector<size_t> color( P.numPatches), colorSize,
+                        stamp( A.num_cols(), NoIdx), // velocity unknowns, that have been visited for the current patch
+                        mark;                        // colors, that are forbidden for the current patch
+    for (size_t id= 0; id < P.numPatches; ++id) {
+        const size_t rows[2]= { id, P.p1x ? P.p1x->GetXidx()[id] : NoIdx };
+        for (size_t r= 0; r < 2 && rows[r] != NoIdx; ++r)
+            for (const size_t* u= B.GetFirstCol( rows[r]); u != B.GetFirstCol( rows[r] + 1); ++u)
+                for (const size_t* t= A.GetFirstCol( *u); t != A.GetFirstCol( *u + 1); ++t) {
+                    if (stamp[*t] == id) continue;
+                    stamp[*t]= id;
+                    for (const size_t* q= BT.GetFirstCol( *t); q != BT.GetFirstCol( *t + 1); ++q)
+                        if (patchOf[*q] < id)
+                            mark[color[patchOf[*q]]]= id;
+                }
+        size_t c= 0;
+        while (c < mark.size() && mark[c] == id) ++c;
+        if (c == mark.size()) {
+            mark.push_back( NoIdx);
+            colorSize.push_back( 0);
+        }
+        color[id]= c;
+        ++colorSize[c];
+    }
 
+    P.colorBeg.assign( colorSize.size() + 1, 0);
+    for (size_t c= 0; c < colorSize.size(); ++c)
+        P.colorBeg[c + 1]= P.colorBeg[c] + colorSize[c];
+    P.patch.resize( P.numPatches);
+    std::vector<size_t> pos( P.colorBeg.begin(), P.colorBeg.end() - 1);
+    for (size_t id= 0; id < P.numPatches; ++id)
+        P.patch[pos[color[id]]++]= id;
 }
 
-template <typename Mat, typename Vec>
-void PVankaSmootherCL::LRSmoother(Uint id, NodeListVelT& NodeListVel, const Mat& A, const Mat& B, Vec& v) const
+template <typename Mat>
+const PVankaSmootherCL::PatchesT&
+PVankaSmootherCL::GetPatches_ (const Mat& A, const Mat& B, const Mat& BT, const IdxDescCL* p1x) const
 {
-    DMatrixCL<double> M(SetupLocalProblem(id, NodeListVel, A, B));
-    gauss_pivot (M, v);
+    PatchesT& P= patches_[&B];
+    if (P.A == &A && P.Aversion == A.Version() && P.Bversion == B.Version() && P.method == vanka_method_ && P.p1x == p1x)
+        return P;
+
+    // the coloring only depends on the sparsity patterns
+    const bool newPattern= P.A != &A || P.Annz != A.num_nonzeros() || P.Bversion != B.Version() || P.p1x != p1x || P.colorBeg.empty();
+    if (vanka_method_ != 0 && p1x)
+        throw DROPSErrCL("PVankaSmootherCL: extended pressure is only supported by the diagonal method (0)");
+    P.A= &A;
+    P.Annz= A.num_nonzeros();
+    P.Aversion= A.Version();
+    P.Bversion= B.Version();
+    P.method= vanka_method_;
+    P.p1x= p1x;
+    P.numPatches= p1x ? p1x->GetXidx().GetNumUnknownsStdFE() : B.num_rows();
+    if (newPattern)
+        ColorPatches_( P, A, B, BT);
+
+    P.maxDim= 0;
+    P.dataBeg.resize( P.numPatches + 1);
+    P.dataBeg[0]= 0;
+    for (size_t id= 0; id < P.numPatches; ++id) {
+        const size_t dim= B.row_beg( id + 1) - B.row_beg( id);
+        P.maxDim= std::max( P.maxDim, dim);
+        P.dataBeg[id + 1]= P.dataBeg[id] + PatchDataSize_( dim, p1x ? p1x->GetXidx()[id] : NoIdx);
+    }
+    P.data.resize( P.dataBeg[P.numPatches]);
+    P.pivot.resize( P.method == 2 ? B.row_beg( P.numPatches) + P.numPatches : 0);
+
+    // exceptions must not leave the parallel region
+    bool singular= false;
+#ifndef DROPS_WIN
+    size_t id;
+#else
+    int id;
+#endif
+#   pragma omp parallel for reduction(||: singular)
+    for (id= 0; id < P.numPatches; ++id) {
+        try {
+            SetupPatch_( P, id, p1x ? p1x->GetXidx()[id] : NoIdx, A, B, Addr( P.data) + P.dataBeg[id],
+                         P.method == 2 ? Addr( P.pivot) + B.row_beg( id) + id : 0);
+        } catch (DROPSErrCL&) {
+            singular= true;
+        }
+    }
+    if (singular) {
+        P.method= -1;
+        throw DROPSErrCL("PVankaSmootherCL: singular local problem");
+    }
+    return P;
 }
 
 template <typename Mat, typename Vec>
 void
 PVankaSmootherCL::Apply(const Mat& A, const Mat& B, const Mat& BT, const Mat&, Vec& x, Vec& y, const Vec& f, const Vec& g) const
 {
-    NodeListVelT NodeListVel;
-    NodeListVel.reserve(200);
-    size_t dim;
     const IdxDescCL* p1x= 0;
     if (idx_)
         for (MLIdxDescCL::const_iterator it= idx_->begin(); it != idx_->end(); ++it)
             if (it->IsExtended() && it->NumUnknowns() == g.size())
                 p1x= &*it;
+    const PatchesT& P= GetPatches_( A, B, BT, p1x);
 
-    // Cycle by pressure variables
-    for (size_t id= 0; (!p1x && id < g.size()) || (p1x && id < p1x->GetXidx().GetNumUnknownsStdFE()); ++id ) {
-        size_t id2( p1x ? p1x->GetXidx()[id] : NoIdx); // possible extended pressure unknown
-
-        dim = B.row_beg(id+1) - B.row_beg(id);
-        Vec v(dim + (id2 == NoIdx ? 1 : 2));
-
-        NodeListVel.resize( dim);
-
-        // copy column indices of nonzeros from row id of B to NodeListVel
-        std::memcpy( &NodeListVel[0], B.raw_col() + B.row_beg( id), dim*sizeof(size_t));
-
-        // v = resid of (A & B^T \\ B & 0) * (x \\ y) - (f \\ g) for the rows NodeListVel, id
-        for ( size_t i=0; i<dim; ++i ) {
-            const int irow = NodeListVel[i];
-            v[i]= mul_row( A, x, irow) + mul_row( BT, y, irow) - f[irow];
-        }
-        v[dim]= mul_row( B, x, id) - g[id];
-        if (id2!=NoIdx)
-            v[dim +  1]= mul_row( B, x, id2) - g[id2];
-            
-        // smoothing
-        switch (vanka_method_) {
-            case 0 : {
-                DiagSmoother(id, NodeListVel, A, B, v, id2);
-            } break;
-            case 2: {
-                LRSmoother  (id, NodeListVel, A, B, v);
-            } break;
-            case 3: case 4 : {
-                GSSmoother  (id, NodeListVel, A, B, v);
-            } break;
-        }
-
-        // Cycle by local unknowns: correction of the approximation x
-        for (size_t i= 0; i < dim; ++i) {
-            x[NodeListVel[i]]-= tau_ * v[i];
+#   pragma omp parallel
+    {
+        // v: local residual and correction, v[dim+1, ..., 2*dim] is used as workspace by methods 3, 4
+        std::vector<double> v( 2*P.maxDim + 2);
+        for (size_t c= 0; c + 1 < P.colorBeg.size(); ++c) {
+#ifndef DROPS_WIN
+            size_t k;
+#else
+            int k;
+#endif
+#           pragma omp for
+            for (k= P.colorBeg[c]; k < P.colorBeg[c + 1]; ++k) {
+                const size_t id= P.patch[k];
+                const size_t id2( p1x ? p1x->GetXidx()[id] : NoIdx); // possible extended pressure unknown
+                const size_t dim= B.row_beg( id + 1) - B.row_beg( id);
+                const size_t* NodeListVel= B.raw_col() + B.row_beg( id);
+
+                // v = resid of (A & B^T \\ B & 0) * (x \\ y) - (f \\ g) for the rows NodeListVel, id
+                for (size_t i= 0; i < dim; ++i) {
+                    const size_t irow= NodeListVel[i];
+                    v[i]= mul_row( A, x, irow) + mul_row( BT, y, irow) - f[irow];
+                }
+                v[dim]= mul_row( B, x, id) - g[id];
+                if (id2 != NoIdx)
+                    v[dim + 1]= mul_row( B, x, id2) - g[id2];
+
+                // smoothing
+                SolvePatch_( P, id, id2, B, Addr( v));
+
+                // Cycle by local unknowns: correction of the approximation x
+                for (size_t i= 0; i < dim; ++i)
+                    x[NodeListVel[i]]-= tau_ * v[i];
+                y[id]-= tau_ * v[dim];
+                if (id2 != NoIdx)
+                    y[id2]-= tau_ * v[dim + 1];
+            }
         }
-        y[id]-= tau_ * v[dim];
-        if (id2 != NoIdx)
-            y[id2]-= tau_ * v[dim + 1];
     }
 }
 
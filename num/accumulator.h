@@ -26,8 +26,10 @@
 #define DROPS_ACCUMULATOR_H
 
 #include "../geom/multigrid.h"
+#include "misc/profiler.h"
 
 #include <vector>
+#include <numeric>
 #include <functional>
 #include <algorithm>
 
@@ -61,6 +63,59 @@ class AccumulatorCL
 typedef AccumulatorCL<TetraCL> TetraAccumulatorCL;
 
 
+/// \brief Measured cost (time in seconds) of visiting each object of a triangulation by the accumulators.
+///
+/// The costs are stored in a flat array indexed by the position of the object in the triangulation of the
+/// last level of the multigrid; accumulations on other levels are not recorded. An AccumulatorTupleCL
+/// records into a VisitCostCL only if it has been registered with AccumulatorTupleCL::set_cost_recorder.
+/// The costs are summed up over all recorded accumulations and are reset, if the version of the multigrid
+/// changes, i.e. after each refinement or migration.
+template <class VisitedT>
+class VisitCostCL
+{
+  private:
+    std::vector<double> cost_;
+    size_t version_;    ///< version of the multigrid, for which cost_ has been recorded
+
+  public:
+    VisitCostCL () : version_( 0) {}
+
+    /// \brief Prepare the recording of an accumulation on level lvl of mg; returns false, if it is not to be recorded.
+    inline bool prepare (const MultiGridCL& mg, int lvl);
+    /// \brief True, if the costs have been recorded on the last level of mg in its current version.
+    bool valid (const MultiGridCL& mg) const {
+        return version_ == mg.GetVersion() && !cost_.empty()
+            && cost_.size() == static_cast<size_t>( std::distance( mg.GetTriangTetraBegin(), mg.GetTriangTetraEnd()));
+    }
+
+    /// \brief Add the cost c to the object at position i of the triangulation; the objects are distinct for different threads.
+    void   add (size_t i, double c) { cost_[i]+= c; }
+    /// \brief Measured cost of the object at position i of the triangulation.
+    double operator[] (size_t i) const { return cost_[i]; }
+    /// \brief Sum of all recorded costs.
+    double sum  () const { return std::accumulate( cost_.begin(), cost_.end(), 0.); }
+    /// \brief Number of objects in the recorded triangulation.
+    size_t size () const { return cost_.size(); }
+    bool   empty() const { return cost_.empty(); }
+    void   clear() { cost_.clear(); }
+};
+
+template <class VisitedT>
+inline bool VisitCostCL<VisitedT>::prepare (const MultiGridCL& mg, int lvl)
+{
+    if (lvl >= 0 && static_cast<Uint>( lvl) != mg.GetLastLevel())
+        return false;
+    if (!valid( mg)) {
+        cost_.assign( std::distance( mg.GetTriangTetraBegin(), mg.GetTriangTetraEnd()), 0.);
+        version_= mg.GetVersion();
+    }
+    return true;
+}
+
+/// \brief Measured cost of visiting TetraCL.
+typedef VisitCostCL<TetraCL> TetraCostCL;
+
+
 /// \brief A tuple of accumulators plus the iteration logic.
 ///
 /// The accumulators are stored via pointers to AccumulatorCL.
@@ -78,6 +133,9 @@ class AccumulatorTupleCL
     ContainerT accus_;          ///< the individual accumulators
     ContainerT deletion_cache_; ///< These accumulators are deleted by the destructor.
 
+    VisitCostCL<VisitedT>* cost_;   ///< if not 0, the time spent in visit is recorded here for each object
+    bool record_;                   ///< true, if the current accumulation is recorded in cost_
+
     /// \brief Calls begin_iteration for each accumulator before the iteration.
     inline void begin_iteration ();
     /// \brief Calls finalize_iteration for each accumulator after the iteration.
@@ -89,6 +147,7 @@ class AccumulatorTupleCL
     void delete_clones(std::vector<ContainerT>& clones);
 
   public:
+    AccumulatorTupleCL () : cost_( 0), record_( false) {}
     /// \brief Deletes the objects in deletion_cache_.
     ~AccumulatorTupleCL ();
 
@@ -102,6 +161,12 @@ class AccumulatorTupleCL
     void operator() (ExternalIteratorCL begin, ExternalIteratorCL end);
     /// \brief Calls the accumulators for each object by using a ColorClassesCL.
     void operator() (const ColorClassesCL& colors);
+
+    /// \brief Record the time spent in the accumulators for each visited object in c; c==0 turns the recording off.
+    void set_cost_recorder (VisitCostCL<VisitedT>* c) { cost_= c; }
+    VisitCostCL<VisitedT>* get_cost_recorder () const { return cost_; }
+    /// \brief Called by accumulate: the next accumulation visits the triangulation of level lvl of mg.
+    void prepare_recording (const MultiGridCL& mg, int lvl) { record_= cost_ != 0 && cost_->prepare( mg, lvl); }
 };
 
 template <class VisitedT>
@@ -145,15 +210,28 @@ template<class VisitedT>
 template <class ExternalIteratorCL>
 void AccumulatorTupleCL<VisitedT>::operator() (ExternalIteratorCL begin, ExternalIteratorCL end)
 {
+    DROPS_PROFILE_REGION("AccumulatorTupleCL");
     begin_iteration();
-    for ( ; begin != end; ++begin)
-        std::for_each( accus_.begin(), accus_.end(), std::bind2nd( std::mem_fun( &AccumulatorCL<VisitedT>::visit), *begin));
+    if (!record_)
+        for ( ; begin != end; ++begin)
+            std::for_each( accus_.begin(), accus_.end(), std::bind2nd( std::mem_fun( &AccumulatorCL<VisitedT>::visit), *begin));
+    else {
+        TimerCL timer;
+        for (size_t i= 0; begin != end; ++begin, ++i) {
+            timer.Reset();
+            std::for_each( accus_.begin(), accus_.end(), std::bind2nd( std::mem_fun( &AccumulatorCL<VisitedT>::visit), *begin));
+            timer.Stop();
+            cost_->add( i, timer.GetTime());
+        }
+    }
+    record_= false;
     finalize_iteration();
 }
 
 template<class VisitedT>
 void AccumulatorTupleCL<VisitedT>::operator() (const ColorClassesCL& colors)
 {
+    DROPS_PROFILE_REGION("AccumulatorTupleCL");
     begin_iteration();
 
     std::vector<ContainerT> clones( omp_get_max_threads());
@@ -161,18 +239,29 @@ void AccumulatorTupleCL<VisitedT>::operator() (const ColorClassesCL& colors)
     for (ColorClassesCL::const_iterator cit= colors.begin(); cit != colors.end() ;++cit) {
 #       pragma omp parallel
         {
+            DROPS_PROFILE_REGION("color class");
             const int t_id= omp_get_thread_num();
             const ColorClassesCL::ColorClassT& cc= *cit;
+            const ColorClassesCL::PositionT& pos= colors.positions( cit);
+            TimerCL timer;
 #ifndef DROPS_WIN
             size_t j;
 #else
             int j;
 #endif
 #           pragma omp for schedule(dynamic)
-            for (j= 0; j < cc.size(); ++j)
+            for (j= 0; j < cc.size(); ++j) {
+                if (record_)
+                    timer.Reset();
                 std::for_each( clones[t_id].begin(), clones[t_id].end(), std::bind2nd( std::mem_fun( &AccumulatorCL<VisitedT>::visit), *cc[j]));
+                if (record_) {
+                    timer.Stop();
+                    cost_->add( pos[j], timer.GetTime());
+                }
+            }
         }
     }
+    record_= false;
     delete_clones(clones);
 
     finalize_iteration();
@@ -200,6 +289,7 @@ struct do_accumulateCL<AccumulatorTupleCL<VisitedT> >
 {
     static void accumulate (AccumulatorTupleCL<VisitedT>& accu, const MultiGridCL& mg, int lvl, match_fun match, const BndCondCL& Bnd)
     {
+        accu.prepare_recording( mg, lvl);
         if (omp_get_max_threads() > 1)
             accu( mg.GetColorClasses( lvl, match, Bnd));
         else
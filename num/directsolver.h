@@ -26,6 +26,7 @@
 #define DROPS_DIRECTSOLVER_H
 
 #include "num/spmat.h"
+#include <algorithm>
 #include "cholmod.h"
 #include "umfpack.h"
 
@@ -51,13 +52,22 @@ private:
             *Ait;                        ///< matrix A column pointer
     double  *Axt;                        ///< matrix A nonzeros
     size_t  num_rows_,                   ///< # rows
-            num_cols_;                   ///< # columns
+            num_cols_,                   ///< # columns
+            nnz_;                        ///< # nonzeros
+
+    /// true, if A has the pattern of the stored matrix
+    bool SamePattern_(const MatrixCL& A) const
+    {
+        return Symbolic_ != 0 && A.num_rows() == num_rows_ && A.num_cols() == num_cols_ && A.num_nonzeros() == nnz_
+            && std::equal(A.raw_row(), A.raw_row()+A.num_rows()+1, Apt)
+            && std::equal(A.raw_col(), A.raw_col()+A.num_nonzeros(), Ait);
+    }
 
 public:
 
 /// store and factorize the matrix A
 DirectNonSymmSolverCL(const MatrixCL& A)
-: Apt(0), Ait(0), Axt(0)
+: Symbolic_(0), Numeric_(0), Apt(0), Ait(0), Axt(0), num_rows_(0), num_cols_(0), nnz_(0)
 {
     // get the default control parameters
     umfpack_dl_defaults(Control_);
@@ -82,40 +92,47 @@ DirectNonSymmSolverCL(const MatrixCL& A)
     umfpack_dl_free_symbolic (&Symbolic_);
     umfpack_dl_free_numeric (&Numeric_);
 }
-/// delete stored matrix and store/factorize the matrix A
+/// store/factorize the matrix A; the symbolic factorization is kept, if the pattern of A is unchanged
 void Update(const MatrixCL& A)
 {
     int status;
 
-    delete [] Apt;
-    delete [] Ait;
-    delete [] Axt;
-
-    Apt = new UF_long [A.num_rows()+1];
-    Ait = new UF_long [A.num_nonzeros()];
-    Axt = new double  [A.num_nonzeros()];
-
-    std::copy(A.raw_col(), A.raw_col()+A.num_nonzeros(), Ait);
-    std::copy(A.raw_row(), A.raw_row()+A.num_rows()+1  , Apt);
-    std::copy(A.raw_val(), A.raw_val()+A.num_nonzeros(), Axt);
-
-    //print the matrix
-    umfpack_dl_report_matrix (A.num_rows(), A.num_cols(), Apt, Ait, Axt, 1, Control_);
-
-    // symbolic factorization
-    status = umfpack_dl_symbolic (A.num_rows(), A.num_cols(), Apt, Ait, Axt, &Symbolic_, Control_, Info_) ;
-    if (status < 0)
+    if (!SamePattern_(A))
     {
-        Control_ [UMFPACK_PRL] = 6;
-        umfpack_dl_report_info   (Control_, Info_);
-        umfpack_dl_report_status (Control_, status);
-        throw DROPSErrCL("umfpack_dl_symbolic failed");
+        delete [] Apt;
+        delete [] Ait;
+        delete [] Axt;
+        umfpack_dl_free_symbolic (&Symbolic_);
+
+        Apt = new UF_long [A.num_rows()+1];
+        Ait = new UF_long [A.num_nonzeros()];
+        Axt = new double  [A.num_nonzeros()];
+
+        std::copy(A.raw_col(), A.raw_col()+A.num_nonzeros(), Ait);
+        std::copy(A.raw_row(), A.raw_row()+A.num_rows()+1  , Apt);
+        std::copy(A.raw_val(), A.raw_val()+A.num_nonzeros(), Axt);
+
+        //print the matrix
+        umfpack_dl_report_matrix (A.num_rows(), A.num_cols(), Apt, Ait, Axt, 1, Control_);
+
+        // symbolic factorization
+        status = umfpack_dl_symbolic (A.num_rows(), A.num_cols(), Apt, Ait, Axt, &Symbolic_, Control_, Info_) ;
+        if (status < 0)
+        {
+            Control_ [UMFPACK_PRL] = 6;
+            umfpack_dl_report_info   (Control_, Info_);
+            umfpack_dl_report_status (Control_, status);
+            throw DROPSErrCL("umfpack_dl_symbolic failed");
+        }
+
+        //print the symbolic factorization
+        umfpack_dl_report_symbolic (Symbolic_, Control_);
     }
-
-    //print the symbolic factorization
-    umfpack_dl_report_symbolic (Symbolic_, Control_);
+    else // only the values have changed
+        std::copy(A.raw_val(), A.raw_val()+A.num_nonzeros(), Axt);
 
     // numeric factorization
+    umfpack_dl_free_numeric (&Numeric_);
     status = umfpack_dl_numeric (Apt, Ait, Axt, Symbolic_, &Numeric_, Control_, Info_);
     if (status < 0)
     {
@@ -130,6 +147,7 @@ void Update(const MatrixCL& A)
 
     num_cols_ = A.num_cols();
     num_rows_ = A.num_rows();
+    nnz_      = A.num_nonzeros();
 }
 
 /// solve Ax=b, NOTE: DROPS::CRS, UMFPACK: CCS
@@ -177,16 +195,25 @@ A_(0), L_(0)
     Update(A);
 }
 
-/// delete stored matrix and store/factorize the matrix A
+/// store/factorize the matrix A; the symbolic analysis is kept, if the pattern of A is unchanged
 void Update(const MatrixCL& A)
 {
-    cholmod_l_free_sparse (&A_, &c_);
-    A_= cholmod_l_allocate_sparse (A.num_rows(), A.num_cols(), A.num_nonzeros(), /*sorted*/ true,
-           /*packed*/ true, /*upper left block used*/ 1, /*pattern*/ CHOLMOD_REAL, &c_);
+    const bool samePattern= A_ != 0 && L_ != 0 && A.num_rows() == A_->nrow && A.num_cols() == A_->ncol
+        && A.num_nonzeros() == A_->nzmax
+        && std::equal(A.raw_row(), A.raw_row()+A.num_rows()+1  , static_cast<size_t *>(A_->p))
+        && std::equal(A.raw_col(), A.raw_col()+A.num_nonzeros(), static_cast<size_t *>(A_->i));
 
-    // MatrixCL -> cholmod_sparse
-    std::copy(A.raw_col(), A.raw_col()+A.num_nonzeros(), static_cast<size_t *>(A_->i));
-    std::copy(A.raw_row(), A.raw_row()+A.num_rows()+1  , static_cast<size_t *>(A_->p));
+    if (!samePattern)
+    {
+        cholmod_l_free_sparse (&A_, &c_);
+        cholmod_l_free_factor (&L_, &c_);
+        A_= cholmod_l_allocate_sparse (A.num_rows(), A.num_cols(), A.num_nonzeros(), /*sorted*/ true,
+               /*packed*/ true, /*upper left block used*/ 1, /*pattern*/ CHOLMOD_REAL, &c_);
+
+        // MatrixCL -> cholmod_sparse
+        std::copy(A.raw_col(), A.raw_col()+A.num_nonzeros(), static_cast<size_t *>(A_->i));
+        std::copy(A.raw_row(), A.raw_row()+A.num_rows()+1  , static_cast<size_t *>(A_->p));
+    }
     std::copy(A.raw_val(), A.raw_val()+A.num_nonzeros(), static_cast<double *>(A_->x));
 
    //check A
@@ -194,7 +221,9 @@ void Update(const MatrixCL& A)
 //    char dummy[]= "A";
 //    cholmod_print_sparse (A_, dummy, &c_);
 
-    L_ = cholmod_l_analyze (A_, &c_);
+    if (!samePattern)
+        L_ = cholmod_l_analyze (A_, &c_);
+    // numeric factorization with the symbolic analysis stored in L_
     cholmod_l_factorize (A_, L_, &c_);
 }
 
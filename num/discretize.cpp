@@ -123,6 +123,7 @@ const double Quad3DataCL::Weight[5]= {
 };
 
 std::valarray<double> Quad3DataCL::P2_Val[10]; // P2_Val[i] contains FE_P2CL::H_i( Node).
+P2ShapeTableCL Quad3DataCL::P2_Table;
 
 Quad3DataCL::Quad3DataCL()
 {
@@ -135,6 +136,7 @@ Quad3DataCL::Quad3DataCL()
     Node[4]= MakeBaryCoord( B,A,A,A);
 
     FE_P2CL::ApplyAll( NumNodesC, Node, P2_Val);
+    P2_Table= P2ShapeTableCL( NumNodesC, Node);
 }
 
 BaryCoordCL* Quad3DataCL::TransformNodes (const SArrayCL<BaryCoordCL,4>& M, BaryCoordCL* p)
@@ -181,6 +183,7 @@ const double Quad5DataCL::Weight[NumNodesC]= {
 };
 
 std::valarray<double> Quad5DataCL::P2_Val[10]; // P2_Val[i] contains FE_P2CL::H_i( Node).
+P2ShapeTableCL Quad5DataCL::P2_Table;
 
 Quad5DataCL::Quad5DataCL()
 {
@@ -207,6 +210,7 @@ Quad5DataCL::Quad5DataCL()
     Node[14]= MakeBaryCoord( B3,B3,A3,A3);
 
     FE_P2CL::ApplyAll( NumNodesC, Node, P2_Val);
+    P2_Table= P2ShapeTableCL( NumNodesC, Node);
 }
 
 BaryCoordCL*
@@ -571,6 +571,7 @@ class Quad3DataCL
     static const double          Wght[2];         ///< quadrature weights
     static const double          Weight[NumNodesC];///< quadrature weight for each node
     static std::valarray<double> P2_Val[10];      ///< P2_Val[i] contains FE_P2CL::H_i( Node).
+    static P2ShapeTableCL        P2_Table;        ///< P2_Table.row( i) contains FE_P2CL::H_i( Node); used for the batched evaluation of P2-functions.
 
     /// \param M contains the barycentric coordinates of a tetrahedron;
     /// \param p array to be used for the quadrature points for this tetrahedron.
@@ -655,6 +656,7 @@ class Quad5DataCL
     static const double          Wght[4];         ///< quadrature weights
     static const double          Weight[NumNodesC];///< quadrature weight for each node
     static std::valarray<double> P2_Val[10];      ///< P2_Val[i] contains FE_P2CL::H_i( Node).
+    static P2ShapeTableCL        P2_Table;        ///< P2_Table.row( i) contains FE_P2CL::H_i( Node); used for the batched evaluation of P2-functions.
 
     /// \param M contains the barycentric coordinates of a tetrahedron;
     /// \param p array to be used for the quadrature points for this tetrahedron.
@@ -429,9 +429,7 @@ template<class T>
   inline Quad3CL<T>&
   Quad3CL<T>::assign(const LocalP2CL<value_type>& f)
 {
-    (*this)= f[0]*static_cast<GridFunctionCL<double> >( Quad3DataCL::P2_Val[0]);
-    for (size_t i= 1; i < 10; ++i)
-        (*this)+= f[i]*static_cast<GridFunctionCL<double> >( Quad3DataCL::P2_Val[i]);
+    Quad3DataCL::P2_Table.evaluate<value_type>( f, Addr( *this));
     return *this;
 }
 
@@ -451,10 +449,7 @@ template<class T>
 {
     value_type dof[10];
     f.GetDoF( s, dof);
-    (*this)= T();
-    for (size_t i= 0; i < Quad3DataCL::NumNodesC; ++i)
-        for (size_t j= 0; j < 10; ++j)
-            (*this)[i]+= dof[j]*Quad3DataCL::P2_Val[j][i];
+    Quad3DataCL::P2_Table.evaluate<value_type>( dof, Addr( *this));
     return *this;
 }
 
@@ -558,9 +553,7 @@ template<class T>
   inline Quad5CL<T>&
   Quad5CL<T>::assign(const LocalP2CL<value_type>& f)
 {
-    (*this)= f[0]*static_cast<GridFunctionCL<double> >( Quad5DataCL::P2_Val[0]);
-    for (size_t i= 1; i < 10; ++i)
-        (*this)+= f[i]*static_cast<GridFunctionCL<double> >( Quad5DataCL::P2_Val[i]);
+    Quad5DataCL::P2_Table.evaluate<value_type>( f, Addr( *this));
     return *this;
 }
 
@@ -580,10 +573,7 @@ template<class T>
 {
     value_type dof[10];
     f.GetDoF( s, dof);
-    (*this)= T();
-    for (size_t i= 0; i < Quad5DataCL::NumNodesC; ++i)
-        for (size_t j= 0; j < 10; ++j)
-            (*this)[i]+= dof[j]*Quad5DataCL::P2_Val[j][i];
+    Quad5DataCL::P2_Table.evaluate<value_type>( dof, Addr( *this));
     return *this;
 }
 
@@ -67,6 +67,16 @@ FE_P2CL::ApplyAll(Uint numpt, const BaryCoordCL* const pt, std::valarray<double>
     }
 }
 
+void
+P2ShapeTableCL::init (Uint numpt, const BaryCoordCL* const pt)
+{
+    num_points_= numpt;
+    val_.resize( FE_P2CL::NumDoFC*numpt);
+    for (Uint k= 0; k < numpt; ++k)
+        for (Uint i= 0; i < FE_P2CL::NumDoFC; ++i)
+            val_[i*numpt + k]= FE_P2CL::H( i, pt[k]);
+}
+
 
 //**************************************************************************
 // P1-Prolongation                                                         *
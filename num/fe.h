@@ -328,6 +328,50 @@ class FE_P2CL
 };
 
 
+/// \brief The P2 shape functions tabulated on a fixed sequence of points in barycentric coordinates.
+///
+/// The values are stored shape-function-major: row( i)[k] == FE_P2CL::H_i( p_k). Evaluating a local
+/// P2-function on all points is then a small dense product (num_points x 10) * (10 x #components),
+/// which evaluate() computes in blocks of BlockSizeC points with contiguous, vectorizable inner loops.
+/// The table is computed once per point set; see p2_shape_table() in num/lattice-eval.h for the
+/// principal lattices and Quad3DataCL/Quad5DataCL::P2_Table() for the quadrature rules.
+class P2ShapeTableCL
+{
+  public:
+    enum { BlockSizeC= 64 }; ///< number of points handled in one block by evaluate()
+
+  private:
+    Uint num_points_;
+    std::valarray<double> val_; ///< val_[i*num_points_ + k] == H_i( p_k)
+
+    void init (Uint numpt, const BaryCoordCL* const pt);
+
+    ///\brief Evaluation kernels: out[k] == sum_i dof[i]*H_i( p_k) for k in [begin, begin + n).
+    ///@{
+    inline void block_evaluate (const double* dof, Uint begin, Uint n, double* out) const;
+    inline void block_evaluate (const SVectorCL<3>* dof, Uint begin, Uint n, SVectorCL<3>* out) const;
+    template <class T>
+      inline void block_evaluate (const T* dof, Uint begin, Uint n, T* out) const;
+    ///@}
+
+  public:
+    P2ShapeTableCL () : num_points_( 0) {}
+    P2ShapeTableCL (Uint numpt, const BaryCoordCL* const pt) { init( numpt, pt); }
+    template <class VertexIterT>
+      P2ShapeTableCL (VertexIterT begin, VertexIterT end);
+
+    Uint num_points () const { return num_points_; }
+    ///\brief Values of H_i on all points.
+    const double* row (Uint i) const { return Addr( val_) + i*num_points_; }
+
+    ///\brief Evaluate the P2-function with the 10 dof in c on all points; c[i] must be convertible to T.
+    /// The num_points() results are written to the sequence starting at result_iterator.
+    /// \return end-iterator of the sequence of written values.
+    template <class T, class Cont, class ResultIterT>
+      ResultIterT evaluate (const Cont& c, ResultIterT result_iterator) const;
+};
+
+
 //**************************************************************************
 // Class:   FE_P1BubbleCL                                                  *
 // Purpose: Shape functions and their gradients for the mini element.      *
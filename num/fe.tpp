@@ -221,6 +221,78 @@ FE_P2CL::Laplace(Uint dof, const SMatrixCL<3,3>& M)
 }
 
 
+//**************************************************************************
+// Class:   P2ShapeTableCL                                                 *
+//**************************************************************************
+template <class VertexIterT>
+  P2ShapeTableCL::P2ShapeTableCL (VertexIterT begin, VertexIterT end)
+{
+    const std::vector<BaryCoordCL> pt( begin, end);
+    init( pt.size(), pt.empty() ? 0 : &pt[0]);
+}
+
+inline void
+P2ShapeTableCL::block_evaluate (const double* dof, Uint begin, Uint n, double* out) const
+{
+    for (Uint k= 0; k < n; ++k)
+        out[k]= 0.;
+    for (Uint i= 0; i < FE_P2CL::NumDoFC; ++i) {
+        const double  c= dof[i];
+        const double* h= row( i) + begin;
+        for (Uint k= 0; k < n; ++k)
+            out[k]+= c*h[k];
+    }
+}
+
+inline void
+P2ShapeTableCL::block_evaluate (const SVectorCL<3>* dof, Uint begin, Uint n, SVectorCL<3>* out) const
+{
+    // component-planar accumulation, such that the inner loops are contiguous
+    double x[BlockSizeC], y[BlockSizeC], z[BlockSizeC];
+    for (Uint k= 0; k < n; ++k)
+        x[k]= y[k]= z[k]= 0.;
+    for (Uint i= 0; i < FE_P2CL::NumDoFC; ++i) {
+        const double  c0= dof[i][0], c1= dof[i][1], c2= dof[i][2];
+        const double* h= row( i) + begin;
+        for (Uint k= 0; k < n; ++k) {
+            x[k]+= c0*h[k];
+            y[k]+= c1*h[k];
+            z[k]+= c2*h[k];
+        }
+    }
+    for (Uint k= 0; k < n; ++k)
+        out[k]= MakePoint3D( x[k], y[k], z[k]);
+}
+
+template <class T>
+  inline void
+  P2ShapeTableCL::block_evaluate (const T* dof, Uint begin, Uint n, T* out) const
+{
+    for (Uint k= 0; k < n; ++k)
+        out[k]= row( 0)[begin + k]*dof[0];
+    for (Uint i= 1; i < FE_P2CL::NumDoFC; ++i)
+        for (Uint k= 0; k < n; ++k)
+            out[k]+= row( i)[begin + k]*dof[i];
+}
+
+template <class T, class Cont, class ResultIterT>
+  ResultIterT
+  P2ShapeTableCL::evaluate (const Cont& c, ResultIterT result_iterator) const
+{
+    T dof[FE_P2CL::NumDoFC];
+    for (Uint i= 0; i < FE_P2CL::NumDoFC; ++i)
+        dof[i]= c[i];
+
+    T buf[BlockSizeC];
+    for (Uint begin= 0; begin < num_points(); begin+= BlockSizeC) {
+        const Uint n= std::min<Uint>( BlockSizeC, num_points() - begin);
+        block_evaluate( dof, begin, n, buf);
+        result_iterator= std::copy( buf, buf + n, result_iterator);
+    }
+    return result_iterator;
+}
+
+
 //**************************************************************************
 // Class:   P1EvalCL                                                       *
 //**************************************************************************
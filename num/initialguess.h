@@ -0,0 +1,220 @@
+/// \file initialguess.h
+/// \brief initial guesses for the linear systems of time stepping schemes from the solution history
+/// \author LNM RWTH Aachen: Patrick Esser, Joerg Grande, Sven Gross; SC RWTH Aachen: Oliver Fortmeier
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2009 LNM/SC RWTH Aachen, Germany
+*/
+
+#ifndef DROPS_INITIALGUESS_H
+#define DROPS_INITIALGUESS_H
+
+#include "num/spmat.h"
+#include "num/spblockmat.h"
+#include "levelset/mgobserve.h"
+#include <deque>
+#include <vector>
+
+namespace DROPS
+{
+
+/// \brief Keeps the last solutions of a sequence of linear systems and predicts an initial guess for the next one.
+///
+/// The history holds at most GetSize() pairs (t, x), newest first. Extrapolate() evaluates the
+/// interpolation polynomial of degree GetOrder() through the newest solutions at the new time.
+/// Project() minimizes the residual |b - A*x| over the span of the history and the current
+/// guess x; since x itself is in the span, the residual never grows. The history is dropped
+/// whenever the length of the vectors changes, e.g. after a new numbering; use Clear() or
+/// InitialGuessRepairCL if the numbering may change without a change of the length.
+/// Pairs of vectors (velocity, pressure) are stored as one concatenated vector.
+class InitialGuessCL
+{
+  public:
+    enum MethodT { IG_None= 0, IG_Extrapolation= 1, IG_Projection= 2 };
+
+  private:
+    MethodT              method_;
+    size_t               size_,   ///< maximal number of stored solutions
+                         order_;  ///< degree of the extrapolation polynomial
+    std::deque<VectorCL> x_;
+    std::deque<double>   t_;
+
+    /// join (v,p) into one vector
+    static VectorCL Join_( const VectorCL& v, const VectorCL& p) {
+        VectorCL x( v.size() + p.size());
+        x[std::slice( 0, v.size(), 1)]= v;
+        x[std::slice( v.size(), p.size(), 1)]= p;
+        return x;
+    }
+    /// split x into (v,p); v and p have the correct size
+    static void Split_( const VectorCL& x, VectorCL& v, VectorCL& p) {
+        v= x[std::slice( 0, v.size(), 1)];
+        p= x[std::slice( v.size(), p.size(), 1)];
+    }
+
+  public:
+    InitialGuessCL( MethodT method= IG_None, size_t size= 3, size_t order= 1)
+        : method_( method), size_( size), order_( order) {}
+
+    /// \name Getters and Setters
+    //@{
+    MethodT GetMethod() const { return method_; }
+    size_t  GetSize()   const { return size_; }
+    size_t  GetOrder()  const { return order_; }
+    void    SetMethod( MethodT method) { method_= method; if (method_ == IG_None) Clear(); }
+    void    SetSize  ( size_t size) {
+        size_= size;
+        while (x_.size() > size_) { x_.pop_back(); t_.pop_back(); }
+    }
+    void    SetOrder ( size_t order) { order_= order; }
+    //@}
+
+    /// number of stored solutions
+    size_t size() const { return x_.size(); }
+    /// drop the history, e.g. after the numbering of the unknowns has changed
+    void Clear() { x_.clear(); t_.clear(); }
+
+    /// \brief Store the solution x at time t.
+    ///
+    /// Solutions at times >= t (repeated or rejected steps) are replaced.
+    void Push( const VectorCL& x, double t) {
+        if (method_ == IG_None || size_ == 0) return;
+        if (!x_.empty() && x_.front().size() != x.size())
+            Clear();
+        while (!t_.empty() && t_.front() >= t) { x_.pop_front(); t_.pop_front(); }
+        x_.push_front( x);
+        t_.push_front( t);
+        if (x_.size() > size_) { x_.pop_back(); t_.pop_back(); }
+    }
+    void Push( const VectorCL& v, const VectorCL& p, double t) {
+        if (method_ != IG_None) Push( Join_( v, p), t);
+    }
+
+    /// drop the solutions at times > t, e.g. after a rejected time step
+    void Discard( double t) {
+        while (!t_.empty() && t_.front() > t) { x_.pop_front(); t_.pop_front(); }
+    }
+
+    /// \brief Extrapolate the history to time t; returns false, if x is unchanged.
+    bool Extrapolate( VectorCL& x, double t) const {
+        if (method_ == IG_None || x_.empty() || x_.front().size() != x.size())
+            return false;
+        const size_t m= std::min( order_ + 1, x_.size());
+        x= 0.;
+        for (size_t i= 0; i < m; ++i) {
+            double l= 1.;
+            for (size_t j= 0; j < m; ++j)
+                if (j != i) l*= (t - t_[j])/(t_[i] - t_[j]);
+            x+= l*x_[i];
+        }
+        return true;
+    }
+    bool Extrapolate( VectorCL& v, VectorCL& p, double t) const {
+        VectorCL x( v.size() + p.size());
+        if (!Extrapolate( x, t)) return false;
+        Split_( x, v, p);
+        return true;
+    }
+
+    /// \brief Minimize |b - A*x| over span{ x, history }; returns false, if x is unchanged.
+    ///
+    /// Costs size()+1 matrix-vector products. Only available in the serial version.
+    template <class Mat>
+    bool Project( const Mat& A, VectorCL& x, const VectorCL& b) const;
+    /// \brief Same as Project for the saddle point system ( A B^T; B 0)(v; p) = (b; c).
+    template <class Mat>
+    bool Project( const Mat& A, const Mat& B, VectorCL& v, VectorCL& p, const VectorCL& b, const VectorCL& c) const {
+        if (method_ != IG_Projection || x_.empty()) return false;
+        BlockMatrixBaseCL<Mat> K( &A, MUL, &B, TRANSP_MUL, &B, MUL);
+        VectorCL x( Join_( v, p));
+        if (!Project( K, x, Join_( b, c))) return false;
+        Split_( x, v, p);
+        return true;
+    }
+};
+
+template <class Mat>
+bool InitialGuessCL::Project( const Mat& A, VectorCL& x, const VectorCL& b) const
+{
+#ifndef _PAR
+    if (method_ != IG_Projection || x_.empty() || x_.front().size() != x.size())
+        return false;
+
+    // basis V= [x, history], W= A*V; orthonormalize W by modified Gram-Schmidt and apply
+    // the same transformation to V, then x= V*W^T*b.
+    std::vector<VectorCL> V, W;
+    V.reserve( x_.size() + 1);
+    W.reserve( x_.size() + 1);
+    for (size_t i= 0; i <= x_.size(); ++i) {
+        VectorCL v( i == 0 ? x : x_[i-1]),
+                 w( A*v);
+        const double nw0= norm( w);
+        for (size_t j= 0; j < W.size(); ++j) {
+            const double h= dot( W[j], w);
+            w-= h*W[j];
+            v-= h*V[j];
+        }
+        const double nw= norm( w);
+        if (nw <= 1e-10*nw0) // linearly dependent
+            continue;
+        w/= nw;
+        v/= nw;
+        W.push_back( w);
+        V.push_back( v);
+    }
+    if (V.empty()) return false;
+    x= 0.;
+    for (size_t j= 0; j < V.size(); ++j)
+        x+= dot( W[j], b)*V[j];
+    return true;
+#else
+    // dot products of distributed vectors would require the ExchangeCL of the unknowns
+    static_cast<void>( A); static_cast<void>( x); static_cast<void>( b);
+    return false;
+#endif
+}
+
+
+/// \brief Drops the history of InitialGuessCL objects, if the multigrid is modified.
+class InitialGuessRepairCL : public MGObserverCL
+{
+  private:
+    std::vector<InitialGuessCL*> guess_;
+
+  public:
+    InitialGuessRepairCL() {}
+    /// observe the history g
+    void push_back( InitialGuessCL* g) { guess_.push_back( g); }
+
+    void pre_refine  () {}
+    void post_refine () {
+        for (size_t i= 0; i < guess_.size(); ++i)
+            guess_[i]->Clear();
+    }
+
+    void pre_refine_sequence  () {}
+    void post_refine_sequence () { post_refine(); }
+#ifdef _PAR
+    const IdxDescCL* GetIdxDesc() const { return (const IdxDescCL*)0; }
+#endif
+};
+
+} // end of namespace DROPS
+
+#endif
@@ -26,9 +26,19 @@
 #define DROPS_LATTICE_EVAL_H
 
 #include "misc/container.h"
+#include "geom/principallattice.h"
+#include "num/discretize.h"
+
+#include <vector>
+#include <algorithm>
 
 namespace DROPS {
 
+///\brief The P2 shape functions tabulated on the vertices of the principal lattice lat.
+/// The tables for lattices with up to 16 intervals are computed once on first use; for finer lattices, 0 is returned.
+inline const P2ShapeTableCL*
+p2_shape_table (const PrincipalLatticeCL& lat);
+
 ///\brief Evaluate the LocalP2CL-like function f on [dom.vertex_begin(), dom.vertex_end()).
 /// The result is stored to the sequence starting at result_iterator.
 /// LocalFET must provide double operator() (const BaryCoordCL&).
@@ -45,6 +55,14 @@ template <class LocalFET, class DomainT, class ResultIterT>
   evaluate_on_vertexes (const LocalFET& f, const DomainT& dom, TetraSignEnum s, ResultIterT result_iterator);
 ///@}
 
+///\brief Evaluate the LocalP2CL f on all vertices of the principal lattice lat.
+/// Uses the cached shape function table p2_shape_table( lat) instead of evaluating the shape functions point by point.
+/// The result is stored to the sequence starting at result_iterator.
+/// \return end-iterator of the sequence of written values.
+template <class T, class ResultIterT>
+  inline ResultIterT
+  evaluate_on_vertexes (const LocalP2CL<T>& f, const PrincipalLatticeCL& lat, ResultIterT result_iterator);
+
 ///\brief Evaluate the LocalP2CL-like function f on [dom.vertex_begin(), dom.vertex_end()).
 /// The result is stored to result_container. The latter is resized to dom_vertex_size().
 /// ResultContainerT may be std::valarray and its derivatives, e.g. GridFunctionCL.
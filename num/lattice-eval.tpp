@@ -24,6 +24,44 @@
 
 namespace DROPS {
 
+/// \brief The shape tables of the principal lattices with up to MaxIntervalsC intervals.
+/// The tables are computed in the constructor; afterwards, the cache is read-only.
+class P2ShapeTableCacheCL
+{
+  public:
+    enum { MaxIntervalsC= 16 };
+
+  private:
+    std::vector<P2ShapeTableCL> table_;
+
+  public:
+    P2ShapeTableCacheCL () : table_( MaxIntervalsC) {
+        for (Uint n= 1; n <= MaxIntervalsC; ++n) {
+            const PrincipalLatticeCL& lat= PrincipalLatticeCL::instance( n);
+            table_[n-1]= P2ShapeTableCL( lat.vertex_begin(), lat.vertex_end());
+        }
+    }
+
+    const P2ShapeTableCL* operator() (Uint n) const { return n <= MaxIntervalsC ? &table_[n-1] : 0; }
+};
+
+inline const P2ShapeTableCL*
+p2_shape_table (const PrincipalLatticeCL& lat)
+{
+    static const P2ShapeTableCacheCL cache; // built once on first use; the initialization of local statics is thread-safe
+    return cache( lat.num_intervals());
+}
+
+template <class T, class ResultIterT>
+  inline ResultIterT
+  evaluate_on_vertexes (const LocalP2CL<T>& f, const PrincipalLatticeCL& lat, ResultIterT result_iterator)
+{
+    const P2ShapeTableCL* tab= p2_shape_table( lat);
+    if (tab != 0)
+        return tab->evaluate<T>( f, result_iterator);
+    return std::transform( lat.vertex_begin(), lat.vertex_end(), result_iterator, f);
+}
+
 template <class LocalFET, class DomainT, class ResultIterT>
   inline ResultIterT
   evaluate_on_vertexes (const LocalFET& ls, const DomainT& dom, ResultIterT result_iterator)
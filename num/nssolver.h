@@ -75,6 +75,16 @@ class NSSolverBaseCL : public SolverBaseCL
     }
 };
 
+/// \brief Linearization of the convection term in AdaptFixedPtDefectCorrCL.
+///
+/// NS_Picard uses the fixed-point matrix N(u), NS_Newton the Jacobian N(u) + R(u) (see
+/// SetupNonlinearJacobian of the Navier-Stokes problem classes). NS_AdaptiveNewton starts with
+/// Picard steps and switches to Newton, once the residual has been reduced by the switch factor;
+/// if a Newton step increases the residual, it falls back to Picard.
+/// Newton steps are damped by backtracking on the residual of the nonlinear system, the
+/// relaxation policy is only used for Picard steps.
+enum NSLinearizationT { NS_Picard= 0, NS_Newton= 1, NS_AdaptiveNewton= 2 };
+
 // forward declaration
 class LineSearchPolicyCL;
 
@@ -99,18 +109,42 @@ class AdaptFixedPtDefectCorrCL : public NSSolverBaseCL<NavStokesT>
     using base_::_res;
 
     MLMatrixCL* AN_;
+    MatrixCL    R_;          ///< Newton part of the Jacobian of the convection term
 
     double      red_;
     bool        adap_;
 
+    NSLinearizationT lin_;
+    double      switch_,     ///< NS_AdaptiveNewton: switch to Newton at this reduction of the residual
+                resswitch_;  ///< residual, below which Newton is used
+    bool        newton_;     ///< true, if the current step is a Newton step
+    bool        ew_;         ///< Eisenstat-Walker control of the inner tolerance in Newton steps
+    double      gamma_,      ///< parameter of the Eisenstat-Walker formula
+                eta_;        ///< last relative inner tolerance
+
+    /// \brief Decide on the linearization of the step with residual res; resold is the residual of the last step.
+    void ChooseLinearization_( double res, double resold);
+    /// \brief Relative tolerance for the inner solver; Eisenstat-Walker (choice 2) in Newton steps, else the reduction.
+    double InnerReduction_( double res, double resold);
+    /// \brief Step length of the Newton correction (w, q): halve omega, starting with 1, until the residual decreases sufficiently.
+    double Backtrack_( const MatrixCL& A, const MatrixCL& B, const VecDescCL& v, const VectorCL& p,
+                       const VectorCL& b, VecDescCL& cplN, const VectorCL& c,
+                       const VectorCL& w, const VectorCL& q, double alpha);
+
   public:
     AdaptFixedPtDefectCorrCL( NavStokesT& NS, StokesSolverBaseCL& solver, int maxiter,
                               double tol, double reduction= 0.1, bool adap=true)
-        : base_( NS, solver, maxiter, tol), AN_( new MLMatrixCL( NS.vel_idx.size()) ), red_( reduction), adap_( adap) { }
+        : base_( NS, solver, maxiter, tol), AN_( new MLMatrixCL( NS.vel_idx.size()) ), red_( reduction), adap_( adap),
+          lin_( NS_Picard), switch_( 0.1), resswitch_( 0.), newton_( false), ew_( false), gamma_( 0.9), eta_( reduction) { }
 
     ~AdaptFixedPtDefectCorrCL() { delete AN_; }
 
     void SetReduction( double red) { red_= red; }
+    /// \brief Choose Picard, Newton or adaptive Newton; switchred is the residual reduction for the switch to Newton.
+    void SetLinearization( NSLinearizationT lin, double switchred= 0.1) { lin_= lin; switch_= switchred; }
+    /// \brief Control the inner tolerance of Newton steps by the Eisenstat-Walker formula eta= gamma*(res/resold)^2.
+    void SetEisenstatWalker( bool ew, double gamma= 0.9) { ew_= ew; gamma_= gamma; }
+    NSLinearizationT GetLinearization() const { return lin_; }
     double   GetResid ()         const { return _res; }
     int      GetIter  ()         const { return _iter; }
 
@@ -263,6 +297,84 @@ template<class NavStokesT>
     w_old_= w; q_old_= q;
 }
 
+template<class NavStokesT, class RelaxationPolicyT>
+void
+AdaptFixedPtDefectCorrCL<NavStokesT, RelaxationPolicyT>::ChooseLinearization_( double res, double resold)
+{
+    switch (lin_) {
+      case NS_Picard: newton_= false; break;
+      case NS_Newton: newton_= true;  break;
+      case NS_AdaptiveNewton:
+        if (_iter == 0) {
+            newton_= false;
+            resswitch_= switch_*res;
+        }
+        else if (newton_ && res > resold) { // Newton step failed: Picard, until the residual is reduced again
+            newton_= false;
+            resswitch_= switch_*res;
+            std::cout << "Newton step increased the residual: switching to Picard\n";
+        }
+        else if (!newton_ && res <= resswitch_) {
+            newton_= true;
+            eta_= red_;
+            std::cout << "switching to Newton\n";
+        }
+        break;
+      default: throw DROPSErrCL( "AdaptFixedPtDefectCorrCL: unknown linearization");
+    }
+}
+
+template<class NavStokesT, class RelaxationPolicyT>
+double
+AdaptFixedPtDefectCorrCL<NavStokesT, RelaxationPolicyT>::InnerReduction_( double res, double resold)
+{
+    if (!newton_ || !ew_ || _iter == 0)
+        return eta_= red_;
+    // Eisenstat-Walker, choice 2, with safeguard against too small tolerances
+    double eta= gamma_*std::pow( res/resold, 2);
+    const double safe= gamma_*eta_*eta_;
+    if (safe > 0.1)
+        eta= std::max( eta, safe);
+    return eta_= std::min( eta, red_);
+}
+
+template<class NavStokesT, class RelaxationPolicyT>
+double
+AdaptFixedPtDefectCorrCL<NavStokesT, RelaxationPolicyT>::Backtrack_(
+    const MatrixCL& A, const MatrixCL& B, const VecDescCL& v, const VectorCL& p,
+    const VectorCL& b, VecDescCL& cplN, const VectorCL& c,
+    const VectorCL& w, const VectorCL& q, double alpha)
+// accumulated and non accumulated vectors:
+// v - acc, p - acc, b - non-acc, cplN - non-acc, c - non-acc, w - acc, q - acc
+{
+#ifdef _PAR
+    ExchangeCL& ExVel= NS_.vel_idx.GetEx();
+    ExchangeCL& ExPr = NS_.pr_idx.GetEx();
+    const bool useAccur=true;
+#endif
+    const int maxhalve= 5;        // smallest step length is 2^-maxhalve
+    const double sufficient= 1e-4; // Armijo constant
+    VecDescCL v_omw( v.RowIdx);
+    v_omw.t= v.t;
+    VectorCL d( v.Data.size()), e( p.size());
+    double omega= 1., res;
+    for (int i= 0; ; ++i, omega*= 0.5) {
+        v_omw.Data= v.Data - omega*w;
+        NS_.SetupNonlinear( NS_.N.Data.GetFinest(), &v_omw, &cplN, NS_.N.RowIdx->GetFinest());
+        d= A*v_omw.Data + alpha*(NS_.N.Data.GetFinest()*v_omw.Data) + transp_mul( B, VectorCL( p - omega*q))
+           - b - alpha*cplN.Data;
+        e= B*v_omw.Data - c;
+#ifndef _PAR
+        res= std::sqrt( norm_sq( d) + norm_sq( e));
+#else
+        res= std::sqrt( ExVel.Norm_sq( d, false, useAccur) + ExPr.Norm_sq( e, false, useAccur));
+#endif
+        if (res <= (1. - sufficient*omega)*_res || i == maxhalve)
+            break;
+    }
+    return omega;
+}
+
 template<class NavStokesT, class RelaxationPolicyT>
 void
 AdaptFixedPtDefectCorrCL<NavStokesT, RelaxationPolicyT>::Solve(
@@ -279,7 +391,8 @@ AdaptFixedPtDefectCorrCL<NavStokesT, RelaxationPolicyT>::Solve(
     ExchangeCL& ExPr = NS_.pr_idx.GetEx();
     const bool useAccur=true;
 #endif
-    double res0= 1.;
+    double res0= 1., resold= 0.;
+    bool wasnewton= false;
     int oseenIter= 0;
     _iter= 0;
     for(;;++_iter) { // ever
@@ -303,7 +416,16 @@ AdaptFixedPtDefectCorrCL<NavStokesT, RelaxationPolicyT>::Solve(
             break;
 
         // solve correction:
-        double outer_tol= _res*red_;
+        ChooseLinearization_( _res, resold);
+        if (newton_ && !wasnewton) // the state of the relaxation policy belongs to the Picard corrections
+            relax= RelaxationPolicyT( v.Data.size(), p.size());
+        wasnewton= newton_;
+        if (newton_) { // Jacobian; the coarse levels keep the fixed-point matrices for the preconditioner
+            NS_.SetupNonlinearJacobian( R_, &v, NS_.N.RowIdx->GetFinest());
+            AN_->GetFinest().LinComb( 1., A, alpha, NS_.N.Data.GetFinest(), alpha, R_);
+        }
+        double outer_tol= _res*InnerReduction_( _res, resold);
+        resold= _res;
         if (outer_tol < 0.5*_tol && this->GetRelError() == false)
             outer_tol= 0.5*_tol;
         solver_.SetTol( outer_tol);
@@ -311,12 +433,18 @@ AdaptFixedPtDefectCorrCL<NavStokesT, RelaxationPolicyT>::Solve(
         solver_.Solve( AN_->GetFinest(), B, w, q, d, e); // solver_ should use a relative termination criterion.
         oseenIter+= solver_.GetIter();
 
-        // calculate step length omega:
-        relax.Update( NS_, A,  B, v, p, b, cplN, c, w,  q, alpha);
+        // calculate step length omega: the relaxation policy minimizes the defect of the Picard
+        // linearization, which does not fit Newton corrections
+        double omega;
+        if (newton_)
+            omega= Backtrack_( A, B, v, p, b, cplN, c, w, q, alpha);
+        else {
+            relax.Update( NS_, A,  B, v, p, b, cplN, c, w,  q, alpha);
+            omega= relax.RelaxFactor();
+        }
 
         // update solution:
-        const double omega( relax.RelaxFactor());
-        std::cout << "omega = " << omega << std::endl;
+        std::cout << "omega = " << omega << (newton_ ? " (Newton)" : "") << std::endl;
         v.Data-= omega*w;
         p     -= omega*q;
     }
@@ -339,7 +467,8 @@ AdaptFixedPtDefectCorrCL<NavStokesT, RelaxationPolicyT>::Solve(
     ExchangeCL& ExPr = NS_.pr_idx.GetEx();
     const bool useAccur=true;
 #endif
-    double res0= 1.;
+    double res0= 1., resold= 0.;
+    bool wasnewton= false;
     int oseenIter= 0;
 
     _iter= 0;
@@ -362,7 +491,16 @@ AdaptFixedPtDefectCorrCL<NavStokesT, RelaxationPolicyT>::Solve(
             break;
 
         // solve correction:
-        double outer_tol= _res*red_;
+        ChooseLinearization_( _res, resold);
+        if (newton_ && !wasnewton) // the state of the relaxation policy belongs to the Picard corrections
+            relax= RelaxationPolicyT( v.Data.size(), p.size());
+        wasnewton= newton_;
+        if (newton_) { // Jacobian; the coarse levels keep the fixed-point matrices for the preconditioner
+            NS_.SetupNonlinearJacobian( R_, &v, NS_.N.RowIdx->GetFinest());
+            AN_->GetFinest().LinComb( 1., A.GetFinest(), alpha, NS_.N.Data.GetFinest(), alpha, R_);
+        }
+        double outer_tol= _res*InnerReduction_( _res, resold);
+        resold= _res;
         if (outer_tol < 0.5*_tol && this->GetRelError() == false)
             outer_tol= 0.5*_tol;
         w= 0.0; q= 0.0;
@@ -370,12 +508,18 @@ AdaptFixedPtDefectCorrCL<NavStokesT, RelaxationPolicyT>::Solve(
         solver_.Solve( *AN_, B, w, q, d, e); // solver_ should use a relative termination criterion.
         oseenIter+= solver_.GetIter();
 
-        // calculate step length omega:
-        relax.Update( NS_, A.GetFinest(),  B.GetFinest(), v, p, b, cplN, c, w,  q, alpha);
+        // calculate step length omega: the relaxation policy minimizes the defect of the Picard
+        // linearization, which does not fit Newton corrections
+        double omega;
+        if (newton_)
+            omega= Backtrack_( A.GetFinest(), B.GetFinest(), v, p, b, cplN, c, w, q, alpha);
+        else {
+            relax.Update( NS_, A.GetFinest(),  B.GetFinest(), v, p, b, cplN, c, w,  q, alpha);
+            omega= relax.RelaxFactor();
+        }
 
         // update solution:
-        const double omega( relax.RelaxFactor());
-        std::cout << "omega = " << omega << std::endl;
+        std::cout << "omega = " << omega << (newton_ ? " (Newton)" : "") << std::endl;
         v.Data-= omega*w;
         p     -= omega*q;
     }
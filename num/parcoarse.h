@@ -0,0 +1,119 @@
+/// \file parcoarse.h
+/// \brief Parallel coarse grid solver, that agglomerates the coarse problem onto a subset of procs
+/// \author LNM RWTH Aachen
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2009 LNM/SC RWTH Aachen, Germany
+*/
+
+#ifndef DROPS_PARCOARSE_H
+#define DROPS_PARCOARSE_H
+
+#include "num/parsolver.h"
+#include "num/pclifecycle.h"
+#include <vector>
+
+namespace DROPS
+{
+
+// ***************************************************************************
+/// \brief Redundant direct solver for (coarse) problems agglomerated onto a subset of procs
+// ***************************************************************************
+template <class DirectSolverT>
+class ParAgglomeratedDirectSolverCL : public ParSolverBaseCL
+/** On coarse levels only a handful of unknowns per proc remain, such that
+    iterative solvers spanning all procs are dominated by the latency of the
+    global reductions. This class gathers the matrix onto the first
+    \a numHosts_ procs (the hosts), such that each host stores at least
+    \a minUnkPerProc_ unknowns on average. Proc \a p sends its unknowns to
+    the host \f$p\bmod\f$ \a numHosts_. The hosts exchange the matrix within
+    their own sub-communicator and store and factorize it redundantly by
+    \a DirectSolverT, e.g., DirectNonSymmSolverCL or DirectSymmSolverCL of
+    num/directsolver.h, or DirectLDLtSolverCL of num/sparseldlt.h, which
+    needs no external library.
+
+    Within Solve, the right-hand side is gathered by the hosts, summed up in
+    the sub-communicator, and the accumulated solution is sent back to the
+    clients. Hence, the only collective operation involves the hosts, whose
+    number only depends on the size of the coarse problem.
+    The matrix is gathered and factorized again, whenever the matrix changes;
+    if only its version changes, GetLifecycle() decides whether the old
+    factorization is kept.
+    \pre  b has distributed form
+    \post x has accumulated form
+*/
+{
+  private:
+    typedef ParSolverBaseCL base;
+
+    size_t             minUnkPerProc_;  ///< minimal average number of unknowns per host
+    int                numHosts_;       ///< number of procs storing the coarse problem
+    ProcCL::SubCommT   hostComm_;       ///< communicator of the hosts
+    size_t             numGlobUnk_;     ///< global number of unknowns
+    VectorBaseCL<int>  globIdx_;        ///< global number of each local unknown
+    std::vector<int>   clients_;        ///< procs, whose unknowns are gathered by this host (except itself)
+    std::vector< VectorBaseCL<int> > clientIdx_; ///< global numbers of the unknowns of each client
+    MatrixCL           M_;              ///< gathered matrix (only on hosts)
+    DirectSolverT*     solver_;         ///< factorization of M_ (only on hosts)
+    const MatrixCL*    mat_;            ///< matrix, M_ has been gathered from
+    PcLifecycleCL      lifecycle_;      ///< decides on a new factorization, if the version of the matrix has changed
+    int                tag_;            ///< first tag used by this class
+
+    /// \brief Host of a proc
+    int  Host( int proc) const { return proc%numHosts_; }
+    /// \brief Check if the calling proc stores the coarse problem
+    bool IamHost() const { return ProcCL::MyRank()<numHosts_; }
+
+    /// \brief Number the exclusive unknowns consecutively and determine hosts
+    void CreateNumbering_( size_t numUnk);
+    /// \brief Gather the matrix onto the hosts and factorize it
+    void GatherMatrix_( const MatrixCL&);
+    /// \brief Free sub-communicator and factorization
+    void Clear_();
+
+  public:
+    /// \brief Constructor
+    /** \param idx           index of the coarse problem
+        \param minUnkPerProc minimal average number of unknowns per host*/
+    ParAgglomeratedDirectSolverCL( const IdxDescCL& idx, size_t minUnkPerProc= 2000)
+      : base( 1, 0., idx), minUnkPerProc_( minUnkPerProc), numHosts_( 0),
+        hostComm_( ProcCL::NullComm), numGlobUnk_( 0), solver_( 0), mat_( 0),
+        tag_( 1101) {}
+    ~ParAgglomeratedDirectSolverCL() { Clear_(); }
+
+    /// \brief Gather and factorize the matrix A (done automatically by Solve if A has changed)
+    void Setup( const MatrixCL& A);
+    /// \brief Solve the linear system with coefficient matrix A and distributed rhs b
+    void Solve( const MatrixCL& A, VectorCL& x, const VectorCL& b);
+
+    /// \brief Number of procs, the coarse problem is agglomerated onto
+    int    GetNumHosts()     const { return numHosts_; }
+    /// \brief Minimal average number of unknowns per host
+    size_t GetMinUnkPerProc() const { return minUnkPerProc_; }
+    /// \brief Set minimal average number of unknowns per host (takes effect with the next Setup)
+    void   SetMinUnkPerProc( size_t n) { minUnkPerProc_= n; mat_= 0; }
+    /// \brief Policy for a new factorization after the matrix has changed
+    PcLifecycleCL& GetLifecycle() { return lifecycle_; }
+};
+
+} // end of namespace DROPS
+
+#include "num/parcoarse.tpp"
+
+#endif
@@ -0,0 +1,207 @@
+/// \file parcoarse.tpp
+/// \brief Parallel coarse grid solver, that agglomerates the coarse problem onto a subset of procs
+/// \author LNM RWTH Aachen
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2009 LNM/SC RWTH Aachen, Germany
+*/
+
+namespace DROPS
+{
+
+/****************************************************************************
+* P A R  A G G L O M E R A T E D  D I R E C T  S O L V E R  C L             *
+****************************************************************************/
+
+template <class DirectSolverT>
+void ParAgglomeratedDirectSolverCL<DirectSolverT>::Clear_()
+{
+    ProcCL::FreeComm( hostComm_);
+    delete solver_; solver_= 0;
+    clients_.clear();
+    clientIdx_.clear();
+    mat_= 0;
+}
+
+/** As for HypreIndexCL, each proc numbers its exclusive unknowns consecutively
+    and the numbering is made consistent by accumulation. Afterwards the number
+    of hosts is determined and the sub-communicator of the hosts is created.*/
+template <class DirectSolverT>
+void ParAgglomeratedDirectSolverCL<DirectSolverT>::CreateNumbering_( size_t numUnk)
+{
+    const ExchangeCL& ex= base::GetEx();
+    const int numExclusive= (int)ex.GetNumExclusive();
+
+    std::vector<int> numExclusiveProc( ProcCL::Size());
+    ProcCL::Gather( &numExclusive, Addr( numExclusiveProc), 1, -1);
+    int offset= 0;
+    numGlobUnk_= 0;
+    for (int p=0; p<ProcCL::Size(); ++p){
+        if (p==ProcCL::MyRank())
+            offset= (int)numGlobUnk_;
+        numGlobUnk_+= numExclusiveProc[p];
+    }
+
+    globIdx_.resize( numUnk);
+    int gidx= offset;
+    for (size_t i=0; i<numUnk; ++i)
+        globIdx_[i]= ex.IsExclusive( i) ? gidx++ : 0;
+    ex.Accumulate( globIdx_);
+
+    numHosts_= std::max( 1, std::min( ProcCL::Size(), (int)(numGlobUnk_/std::max( minUnkPerProc_, (size_t)1))));
+    hostComm_= ProcCL::SplitComm( IamHost() ? 0 : -1, ProcCL::MyRank());
+
+    if (IamHost())
+        for (int p=ProcCL::MyRank()+numHosts_; p<ProcCL::Size(); p+=numHosts_)
+            clients_.push_back( p);
+}
+
+/** Each proc sends the global numbers of its unknowns and its non-zeros to its
+    host. The hosts exchange the non-zeros of their clients within the
+    sub-communicator, so that each host assembles the whole matrix. Non-zeros of
+    the same entry stored by different procs are summed up.*/
+template <class DirectSolverT>
+void ParAgglomeratedDirectSolverCL<DirectSolverT>::GatherMatrix_( const MatrixCL& A)
+{
+    // local non-zeros in global numbering
+    std::vector<int>    rowcol( 2*A.num_nonzeros());
+    std::vector<double> val( A.raw_val(), A.raw_val()+A.num_nonzeros());
+    for (size_t i=0, nz=0; i<A.num_rows(); ++i)
+        for (; nz<A.row_beg( i+1); ++nz){
+            rowcol[2*nz]  = globIdx_[i];
+            rowcol[2*nz+1]= globIdx_[A.col_ind( nz)];
+        }
+
+    if (!IamHost()){
+        const int host= Host( ProcCL::MyRank());
+        std::vector<ProcCL::RequestT> req;
+        req.push_back( ProcCL::Isend( globIdx_, host, tag_));
+        req.push_back( ProcCL::Isend( rowcol,   host, tag_+1));
+        req.push_back( ProcCL::Isend( val,      host, tag_+2));
+        ProcCL::WaitAll( req);
+        return;
+    }
+
+    // receive unknowns and non-zeros of the clients
+    clientIdx_.resize( clients_.size());
+    for (size_t c=0; c<clients_.size(); ++c){
+        clientIdx_[c].resize( ProcCL::GetMessageLength<int>( clients_[c], tag_));
+        ProcCL::Recv( clientIdx_[c], clients_[c], tag_);
+        const size_t oldnnz= val.size(),
+                     nnz= ProcCL::GetMessageLength<double>( clients_[c], tag_+2);
+        rowcol.resize( 2*(oldnnz+nnz));
+        val.resize( oldnnz+nnz);
+        ProcCL::Recv( Addr( rowcol)+2*oldnnz, 2*nnz, clients_[c], tag_+1);
+        ProcCL::Recv( Addr( val)+oldnnz,      nnz,   clients_[c], tag_+2);
+    }
+
+    // exchange the non-zeros among the hosts
+    const int nnz= (int)val.size();
+    std::vector<int> nnzHost( numHosts_), displs( numHosts_+1, 0);
+    ProcCL::Allgather( hostComm_, &nnz, 1, Addr( nnzHost));
+    for (int h=0; h<numHosts_; ++h)
+        displs[h+1]= displs[h]+nnzHost[h];
+    std::vector<double> allVal( displs[numHosts_]);
+    ProcCL::Allgatherv( hostComm_, Addr( val), nnz, Addr( allVal), Addr( nnzHost), Addr( displs));
+    for (int h=0; h<numHosts_; ++h){
+        nnzHost[h]*= 2; displs[h]*= 2;
+    }
+    std::vector<int> allRowCol( 2*allVal.size());
+    ProcCL::Allgatherv( hostComm_, Addr( rowcol), 2*nnz, Addr( allRowCol), Addr( nnzHost), Addr( displs));
+
+    // assemble the global matrix
+    SparseMatBuilderCL<double> M( &M_, numGlobUnk_, numGlobUnk_);
+    for (size_t nz=0; nz<allVal.size(); ++nz)
+        M( allRowCol[2*nz], allRowCol[2*nz+1])+= allVal[nz];
+    M.Build();
+
+    if (solver_==0)
+        solver_= new DirectSolverT( M_);
+    else
+        solver_->Update( M_);
+}
+
+/** This function has to be called by all procs.*/
+template <class DirectSolverT>
+void ParAgglomeratedDirectSolverCL<DirectSolverT>::Setup( const MatrixCL& A)
+{
+    lifecycle_.BeginUpdate();
+    Clear_();
+    CreateNumbering_( A.num_rows());
+    GatherMatrix_( A);
+    mat_= &A;
+    lifecycle_.EndUpdate( PcLifecycleCL::PC_Rebuild, A.Version(), A);
+}
+
+/** The residual is not measured, i.e., GetIter() returns 1 and GetResid() 0.
+    This function has to be called by all procs.*/
+template <class DirectSolverT>
+void ParAgglomeratedDirectSolverCL<DirectSolverT>::Solve( const MatrixCL& A, VectorCL& x, const VectorCL& b)
+{
+    if (mat_!=&A)
+        lifecycle_.Invalidate();
+    if (lifecycle_.Decide( "ParAgglomeratedDirectSolverCL", A.Version(), A) >= PcLifecycleCL::PC_Refresh)
+        Setup( A);
+    lifecycle_.BeginApply();
+
+    base::_iter= 1;
+    base::_res=  0.;
+    if (x.size()!=b.size())
+        x.resize( b.size());
+
+    if (!IamHost()){
+        const int host= Host( ProcCL::MyRank());
+        ProcCL::RequestT req= ProcCL::Isend( b, host, tag_+3);
+        ProcCL::Recv( x, host, tag_+4);
+        ProcCL::Wait( req);
+        lifecycle_.EndApply();
+        return;
+    }
+
+    // gather and sum up the distributed rhs
+    VectorCL bLoc( numGlobUnk_), bGlob( numGlobUnk_), xGlob( numGlobUnk_);
+    for (size_t i=0; i<b.size(); ++i)
+        bLoc[globIdx_[i]]+= b[i];
+    VectorCL bClient;
+    for (size_t c=0; c<clients_.size(); ++c){
+        bClient.resize( clientIdx_[c].size());
+        ProcCL::Recv( bClient, clients_[c], tag_+3);
+        for (size_t i=0; i<bClient.size(); ++i)
+            bLoc[clientIdx_[c][i]]+= bClient[i];
+    }
+    ProcCL::AllReduce( hostComm_, Addr( bLoc), Addr( bGlob), (int)numGlobUnk_, MPI_SUM_Operation);
+
+    solver_->Solve( M_, xGlob, bGlob);
+
+    // scatter the accumulated solution
+    std::vector<VectorCL> xClient( clients_.size());
+    std::vector<ProcCL::RequestT> req( clients_.size());
+    for (size_t c=0; c<clients_.size(); ++c){
+        xClient[c].resize( clientIdx_[c].size());
+        for (size_t i=0; i<xClient[c].size(); ++i)
+            xClient[c][i]= xGlob[clientIdx_[c][i]];
+        req[c]= ProcCL::Isend( xClient[c], clients_[c], tag_+4);
+    }
+    for (size_t i=0; i<x.size(); ++i)
+        x[i]= xGlob[globIdx_[i]];
+    ProcCL::WaitAll( req);
+    lifecycle_.EndApply();
+}
+
+} // end of namespace DROPS
@@ -132,6 +132,26 @@ template <typename Mat, typename Vec, typename PreCon, typename ExCL>
 bool ParGCR(const Mat& A, Vec& x, const Vec& b, const ExCL& ExX, PreCon& M,
     int m, int& max_iter, double& tol, bool measure_relative_tol= true, std::ostream* output=0);
 
+//***************************************************************************
+// matrix-vector products with accumulation of the result
+//***************************************************************************
+
+/// \brief Compute y=A*x_acc and the accumulated form y_acc of y
+/** y_acc may be the same object as x_acc.*/
+template <typename Mat, typename Vec, typename ExCL>
+inline void ParMulAcc(const Mat& A, const Vec& x_acc, Vec& y, Vec& y_acc, const ExCL& ExX)
+{
+    y= A*x_acc;
+    y_acc= ExX.GetAccumulate(y);
+}
+
+/// \brief Compute y=A*x_acc and y_acc, the accumulation is overlapped with the interior rows (see ExchangeCL::MulAcc)
+/** y_acc may be the same object as x_acc.*/
+inline void ParMulAcc(const MatrixCL& A, const VectorCL& x_acc, VectorCL& y, VectorCL& y_acc, const ExchangeCL& ExX)
+{
+    ExX.MulAcc(A, x_acc, y, y_acc);
+}
+
 
 //***************************************************************************
 //                      S O L V E R   B A S E  C L A S S E S
@@ -464,6 +484,7 @@ bool ParCG(const Mat& A, Vec& x_acc, const Vec& b, const ExCL& ExX, int& max_ite
     /// \param[in,out] tol      IN: tolerance for the residual, OUT: residual
     /// \return                 convergence within max_iter iterations
 {
+    DROPS_PROFILE_REGION("ParCG");
     Vec r ( b - A*x_acc ), r_acc(r);
 
     double alpha = ExX.ParDotAcc(r_acc,r);
@@ -483,7 +504,7 @@ bool ParCG(const Mat& A, Vec& x_acc, const Vec& b, const ExCL& ExX, int& max_ite
     for (int i=1; i<=max_iter; ++i)
     {
         const Vec    v      = A*p_acc;
-        const double gamma  = ProcCL::GlobalSum(dot( v, p_acc));
+        const double gamma  = ProcCL::GlobalSum(omp_dot( v, p_acc));
         const double lambda = alpha/gamma;
         double       beta   = alpha;
 
@@ -524,13 +545,14 @@ bool ParPCG(const Mat& A, Vec& x_acc, const Vec& b, const ExCL& ExX,
     /// \param[in]     measure_relative_tol measure resid relative
     /// \return                             convergence within max_iter iterations
 {
+    DROPS_PROFILE_REGION("ParPCG");
     // Check if preconditioner needs diagonal of matrix. The preconditioner
     // only computes the diagonal new, if the matrix has changed
     if (M.NeedDiag())
         M.SetDiag(A);
 
     const size_t n= b.size();
-    Vec p_acc(n), z_acc(n), q(n), r( b - A*x_acc), r_acc(r);
+    Vec p_acc(n), z_acc(n), q(n), q_acc(n), r( b - A*x_acc), r_acc(r);
 
     double rho,
            rho_1= 0.0,
@@ -552,7 +574,7 @@ bool ParPCG(const Mat& A, Vec& x_acc, const Vec& b, const ExCL& ExX,
     {
         M.Apply(A, z_acc, r);
         if (M.RetAcc())
-            rho = ProcCL::GlobalSum(dot(z_acc,r));
+            rho = ProcCL::GlobalSum(omp_dot(z_acc,r));
         else
             rho= ExX.ParDotAcc( z_acc, r);
 
@@ -561,14 +583,16 @@ bool ParPCG(const Mat& A, Vec& x_acc, const Vec& b, const ExCL& ExX,
         else
             p_acc = z_acc + (rho/rho_1)*p_acc;
 
-        q= A*p_acc;
-        const double lambda = ProcCL::GlobalSum(dot(p_acc, q));
+        // accumulating q is overlapped with the product, so r_acc is updated without another exchange
+        ParMulAcc(A, p_acc, q, q_acc, ExX);
+        const double lambda = ProcCL::GlobalSum(omp_dot(p_acc, q));
         const double alpha  = rho/lambda;
 
-        x_acc += alpha * p_acc;
-        r     -= alpha * q;
+        omp_axpy(  alpha, p_acc, x_acc);
+        omp_axpy( -alpha, q, r);
+        omp_axpy( -alpha, q_acc, r_acc);
 
-        const double res= ExX.Norm_sq_Acc(r_acc, r);
+        const double res= ProcCL::GlobalSum(omp_dot(r_acc, r));
         resid= std::sqrt(res<0 ? 0 : res) / normb;
 
         if (resid<=tol){
@@ -603,6 +627,7 @@ template <typename Mat, typename Vec, typename PreCon, typename ExCL>
     /// \param[in]     output               write information onto output stream
     /// \return                             convergence within max_iter iterations
 {
+    DROPS_PROFILE_REGION("ParAccurPCG");
     // Check if preconditioner needs diagonal of matrix. The preconditioner
     // only computes the diagonal new, if the matrix has changed
     if (M.NeedDiag())
@@ -753,6 +778,7 @@ template <typename Mat, typename Vec, typename PreCon, typename ExCL>
     /// \return  convergence within max_iter iterations
     /// \pre     the preconditioner should be able to handle a accumulated b
 {
+    DROPS_PROFILE_REGION("ParGMRES");
     // Check if preconditioner needs diagonal of matrix. The preconditioner
     // only computes the diagonal new, if the matrix has changed
     if (M.NeedDiag())
@@ -920,8 +946,7 @@ template <typename Mat, typename Vec, typename PreCon, typename ExCL>
                 if (method == RightPreconditioning)
                 {
                     M.Apply( A, w, v[i]);                   // hopefully, preconditioner do right things with accumulated v[i]
-                    w=A*w;
-                    ExX.Accumulate(w);
+                    ParMulAcc(A, w, t, w, ExX);
                 }
                 else
                     M.Apply( A, w, A*v[i]);
@@ -1007,6 +1032,7 @@ template <typename Mat, typename Vec, typename PreCon, typename ExCL>
     /// \return  convergence within max_iter iterations
     /// \pre     the preconditioner should be able to handle a accumulated b
 {
+    DROPS_PROFILE_REGION("ParModGMRES");
     Assert(x_acc.size()==b.size() && x_acc.size()==ExX.GetNum(), DROPSErrCL("ParModGMRES: Incompatible dimension"), DebugParallelNumC);
 
     // Check if preconditioner needs diagonal of matrix. The preconditioner
@@ -1058,8 +1084,7 @@ template <typename Mat, typename Vec, typename PreCon, typename ExCL>
         {
             if (method == RightPreconditioning){
                 M.Apply(A, w_acc, v_acc[i]);                // hopefully M does the right thing
-                w = A*w_acc;
-                w_acc = ExX.GetAccumulate(w);
+                ParMulAcc(A, w_acc, w, w_acc, ExX);
             }
             else{
                 M.Apply(A, w, A*v_acc[i]);
@@ -1139,6 +1164,7 @@ template <typename Mat, typename Vec, typename PreCon, typename ExCL>
     /// \pre                                the preconditioner must fulfill the following condition: M.Apply(A,x,b): b is accumulated => x is accumulated
     /// \return                             convergence within max_iter iterations
 {
+    DROPS_PROFILE_REGION("ParBiCGSTAB");
     // Check if preconditioner needs diagonal of matrix. The preconditioner
     // only computes the diagonal new, if the matrix has changed
     if (M.NeedDiag())
@@ -1260,6 +1286,7 @@ bool ParModPGCR(const Mat& A, Vec& x_acc, const Vec& b, const ExCL& ExX, PreCon&
     /// \param[in]     measure_relative_tol if true stop if |M^(-1)(b-Ax)|/|M^(-1)b| <= tol, else stop if |M^(-1)(b-Ax)|<=tol
     /// \return                             convergence within max_iter iterations
 {
+    DROPS_PROFILE_REGION("ParModPGCR");
     // Check if preconditioner needs diagonal of matrix. The preconditioner
     // only computes the diagonal new, if the matrix has changed
     if (M.NeedDiag())
@@ -1375,6 +1402,7 @@ bool ParModAccurPGCR(const Mat& A, Vec& x_acc, const Vec& b, const ExCL& ExX, Pr
     /// \param[in,out] os                   outstream pointer
     /// \return                             convergence within max_iter iterations
 {
+    DROPS_PROFILE_REGION("ParModAccurPGCR");
     // Check if preconditioner needs diagonal of matrix. The preconditioner
     // only computes the diagonal new, if the matrix has changed
     if (M.NeedDiag())
@@ -1420,8 +1448,7 @@ bool ParModAccurPGCR(const Mat& A, Vec& x_acc, const Vec& b, const ExCL& ExX, Pr
 
         // orthogonalization of p
         M.Apply(A,z_acc,r_acc);
-        y  = A*z_acc;
-        y_acc = ExX.GetAccumulate(y);
+        ParMulAcc(A, z_acc, y, y_acc, ExX);
         c[last_idx] = gamma[0];
         int k;
         for (k=0; k<=j && k<m; ++k)
@@ -1499,6 +1526,7 @@ bool ParPGCR(const Mat& A, Vec& x_acc, const Vec& b, const ExCL& ExX, PreCon& M,
     /// \param[in]     useAcc               use accurate or fast variant for inner products and norms
     /// \return                             convergence within max_iter iterations
 {
+    DROPS_PROFILE_REGION("ParPGCR");
     // Check if preconditioner needs diagonal of matrix. The preconditioner
     // only computes the diagonal new, if the matrix has changed
     if (M.NeedDiag())
@@ -1605,6 +1633,7 @@ bool ParQMR(const Mat& A, Vec& x_acc, const Vec& b, const ExCL& ExX, Lanczos lan
     /// \param[in]     measure_relative_tol if true stop if |M^(-1)(b-Ax)|/|M^(-1)b| <= tol, else stop if |M^(-1)(b-Ax)|<=tol
     /// \return                             convergence within max_iter iterations
 {
+    DROPS_PROFILE_REGION("ParQMR");
     tol*=tol;
 
     Vec d_acc(x_acc.size()), s(d_acc), r(b-A*x_acc), r_acc(r);
@@ -1674,6 +1703,7 @@ bool ParGCRMod(const Mat& A, Vec& x, const Vec& b, const ExCL& ExX, PreCon& M,
     Systems" 2nd edition, Yousef Saad, p. 196
 */
 {
+    DROPS_PROFILE_REGION("ParGCRMod");
     const size_t N= x.size();
     const bool useAccur= true;
     if (M.NeedDiag())
@@ -1693,7 +1723,7 @@ bool ParGCRMod(const Mat& A, Vec& x, const Vec& b, const ExCL& ExX, PreCon& M,
 
     resid     = ExX.Norm( r, false, useAccur, &r_acc);
     p_acc[0]  = r_acc;
-    Ap_acc[0] = ExX.GetAccumulate( Vec(A*p_acc[0]));
+    ParMulAcc(A, p_acc[0], Ar, Ap_acc[0], ExX);
 
     for ( int j=0; j<max_iter; ++j){
         // compute alpha and resid
@@ -1715,7 +1745,7 @@ bool ParGCRMod(const Mat& A, Vec& x, const Vec& b, const ExCL& ExX, PreCon& M,
         r_acc += -alpha*Ap_acc[j];
 
         // compute orthogonalization
-        Ar_acc= ExX.GetAccumulate( (Vec)(A*r_acc));
+        ParMulAcc(A, r_acc, Ar, Ar_acc, ExX);
         for ( int i=0; i<=j; ++i){
             tau[ 2*i+0]= ExX.LocDot( Ar_acc,    true, Ap_acc[i], true, useAccur);
             tau[ 2*i+1]= ExX.LocDot( Ap_acc[i], true, Ap_acc[i], true, useAccur);
@@ -1736,6 +1766,7 @@ template <typename Mat, typename Vec, typename PreCon, typename ExCL>
 bool ParGCR(const Mat& A, Vec& x, const Vec& b, const ExCL& ExX, PreCon& M,
     int m, int& max_iter, double& tol, bool measure_relative_tol, std::ostream* output)
 {
+    DROPS_PROFILE_REGION("ParGCR");
     if (M.NeedDiag())
         M.SetDiag(A);
 
@@ -0,0 +1,188 @@
+/// \file pclifecycle.h
+/// \brief lazy update policy for preconditioners which depend on changing matrices
+/// \author LNM RWTH Aachen: Patrick Esser, Joerg Grande, Sven Gross; SC RWTH Aachen: Oliver Fortmeier
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2009 LNM/SC RWTH Aachen, Germany
+*/
+
+#ifndef DROPS_PCLIFECYCLE_H
+#define DROPS_PCLIFECYCLE_H
+
+#include "misc/utils.h"
+#ifdef _PAR
+#  include "parallel/parallel.h"
+#endif
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace DROPS
+{
+
+/// \brief Decides, whether a preconditioner is updated after its matrices have changed.
+///
+/// The preconditioner calls Decide() before each application with the (summed) version of its
+/// matrices and the matrix that determines its structure. If the matrices have changed, the
+/// lifecycle either keeps the stale preconditioner, refreshes it (same sparsity pattern, i.e.,
+/// identical row and column arrays) or rebuilds it (new pattern). A period is the time between two matrix changes. The first period
+/// after an update yields the baseline number of applications; the excess applications of the
+/// following periods times the measured time per application are summed up as penalty. The
+/// preconditioner is updated, as soon as the penalty exceeds the measured time of the last update
+/// of the same kind, the number of applications exceeds maxratio times the baseline, or the
+/// stale preconditioner has been kept for maxage periods. A change of the dimensions always
+/// forces a rebuild. With maxage == 0 (the default), each change triggers an update.
+class PcLifecycleCL
+{
+  public:
+    enum ActionT { PC_Current= 0, PC_Keep= 1, PC_Refresh= 2, PC_Rebuild= 3 };
+
+  private:
+    int    maxage_;                 ///< maximal number of periods for a stale preconditioner; 0: update eagerly
+    double maxratio_;               ///< tolerated growth of the applications per period
+    size_t version_;                ///< matrix version of the current period
+    size_t rows_, cols_;            ///< dimensions at the last update
+    std::vector<size_t> rowbeg_,    ///< row and column arrays of the pattern at the last update
+                        colind_;
+    bool   valid_;                  ///< false, if a rebuild is mandatory
+    int    age_;                    ///< number of periods since the last update
+    size_t applies_;                ///< applications in the current period
+    double baseline_,               ///< applications in the first period after the last update; -1 if unknown
+           penalty_,                ///< estimated time lost by keeping the stale preconditioner
+           tupdate_[2],             ///< time of the last refresh and rebuild
+           tapply_;                 ///< time of the applications in the current period
+    size_t count_[4];               ///< number of decisions per action
+    TimerCL timer_;
+    std::ostream* output_;
+
+    /// all processes have to take the same decision, as the update may communicate
+    static double GlobalMax_( double t) {
+#ifdef _PAR
+        return ProcCL::GlobalMax( t);
+#else
+        return t;
+#endif
+    }
+    static bool GlobalOr_( bool b) {
+#ifdef _PAR
+        return ProcCL::GlobalOr( b);
+#else
+        return b;
+#endif
+    }
+    /// true, if the local pattern of M coincides with the one at the last update
+    template <class Mat>
+    bool SamePattern_( const Mat& M) const {
+        return M.num_nonzeros() == colind_.size()
+            && std::equal( rowbeg_.begin(), rowbeg_.end(), M.raw_row())
+            && std::equal( colind_.begin(), colind_.end(), M.raw_col());
+    }
+
+  public:
+    PcLifecycleCL( int maxage= 0, double maxratio= 1.5, std::ostream* output= &std::cout)
+        : maxage_( maxage), maxratio_( maxratio), version_( 0), rows_( 0), cols_( 0), valid_( false),
+          age_( 0), applies_( 0), baseline_( -1.), penalty_( 0.), tapply_( 0.), output_( output)
+    {
+        tupdate_[0]= tupdate_[1]= 0.;
+        std::fill( count_, count_ + 4, 0);
+    }
+
+    /// \name Policy
+    //@{
+    void SetPolicy( int maxage, double maxratio) { maxage_= maxage; maxratio_= maxratio; }
+    int    GetMaxAge()   const { return maxage_; }
+    double GetMaxRatio() const { return maxratio_; }
+    void   SetOutput( std::ostream* output) { output_= output; }
+    //@}
+
+    /// force a rebuild before the next application, e.g. after new matrices have been set
+    void Invalidate() { valid_= false; }
+    /// number of periods since the last update
+    int    GetAge() const { return age_; }
+    /// number of decisions for action a
+    size_t GetCount( ActionT a) const { return count_[a]; }
+
+    /// \brief Decide on the update of the preconditioner \a name; the pattern is taken from \a M.
+    /// Has to be called by all processes.
+    template <class Mat>
+    ActionT Decide( const char* name, size_t version, const Mat& M);
+
+    /// \name Measure the cost of updates and applications
+    //@{
+    void BeginUpdate() { timer_.Reset(); }
+    /// the preconditioner has been updated by action a for the matrices with the given version
+    template <class Mat>
+    void EndUpdate( ActionT a, size_t version, const Mat& M) {
+        timer_.Stop();
+        tupdate_[a == PC_Rebuild]= GlobalMax_( timer_.GetTime());
+        if (tupdate_[0] == 0.) // no refresh measured yet
+            tupdate_[0]= tupdate_[1];
+        version_= version;
+        rows_= M.num_rows(); cols_= M.num_cols();
+        rowbeg_.assign( M.raw_row(), M.raw_row() + M.num_rows() + 1);
+        colind_.assign( M.raw_col(), M.raw_col() + M.num_nonzeros());
+        valid_= true;
+        age_= 0;
+        baseline_= -1.;
+        penalty_= 0.;
+    }
+    void BeginApply() { timer_.Reset(); }
+    void EndApply()   { timer_.Stop(); tapply_+= timer_.GetTime(); ++applies_; }
+    //@}
+};
+
+template <class Mat>
+PcLifecycleCL::ActionT PcLifecycleCL::Decide( const char* name, size_t version, const Mat& M)
+{
+    // the local versions may differ, but all processes have to enter the collectives below
+    if (!GlobalOr_( !valid_ || version != version_))
+        return PC_Current;
+    version_= version;
+
+    ActionT a= PC_Rebuild;
+    if (!GlobalOr_( !valid_ || M.num_rows() != rows_ || M.num_cols() != cols_)) {
+        const bool   samepattern= !GlobalOr_( !SamePattern_( M));
+        const double n= applies_,
+                     tperapply= applies_ > 0 ? GlobalMax_( tapply_)/applies_ : 0.;
+        if (baseline_ < 0.)
+            baseline_= n;
+        else
+            penalty_+= std::max( 0., n - baseline_)*tperapply;
+        const bool update= maxage_ <= 0 || age_ >= maxage_ || n > maxratio_*baseline_
+            || penalty_ >= tupdate_[!samepattern];
+        a= update ? (samepattern ? PC_Refresh : PC_Rebuild) : PC_Keep;
+        if (maxage_ > 0 && output_ != 0) {
+            static const char* actname[4]= { "current", "keep", "refresh", "rebuild" };
+            IF_MASTER
+                (*output_) << name << ": " << actname[a] << " (age " << age_ << ", applications " << n
+                           << ", baseline " << baseline_ << ", penalty " << penalty_ << "s, last update "
+                           << tupdate_[!samepattern] << "s)\n";
+        }
+    }
+    if (a == PC_Keep)
+        ++age_;
+    ++count_[a];
+    applies_= 0;
+    tapply_= 0.;
+    return a;
+}
+
+} // end of namespace DROPS
+
+#endif
@@ -27,6 +27,7 @@
 #define POISSONSOLVERFACTORY_H_
 
 #include "num/solver.h"
+#include "num/sparseldlt.h"
 #include "misc/params.h"
 #ifdef _HYPRE
 #include "num/hypre.h"
@@ -91,7 +92,10 @@ class PoissonSolverCL : public PoissonSolverBaseCL
     <tr><td>  5 </td><td>                     </td><td> SGS                  </td></tr>
     <tr><td>  6 </td><td>                     </td><td> SOR                  </td></tr>
     <tr><td>  7 </td><td>                     </td><td>                      </td></tr>
-    </table>*/
+    </table>
+    For the MultiGrid V-cycle with SSOR smoother (103), Poisson.DirectCoarse=1 replaces the
+    iterative coarse grid solver by the sparse LDL^T factorization DirectLDLtSolverCL,
+    which repeats only the numeric factorization, as long as the coarse pattern is unchanged.*/
 #ifndef _PAR
 template <class ProlongationT= MLMatrixCL>
 class PoissonSolverFactoryCL
@@ -122,6 +126,9 @@ class PoissonSolverFactoryCL
     MGSolversymmSORT MGSolversymmSOR_;
     typedef MGSolverCL<SSORsmoothCL, PCG_SsorCL, ProlongationT> MGSolversymmSSORT;
     MGSolversymmSSORT MGSolversymmSSOR_;
+    DirectLDLtSolverCL coarsesolverdirect_;
+    typedef MGSolverCL<SSORsmoothCL, DirectLDLtSolverCL, ProlongationT> MGSolverDirectSSORT;
+    MGSolverDirectSSORT MGSolverDirectSSOR_;
 
     //JAC-GMRes
     typedef GMResSolverCL<JACPcCL> GMResSolverT;
@@ -155,10 +162,20 @@ PoissonSolverFactoryCL<ProlongationT>::
         MGSolversymmSGS_( sgssmoother_, coarsesolversymm_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), false, P.get<int>("Poisson.SmoothingSteps"), P.get<int>("Poisson.NumLvl")),
         MGSolversymmSOR_( sorsmoother_, coarsesolversymm_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), P.get<double>("Poisson.RelativeErr"), P.get<int>("Poisson.SmoothingSteps"), P.get<int>("Poisson.NumLvl")),
         MGSolversymmSSOR_( ssorsmoother_, coarsesolversymm_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), P.get<double>("Poisson.RelativeErr"), P.get<int>("Poisson.SmoothingSteps"), P.get<int>("Poisson.NumLvl")),
+        MGSolverDirectSSOR_( ssorsmoother_, coarsesolverdirect_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), P.get<double>("Poisson.RelativeErr"), P.get<int>("Poisson.SmoothingSteps"), P.get<int>("Poisson.NumLvl")),
         GMResSolver_( JACPc_, P.get<int>("Poisson.Restart"), P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), P.get<double>("Poisson.RelativeErr")),
         GMResSolverSSOR_( SSORPc_, P.get<int>("Poisson.Restart"), P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), P.get<double>("Poisson.RelativeErr")),
         PCGSolver_( SSORPc_, P.get<int>("Poisson.Iter"), P.get<double>("Poisson.Tol"), P.get<double>("Poisson.RelativeErr"))
-        {}
+{
+    // Galerkin products P^T*A*P as coarse grid operators of the MG solvers
+    const bool galerkin= P.get<int>("Poisson.Galerkin", 0) != 0;
+    MGSolversymmJOR_.SetGalerkin( galerkin);
+    MGSolversymmGS_.SetGalerkin( galerkin);
+    MGSolversymmSGS_.SetGalerkin( galerkin);
+    MGSolversymmSOR_.SetGalerkin( galerkin);
+    MGSolversymmSSOR_.SetGalerkin( galerkin);
+    MGSolverDirectSSOR_.SetGalerkin( galerkin);
+}
 
 template <class ProlongationT>
 PoissonSolverBaseCL* PoissonSolverFactoryCL<ProlongationT>::CreatePoissonSolver()
@@ -171,8 +188,14 @@ PoissonSolverBaseCL* PoissonSolverFactoryCL<ProlongationT>::CreatePoissonSolver(
             prolongptr_ = MGSolversymmJOR_.GetProlongation();
         } break;
         case  103 : {
-            Poissonsolver = new PoissonSolverCL<MGSolversymmSSORT>( MGSolversymmSSOR_);
-            prolongptr_ = MGSolversymmSSOR_.GetProlongation();
+            if (P_.get<int>("Poisson.DirectCoarse", 0) != 0) {
+                Poissonsolver = new PoissonSolverCL<MGSolverDirectSSORT>( MGSolverDirectSSOR_);
+                prolongptr_ = MGSolverDirectSSOR_.GetProlongation();
+            }
+            else {
+                Poissonsolver = new PoissonSolverCL<MGSolversymmSSORT>( MGSolversymmSSOR_);
+                prolongptr_ = MGSolversymmSSOR_.GetProlongation();
+            }
         } break;
         case  104 : {
             Poissonsolver = new PoissonSolverCL<MGSolversymmGST>( MGSolversymmGS_);
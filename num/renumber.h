@@ -196,8 +196,51 @@ class IteratedDownwindCL
           crosswind_limit_( p.get<double>( "CrosswindLimit")) {}
 
     /// \brief Returns a permutation for the unknowns, such that they are arranged from upwind to downwind.
+    /// If component is not 0, the component map of the final Tarjan decomposition is stored there.
     template <class T>
-      PermutationT downwind_numbering (SparseMatBaseCL<T>& M);
+      PermutationT downwind_numbering (SparseMatBaseCL<T>& M, std::vector<size_t>* component= 0);
+
+    double crosswind_limit () const { return crosswind_limit_; }
+};
+
+/// \brief Downwind numbering, which reuses the last permutation as long as it is still a downwind numbering.
+/// The graph of the strong edges of M (the edges remaining after the removal of crosswind edges, see
+/// IteratedDownwindCL) and the permutation with its component map are stored. On the next call, only the rows
+/// with a changed set of strong edges are examined: If every strong edge (i,j) in these rows points downwind in
+/// the old numbering, i.e. j is numbered before i or both are in the same component, the old permutation is
+/// returned. Otherwise, or if more than max_changed_ratio of the rows changed, the numbering is recomputed by
+/// IteratedDownwindCL.
+///
+/// The matrices must refer to the same numbering of the unknowns in each call; Invalidate() must be called,
+/// if this numbering changes, e.g. after a grid modification.
+class CachedDownwindCL
+{
+  private:
+    IteratedDownwindCL  dw_;
+    double              max_changed_ratio_;
+    std::vector<size_t> row_beg_,          ///< graph of the strong edges of the last call
+                        col_;
+    PermutationT        p_;                ///< permutation of the last call, empty if invalid
+    std::vector<size_t> component_;        ///< component map of the Tarjan decomposition belonging to p_
+    bool                reused_;
+
+    /// \brief Check, whether the strong edges of the rows, which differ from the stored graph, point downwind in p_.
+    bool is_downwind (const std::vector<size_t>& row_beg, const std::vector<size_t>& col) const;
+
+  public:
+    explicit CachedDownwindCL (const IteratedDownwindCL& dw= IteratedDownwindCL(), double max_changed_ratio= 0.05)
+        : dw_( dw), max_changed_ratio_( max_changed_ratio), reused_( false) {}
+    CachedDownwindCL (const ParamCL& p)
+        : dw_( p), max_changed_ratio_( p.get<double>( "MaxChangedRatio")), reused_( false) {}
+
+    /// \brief Forget the stored numbering; the next call computes the numbering from scratch.
+    void Invalidate () { p_.clear(); }
+    /// \brief True, if the last call returned the stored permutation.
+    bool WasReused () const { return reused_; }
+
+    /// \brief Returns a permutation for the unknowns, such that they are arranged from upwind to downwind. M is modified as by IteratedDownwindCL.
+    template <class T>
+      const PermutationT& downwind_numbering (SparseMatBaseCL<T>& M);
 };
 
 
@@ -325,7 +325,7 @@ void remove_crosswind_edges (SparseMatBaseCL<T>& M, double crosswind_ratio)
 }
 
 template <class T>
-PermutationT IteratedDownwindCL::downwind_numbering (SparseMatBaseCL<T>& M)
+PermutationT IteratedDownwindCL::downwind_numbering (SparseMatBaseCL<T>& M, std::vector<size_t>* component)
 {
     const size_t dim= M.num_rows();
 
@@ -351,8 +351,54 @@ PermutationT IteratedDownwindCL::downwind_numbering (SparseMatBaseCL<T>& M)
     re_num.stats( std::cout);
     std::cout << "IteratedDownwindCL::downwind_numbering: " << counter << " iterations.\n";
 
+    if (component != 0)
+        *component= re_num.component_map();
     return re_num.permutation();
 }
 
+inline bool CachedDownwindCL::is_downwind (const std::vector<size_t>& row_beg, const std::vector<size_t>& col) const
+{
+    const size_t dim= row_beg.size() - 1;
+    size_t num_changed= 0;
+    for (size_t i= 0; i < dim; ++i) {
+        if (row_beg[i+1] - row_beg[i] == row_beg_[i+1] - row_beg_[i]
+            && std::equal( col.begin() + row_beg[i], col.begin() + row_beg[i+1], col_.begin() + row_beg_[i]))
+            continue;
+        if (++num_changed > max_changed_ratio_*dim)
+            return false;
+        for (size_t k= row_beg[i]; k < row_beg[i+1]; ++k)
+            if (p_[col[k]] > p_[i] && component_[col[k]] != component_[i])
+                return false;
+    }
+    std::cout << "CachedDownwindCL::downwind_numbering: " << num_changed << " rows changed, the numbering is still downwind.\n";
+    return true;
+}
+
+template <class T>
+const PermutationT& CachedDownwindCL::downwind_numbering (SparseMatBaseCL<T>& M)
+{
+    const size_t dim= M.num_rows();
+
+    // the graph of the strong edges; the columns of each row are sorted
+    sort_row_entries( M);
+    remove_crosswind_edges( M, dw_.crosswind_limit());
+    std::vector<size_t> row_beg( dim + 1, 0), col;
+    col.reserve( M.num_nonzeros());
+    for (size_t i= 0; i < dim; ++i) {
+        for (size_t k= M.row_beg( i); k < M.row_beg( i + 1); ++k)
+            if (M.val( k) > T())
+                col.push_back( M.col_ind( k));
+        std::sort( col.begin() + row_beg[i], col.end());
+        row_beg[i+1]= col.size();
+    }
+
+    reused_= p_.size() == dim && row_beg_.size() == dim + 1 && is_downwind( row_beg, col);
+    if (!reused_)
+        p_= dw_.downwind_numbering( M, &component_);
+    row_beg_.swap( row_beg);
+    col_.swap( col);
+    return p_;
+}
+
 
 } // end of namspace DROPS
@@ -26,9 +26,11 @@
 #define DROPS_SOLVER_H
 
 #include <vector>
+#include <algorithm>
 #include "misc/container.h"
 #include "num/spmat.h"
 #include "num/spblockmat.h"
+#include "misc/profiler.h"
 
 namespace DROPS
 {
@@ -323,6 +325,8 @@ class PreGSCL<PM,false>
   public:
     PreGSCL (double om= 1.0) : _omega(om) {}
 
+    double GetOmega() const { return _omega; }
+
     template <typename Mat, typename Vec>
     void Apply(const Mat& A, Vec& x, const Vec& b) const
     {
@@ -629,11 +633,147 @@ Vec NEGSPcCL::transp_mul(const Mat& A, const Vec& b) const
     return x;
 }
 
+//=============================================================================
+//  Multivectors and block preconditioning
+//=============================================================================
+
+// A multivector with m columns is stored row-interleaved in one VectorCL, i.e.
+// X[i*m+j] is the i-th component of column j. Thus, the m entries of a row are
+// contiguous and a matrix can be applied to all columns in one sweep (mul_multi).
+
+/// \brief d[j]= dot( X_j, Y_j) for all columns j of the multivectors X and Y with m columns.
+inline void dot_multi (const VectorCL& X, const VectorCL& Y, size_t m, std::vector<double>& d)
+{
+    Assert( X.size()==Y.size() && X.size()%m==0, DROPSErrCL("dot_multi: incompatible dimensions"), DebugNumericC);
+    d.assign( m, 0.);
+    const double* x= Addr( X), * y= Addr( Y);
+    for (size_t k= 0; k < X.size(); k+= m)
+        for (size_t j= 0; j < m; ++j)
+            d[j]+= x[k+j]*y[k+j];
+}
+
+/// \brief Y_j+= a[j]*X_j for all columns j of the multivectors X and Y with m columns.
+inline void axpy_multi (const std::vector<double>& a, const VectorCL& X, VectorCL& Y, size_t m)
+{
+    Assert( X.size()==Y.size() && X.size()%m==0, DROPSErrCL("axpy_multi: incompatible dimensions"), DebugNumericC);
+    const double* x= Addr( X);
+    double* y= Addr( Y);
+    for (size_t k= 0; k < X.size(); k+= m)
+        for (size_t j= 0; j < m; ++j)
+            y[k+j]+= a[j]*x[k+j];
+}
+
+// One step of the Jacobi method with start vector 0 for the multivector B with m columns
+inline void
+SolveGSstepMulti(const PreDummyCL<PB_JAC0>&, const MatrixCL& A, VectorCL& X, const VectorCL& B, size_t m, double omega)
+{
+    const size_t n= A.num_rows();
+    size_t nz;
+
+    for (size_t i= 0; i < n; ++i) {
+        nz= A.row_beg( i);
+        for (const size_t end= A.row_beg( i+1); A.col_ind( nz) != i && nz < end; ++nz) ; // empty loop
+        const double d= omega/A.val( nz);
+        for (size_t j= 0; j < m; ++j)
+            X[i*m+j]= d*B[i*m+j];
+    }
+}
+
+// One step of the Symmetric-Gauss-Seidel/SSOR method with start vector 0 for the
+// multivector B with m columns; omega == 1 is SGS.
+inline void
+SolveGSstepMulti(const PreDummyCL<PB_SGS0>&, const MatrixCL& A, VectorCL& X, const VectorCL& B, size_t m, double omega)
+{
+    const size_t n= A.num_rows();
+    std::vector<double> sum( m);
+
+    for (size_t i=0; i<n; ++i)
+    {
+        for (size_t k= 0; k < m; ++k)
+            sum[k]= B[i*m+k];
+        size_t j= A.row_beg(i);
+        for ( ; A.col_ind(j) < i; ++j) {
+            const double a= A.val(j);
+            const size_t c= A.col_ind(j)*m;
+            for (size_t k= 0; k < m; ++k)
+                sum[k]-= a*X[c+k];
+        }
+        const double d= omega/A.val(j);
+        for (size_t k= 0; k < m; ++k)
+            X[i*m+k]= d*sum[k];
+    }
+
+    for (size_t i=n; i>0; )
+    {
+        --i;
+        std::fill( sum.begin(), sum.end(), 0.);
+        size_t j= A.row_beg(i+1)-1;
+        for ( ; A.col_ind(j) > i; --j) {
+            const double a= A.val(j);
+            const size_t c= A.col_ind(j)*m;
+            for (size_t k= 0; k < m; ++k)
+                sum[k]-= a*X[c+k];
+        }
+        const double d= omega/A.val(j);
+        for (size_t k= 0; k < m; ++k)
+            X[i*m+k]= (2.-omega)*X[i*m+k] + d*sum[k];
+    }
+}
+
+/// \brief Apply the preconditioner pc to all columns of the multivector B with m columns.
+///
+/// The generic version applies pc column by column. The overloads below for the identity,
+/// Jacobi, SGS and SSOR with start vector 0 sweep through the matrix once for all columns.
+template <typename PC, typename Mat>
+void BlockApply (const PC& pc, const Mat& A, VectorCL& X, const VectorCL& B, size_t m)
+{
+    const size_t n= B.size()/m;
+    if (X.size() != B.size()) X.resize( B.size());
+    VectorCL x( n), b( n);
+    for (size_t j= 0; j < m; ++j) {
+        x= X[std::slice( j, n, m)];
+        b= B[std::slice( j, n, m)];
+        pc.Apply( A, x, b);
+        X[std::slice( j, n, m)]= x;
+    }
+}
+
+template <typename Mat>
+inline void BlockApply (const DummyPcCL&, const Mat&, VectorCL& X, const VectorCL& B, size_t)
+{
+    if (X.size() != B.size()) X.resize( B.size());
+    X= B;
+}
+
+inline void BlockApply (const PreGSCL<P_JAC0>& pc, const MatrixCL& A, VectorCL& X, const VectorCL& B, size_t m)
+{
+    if (X.size() != B.size()) X.resize( B.size());
+    SolveGSstepMulti( PreDummyCL<PB_JAC0>(), A, X, B, m, pc.GetOmega());
+}
+
+inline void BlockApply (const PreGSCL<P_SGS0>&, const MatrixCL& A, VectorCL& X, const VectorCL& B, size_t m)
+{
+    if (X.size() != B.size()) X.resize( B.size());
+    SolveGSstepMulti( PreDummyCL<PB_SGS0>(), A, X, B, m, 1.0);
+}
+
+inline void BlockApply (const PreGSCL<P_SSOR0>& pc, const MatrixCL& A, VectorCL& X, const VectorCL& B, size_t m)
+{
+    if (X.size() != B.size()) X.resize( B.size());
+    SolveGSstepMulti( PreDummyCL<PB_SGS0>(), A, X, B, m, pc.GetOmega());
+}
+
+template <PreMethGS PM>
+void BlockApply (const PreGSCL<PM,false>& pc, const MLMatrixCL& A, VectorCL& X, const VectorCL& B, size_t m)
+{
+    BlockApply( pc, A.GetFinest(), X, B, m);
+}
+
 
 //*****************************************************************************
 //
 //  Iterative solvers: CG, PCG, PCGNE, GMRES, PMINRES, MINRES, BiCGStab, GCR,
-//                     GMRESR, IDR(s)
+//                     GMRESR, IDR(s), BlockPCG, BlockGMRES
 //
 //*****************************************************************************
 
@@ -715,6 +855,7 @@ bool
 PCG(const Mat& A, Vec& x, const Vec& b, const PreCon& M,
     int& max_iter, double& tol, bool measure_relative_tol= false)
 {
+    DROPS_PROFILE_REGION("PCG");
     const size_t n= x.size();
     Vec p( n), z( n), q( n), r( b - A*x);
     double rho, rho_1, normb= norm( b), resid;
@@ -775,6 +916,7 @@ bool
 PCGNE(const Mat& A, Vec& u, const Vec& b, const PreCon& M,
     int& max_iter, double& tol, bool measure_relative_tol= false)
 {
+    DROPS_PROFILE_REGION("PCGNE");
     Vec r( b - A*transp_mul( A, u));
     double normb= norm( b);
     if (normb == 0.0 || measure_relative_tol == false) normb= 1.0;
@@ -886,6 +1028,7 @@ GMRES(const Mat& A, Vec& x, const Vec& b, const PreCon& M,
       int /*restart parameter*/ m, int& max_iter, double& tol,
       bool measure_relative_tol= true, bool calculate2norm= false, PreMethGMRES method = LeftPreconditioning)
 {
+    DROPS_PROFILE_REGION("GMRES");
     m= (m <= max_iter) ? m : max_iter; // m > max_iter only wastes memory.
 
     DMatrixCL<double> H( m, m);
@@ -1004,6 +1147,226 @@ GMRES(const Mat& A, Vec& x, const Vec& b, const PreCon& M,
 }
 
 
+//-----------------------------------------------------------------------------
+// Block solvers for m right-hand sides, which are stored as row-interleaved
+// multivector B (see dot_multi); the initial guesses and solutions X are stored
+// in the same way. Each column is iterated with its own Krylov space, but the
+// multiplications with A (mul_multi) and the preconditioner (BlockApply) are
+// performed for all columns at once, such that A is read once per iteration
+// instead of once per right-hand side. Converged columns are frozen.
+// The block solvers are serial, as dot_multi does not accumulate distributed vectors.
+//
+// The return value indicates convergence of all columns within max_iter (input)
+// iterations (true), or no convergence within max_iter iterations (false).
+// Upon return, output arguments have the following values:
+//
+//        X - approximate solutions to A X_j = B_j
+// max_iter - number of iterations performed
+//      tol - maximum over the columns of the 2-norm of the (relative, see below)
+//            residual after the final iteration; for BlockGMRES, the residual is
+//            preconditioned.
+// measure_relative_tol - If true, stop column j if |B_j - AX_j|/|B_j| <= tol,
+//     if false, stop if |B_j - AX_j| <= tol.
+//-----------------------------------------------------------------------------
+
+// Determine, which of the columns are converged; returns the number of active columns
+// and the maximal residual in maxres.
+inline size_t BlockSolver_Check(const std::vector<double>& resnorm_sq, const std::vector<double>& normb,
+    double tol, std::vector<double>& resid, std::vector<bool>& active, double& maxres)
+{
+    size_t numactive= 0;
+    maxres= 0.;
+    for (size_t j= 0; j < active.size(); ++j) {
+        if (active[j]) {
+            resid[j]= std::sqrt( resnorm_sq[j])/normb[j];
+            active[j]= resid[j] > tol;
+        }
+        numactive+= active[j];
+        maxres= std::max( maxres, resid[j]);
+    }
+    return numactive;
+}
+
+template <typename Mat, typename PreCon>
+bool
+BlockPCG(const Mat& A, VectorCL& X, const VectorCL& B, size_t m, const PreCon& M,
+    int& max_iter, double& tol, bool measure_relative_tol= false)
+{
+    DROPS_PROFILE_REGION("BlockPCG");
+    const size_t N= X.size();
+    VectorCL P( N), Z( N), Q( N), R( B - mul_multi( A, X, m));
+    std::vector<double> normb, rho, rho_1, pq, resid( m, 0.), alpha( m), beta( m);
+    std::vector<bool> active( m, true);
+    double maxres;
+
+    dot_multi( B, B, m, normb);
+    for (size_t j= 0; j < m; ++j)
+        normb[j]= (normb[j] == 0.0 || measure_relative_tol == false) ? 1.0 : std::sqrt( normb[j]);
+
+    dot_multi( R, R, m, pq);
+    if (BlockSolver_Check( pq, normb, tol, resid, active, maxres) == 0) {
+        tol= maxres;
+        max_iter= 0;
+        return true;
+    }
+
+    BlockApply( M, A, Z, R, m);
+    P= Z;
+    dot_multi( R, Z, m, rho);
+    for (int i= 1; i <= max_iter; ++i) {
+        Q= mul_multi( A, P, m);
+        dot_multi( P, Q, m, pq);
+        for (size_t j= 0; j < m; ++j)
+            alpha[j]= active[j] ? rho[j]/pq[j] : 0.;
+        axpy_multi( alpha, P, X, m);                // X_j+= alpha_j*P_j
+        for (size_t j= 0; j < m; ++j) alpha[j]= -alpha[j];
+        axpy_multi( alpha, Q, R, m);                // R_j-= alpha_j*Q_j
+
+        dot_multi( R, R, m, pq);
+        if (BlockSolver_Check( pq, normb, tol, resid, active, maxres) == 0) {
+            tol= maxres;
+            max_iter= i;
+            return true;
+        }
+
+        BlockApply( M, A, Z, R, m);
+        rho_1= rho;
+        dot_multi( R, Z, m, rho);
+        for (size_t j= 0; j < m; ++j)
+            beta[j]= active[j] ? rho[j]/rho_1[j] : 0.;
+        for (size_t k= 0; k < N; k+= m)             // P_j= Z_j + beta_j*P_j, frozen columns: P_j= 0
+            for (size_t j= 0; j < m; ++j)
+                P[k+j]= active[j] ? Z[k+j] + beta[j]*P[k+j] : 0.;
+    }
+    tol= maxres;
+    return false;
+}
+
+// X_j+= V_j*y, where y solves the upper triangular system H_j y= s_j of size k+1. The
+// Hessenberg matrix of column j is stored column-wise in H[j], the rotated right-hand
+// sides in the multivector s.
+inline void BlockGMRES_Update(VectorCL& X, size_t m, size_t j, int k, const VectorCL& H, int restart,
+    const VectorCL& s, const std::vector<VectorCL>& V)
+{
+    std::vector<double> y( k + 1);
+    for (int i= 0; i <= k; ++i)
+        y[i]= s[i*m+j];
+
+    // Backsolve:
+    for (int i= k; i >= 0; --i) {
+        y[i]/= H[i*restart+i];
+        for (int l= i-1; l >= 0; --l)
+            y[l]-= H[i*restart+l]*y[i];
+    }
+
+    for (int i= 0; i <= k; ++i)
+        for (size_t r= j; r < X.size(); r+= m)
+            X[r]+= y[i]*V[i][r];
+}
+
+// Left preconditioned, restarted GMRES for m right-hand sides; restart >= 2.
+template <typename Mat, typename PreCon>
+bool
+BlockGMRES(const Mat& A, VectorCL& X, const VectorCL& B, size_t m, const PreCon& M,
+    int restart, int& max_iter, double& tol, bool measure_relative_tol= true)
+{
+    DROPS_PROFILE_REGION("BlockGMRES");
+    restart= std::max( 2, std::min( restart, max_iter)); // restart > max_iter only wastes memory.
+
+    const size_t N= B.size();
+    std::vector<VectorCL> H( m, VectorCL( restart*restart)), V( restart);
+    VectorCL s( restart*m), cs( restart*m), sn( restart*m), W( N), R( N);
+    std::vector<double> normb, beta, h, resid( m, 0.);
+    std::vector<bool> active( m, true);
+    std::vector<int> last( m);
+    double maxres;
+    for (int i= 0; i < restart; ++i)
+        V[i].resize( N);
+
+    BlockApply( M, A, W, B, m);
+    dot_multi( W, W, m, normb);
+    for (size_t j= 0; j < m; ++j)
+        normb[j]= (normb[j] == 0.0 || measure_relative_tol == false) ? 1.0 : std::sqrt( normb[j]);
+
+    BlockApply( M, A, R, VectorCL( B - mul_multi( A, X, m)), m);
+    dot_multi( R, R, m, beta);
+    if (BlockSolver_Check( beta, normb, tol, resid, active, maxres) == 0) {
+        tol= maxres;
+        max_iter= 0;
+        return true;
+    }
+
+    int it= 1;
+    while (it <= max_iter) {
+        for (size_t j= 0; j < m; ++j)
+            beta[j]= std::sqrt( beta[j]);
+        for (size_t k= 0; k < N; k+= m)
+            for (size_t j= 0; j < m; ++j)
+                V[0][k+j]= active[j] ? R[k+j]/beta[j] : 0.;
+        s= 0.;
+        for (size_t j= 0; j < m; ++j) {
+            s[j]= beta[j];
+            last[j]= -1;
+        }
+
+        size_t numactive= 1;
+        for (int i= 0; i < restart - 1 && it <= max_iter && numactive > 0; ++i, ++it) {
+            BlockApply( M, A, W, mul_multi( A, V[i], m), m);
+            for (int k= 0; k <= i; ++k) { // modified Gram-Schmidt for all columns
+                dot_multi( W, V[k], m, h);
+                for (size_t j= 0; j < m; ++j) {
+                    H[j][i*restart+k]= h[j];
+                    h[j]= -h[j];
+                }
+                axpy_multi( h, V[k], W, m);
+            }
+            dot_multi( W, W, m, h);
+            for (size_t j= 0; j < m; ++j)
+                h[j]= H[j][i*restart+i+1]= std::sqrt( h[j]);
+            for (size_t k= 0; k < N; k+= m)
+                for (size_t j= 0; j < m; ++j)
+                    V[i+1][k+j]= (active[j] && h[j] != 0.) ? W[k+j]/h[j] : 0.;
+
+            for (size_t j= 0; j < m; ++j) {
+                if (!active[j]) continue;
+                VectorCL& Hj= H[j];
+                for (int k= 0; k < i; ++k)
+                    GMRES_ApplyPlaneRotation( Hj[i*restart+k], Hj[i*restart+k+1], cs[k*m+j], sn[k*m+j]);
+                GMRES_GeneratePlaneRotation( Hj[i*restart+i], Hj[i*restart+i+1], cs[i*m+j], sn[i*m+j]);
+                GMRES_ApplyPlaneRotation( Hj[i*restart+i], Hj[i*restart+i+1], cs[i*m+j], sn[i*m+j]);
+                GMRES_ApplyPlaneRotation( s[i*m+j], s[(i+1)*m+j], cs[i*m+j], sn[i*m+j]);
+                last[j]= i;
+                resid[j]= std::abs( s[(i+1)*m+j])/normb[j];
+                if (resid[j] <= tol) { // freeze column j
+                    BlockGMRES_Update( X, m, j, i, Hj, restart, s, V);
+                    active[j]= false;
+                }
+            }
+            numactive= std::count( active.begin(), active.end(), true);
+        }
+
+        for (size_t j= 0; j < m; ++j)
+            if (active[j] && last[j] >= 0)
+                BlockGMRES_Update( X, m, j, last[j], H[j], restart, s, V);
+        if (numactive == 0) {
+            tol= *std::max_element( resid.begin(), resid.end());
+            max_iter= it - 1;
+            return true;
+        }
+
+        BlockApply( M, A, R, VectorCL( B - mul_multi( A, X, m)), m);
+        dot_multi( R, R, m, beta);
+        if (BlockSolver_Check( beta, normb, tol, resid, active, maxres) == 0) {
+            tol= maxres;
+            max_iter= it - 1;
+            return true;
+        }
+    }
+    tol= *std::max_element( resid.begin(), resid.end());
+    return false;
+}
+
+
 // One recursive step of Lanzcos' algorithm for computing an ONB (q1, q2, q3,...)
 // of the Krylovspace of A for a given starting vector r. This is a three term
 // recursion, computing the next q_i from the two previous ones.
@@ -1163,6 +1526,7 @@ bool
 PMINRES(const Mat& A, Vec& x, const Vec&, Lanczos& q, int& max_iter, double& tol,
     bool measure_relative_tol= false)
 {
+    DROPS_PROFILE_REGION("PMINRES");
     Vec dx( x.size());
     const double norm_r0= q.norm_r0();
     double normb= std::fabs( norm_r0);
@@ -1285,6 +1649,7 @@ BICGSTAB( const Mat& A, Vec& x, const Vec& b,
     const Preconditioner& M, int& max_iter, double& tol,
     bool measure_relative_tol= true)
 {
+    DROPS_PROFILE_REGION("BICGSTAB");
     double rho_1= 0.0, rho_2= 0.0, alpha= 0.0, beta= 0.0, omega= 0.0;
     Vec p( x.size()), phat( x.size()), s( x.size()), shat( x.size()),
         t( x.size()), v( x.size());
@@ -1348,6 +1713,180 @@ BICGSTAB( const Mat& A, Vec& x, const Vec& b,
     return false;
 }
 
+//*****************************************************************
+// GCRRecycleSpaceCL
+//
+// Subspace recycled between consecutive solves by GCR and GMRESR
+// (deflated GCR, cf. GCRO-DR). It consists of pairs (u_i, c_i) with
+// c_i= A*u_i and orthonormal c_i.
+//
+// Before a solve, Refresh recomputes the c_i for the current matrix and
+// orthonormalizes them; this costs one matrix-vector product per
+// recycled vector, such that changes of the matrix between time steps
+// are taken into account. Vectors of the wrong size, e.g. after mesh
+// adaptation, are discarded. Project removes the components of the
+// initial residual in span(c_i); afterwards, the new search directions
+// are kept orthogonal to the c_i by Orthogonalize.
+//
+// After a solve, Update selects the new subspace from the old one and the
+// search directions of the solve: Among all w= W*y, W= [u_i, s_j], the
+// vectors with the smallest ratio |A*w|/|w| are kept. As A*W has
+// orthonormal columns, these are the eigenvectors of W^T*W to the
+// largest eigenvalues. They approximate the right singular vectors to
+// the smallest singular values of A, which slow down the convergence.
+//*****************************************************************
+template <class Vec>
+class GCRRecycleSpaceCL
+{
+  private:
+    size_t           maxdim_; ///< maximal number of recycled vectors
+    std::vector<Vec> u_, c_;  ///< recycled pairs with c_= A*u_
+
+    /// \brief Eigenvalues and -vectors of the symmetric n x n matrix a (stored row by row) by the cyclic Jacobi method;
+    /// a is overwritten by the diagonalized matrix, the eigenvectors are the columns of v.
+    static void JacobiEigen_ (std::vector<double>& a, size_t n, std::vector<double>& v);
+
+  public:
+    GCRRecycleSpaceCL (size_t maxdim= 0) : maxdim_( maxdim) {}
+
+    size_t GetMaxDim () const { return maxdim_; }
+    void   SetMaxDim (size_t maxdim) { maxdim_= maxdim; if (u_.size() > maxdim_) { u_.resize( maxdim_); c_.resize( maxdim_); } }
+    size_t size      () const { return u_.size(); }
+    void   Clear     ()       { u_.clear(); c_.clear(); }
+
+    /// \brief Recompute c_i= A*u_i and orthonormalize them; vectors of another size than n are discarded.
+    template <class Mat>
+    void Refresh (const Mat& A, size_t n);
+    /// \brief x+= U*C^T*r, r-= C*C^T*r
+    void Project (Vec& x, Vec& r) const {
+        for (size_t i= 0; i < c_.size(); ++i) {
+            const double gamma= dot( r, c_[i]);
+            x+= gamma*u_[i];
+            r-= gamma*c_[i];
+        }
+    }
+    /// \brief v-= C*C^T*v, s-= U*C^T*v
+    void Orthogonalize (Vec& s, Vec& v) const {
+        for (size_t i= 0; i < c_.size(); ++i) {
+            const double alpha= dot( v, c_[i]);
+            v-= alpha*c_[i];
+            s-= alpha*u_[i];
+        }
+    }
+    /// \brief Select the new subspace from the recycled vectors and the search directions s[i], v[i]= A*s[i], i= first, ..., s.size()-1.
+    void Update (const std::vector<Vec>& s, const std::vector<Vec>& v, size_t first= 0);
+};
+
+template <class Vec>
+void GCRRecycleSpaceCL<Vec>::JacobiEigen_ (std::vector<double>& a, size_t n, std::vector<double>& v)
+{
+    v.assign( n*n, 0.);
+    for (size_t i= 0; i < n; ++i)
+        v[i*n+i]= 1.;
+    for (int sweep= 0; sweep < 50; ++sweep) {
+        double off= 0., diag= 0.;
+        for (size_t p= 0; p < n; ++p) {
+            diag+= a[p*n+p]*a[p*n+p];
+            for (size_t q= p+1; q < n; ++q)
+                off+= a[p*n+q]*a[p*n+q];
+        }
+        if (off <= 1e-30*diag)
+            return;
+        for (size_t p= 0; p < n; ++p)
+            for (size_t q= p+1; q < n; ++q) {
+                if (a[p*n+q] == 0.) continue;
+                const double theta= (a[q*n+q] - a[p*n+p])/(2.*a[p*n+q]),
+                             t= (theta >= 0. ? 1. : -1.)/(std::fabs( theta) + std::sqrt( theta*theta + 1.)),
+                             c= 1./std::sqrt( t*t + 1.),
+                             s= t*c;
+                for (size_t k= 0; k < n; ++k) { // columns p, q
+                    const double akp= a[k*n+p], akq= a[k*n+q];
+                    a[k*n+p]= c*akp - s*akq;
+                    a[k*n+q]= s*akp + c*akq;
+                }
+                for (size_t k= 0; k < n; ++k) { // rows p, q
+                    const double apk= a[p*n+k], aqk= a[q*n+k];
+                    a[p*n+k]= c*apk - s*aqk;
+                    a[q*n+k]= s*apk + c*aqk;
+                }
+                for (size_t k= 0; k < n; ++k) {
+                    const double vkp= v[k*n+p], vkq= v[k*n+q];
+                    v[k*n+p]= c*vkp - s*vkq;
+                    v[k*n+q]= s*vkp + c*vkq;
+                }
+            }
+    }
+}
+
+template <class Vec>
+  template <class Mat>
+void GCRRecycleSpaceCL<Vec>::Refresh (const Mat& A, size_t n)
+{
+    if (!u_.empty() && u_[0].size() != n)
+        Clear();
+    size_t j= 0;
+    for (size_t i= 0; i < u_.size(); ++i) {
+        if (i != j)
+            u_[j]= u_[i];
+        c_[j]= A*u_[j];
+        const double norm0= norm( c_[j]);
+        for (size_t l= 0; l < j; ++l) {
+            const double alpha= dot( c_[j], c_[l]);
+            c_[j]-= alpha*c_[l];
+            u_[j]-= alpha*u_[l];
+        }
+        const double beta= norm( c_[j]);
+        if (beta <= 1e-10*norm0) // linearly dependent
+            continue;
+        c_[j]/= beta;
+        u_[j]/= beta;
+        ++j;
+    }
+    u_.resize( j);
+    c_.resize( j);
+}
+
+template <class Vec>
+void GCRRecycleSpaceCL<Vec>::Update (const std::vector<Vec>& s, const std::vector<Vec>& v, size_t first)
+{
+    const size_t k= u_.size(), n= k + s.size() - first;
+    if (maxdim_ == 0 || s.size() <= first)
+        return;
+
+    // W= [u_, s], A*W= [c_, v]
+    std::vector<const Vec*> w( n), aw( n);
+    for (size_t i= 0; i < k; ++i) {
+        w[i]= &u_[i];
+        aw[i]= &c_[i];
+    }
+    for (size_t i= k; i < n; ++i) {
+        w[i]= &s[first + i - k];
+        aw[i]= &v[first + i - k];
+    }
+    std::vector<double> G( n*n), Y;
+    for (size_t i= 0; i < n; ++i)
+        for (size_t j= 0; j <= i; ++j)
+            G[i*n+j]= G[j*n+i]= dot( *w[i], *w[j]);
+    JacobiEigen_( G, n, Y);
+
+    // eigenvalues in descending order
+    std::vector<std::pair<double, size_t> > ev( n);
+    for (size_t i= 0; i < n; ++i)
+        ev[i]= std::make_pair( -G[i*n+i], i);
+    std::sort( ev.begin(), ev.end());
+
+    const size_t newdim= std::min( maxdim_, n);
+    std::vector<Vec> u( newdim, Vec( w[0]->size())), c( newdim, Vec( w[0]->size()));
+    for (size_t j= 0; j < newdim; ++j)
+        for (size_t i= 0; i < n; ++i) {
+            const double y= Y[i*n + ev[j].second];
+            u[j]+= y*(*w[i]);
+            c[j]+= y*(*aw[i]);
+        }
+    u_.swap( u);
+    c_.swap( c);
+}
+
 //*****************************************************************
 // GCR
 //
@@ -1371,16 +1910,24 @@ BICGSTAB( const Mat& A, Vec& x, const Vec& b,
 //     new vector sn (min-alpha strategy).
 // measure_relative_tol -- If true, stop if |b - Ax|/|b| <= tol,
 //     if false, stop if |b - Ax| <= tol. ( |.| is the euclidean norm.)
+// recycle -- If not 0, the search directions are kept orthogonal to the
+//     recycled subspace, which is updated at the end, see GCRRecycleSpaceCL.
 //
 //*****************************************************************
 template <class Mat, class Vec, class Preconditioner>
 bool
 GCR(const Mat& A, Vec& x, const Vec& b, const Preconditioner& M,
-    int m, int& max_iter, double& tol, bool measure_relative_tol= true)
+    int m, int& max_iter, double& tol, bool measure_relative_tol= true,
+    GCRRecycleSpaceCL<Vec>* recycle= 0)
 {
+    DROPS_PROFILE_REGION("GCR");
     m= (m <= max_iter) ? m : max_iter; // m > max_iter only wastes memory.
 
     Vec r( b - A*x);
+    if (recycle) {
+        recycle->Refresh( A, b.size());
+        recycle->Project( x, r);
+    }
     Vec sn( b.size()), vn( b.size());
     std::vector<Vec> s, v;
     std::vector<double> a( m);
@@ -1393,10 +1940,12 @@ GCR(const Mat& A, Vec& x, const Vec& b, const Preconditioner& M,
         if (resid < tol) {
             tol= resid;
             max_iter= k;
+            if (recycle) recycle->Update( s, v);
             return true;
         }
         M.Apply( A, sn, r);
         vn= A*sn;
+        if (recycle) recycle->Orthogonalize( sn, vn);
         for (int i= 0; i < k && i < m; ++i) {
             const double alpha= dot( vn, v[i]);
             a[i]= alpha;
@@ -1427,6 +1976,7 @@ GCR(const Mat& A, Vec& x, const Vec& b, const Preconditioner& M,
         }
     }
     tol= resid;
+    if (recycle) recycle->Update( s, v);
     return false;
 }
 
@@ -1449,14 +1999,23 @@ GCR(const Mat& A, Vec& x, const Vec& b, const Preconditioner& M,
 //
 // measure_relative_tol - If true, stop if |b - Ax|/|b| <= tol,
 //     if false, stop if |b - Ax| <= tol. ( |.| is the euclidean norm.)
+// recycle - If not 0, the outer search directions are kept orthogonal to the
+//     recycled subspace, which is updated at the end, see GCRRecycleSpaceCL.
 //
 //*****************************************************************
 template <class Mat, class Vec, class Preconditioner>
 bool
 GMRESR( const Mat& A, Vec& x, const Vec& b, const Preconditioner& M,
     int /*restart parameter m*/ m, int& max_iter, int& inner_max_iter, double& tol, double& inner_tol,
-    bool measure_relative_tol= true, PreMethGMRES method = RightPreconditioning)
-{  Vec r( b - A*x);
+    bool measure_relative_tol= true, PreMethGMRES method = RightPreconditioning,
+    GCRRecycleSpaceCL<Vec>* recycle= 0)
+{
+    DROPS_PROFILE_REGION("GMRESR");
+    Vec r( b - A*x);
+    if (recycle) {
+        recycle->Refresh( A, b.size());
+        recycle->Project( x, r);
+    }
     std::vector<Vec> u(1), c(1); // Positions u[0], c[0] are unused below.
     double normb= norm( b);
     if (normb == 0.0 || measure_relative_tol == false) normb= 1.0;
@@ -1466,6 +2025,7 @@ GMRESR( const Mat& A, Vec& x, const Vec& b, const Preconditioner& M,
         if ((resid= norm( r)/normb) < tol) {
             tol= resid;
             max_iter= k;
+            if (recycle) recycle->Update( u, c, 1);
             return true;
         }
         std::cout << "GMRESR: k: " << k << "\tresidual: " << resid << std::endl;
@@ -1483,6 +2043,7 @@ GMRESR( const Mat& A, Vec& x, const Vec& b, const Preconditioner& M,
             std::cout<<"LSQR switch!\n";
         }
         c.push_back( A*u[k+1]);
+        if (recycle) recycle->Orthogonalize( u[k+1], c[k+1]);
         for (int i= 1; i <= k; ++i) {
             const double alpha= dot( c[k+1], c[i]);
             c[k+1]-= alpha*c[i];
@@ -1496,6 +2057,7 @@ GMRESR( const Mat& A, Vec& x, const Vec& b, const Preconditioner& M,
         r-= gamma*c[k+1];
     }
     tol= resid;
+    if (recycle) recycle->Update( u, c, 1);
     return false;
 }
 
@@ -1531,6 +2093,7 @@ bool
 IDRS( const Mat& A, Vec& x, const Vec& rhs, PC& pc, int& max_iter, double& tol, bool measure_relative_tol= false,
 		const int s=4, typename Vec::value_type omega_bound=0.7)
 {
+    DROPS_PROFILE_REGION("IDRS");
     typedef typename Vec::value_type ElementTyp;
     int n= x.size(),  it;
 
@@ -1883,6 +2446,72 @@ class GMResSolverCL : public SolverBaseCL
     }
 };
 
+/// \brief PCG for m right-hand sides with a fused matrix-multivector product, see BlockPCG.
+///
+/// X and B are multivectors with m columns, stored row-interleaved (see dot_multi).
+template <typename PC>
+class BlockPCGSolverCL : public SolverBaseCL
+{
+  private:
+    PC& pc_;
+
+  public:
+    BlockPCGSolverCL(PC& pc, int maxiter, double tol, bool rel= false)
+        : SolverBaseCL( maxiter, tol, rel), pc_( pc) {}
+
+    PC&       GetPc ()       { return pc_; }
+    const PC& GetPc () const { return pc_; }
+
+    template <typename Mat>
+    void Solve(const Mat& A, VectorCL& X, const VectorCL& B, size_t m)
+    {
+        _res=  _tol;
+        _iter= _maxiter;
+        BlockPCG( A, X, B, m, pc_, _iter, _res, rel_);
+    }
+    template <typename Mat>
+    void Solve(const Mat& A, VectorCL& X, const VectorCL& B, size_t m, int& numIter, double& resid) const
+    {
+        resid=   _tol;
+        numIter= _maxiter;
+        BlockPCG( A, X, B, m, pc_, numIter, resid, rel_);
+    }
+};
+
+/// \brief Left preconditioned GMRES for m right-hand sides with a fused matrix-multivector product, see BlockGMRES.
+///
+/// X and B are multivectors with m columns, stored row-interleaved (see dot_multi).
+template <typename PC>
+class BlockGMResSolverCL : public SolverBaseCL
+{
+  private:
+    PC& pc_;
+    int restart_;
+
+  public:
+    BlockGMResSolverCL( PC& pc, int restart, int maxiter, double tol, bool relative= true)
+        : SolverBaseCL( maxiter, tol, relative), pc_( pc), restart_( restart) {}
+
+    PC&       GetPc      ()       { return pc_; }
+    const PC& GetPc      () const { return pc_; }
+    int       GetRestart () const { return restart_; }
+
+    template <typename Mat>
+    void Solve(const Mat& A, VectorCL& X, const VectorCL& B, size_t m)
+    {
+        _res=  _tol;
+        _iter= _maxiter;
+        BlockGMRES( A, X, B, m, pc_, restart_, _iter, _res, rel_);
+    }
+    template <typename Mat>
+    void Solve(const Mat& A, VectorCL& X, const VectorCL& B, size_t m, int& numIter, double& resid) const
+    {
+        resid=   _tol;
+        numIter= _maxiter;
+        BlockGMRES( A, X, B, m, pc_, restart_, numIter, resid, rel_);
+    }
+};
+
 // BiCGStab
 template <typename PC>
 class BiCGStabSolverCL : public SolverBaseCL
@@ -1920,6 +2549,9 @@ class GCRSolverCL : public SolverBaseCL
   private:
     PC& pc_;
     int truncate_; // no effect atm.
+    mutable GCRRecycleSpaceCL<VectorCL> recycle_; ///< subspace kept between the solves
+
+    GCRRecycleSpaceCL<VectorCL>* Recycle_() const { return recycle_.GetMaxDim() > 0 ? &recycle_ : 0; }
 
   public:
     GCRSolverCL( PC& pc, int truncate, int maxiter, double tol,
@@ -1930,13 +2562,18 @@ class GCRSolverCL : public SolverBaseCL
     PC&       GetPc      ()       { return pc_; }
     const PC& GetPc      () const { return pc_; }
     int       GetTruncate() const { return truncate_; }
+    /// \brief Keep up to dim search directions between the solves (0: no recycling)
+    void      SetRecycle  (int dim) { recycle_.SetMaxDim( dim); }
+    int       GetRecycle  () const  { return recycle_.GetMaxDim(); }
+    /// \brief Discard the recycled subspace
+    void      ClearRecycle()        { recycle_.Clear(); }
 
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b)
     {
         _res=  _tol;
         _iter= _maxiter;
-        GCR( A, x, b, pc_, truncate_, _iter, _res, rel_);
+        GCR( A, x, b, pc_, truncate_, _iter, _res, rel_, Recycle_());
         if (output_ != 0)
             *output_ << "GCRSolverCL: iterations: " << GetIter()
                      << "\tresidual: " << GetResid() << std::endl;
@@ -1946,7 +2583,7 @@ class GCRSolverCL : public SolverBaseCL
     {
         resid=   _tol;
         numIter= _maxiter;
-        GCR(A, x, b, pc_, truncate_, numIter, resid, rel_);
+        GCR(A, x, b, pc_, truncate_, numIter, resid, rel_, Recycle_());
         if (output_ != 0)
             *output_ << "GCRSolverCL: iterations: " << GetIter()
                     << "\tresidual: " << GetResid() << std::endl;
@@ -1962,6 +2599,10 @@ class GMResRSolverCL : public SolverBaseCL
     int          inner_maxiter_;
     double       inner_tol_;
     PreMethGMRES method_;
+    mutable GCRRecycleSpaceCL<VectorCL> recycle_; ///< subspace kept between the solves
+
+    GCRRecycleSpaceCL<VectorCL>* Recycle_() const { return recycle_.GetMaxDim() > 0 ? &recycle_ : 0; }
+
   public:
     GMResRSolverCL( PC& pc, int restart, int maxiter, int  inner_maxiter,
         double tol, double  inner_tol, bool relative= true, PreMethGMRES method = RightPreconditioning, std::ostream* output= 0)
@@ -1973,13 +2614,18 @@ class GMResRSolverCL : public SolverBaseCL
     int       GetRestart () const { return restart_; }
     void   SetInnerTol     (double tol) { inner_tol_= tol; }
     void   SetInnerMaxIter (int iter)   { inner_maxiter_= iter; }
+    /// \brief Keep up to dim outer search directions between the solves (0: no recycling)
+    void   SetRecycle      (int dim)    { recycle_.SetMaxDim( dim); }
+    int    GetRecycle      () const     { return recycle_.GetMaxDim(); }
+    /// \brief Discard the recycled subspace
+    void   ClearRecycle    ()           { recycle_.Clear(); }
 
     template <typename Mat, typename Vec>
     void Solve(const Mat& A, Vec& x, const Vec& b)
     {
         _res=  _tol;
         _iter= _maxiter;
-        GMRESR(A, x, b, pc_, restart_, _iter, inner_maxiter_, _res, inner_tol_, rel_, method_);
+        GMRESR(A, x, b, pc_, restart_, _iter, inner_maxiter_, _res, inner_tol_, rel_, method_, Recycle_());
         if (output_ != 0)
             *output_ << "GmresRSolverCL: iterations: " << GetIter()
                      << "\tresidual: " << GetResid() << std::endl;
@@ -1991,7 +2637,7 @@ class GMResRSolverCL : public SolverBaseCL
     {
         resid=   _tol;
         numIter= _maxiter;
-        GMRESR(A, x, b, pc_, restart_, numIter, inner_maxiter_, resid, inner_tol_, rel_, method_);
+        GMRESR(A, x, b, pc_, restart_, numIter, inner_maxiter_, resid, inner_tol_, rel_, method_, Recycle_());
         if (output_ != 0)
             *output_ << "GmresRSolverCL: iterations: " << GetIter()
                      << "\tresidual: " << GetResid() << std::endl;
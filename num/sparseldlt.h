@@ -0,0 +1,395 @@
+/// \file sparseldlt.h
+/// \brief sparse LDL^T factorization with nested dissection ordering, no external libraries needed
+/// \author LNM RWTH Aachen: Patrick Esser, Joerg Grande, Sven Gross; SC RWTH Aachen: Oliver Fortmeier
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2009 LNM/SC RWTH Aachen, Germany
+*/
+
+#ifndef DROPS_SPARSELDLT_H
+#define DROPS_SPARSELDLT_H
+
+#include "num/solver.h"
+#include <vector>
+#include <algorithm>
+
+namespace DROPS
+{
+
+/*******************************************************************
+*   D I R E C T L D L T S O L V E R   C L                          *
+*******************************************************************/
+/// \brief Direct solver for Ax=b with sparse symmetric matrix A, which does not need CHOLMOD or UMFPACK.
+/** The matrix is factorized as P A P^T = L D L^T with unit lower triangular L.
+    No pivoting is performed, thus A should be positive definite (or quasi-definite),
+    e.g. the coarse grid matrix of a Poisson problem or a mass matrix. Only the upper
+    triangle of P A P^T is read, i.e., A is assumed to be symmetric.
+
+    The symmetric permutation P is a nested dissection ordering: the graph of A is split
+    recursively by the middle level of a breadth first search from a pseudo-peripheral
+    vertex; the separator vertices are numbered last.
+
+    The symbolic analysis (ordering, elimination tree, pattern of L) is kept together with
+    the pattern of A. Update() only recomputes the numeric factorization, if the pattern is
+    unchanged. Solve() calls Update() itself, if a different matrix or a new version of the
+    matrix is passed. Hence, the class can be used as coarse grid solver in MGSolverCL and
+    as DirectSolverT in ParAgglomeratedDirectSolverCL.
+    The factorization is column oriented (up-looking), not supernodal. */
+/*******************************************************************
+*   D I R E C T L D L T S O L V E R   C L                          *
+*******************************************************************/
+class DirectLDLtSolverCL : public SolverBaseCL
+{
+  private:
+    static const size_t NoIdx_= static_cast<size_t>( -1);
+    static const size_t LeafSize_= 32;           ///< subgraphs with at most this number of vertices are not dissected
+
+    size_t num_rows_;
+    std::vector<size_t> rowbeg_, colind_;        ///< pattern of the analysed matrix
+    std::vector<size_t> perm_,                   ///< perm_[new]= old index
+                        pinv_;                   ///< pinv_[old]= new index
+    std::vector<size_t> Cp_, Ci_,                ///< upper triangle of P A P^T, stored by columns
+                        map_;                    ///< position in Ci_ of each non-zero of A; NoIdx_ for the lower triangle
+    std::vector<double> Cx_;
+    std::vector<size_t> parent_,                 ///< elimination tree
+                        Lp_, Li_;                ///< pattern of L (without diagonal), stored by columns
+    std::vector<double> Lx_, D_;
+    mutable std::vector<double> y_;              ///< work array for Solve
+    const MatrixCL*     mat_;                    ///< last factorized matrix
+    size_t              version_;                ///< and its version
+    size_t              numAnalyses_,
+                        numFactorizations_;
+
+    /// \brief true, if A has the pattern of the analysed matrix
+    bool SamePattern_( const MatrixCL& A) const {
+        return !rowbeg_.empty() && A.num_rows() == num_rows_ && A.num_nonzeros() == colind_.size()
+            && std::equal( A.raw_row(), A.raw_row() + num_rows_ + 1, rowbeg_.begin())
+            && std::equal( A.raw_col(), A.raw_col() + colind_.size(), colind_.begin());
+    }
+    /// \brief Number the vertices of a connected subgraph; the vertices v with mark[v]==m are appended to perm_.
+    void Dissect_( const std::vector<size_t>& adjbeg, const std::vector<size_t>& adj,
+        std::vector<size_t>& vert, std::vector<int>& mark, int m, int& nextmark, std::vector<size_t>& level);
+    /// \brief Breadth first search in the subgraph marked by m; returns the number of levels, the vertices are stored in vert by levels.
+    size_t BFS_( const std::vector<size_t>& adjbeg, const std::vector<size_t>& adj, size_t root,
+        std::vector<size_t>& vert, const std::vector<int>& mark, int m, std::vector<size_t>& level,
+        std::vector<size_t>& levbeg) const;
+    /// \brief Nested dissection ordering, elimination tree and pattern of L
+    void Analyze_( const MatrixCL& A);
+    /// \brief Numeric factorization with the pattern from Analyze_
+    void Factorize_( const MatrixCL& A);
+
+  public:
+    DirectLDLtSolverCL()
+        : SolverBaseCL( 1, 0.), num_rows_( 0), mat_( 0), version_( 0), numAnalyses_( 0), numFactorizations_( 0) {}
+    /// store and factorize the matrix A
+    DirectLDLtSolverCL( const MatrixCL& A)
+        : SolverBaseCL( 1, 0.), num_rows_( 0), mat_( 0), version_( 0), numAnalyses_( 0), numFactorizations_( 0) { Update( A); }
+
+    /// \brief Factorize A; the symbolic analysis is only repeated, if the pattern of A has changed.
+    void Update( const MatrixCL& A) {
+        if (A.num_rows() != A.num_cols())
+            throw DROPSErrCL( "DirectLDLtSolverCL::Update: matrix is not square");
+        if (!SamePattern_( A))
+            Analyze_( A);
+        Factorize_( A);
+        mat_= &A;
+        version_= A.Version();
+    }
+    /// \brief Solve Ax=b; A is factorized, if it differs from the last factorized matrix.
+    void Solve( const MatrixCL& A, VectorCL& x, const VectorCL& b);
+
+    /// \name Statistics
+    //@{
+    size_t GetNumAnalyses()       const { return numAnalyses_; }
+    size_t GetNumFactorizations() const { return numFactorizations_; }
+    size_t GetNumNonzerosL()      const { return Li_.size(); }
+    //@}
+};
+
+inline size_t DirectLDLtSolverCL::BFS_( const std::vector<size_t>& adjbeg, const std::vector<size_t>& adj, size_t root,
+    std::vector<size_t>& vert, const std::vector<int>& mark, int m, std::vector<size_t>& level,
+    std::vector<size_t>& levbeg) const
+{
+    vert.clear();
+    levbeg.clear();
+    vert.push_back( root);
+    level[root]= 0;
+    for (size_t beg= 0, end= 1; beg < end; beg= end, end= vert.size()) {
+        levbeg.push_back( beg);
+        for (size_t k= beg; k < end; ++k)
+            for (size_t p= adjbeg[vert[k]]; p < adjbeg[vert[k]+1]; ++p) {
+                const size_t w= adj[p];
+                if (mark[w] == m && level[w] == NoIdx_) {
+                    level[w]= levbeg.size();
+                    vert.push_back( w);
+                }
+            }
+    }
+    levbeg.push_back( vert.size());
+    return levbeg.size() - 1;
+}
+
+inline void DirectLDLtSolverCL::Dissect_( const std::vector<size_t>& adjbeg, const std::vector<size_t>& adj,
+    std::vector<size_t>& vert, std::vector<int>& mark, int m, int& nextmark, std::vector<size_t>& level)
+{
+    if (vert.size() <= LeafSize_) {
+        for (size_t k= 0; k < vert.size(); ++k)
+            perm_.push_back( vert[k]);
+        return;
+    }
+
+    // find a pseudo-peripheral vertex: restart the search from a vertex of minimal degree in the last level
+    std::vector<size_t> levbeg, bfs;
+    size_t root= vert[0], numlevels= 0;
+    for (int sweep= 0; sweep < 4; ++sweep) {
+        const size_t n= BFS_( adjbeg, adj, root, bfs, mark, m, level, levbeg);
+        for (size_t k= 0; k < bfs.size(); ++k)
+            level[bfs[k]]= NoIdx_;
+        if (n <= numlevels)
+            break;
+        numlevels= n;
+        size_t mindeg= NoIdx_;
+        for (size_t k= levbeg[n-1]; k < levbeg[n]; ++k)
+            if (adjbeg[bfs[k]+1] - adjbeg[bfs[k]] < mindeg) {
+                mindeg= adjbeg[bfs[k]+1] - adjbeg[bfs[k]];
+                root= bfs[k];
+            }
+    }
+    numlevels= BFS_( adjbeg, adj, root, bfs, mark, m, level, levbeg);
+    if (numlevels < 3) { // no useful separator
+        for (size_t k= 0; k < bfs.size(); ++k) {
+            level[bfs[k]]= NoIdx_;
+            perm_.push_back( bfs[k]);
+        }
+        return;
+    }
+
+    // separator: vertices of the middle level with a neighbor in the next level
+    const size_t mid= numlevels/2;
+    const int    m0= nextmark++, m1= nextmark++;
+    std::vector<size_t> part0, part1, sep;
+    for (size_t k= 0; k < bfs.size(); ++k) {
+        const size_t v= bfs[k];
+        if (level[v] < mid)
+            part0.push_back( v);
+        else if (level[v] > mid)
+            part1.push_back( v);
+        else {
+            bool cut= false;
+            for (size_t p= adjbeg[v]; p < adjbeg[v+1] && !cut; ++p)
+                cut= mark[adj[p]] == m && level[adj[p]] == mid + 1;
+            (cut ? sep : part0).push_back( v);
+        }
+    }
+    for (size_t k= 0; k < bfs.size(); ++k)
+        level[bfs[k]]= NoIdx_;
+    for (size_t k= 0; k < part0.size(); ++k) mark[part0[k]]= m0;
+    for (size_t k= 0; k < part1.size(); ++k) mark[part1[k]]= m1;
+    for (size_t k= 0; k < sep.size();   ++k) mark[sep[k]]= -1;
+    vert.clear();
+
+    // the parts may be disconnected
+    for (int i= 0; i < 2; ++i) {
+        std::vector<size_t>& part= i == 0 ? part0 : part1;
+        const int mi= i == 0 ? m0 : m1;
+        for (size_t k= 0; k < part.size(); ++k) {
+            if (mark[part[k]] != mi)
+                continue;
+            std::vector<size_t> comp;
+            BFS_( adjbeg, adj, part[k], comp, mark, mi, level, levbeg);
+            const int mc= nextmark++;
+            for (size_t j= 0; j < comp.size(); ++j) {
+                level[comp[j]]= NoIdx_;
+                mark[comp[j]]= mc;
+            }
+            Dissect_( adjbeg, adj, comp, mark, mc, nextmark, level);
+        }
+    }
+    for (size_t k= 0; k < sep.size(); ++k)
+        perm_.push_back( sep[k]);
+}
+
+inline void DirectLDLtSolverCL::Analyze_( const MatrixCL& A)
+{
+    const size_t n= A.num_rows(), nnz= A.num_nonzeros(),
+                 noidx= NoIdx_; // the containers take references
+    num_rows_= n;
+    rowbeg_.assign( A.raw_row(), A.raw_row() + n + 1);
+    colind_.assign( A.raw_col(), A.raw_col() + nnz);
+
+    // graph of A + A^T without the diagonal
+    std::vector<size_t> adjbeg( n + 1, 0), adj;
+    for (size_t i= 0; i < n; ++i)
+        for (size_t p= rowbeg_[i]; p < rowbeg_[i+1]; ++p)
+            if (colind_[p] != i) {
+                ++adjbeg[i+1];
+                ++adjbeg[colind_[p]+1];
+            }
+    for (size_t i= 0; i < n; ++i)
+        adjbeg[i+1]+= adjbeg[i];
+    adj.resize( adjbeg[n]);
+    {
+        std::vector<size_t> pos( adjbeg.begin(), adjbeg.end() - 1);
+        for (size_t i= 0; i < n; ++i)
+            for (size_t p= rowbeg_[i]; p < rowbeg_[i+1]; ++p)
+                if (colind_[p] != i) {
+                    adj[pos[i]++]= colind_[p];
+                    adj[pos[colind_[p]]++]= i;
+                }
+    }
+
+    // nested dissection of each connected component
+    perm_.clear();
+    perm_.reserve( n);
+    std::vector<int>    mark( n, 0);
+    std::vector<size_t> level( n, noidx), levbeg, comp;
+    int nextmark= 1;
+    for (size_t v= 0; v < n; ++v) {
+        if (mark[v] != 0)
+            continue;
+        BFS_( adjbeg, adj, v, comp, mark, 0, level, levbeg);
+        const int mc= nextmark++;
+        for (size_t j= 0; j < comp.size(); ++j) {
+            level[comp[j]]= NoIdx_;
+            mark[comp[j]]= mc;
+        }
+        Dissect_( adjbeg, adj, comp, mark, mc, nextmark, level);
+    }
+    pinv_.resize( n);
+    for (size_t k= 0; k < n; ++k)
+        pinv_[perm_[k]]= k;
+
+    // upper triangle of P A P^T by columns and the map of the non-zeros of A
+    Cp_.assign( n + 1, 0);
+    map_.assign( nnz, noidx);
+    for (size_t i= 0; i < n; ++i)
+        for (size_t p= rowbeg_[i]; p < rowbeg_[i+1]; ++p)
+            if (pinv_[i] <= pinv_[colind_[p]])
+                ++Cp_[pinv_[colind_[p]]+1];
+    for (size_t k= 0; k < n; ++k)
+        Cp_[k+1]+= Cp_[k];
+    Ci_.resize( Cp_[n]);
+    Cx_.resize( Cp_[n]);
+    {
+        std::vector<size_t> pos( Cp_.begin(), Cp_.end() - 1);
+        for (size_t i= 0; i < n; ++i)
+            for (size_t p= rowbeg_[i]; p < rowbeg_[i+1]; ++p)
+                if (pinv_[i] <= pinv_[colind_[p]]) {
+                    const size_t q= pos[pinv_[colind_[p]]]++;
+                    Ci_[q]= pinv_[i];
+                    map_[p]= q;
+                }
+    }
+
+    // elimination tree and number of non-zeros in each column of L
+    parent_.assign( n, noidx);
+    Lp_.assign( n + 1, 0);
+    std::vector<size_t> flag( n);
+    for (size_t k= 0; k < n; ++k) {
+        flag[k]= k;
+        for (size_t p= Cp_[k]; p < Cp_[k+1]; ++p)
+            for (size_t i= Ci_[p]; i < k && flag[i] != k; i= parent_[i]) {
+                if (parent_[i] == NoIdx_)
+                    parent_[i]= k;
+                ++Lp_[i+1];
+                flag[i]= k;
+            }
+    }
+    for (size_t k= 0; k < n; ++k)
+        Lp_[k+1]+= Lp_[k];
+    Li_.resize( Lp_[n]);
+    Lx_.resize( Lp_[n]);
+    D_.resize( n);
+    y_.resize( n);
+    ++numAnalyses_;
+}
+
+inline void DirectLDLtSolverCL::Factorize_( const MatrixCL& A)
+{
+    const size_t n= num_rows_;
+    const double* val= A.raw_val();
+    for (size_t p= 0; p < map_.size(); ++p)
+        if (map_[p] != NoIdx_)
+            Cx_[map_[p]]= val[p];
+
+    // up-looking factorization: row k of L solves a triangular system with the pattern given by the elimination tree
+    std::vector<double> y( n, 0.);
+    std::vector<size_t> flag( n), pattern( n), lnz( n);
+    for (size_t k= 0; k < n; ++k) {
+        size_t top= n;
+        flag[k]= k;
+        lnz[k]= 0;
+        for (size_t p= Cp_[k]; p < Cp_[k+1]; ++p) {
+            size_t i= Ci_[p], len= 0;
+            y[i]+= Cx_[p];
+            for (; flag[i] != k; i= parent_[i]) {
+                pattern[len++]= i;
+                flag[i]= k;
+            }
+            while (len > 0)
+                pattern[--top]= pattern[--len];
+        }
+        D_[k]= y[k];
+        y[k]= 0.;
+        for (; top < n; ++top) {
+            const size_t i= pattern[top], end= Lp_[i] + lnz[i];
+            const double yi= y[i];
+            y[i]= 0.;
+            for (size_t p= Lp_[i]; p < end; ++p)
+                y[Li_[p]]-= Lx_[p]*yi;
+            const double lki= yi/D_[i];
+            D_[k]-= lki*yi;
+            Li_[end]= k;
+            Lx_[end]= lki;
+            ++lnz[i];
+        }
+        if (D_[k] == 0.)
+            throw DROPSErrCL( "DirectLDLtSolverCL::Factorize_: zero pivot, matrix is singular");
+    }
+    ++numFactorizations_;
+}
+
+inline void DirectLDLtSolverCL::Solve( const MatrixCL& A, VectorCL& x, const VectorCL& b)
+{
+    if (mat_ != &A || version_ != A.Version())
+        Update( A);
+    if (b.size() != num_rows_)
+        throw DROPSErrCL( "DirectLDLtSolverCL::Solve: incompatible dimensions");
+    const size_t n= num_rows_;
+    for (size_t k= 0; k < n; ++k)
+        y_[k]= b[perm_[k]];
+    for (size_t j= 0; j < n; ++j)
+        for (size_t p= Lp_[j]; p < Lp_[j+1]; ++p)
+            y_[Li_[p]]-= Lx_[p]*y_[j];
+    for (size_t j= 0; j < n; ++j)
+        y_[j]/= D_[j];
+    for (size_t j= n; j-- > 0; )
+        for (size_t p= Lp_[j]; p < Lp_[j+1]; ++p)
+            y_[j]-= Lx_[p]*y_[Li_[p]];
+    if (x.size() != n)
+        x.resize( n);
+    for (size_t k= 0; k < n; ++k)
+        x[perm_[k]]= y_[k];
+    _iter= 1;
+    _res= 0.;
+}
+
+} // end of namespace DROPS
+
+#endif
@@ -176,6 +176,85 @@ template <typename T>
     z= x + a*y + b*y2;
 }
 
+/// \name OpenMP-parallel vector kernels for VectorBaseCL<double>
+/// They have distinct names, so the serial kernels above stay in use (and
+/// reproducible) unless a solver calls these explicitly; the parallel
+/// Krylov solvers do. Vectors with less than omp_min_vector_size entries
+/// are treated by the calling thread only.
+//@{
+const size_t omp_min_vector_size= 4096;
+
+inline double
+omp_dot(const VectorBaseCL<double>& v, const VectorBaseCL<double>& w)
+{
+    Assert( v.size()==w.size(), "omp_dot: incompatible dimensions", DebugNumericC);
+    const double* const pv= Addr( v), * const pw= Addr( w);
+    const size_t n= v.size();
+    double sum= 0.;
+#ifndef DROPS_WIN
+    size_t i;
+#else
+    int i;
+#endif
+#   pragma omp parallel for reduction(+: sum) if (n > omp_min_vector_size)
+    for (i= 0; i < n; ++i)
+        sum+= pv[i]*pw[i];
+    return sum;
+}
+
+inline double
+omp_norm_sq(const VectorBaseCL<double>& v)
+{
+    const double* const pv= Addr( v);
+    const size_t n= v.size();
+    double sum= 0.;
+#ifndef DROPS_WIN
+    size_t i;
+#else
+    int i;
+#endif
+#   pragma omp parallel for reduction(+: sum) if (n > omp_min_vector_size)
+    for (i= 0; i < n; ++i)
+        sum+= pv[i]*pv[i];
+    return sum;
+}
+
+inline void
+omp_axpy(double a, const VectorBaseCL<double>& x, VectorBaseCL<double>& y)
+{
+    Assert(x.size()==y.size(), "omp_axpy: incompatible dimensions", DebugNumericC);
+    const double* const px= Addr( x);
+    double* const py= Addr( y);
+    const size_t n= x.size();
+#ifndef DROPS_WIN
+    size_t i;
+#else
+    int i;
+#endif
+#   pragma omp parallel for if (n > omp_min_vector_size)
+    for (i= 0; i < n; ++i)
+        py[i]+= a*px[i];
+}
+
+inline void
+omp_z_xpay(VectorBaseCL<double>& z, const VectorBaseCL<double>& x, double a, const VectorBaseCL<double>& y)
+{
+    Assert(z.size()==x.size() && z.size()==y.size(),
+        "omp_z_xpay: incompatible dimensions", DebugNumericC);
+    const double* const px= Addr( x), * const py= Addr( y);
+    double* const pz= Addr( z);
+    const size_t n= z.size();
+#ifndef DROPS_WIN
+    size_t i;
+#else
+    int i;
+#endif
+#   pragma omp parallel for if (n > omp_min_vector_size)
+    for (i= 0; i < n; ++i)
+        pz[i]= px[i] + a*py[i];
+}
+//@}
+
 
 /// \brief Permutes the components of a vector v according to p.
 /// num_components consecutive components are considered as one block (for vector-valued FE). v must have dim(p) * blocksize components.
@@ -629,6 +708,9 @@ public:
                               double, const SparseMatBaseCL<T>&,
                               double, const SparseMatBaseCL<T>&);
 
+    SparseMatBaseCL& MatMul       (const SparseMatBaseCL<T>&, const SparseMatBaseCL<T>&); ///< *this= A*B (symbolic and numeric phase)
+    SparseMatBaseCL& MatMulValues (const SparseMatBaseCL<T>&, const SparseMatBaseCL<T>&); ///< *this= A*B for the unchanged sparsity pattern of a previous MatMul (numeric phase)
+
     void insert_col (size_t c, const VectorBaseCL<T>& v);
 
     ///\brief Resize to new dimensions. The old content is lost.
@@ -1246,6 +1328,114 @@ SparseMatBaseCL<T>& SparseMatBaseCL<T>::LinComb (double coeffA, const SparseMatB
     return this->LinComb( 1.0, tmp, coeffD, D);
 }
 
+/// \brief Compute the product A*B of two sparse matrices.
+/// Symbolic phase: The number of non-zeros of each row is determined by marking the columns
+/// reached via the rows of B (Gustavson's algorithm), the rows are processed in parallel.
+/// After the parallel prefix sum, the sorted column indices are stored. The values are
+/// computed by MatMulValues.
+template <typename T>
+SparseMatBaseCL<T>& SparseMatBaseCL<T>::MatMul (const SparseMatBaseCL<T>& A, const SparseMatBaseCL<T>& B)
+{
+    Assert( A.num_cols()==B.num_rows(), "MatMul: incompatible dimensions", DebugNumericC);
+
+    Comment( "MatMul: Creating NEW matrix" << std::endl, DebugNumericC);
+    num_rows( A.num_rows());
+    num_cols( B.num_cols());
+    _rowbeg[0]= 0;
+    size_t* t_sum= new size_t[omp_get_max_threads()];
+
+#   pragma omp parallel
+    {
+        // marker[c]==row, iff column c has already been found in the current row
+        std::vector<size_t> marker( B.num_cols(), A.num_rows());
+        size_t i, c;
+#ifndef DROPS_WIN
+#       pragma omp for
+        for (size_t row= 0; row < A.num_rows(); ++row)
+#else
+#       pragma omp for
+        for (int row= 0; row < (int)A.num_rows(); ++row)
+#endif
+        {
+            i= 0;
+            for (size_t nzA= A.row_beg( row); nzA < A.row_beg( row + 1); ++nzA)
+                for (size_t nzB= B.row_beg( A._colind[nzA]); nzB < B.row_beg( A._colind[nzA] + 1); ++nzB)
+                    if (marker[c= B._colind[nzB]] != (size_t)row) {
+                        marker[c]= row;
+                        ++i;
+                    }
+            _rowbeg[row + 1]= i;
+        }
+
+        inplace_parallel_partial_sum( _rowbeg, _rowbeg + num_rows() + 1, t_sum);
+#       pragma omp barrier
+#       pragma omp master
+            num_nonzeros( row_beg( num_rows()));
+#       pragma omp barrier
+        // Store the sorted column indices of each row.
+        std::fill( marker.begin(), marker.end(), A.num_rows());
+#ifndef DROPS_WIN
+#       pragma omp for
+        for (size_t row= 0; row < A.num_rows(); ++row)
+#else
+#       pragma omp for
+        for (int row= 0; row < (int)A.num_rows(); ++row)
+#endif
+        {
+            i= row_beg( row);
+            for (size_t nzA= A.row_beg( row); nzA < A.row_beg( row + 1); ++nzA)
+                for (size_t nzB= B.row_beg( A._colind[nzA]); nzB < B.row_beg( A._colind[nzA] + 1); ++nzB)
+                    if (marker[c= B._colind[nzB]] != (size_t)row) {
+                        marker[c]= row;
+                        _colind[i++]= c;
+                    }
+            std::sort( _colind + row_beg( row), _colind + i);
+        }
+    } //end of omp parallel
+    delete [] t_sum;
+    return MatMulValues( A, B);
+}
+
+/// \brief Compute the values of the product A*B, if the sparsity pattern of *this is that of A*B.
+/// This is the case after MatMul( A, B) as long as the patterns of A and B do not change. Only the
+/// values are recomputed, the rows are processed in parallel.
+template <typename T>
+SparseMatBaseCL<T>& SparseMatBaseCL<T>::MatMulValues (const SparseMatBaseCL<T>& A, const SparseMatBaseCL<T>& B)
+{
+    Assert( A.num_cols()==B.num_rows() && A.num_rows()==num_rows() && B.num_cols()==num_cols(),
+            "MatMulValues: incompatible dimensions", DebugNumericC);
+
+    IncrementVersion();
+#   pragma omp parallel
+    {
+        // pos[c] is the position of column c in the current row of the product
+        std::vector<size_t> pos( num_cols());
+#ifndef DROPS_WIN
+#       pragma omp for
+        for (size_t row= 0; row < A.num_rows(); ++row)
+#else
+#       pragma omp for
+        for (int row= 0; row < (int)A.num_rows(); ++row)
+#endif
+        {
+            for (size_t nz= row_beg( row); nz < row_beg( row + 1); ++nz) {
+                pos[_colind[nz]]= nz;
+                _val[nz]= T();
+            }
+            for (size_t nzA= A.row_beg( row); nzA < A.row_beg( row + 1); ++nzA) {
+                const T a= A._val[nzA];
+                for (size_t nzB= B.row_beg( A._colind[nzA]); nzB < B.row_beg( A._colind[nzA] + 1); ++nzB) {
+                    Assert( pos[B._colind[nzB]] >= row_beg( row) && pos[B._colind[nzB]] < row_beg( row + 1)
+                            && _colind[pos[B._colind[nzB]]] == B._colind[nzB],
+                            DROPSErrCL( "MatMulValues: sparsity pattern has changed"), DebugNumericC);
+                    _val[pos[B._colind[nzB]]]+= a*B._val[nzB];
+                }
+            }
+        }
+    } //end of omp parallel
+    return *this;
+}
+
 /// \brief Inserts v as column c. The old columns [c, num_cols()) are shifted to the right.
 ///
 /// If c > num_cols(), implicit zero-columns will show up in the matrix.
@@ -1327,6 +1517,18 @@ transpose (const SparseMatBaseCL<T>& M, SparseMatBaseCL<T>& Mt)
 }
 
 
+/// \brief Check, if A and B have the same dimensions and sparsity pattern.
+template <typename T>
+bool
+same_pattern (const SparseMatBaseCL<T>& A, const SparseMatBaseCL<T>& B)
+{
+    return A.num_rows() == B.num_rows() && A.num_cols() == B.num_cols()
+        && A.num_nonzeros() == B.num_nonzeros()
+        && std::equal( A.raw_row(), A.raw_row() + A.num_rows() + 1, B.raw_row())
+        && std::equal( A.raw_col(), A.raw_col() + A.num_nonzeros(), B.raw_col());
+}
+
+
 /// \brief Compute the diagonal of B*B^T.
 ///
 /// The commented out version computes B*M^(-1)*B^T
@@ -1381,6 +1583,40 @@ y_Ax(T* __restrict y,
     }
 }
 
+// y[rows[k]]= (A*x)[rows[k]] for 0<=k<num_sel, all other components of y are not touched.
+// Used for computing the rows at the process boundary and the interior rows in separate phases.
+// Assumes, that none of the arrays involved do alias.
+template <typename T, typename IndexT>
+inline void
+y_Ax_rows(T* __restrict y,
+     const IndexT* __restrict rows,
+     size_t num_sel,
+     const T* __restrict Aval,
+     const size_t* __restrict Arow,
+     const size_t* __restrict Acol,
+     const T* __restrict x)
+{
+    T sum;
+    size_t row, rowend, nz;
+
+#ifndef DROPS_WIN
+    size_t k;
+#else
+    int k;
+#endif
+
+#   pragma omp parallel for private(sum, row, rowend, nz)
+    for (k = 0; k < num_sel; k++)
+    {
+        sum = 0.0;
+        row = rows[k];
+        rowend = Arow[row+1];
+        for (nz= Arow[row]; nz < rowend; ++nz)
+            sum += Aval[nz] * x[Acol[nz]];
+        y[row] = sum;
+    }
+}
+
 
 template <typename _MatEntry, typename _VecEntry>
 VectorBaseCL<_VecEntry> operator * (const SparseMatBaseCL<_MatEntry>& A, const VectorBaseCL<_VecEntry>& x)
@@ -1397,6 +1633,64 @@ VectorBaseCL<_VecEntry> operator * (const SparseMatBaseCL<_MatEntry>& A, const V
 }
 
 
+// Y= A*X for a multivector X with m columns, which is stored row-interleaved, i.e.
+// X[i*m+j] is the i-th component of column j. A is read only once for all columns.
+// fails, if num_rows==0.
+// Assumes, that none of the arrays involved do alias.
+template <typename T>
+inline void
+Y_AX(T* __restrict Y,
+     size_t num_rows,
+     const T* __restrict Aval,
+     const size_t* __restrict Arow,
+     const size_t* __restrict Acol,
+     const T* __restrict X,
+     size_t m)
+{
+    T a;
+    T* __restrict y;
+    const T* __restrict x;
+    size_t rowend, nz, j;
+
+#ifndef DROPS_WIN
+    size_t i;
+#else
+    int i;
+#endif
+
+#   pragma omp parallel for private(a, y, x, rowend, nz, j)
+    for (i = 0; i < num_rows; i++)
+    {
+        y= Y + i*m;
+        for (j= 0; j < m; ++j)
+            y[j]= 0.0;
+        rowend = Arow[i+1];
+        for (nz= Arow[i]; nz < rowend; ++nz) {
+            a= Aval[nz];
+            x= X + Acol[nz]*m;
+            for (j= 0; j < m; ++j)
+                y[j]+= a*x[j];
+        }
+    }
+}
+
+/// \brief A*X for the row-interleaved multivector X with m columns, see Y_AX.
+template <typename _MatEntry, typename _VecEntry>
+VectorBaseCL<_VecEntry> mul_multi (const SparseMatBaseCL<_MatEntry>& A, const VectorBaseCL<_VecEntry>& X, size_t m)
+{
+    VectorBaseCL<_VecEntry> ret( A.num_rows()*m);
+    Assert( A.num_cols()*m==X.size(), "mul_multi: incompatible dimensions", DebugNumericC);
+    Y_AX( &ret[0],
+          A.num_rows(),
+          A.raw_val(),
+          A.raw_row(),
+          A.raw_col(),
+          Addr( X),
+          m);
+    return ret;
+}
+
+
 // y+= A^T*x
 // fails, if num_rows==0.
 // Assumes, that none of the arrays involved do alias.
@@ -1571,6 +1865,12 @@ VectorBaseCL<_VecEntry> operator* (const MLSparseMatBaseCL<_MatEntry>& A, const
     return A.GetFinest()*x;
 }
 
+template <typename _MatEntry, typename _VecEntry>
+VectorBaseCL<_VecEntry> mul_multi (const MLSparseMatBaseCL<_MatEntry>& A, const VectorBaseCL<_VecEntry>& X, size_t m)
+{
+    return mul_multi( A.GetFinest(), X, m);
+}
+
 //Human Readable
 template <typename T>
 std::ostream& operator << (std::ostream& os, const MLSparseMatBaseCL<T>& A)
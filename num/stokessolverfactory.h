@@ -398,6 +398,17 @@ StokesSolverFactoryCL<StokesT, ProlongationVelT, ProlongationPT>::
         gcrsolver_( DiagGMResMinCommPc_, 500, 500, 1e-6, true), coarse_blockgcrsolver_(gcrsolver_),
         vankasmoother_( 0, 0.8, &Stokes.pr_idx)
 {
+    bbtispc_.SetExplicitBBT( P.get<int>("Stokes.ExplicitBBT", 0) != 0);
+    // Galerkin products P^T*A*P as coarse grid operators of the MG preconditioners for A
+    const bool galerkin= P.get<int>("Stokes.PcAGalerkin", 0) != 0;
+    MGSolversymm_.SetGalerkin( galerkin);
+    MGSolver_.SetGalerkin( galerkin);
+    // lazy update of the Schur complement preconditioners; Stokes.PcMaxAge == 0: update with each change of the matrices
+    const int    maxage=   P.get<int>   ("Stokes.PcMaxAge",   0);
+    const double maxratio= P.get<double>("Stokes.PcMaxRatio", 1.5);
+    bbtispc_.GetLifecycle().SetPolicy( maxage, maxratio);
+    mincommispc_.GetLifecycle().SetPolicy( maxage, maxratio);
+    bdinvbtispc_.GetLifecycle().SetPolicy( maxage, maxratio);
     apc_= CreateAPc();
     spc_= CreateSPc();
 }
@@ -521,15 +532,18 @@ StokesSolverBaseCL* StokesSolverFactoryCL<StokesT, ProlongationVelT, Prolongatio
         case GCR_OS: {
             if (APc_==VankaBlock_APC) {
                 GCRVanka_= new GCR_VankaT( vankapc_,  P_.template get<int>("Stokes.OuterIter"), P_.template get<int>("Stokes.OuterIter"), P_.template get<double>("Stokes.OuterTol"), /*rel*/ false);
+                GCRVanka_->SetRecycle( P_.template get<int>("Stokes.Recycle", 0));
                 stokessolver= new BlockMatrixSolverCL<GCR_VankaT> ( *GCRVanka_);
             } else if (SPc_==SIMPLER_SPC || SPc_==MSIMPLER_SPC) {
                 bdinvbtispc_.SetMassLumping( SPc_==MSIMPLER_SPC);
                 SBlock_= new SIMPLERBlockPcT( *apc_, bdinvbtispc_);
                 GCRSBlock_= new GCR_SBlockT( *SBlock_,  P_.template get<int>("Stokes.OuterIter"), P_.template get<int>("Stokes.OuterIter"), P_.template get<double>("Stokes.OuterTol"), /*rel*/ false);
+                GCRSBlock_->SetRecycle( P_.template get<int>("Stokes.Recycle", 0));
                 stokessolver= new BlockMatrixSolverCL<GCR_SBlockT>( *GCRSBlock_);      
             } else {
                 LBlock_= new LowerBlockPcT( *apc_, *spc_);
                 GCRLBlock_= new GCR_LBlockT( *LBlock_,  P_.template get<int>("Stokes.OuterIter"), P_.template get<int>("Stokes.OuterIter"), P_.template get<double>("Stokes.OuterTol"), /*rel*/ false);
+                GCRLBlock_->SetRecycle( P_.template get<int>("Stokes.Recycle", 0));
                 stokessolver= new BlockMatrixSolverCL<GCR_LBlockT>( *GCRLBlock_);      
             }
         }
@@ -550,10 +564,12 @@ StokesSolverBaseCL* StokesSolverFactoryCL<StokesT, ProlongationVelT, Prolongatio
         case GMResR_OS: {
             if (APc_==VankaBlock_APC) {
                 GMResRVanka_= new GMResR_VankaT( vankapc_,  P_.template get<int>("Stokes.OuterIter"), P_.template get<int>("Stokes.OuterIter"), P_.template get<int>("Stokes.InnerIter"), P_.template get<double>("Stokes.OuterTol"), P_.template get<double>("Stokes.InnerTol"), /*rel*/ false);
+                GMResRVanka_->SetRecycle( P_.template get<int>("Stokes.Recycle", 0));
                 stokessolver= new BlockMatrixSolverCL<GMResR_VankaT> ( *GMResRVanka_);
             } else {
                 LBlock_= new LowerBlockPcT( *apc_, *spc_);
                 GMResRLBlock_= new GMResR_LBlockT( *LBlock_,  P_.template get<int>("Stokes.OuterIter"), P_.template get<int>("Stokes.OuterIter"), P_.template get<int>("Stokes.InnerIter"), P_.template get<double>("Stokes.OuterTol"), P_.template get<double>("Stokes.InnerTol"), /*rel*/ false);
+                GMResRLBlock_->SetRecycle( P_.template get<int>("Stokes.Recycle", 0));
                 stokessolver= new BlockMatrixSolverCL<GMResR_LBlockT>( *GMResRLBlock_);      
             }
         }
@@ -773,7 +789,10 @@ template <class StokesT, class ProlongationVelT, class ProlongationPT>
       LBlockAMGBBTOseenPc_( AMGPc_, bbtispc_),
       GCRAMGBBT_( P.get<int>("Stokes.OuterIter"), P.get<int>("Stokes.OuterIter"), P.get<double>("Stokes.OuterTol"), LBlockAMGBBTOseenPc_, true, false, true, &std::cout)
 #endif
-    {}
+{
+    // lazy update of the Schur complement preconditioner; Stokes.PcMaxAge == 0: update with each change of the matrices
+    bbtispc_.GetLifecycle().SetPolicy( P.get<int>("Stokes.PcMaxAge", 0), P.get<double>("Stokes.PcMaxRatio", 1.5));
+}
 
 template <class StokesT, class ProlongationVelT, class ProlongationPT>
   StokesSolverBaseCL* StokesSolverFactoryCL<StokesT, ProlongationVelT, ProlongationPT>::CreateStokesSolver()
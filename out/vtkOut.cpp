@@ -39,7 +39,7 @@ VTKOutCL::VTKOutCL(const MultiGridCL& mg, const std::string& dataname, Uint nums
 \param lvl       Multigrid level
 */
     : mg_(mg), timestep_(0), numsteps_(numsteps), descstr_(dataname),
-        dirname_(dirname), filename_(filename), binary_(binary), onlyP1_(onlyP1), geomwritten_(false),
+        dirname_(dirname), filename_(filename), binary_(binary), onlyP1_(onlyP1), geomwritten_(false), collective_(false),
         vAddrMap_(), eAddrMap_(), coords_(), tetras_(), lvl_(lvl),
         numPoints_(0), numTetras_(0)
 {
@@ -90,8 +90,24 @@ void VTKOutCL::CheckFile( const std::ofstream& os) const
 }
 
 void VTKOutCL::NewFile(double time, __UNUSED__ bool writeDistribution)
-/** Each process opens a new file and writes header into it*/
+/** Each process opens a new file and writes header into it. In collective mode,
+    the header and the local piece are buffered and written by CommitCollective().*/
 {
+    if (collective_){
+        collName_= filename_;
+        AppendTimecode( collName_);
+        collName_+= ".vtu";
+        piece_.str( "");
+        pieceChunks_.clear();
+        pieceOffsets_.clear();
+        appended_.clear();
+        wrotePointDataLine_= false;
+        IF_MASTER {
+            CreateDirectory( dirname_);
+            GenerateTimeFile( time, collName_);
+        }
+        return;
+    }
     std::string filename(filename_);
 #ifdef _PAR
    ProcCL::AppendProcNum(filename);
@@ -197,12 +213,92 @@ void VTKOutCL::PutHeader()
 }
 
 void VTKOutCL::PutFooter()
-/** Closes the file XML conform*/
+/** Closes the file XML conform. In collective mode, only the local piece is closed.*/
+{
+    Out() <<"\n\t</PointData>"
+            "\n</Piece>";
+    if (!collective_)
+        file_ << "\n</UnstructuredGrid>"
+                 "\n</VTKFile>";
+}
+
+void VTKOutCL::CommitCollective()
+/** The file consists of the header, the XML description of the pieces of all
+    processes, and the appended data of all processes. Each process computes the
+    offsets of its piece and of its appended data by the sizes of the pieces and
+    the appended data of the processes with lower rank. Then, all processes write
+    their part of the file by two collective write operations. The master process
+    writes the header and the beginning of the appended data section, the last
+    process the end of the file.
+*/
 {
-    file_ <<"\n\t</PointData>"
-            "\n</Piece>"
-            "\n</UnstructuredGrid>"
-            "\n</VTKFile>";
+    static const std::string header= "<?xml version=\"1.0\"?>\n"
+                                     "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\">\n"
+                                     "<UnstructuredGrid>\n",
+                             middle= "\n</UnstructuredGrid>"
+                                     "\n<AppendedData encoding=\"raw\">\n_",
+                             footer= "\n</AppendedData>"
+                                     "\n</VTKFile>";
+    pieceChunks_.push_back( piece_.str());
+    piece_.str( "");
+
+    // offset of the local appended data within the appended data section
+    Ulint appBegin= 0;
+#ifdef _PAR
+    const int me= ProcCL::MyRank(), last= ProcCL::Size()-1;
+    const std::vector<Ulint> appSizes= ProcCL::Gather( (Ulint)appended_.size(), -1);
+    for (int p=0; p<me; ++p)
+        appBegin+= appSizes[p];
+#endif
+
+    // XML description of the local piece with global offsets
+    std::ostringstream xml;
+    IF_MASTER
+        xml << header;
+    for (size_t i=0; i<pieceChunks_.size(); ++i){
+        xml << pieceChunks_[i];
+        if (i<pieceOffsets_.size())
+            xml << appBegin+pieceOffsets_[i];
+    }
+    const std::string xmlStr= xml.str();
+
+    // local appended data, the master starts the appended data section, the last process ends the file
+    std::vector<char> app;
+    app.reserve( middle.size()+appended_.size()+footer.size());
+    IF_MASTER
+        app.insert( app.end(), middle.begin(), middle.end());
+    app.insert( app.end(), appended_.begin(), appended_.end());
+#ifdef _PAR
+    if (me==last)
+#endif
+        app.insert( app.end(), footer.begin(), footer.end());
+
+#ifdef _PAR
+    // offsets of the XML pieces and the appended data within the file
+    const std::vector<Ulint> xmlSizes= ProcCL::Gather( (Ulint)xmlStr.size(), -1);
+    Ulint xmlBegin= 0, xmlEnd= 0;
+    for (int p=0; p<=last; ++p){
+        if (p<me) xmlBegin+= xmlSizes[p];
+        xmlEnd+= xmlSizes[p];
+    }
+    Ulint dataBegin= xmlEnd;
+    if (!ProcCL::IamMaster())
+        dataBegin+= middle.size()+appBegin;
+
+    ProcCL::FileT fh= ProcCL::FileOpenWrite( dirname_+collName_);
+    ProcCL::FileWriteAtAll( fh, (ProcCL::OffsetT)xmlBegin,  xmlStr.data(), (int)xmlStr.size());
+    ProcCL::FileWriteAtAll( fh, (ProcCL::OffsetT)dataBegin, Addr( app),    (int)app.size());
+    ProcCL::FileClose( fh);
+#else
+    file_.open( (dirname_+collName_).c_str(), std::ios_base::out | std::ios_base::binary);
+    CheckFile( file_);
+    file_.write( xmlStr.data(), xmlStr.size());
+    file_.write( Addr( app), app.size());
+    file_.close();
+#endif
+    pieceChunks_.clear();
+    pieceOffsets_.clear();
+    std::vector<char>().swap( appended_);
 }
 
 void VTKOutCL::GatherCoord()
@@ -349,9 +445,17 @@ void WriteBase64( const VectorBaseCL<T>& x, std::ostream& os)
 void VTKOutCL::WriteCoords()
 /** Each process writes out its coordinates. */
 {
-    file_<< "<Piece NumberOfPoints=\""<<numPoints_<<"\" NumberOfCells=\""<<numTetras_<<"\">"
+    Out()<< "<Piece NumberOfPoints=\""<<numPoints_<<"\" NumberOfCells=\""<<numTetras_<<"\">"
             "\n\t<Points>"
-            "\n\t\t<DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\"" << ( binary_ ? "binary\">\n\t\t" : "ascii\">\n\t\t");
+            "\n\t\t<DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\"";
+    if (collective_){
+        piece_ << "appended\" offset=\"";
+        AppendRaw( coords_);
+        piece_ << "\"/>\n"
+                  "\t</Points>\n";
+        return;
+    }
+    file_ << ( binary_ ? "binary\">\n\t\t" : "ascii\">\n\t\t");
 
     if (binary_)
         WriteBase64(coords_, file_);
@@ -387,6 +491,27 @@ void VTKOutCL::GatherTetra()
 void VTKOutCL::WriteTetra( bool writeDistribution)
 /** Writes the tetrahedra into the VTK file*/
 {
+    if (collective_){
+        const Uint numVerts= onlyP1_ ? 4 : 10;
+        std::vector<Uint> offsets( numTetras_);
+        for (Uint i=0; i<numTetras_; ++i)
+            offsets[i]= (i+1)*numVerts;
+        const std::vector<Ubyte> types( numTetras_, onlyP1_ ? 10 : 24);
+        piece_ << "\t<Cells>\n"
+                  "\t\t<DataArray type=\"Int32\" Name=\"connectivity\" format=\"appended\" offset=\"";
+        AppendRaw( tetras_);
+        piece_ << "\"/>\n"
+                  "\t\t<DataArray type=\"Int32\" Name=\"offsets\" format=\"appended\" offset=\"";
+        AppendRaw( offsets);
+        piece_ << "\"/>\n"
+                  "\t\t<DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\"";
+        AppendRaw( types);
+        piece_ << "\"/>\n"
+                  "\t</Cells>";
+        if ( writeDistribution)
+            WriteDistribution();
+        return;
+    }
     file_   << "\t<Cells>\n"
                "\t\t<DataArray type=\"Int32\" Name=\"connectivity\" format=\"";
 // Binary output for the connectivity data seems useless (using >5 byte per integer), because it only blows up the amount of needed storage space, but it's implemented anyway,
@@ -436,6 +561,16 @@ void VTKOutCL::WriteDistribution()
 /** Writes the distribution-data into the file (as CellData)*/
 {
 #ifdef _PAR
+    if (collective_){
+        const std::vector<int> proc( numTetras_, ProcCL::MyRank());
+        piece_ << '\n'
+               << "\t<CellData Scalars=\"processor\">\n"
+               << "\t\t<DataArray type=\"Int32\" Name=\"processor\" format=\"appended\" offset=\"";
+        AppendRaw( proc);
+        piece_ << "\"/>\n"
+               << "\t</CellData>\n";
+        return;
+    }
     file_ << '\n'
           << "\t<CellData>\n"
           << "\t\t<DataArray type=\"Int32\" Name=\"processor\" format=\"ascii\">\n"
@@ -448,7 +583,7 @@ void VTKOutCL::WriteDistribution()
 #endif
 }
 
-void VTKOutCL::WriteVarNames(std::ofstream& file, bool masterfile)
+void VTKOutCL::WriteVarNames(std::ostream& file, bool masterfile)
 {
     std::vector<std::string> scalarvalued;
     std::vector<std::string> vectorvalued;
@@ -480,14 +615,20 @@ void VTKOutCL::WriteVarNames(std::ofstream& file, bool masterfile)
     file << ">";
 }
 
-void VTKOutCL::WriteValues( const VectorBaseCL<float>& allData, const std::string& name, int numData, std::ofstream* filePtr)
+void VTKOutCL::WriteValues( const VectorBaseCL<float>& allData, const std::string& name, int numData, std::ostream* filePtr)
 /** Writes out the calculated numerical data*/
 {
-    std::ofstream& file= filePtr ? *filePtr : file_;
-    
+    std::ostream& file= filePtr ? *filePtr : Out();
+
     file << "\n\t\t<" << ( !filePtr ? "" : "P") << "DataArray type=\"Float32\" Name=\"" << name << "\""
-            " NumberOfComponents=\"" << numData << "\" format=\""
-         << ( binary_ ? "binary\"" : "ascii\"") << ( !filePtr ? "" : "/") << ">";
+            " NumberOfComponents=\"" << numData << "\" format=\"";
+    if (collective_ && !filePtr){
+        piece_ << "appended\" offset=\"";
+        AppendRaw( allData);
+        piece_ << "\"/>";
+        return;
+    }
+    file << ( binary_ ? "binary\"" : "ascii\"") << ( !filePtr ? "" : "/") << ">";
     if( !filePtr) // omit for master file
     {
         file << "\n\t\t";
@@ -513,7 +654,7 @@ void VTKOutCL::PutGeom(double time, bool writeDistribution)
     GatherTetra();
     WriteCoords();
     WriteTetra( writeDistribution);
-    WriteVarNames(file_,/*masterfile=*/0);
+    WriteVarNames(Out(),/*masterfile=*/0);
 }
 
 void VTKOutCL::Clear()
@@ -70,6 +70,16 @@ class VTKOutCL
     const bool         binary_;                     ///< output in binary or ascii format
     const bool         onlyP1_;                     ///< the simulation only contains P1 data and therefore only that kind of data will be written out (shrinks file sizes)
     bool               geomwritten_;                ///< flag if geometry has been written
+    bool               collective_;                 ///< all processes write their piece into one file with appended raw data (by MPI-IO)
+    std::string        collName_;                   ///< name of the file written in collective mode
+
+    /// \name Buffers of the local piece in collective mode
+    //@{
+    std::ostringstream       piece_;                ///< XML description of the local piece (after the last appended array)
+    std::vector<std::string> pieceChunks_;          ///< XML description of the local piece, split at the offsets of the appended arrays
+    std::vector<size_t>      pieceOffsets_;         ///< local offsets of the appended arrays
+    std::vector<char>        appended_;             ///< local appended raw data
+    //@}
 
     vertexAddressMapT   vAddrMap_;                  ///< Map vertex address to a unique (consecutive) number
     edgeAddressMapT     eAddrMap_;                  ///< Map edge address to a unique (consecutive) number
@@ -95,7 +105,14 @@ class VTKOutCL
     /// Puts the footer into the file
     void PutFooter( );
     /// Writes the variable names of the numerical data into the file
-    void WriteVarNames(std::ofstream&,bool masterfile=0);
+    void WriteVarNames(std::ostream&,bool masterfile=0);
+    /// Stream, the description of the data is written to (file or buffer of the local piece)
+    std::ostream& Out() { return collective_ ? static_cast<std::ostream&>(piece_) : static_cast<std::ostream&>(file_); }
+    /// Appends raw data to the local appended data and writes the (preliminary local) offset into the XML description
+    template <typename ContT>
+    void AppendRaw(const ContT&);
+    /// Writes the local pieces of all processes into one file (collective mode)
+    void CommitCollective();
 
        /// \name Writes out coordinates of vertices
     //@{
@@ -126,7 +143,7 @@ class VTKOutCL
     template <typename DiscVecT>
     void GatherVector(const DiscVecT&, VectorBaseCL<float>&) const;
     /// Write data
-    void WriteValues(const VectorBaseCL<float>&, const std::string&, int, std::ofstream* masterFile= 0);
+    void WriteValues(const VectorBaseCL<float>&, const std::string&, int, std::ostream* masterFile= 0);
     //@}
 
 
@@ -154,10 +171,19 @@ class VTKOutCL
     template <typename DiscVecT>
     void PutVector( const DiscVecT&, const std::string&);
 
+    /// \brief All processes write into one file by collective MPI-IO instead of one file per process
+    ///
+    /// The data arrays are written as appended raw data, each process at its precomputed offset.
+    /// Call this before the first call of Write().
+    void SetCollectiveOut( bool collective=true) { collective_= collective; }
+
     /// \brief Ends output of a file
     void Commit(){
     	PutFooter();
-        file_.close();
+        if (collective_)
+            CommitCollective();
+        else
+            file_.close();
         timestep_++;
     }
 
@@ -338,6 +364,25 @@ class TwoPhaseTransportVTKCL : public TwoPhaseVTKCL<StokesCL, LevelsetCL>
 //              template definitions
 //=====================================================
 
+template <typename ContT>
+  void VTKOutCL::AppendRaw(const ContT& data)
+/** The offset is relative to the local appended data; CommitCollective() adds
+    the offset of the local data within the whole file. Each array is preceded by
+    its length in bytes (UInt32), as expected by VTK.*/
+{
+    pieceChunks_.push_back( piece_.str());
+    piece_.str( "");
+    pieceOffsets_.push_back( appended_.size());
+
+    const Uint nbytes= data.size()*sizeof(data[0]);
+    const char* hdr= reinterpret_cast<const char*>( &nbytes);
+    appended_.insert( appended_.end(), hdr, hdr+sizeof(Uint));
+    if (nbytes==0)
+        return;
+    const char* raw= reinterpret_cast<const char*>( Addr( data));
+    appended_.insert( appended_.end(), raw, raw+nbytes);
+}
+
 template <typename DiscScalT>
   void VTKOutCL::PutScalar( const DiscScalT& f, const std::string& name)
 /** Writes the values of a scalar valued function into the VTK file
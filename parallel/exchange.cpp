@@ -159,6 +159,44 @@ void ExchangeDataCL::DebugInfo(std::ostream &os) const
     os << std::endl;
 }
 
+// -----------------------------------------------
+// P E R S I S T E N T  E X C H A N G E  C L A S S
+// -----------------------------------------------
+
+void PersistentExchangeCL::Create(const std::vector<int>& procs,
+        const OffsetCT& sendOffsets, const OffsetCT& recvOffsets, int tag)
+/** \param procs       ranks of the neighbor processes
+    \param sendOffsets position of the first sent entry of each neighbor in the send buffer, the last entry is the size of the buffer
+    \param recvOffsets position of the first received entry of each neighbor in the receive buffer, the last entry is the size of the buffer
+    \param tag         tag used for all messages
+*/
+{
+    clear();
+    const size_t n= procs.size();
+    if (n>0){
+        sendBuf_.resize(sendOffsets[n]);
+        recvBuf_.resize(recvOffsets[n]);
+        req_.resize(2*n);
+        for (size_t i=0; i<n; ++i){
+            req_[i]  = ProcCL::SendInit(Addr(sendBuf_)+sendOffsets[i], sendOffsets[i+1]-sendOffsets[i], procs[i], tag);
+            req_[n+i]= ProcCL::RecvInit(Addr(recvBuf_)+recvOffsets[i], recvOffsets[i+1]-recvOffsets[i], procs[i], tag);
+        }
+    }
+    created_= true;
+}
+
+void PersistentExchangeCL::clear()
+{
+    if (active_)
+        Wait();
+    for (size_t i=0; i<req_.size(); ++i)
+        ProcCL::RequestFree(req_[i]);
+    req_.resize(0);
+    sendBuf_.resize(0);
+    recvBuf_.resize(0);
+    created_= false;
+}
+
 // --------------------------
 // E X C H A N G E  C L A S S
 // --------------------------
@@ -166,16 +204,17 @@ void ExchangeDataCL::DebugInfo(std::ostream &os) const
 // Init of static members
 ExchangeCL::SendList2ProcT ExchangeCL::SendList_     = ExchangeCL::SendList2ProcT();
 ExchangeCL::RecvSysnumCT   ExchangeCL::RecvSysnums_  = ExchangeCL::RecvSysnumCT();
-ExchangeCL::MappingIdxCT   ExchangeCL::tmpMappingIdx_= ExchangeCL::MappingIdxCT();
-ExchangeCL::SysnumProcCT   ExchangeCL::tmpSysProc_   = ExchangeCL::SysnumProcCT();
+ExchangeCL::CouplingCT     ExchangeCL::tmpCoupl_     = ExchangeCL::CouplingCT();
 IdxDescCL*                 ExchangeCL::RowIdx_       = 0;
 int                        ExchangeCL::maxNeighs_    = 0;
+bool                       ExchangeCL::usePersistent_= true;
 
 ExchangeCL::ExchangeCL()
 {
     created_   = false;
     mapCreated_= false;
     tag_       = 1001;
+    sendOffsets_.assign(1, 0);
 }
 
 ExchangeCL::~ExchangeCL()
@@ -197,10 +236,14 @@ void ExchangeCL::clear()
     SendRecvReq_.resize(0);
     created_=false;
     recvBuf_.resize(0);
-    MappingIdx_.clear();
-    SysProc_.clear();
+    sysProcBegin_.clear();
+    sysProc_.clear();
+    sysExtIdx_.clear();
     mapCreated_=false;
     accIdxCreated_=false;
+    pers_.clear();
+    sendIdx_.clear();
+    sendOffsets_.assign(1, 0);
 }
 
 // Definition of the wrappers for DDD
@@ -229,15 +272,56 @@ void ExchangeCL::CreateExchangeDataMPIType()
         throw DROPSErrCL("ExchangeCL::CreateExchangeDataClasses: Unknowns on edges (if exist) and vertices must be the same");
     }
 
+    const Uint numUnkVert= RowIdx_->NumUnknownsVertex();
     std::valarray<int> blocklength, displacements;
+    sendIdx_.clear();
+    sendOffsets_.assign(1, 0);
     for (const_SendList2ProcIter it(SendList_.begin()), end(SendList_.end()); it!=end; ++it){
-        const size_t numSendUnks=RowIdx_->NumUnknownsVertex()*it->second.size();
-        blocklength.resize(numSendUnks, RowIdx_->NumUnknownsVertex());
+        const size_t numSendUnks=numUnkVert*it->second.size();
+        blocklength.resize(numSendUnks, numUnkVert);
         displacements.resize(it->second.size());
         std::copy(it->second.begin(), it->second.end(), Addr(displacements));
         ExList_.push_back(ExchangeDataCL(it->first));
         ExList_.back().CreateDataType(it->second.size(), Addr(blocklength), Addr(displacements));
+        // same order as described by the MPI datatype, but packed for the persistent requests
+        for (SendListSingleProcT::const_iterator sit(it->second.begin()); sit!=it->second.end(); ++sit)
+            for (Uint i=0; i<numUnkVert; ++i)
+                sendIdx_.push_back(*sit+i);
+        sendOffsets_.push_back(sendIdx_.size());
+    }
+}
+
+void ExchangeCL::CreatePersistent_() const
+/// Create the persistent requests on the packed buffers for all neighbors
+{
+    std::vector<int> procs;
+    PersistentExchangeCL::OffsetCT recvOffsets(1, 0);
+    for (CommListCT::const_iterator it(ExList_.begin()), end(ExList_.end()); it!=end; ++it){
+        procs.push_back(it->GetProc());
+        recvOffsets.push_back(recvOffsets.back()+it->GetNumRecvEntries());
+    }
+    pers_.Create(procs, sendOffsets_, recvOffsets, tag_);
+}
+
+void ExchangeCL::CreateMapping(Uint numUnk)
+/// Build the flat mapping (local sysnum, proc) -> external sysnum from the couplings
+/// received by TransferSendOrder in one pass: The couplings are sorted by local sysnum
+/// and proc, and stored consecutively, so that the procs of sysnum i are found in
+/// [sysProcBegin_[i], sysProcBegin_[i+1]).
+{
+    std::sort( tmpCoupl_.begin(), tmpCoupl_.end());
+    tmpCoupl_.erase( std::unique( tmpCoupl_.begin(), tmpCoupl_.end()), tmpCoupl_.end());
+
+    sysProcBegin_.assign( numUnk+1, 0);
+    sysProc_.resize( tmpCoupl_.size());
+    sysExtIdx_.resize( tmpCoupl_.size());
+    for (size_t pos=0; pos<tmpCoupl_.size(); ++pos){
+        ++sysProcBegin_[tmpCoupl_[pos].local+1];
+        sysProc_[pos]  = tmpCoupl_[pos].proc;
+        sysExtIdx_[pos]= tmpCoupl_[pos].remote;
     }
+    for (Uint i=0; i<numUnk; ++i)
+        sysProcBegin_[i+1]+= sysProcBegin_[i];
 }
 
 void ExchangeCL::TransferSendOrder(bool CreateMap)
@@ -274,11 +358,8 @@ void ExchangeCL::TransferSendOrder(bool CreateMap)
     }
 
     // Static members are just used for the creation via DDD-Interface
-    if (CreateMap){
-        MappingIdx_ = tmpMappingIdx_;
-        SysProc_.resize(tmpSysProc_.size());
-        std::copy(tmpSysProc_.begin(), tmpSysProc_.end(), SysProc_.begin());
-    }
+    if (CreateMap)
+        CreateMapping(RowIdx_->NumUnknowns());
 
 #if DROPSDebugC&DebugParallelNumC
     // Check if all values of RecvSysnums_ are set
@@ -346,8 +427,7 @@ void ExchangeCL::CreateIndices(IdxDescCL *RowIdx, const VectorBaseCL<bool>& Dist
         for (IdxT i=0; i<numDistrIdx_; ++i)
         {
             IdxT dof= DistrIndex[i];
-            ProcNumCT onProc= GetProcs(dof);
-            ProcNumT minProc= *std::min_element(onProc.begin(), onProc.end());
+            ProcNumT minProc= *GetProcsBegin(dof);      // procs are sorted
             if (minProc>me)
                 coup[minProc].push_back(dof);
         }
@@ -430,6 +510,7 @@ void ExchangeCL::CreateList(const MultiGridCL& mg, IdxDescCL *RowIdx, bool Creat
 /// \param CreateAccDist Tell this function to create also lists, so that the ExchangeCL is able to
 ///    handle accumulated vectors
 {
+    DROPS_PROFILE_REGION("ExchangeCL::CreateList");
     if (created_)
         clear();
     SendList_.clear();
@@ -459,7 +540,7 @@ void ExchangeCL::CreateList(const MultiGridCL& mg, IdxDescCL *RowIdx, bool Creat
 
       // Allocate memory
     VectorBaseCL<bool> DistSysnums(false, numUnk);
-    tmpSysProc_.resize(numUnk);
+    tmpCoupl_.clear();
 
       // Collect distributed sysnums and put them into the lists
     if (numUnkVert>0){
@@ -478,17 +559,22 @@ void ExchangeCL::CreateList(const MultiGridCL& mg, IdxDescCL *RowIdx, bool Creat
 
       // Since number of send DOF to a processor is the same as the number of receiving
       // elements, resize the RecvSysnums_
+    size_t numAllSendUnks=0;
     for (SendList2ProcIter it(SendList_.begin()), end(SendList_.end()); it!=end; ++it){
         const size_t numSendUnks=numUnkVert*it->second.size();
         RecvSysnums_.insert( RecvSysnumElemT(it->first, ExchangeDataCL::SysnumListCT(numSendUnks, NoIdx)) );
+        numAllSendUnks+= numSendUnks;
     }
+    if (CreateMap)
+        tmpCoupl_.reserve( numAllSendUnks);
 
       // Tell neighbor processors about the send order of the unknowns via a
       // DDD-interface.
     TransferSendOrder(CreateMap);
     if (!CreateMap){
-        MappingIdx_.clear();
-        SysProc_.clear();
+        sysProcBegin_.clear();
+        sysProc_.clear();
+        sysExtIdx_.clear();
         mapCreated_=false;
     }
     else{
@@ -515,8 +601,7 @@ void ExchangeCL::CreateList(const MultiGridCL& mg, IdxDescCL *RowIdx, bool Creat
       // Free memory and reset static members
     SendList_.clear();
     RecvSysnums_.clear();
-    tmpMappingIdx_.clear();
-    tmpSysProc_.clear();
+    CouplingCT().swap( tmpCoupl_);
     RowIdx_=0;
     maxNeighs_=-1;
 
@@ -629,8 +714,7 @@ bool ExchangeCL::IsAcc(const VectorCL& vec) const
       // Collect information of distributed DoFs
     for (IdxT i=0; i<vec.size(); ++i)
         if (IsDist(i)){
-            ProcNumCT onProcs=GetProcs(i);
-            for (ProcNumCT::iterator it(onProcs.begin()), end(onProcs.end()); it!=end; ++it)
+            for (ProcNum_const_iterator it(GetProcsBegin(i)), end(GetProcsEnd(i)); it!=end; ++it)
                 ToSend[*it].push_back(CoupT(i,vec[i]));
         }
 
@@ -750,14 +834,14 @@ bool ExchangeCL::IsEqual(const ExchangeCL &ex, std::ostream* os) const
 template<>
 void ExchangeCL::Accumulate<double>(VectorBaseCL<double> &x) const
 {
+    DROPS_PROFILE_REGION("ExchangeCL::Accumulate");
     Assert(created_, DROPSErrCL("ExchangeCL::Accumulate: Lists have not been created (Maybe use CreateList before!)\n"), DebugParallelNumC);
     if (x.size()!=vecSize_)
         printf ("ExchangeCL::Accumulate: Vector has size %lu, but should be %li; MyRank %i\n", (unsigned long)x.size(), vecSize_, ProcCL::MyRank());
     Assert(x.size()==vecSize_, DROPSErrCL("ExchangeCL::Accumulate: vector length does not fit to the created lists. (Maybe used a wrong IdxDescCL?)"), DebugParallelNumC);
 
-    RequestCT req(ExList_.size());
-    InitCommunication(x, SendRecvReq_);
-    AccFromAllProc(x, SendRecvReq_);
+    StartAccumulation(x);
+    FinishAccumulation(x);
 }
 
 // -------------------------------------
@@ -767,17 +851,25 @@ void ExchangeCL::Accumulate<double>(VectorBaseCL<double> &x) const
 void ExchangeBlockCL::AttachTo(const IdxDescCL& idx)
 /** Beside attaching the index describer to the known indices,
     this functions creates the default send- and receive requests
-    and correctly fill the offsets.
+    and correctly fill the offsets. Each ExchangeCL owns only one set
+    of standard buffers. If the ExchangeCL of \a idx is already used by
+    another block, the new block is accumulated by InitCommunication
+    with its own receive buffer instead.
     \param[in] idx new index description
 */
 {
+    bool shared= false;
+    for (size_t i=0; i<idxDesc_.size(); ++i)
+        shared= shared || &idxDesc_[i]->GetEx()==&idx.GetEx();
+    persistent_.push_back( !shared);
     idxDesc_.push_back(&idx);
     SendRecvReq_.push_back( ExchangeCL::RequestCT( 2*idxDesc_.back()->GetEx().GetNumNeighs()));
     Update();
 }
 
 void ExchangeBlockCL::Update()
-/** Update the blockOffset_, where the sizes of the block vectors can be found*/
+/** Update the blockOffset_, where the sizes of the block vectors can be found,
+    and the receive buffers of the blocks, that do not use the standard buffers*/
 {
     blockOffset_.resize(idxDesc_.size()+1);
     // fill block offsets
@@ -785,6 +877,10 @@ void ExchangeBlockCL::Update()
     for (size_t i=1; i<blockOffset_.size(); ++i){
         blockOffset_[i]= blockOffset_[i-1] + idxDesc_[i-1]->NumUnknowns();
     }
+    recvBuf_.resize(idxDesc_.size());
+    for (size_t i=0; i<idxDesc_.size(); ++i)
+        if (!persistent_[i])
+            recvBuf_[i].resize(idxDesc_[i]->GetEx().GetNumReceiveElements());
 }
 
 void ExchangeBlockCL::InitCommunication(const VectorCL& vec, VecRequestCT& req,
@@ -804,6 +900,30 @@ void ExchangeBlockCL::InitCommunication(const VectorCL& vec, VecRequestCT& req,
     }
 }
 
+void ExchangeBlockCL::StartAcc_(const VectorCL& vec) const
+/** Start the accumulation of all blocks by the standard buffers of the
+    corresponding ExchangeCLs (i.e. by persistent requests if enabled).
+    A block, whose ExchangeCL is already used by a previous block, sends
+    and receives by InitCommunication into its own receive buffer.
+ */
+{
+    for (size_t i=0; i<GetNumBlocks(); ++i)
+        if (persistent_[i])
+            idxDesc_[i]->GetEx().StartAccumulation( vec, blockOffset_[i]);
+        else
+            idxDesc_[i]->GetEx().InitCommunication( vec, SendRecvReq_[i], startTag_+i, blockOffset_[i], &recvBuf_[i]);
+}
+
+void ExchangeBlockCL::FinishAcc_(VectorCL& vec) const
+/** Finish the accumulation started by StartAcc_.*/
+{
+    for (size_t i=0; i<GetNumBlocks(); ++i)
+        if (persistent_[i])
+            idxDesc_[i]->GetEx().FinishAccumulation( vec, blockOffset_[i]);
+        else
+            idxDesc_[i]->GetEx().AccFromAllProc( vec, SendRecvReq_[i], blockOffset_[i], &recvBuf_[i]);
+}
+
 void ExchangeBlockCL::AccFromAllProc(VectorCL& vec, VecRequestCT& req,
         std::vector<VectorCL>* recvBuf) const
 /** After the the communication is finished, the vector \a vec
@@ -833,7 +953,6 @@ void ExchangeMatrixCL::BuildCommPattern(const MatrixCL& mat,
     communicated among the processors. Therefore, each processor determines the non-zeroes
     it has to send to neighbors. And second, each processor determines how handle the received
     non-zeroes from a neighbor processor.
-    \todo Are RowEx.GetProcs( i) and ColEx.GetProcs( j) already sorted?
     \param mat distributed matrix
     \param RowEx ExchangeCL that corresponds to row
     \param ColEx ExchangeCL that corresponds to column
@@ -856,9 +975,7 @@ void ExchangeMatrixCL::BuildCommPattern(const MatrixCL& mat,
                 const size_t j= mat.col_ind(nz);
                 if ( ColEx.IsDist( j)){     // here, i and j are both distributed
                     // determine all neighbor processors, that owns i *and* j as well
-                    ProcNumCT RowProcs( RowEx.GetProcs( i));
-                    ProcNumCT ColProcs( ColEx.GetProcs( j));
-                    ProcNum_iter end = Intersect( RowProcs, ColProcs, NZonProcs);
+                    ProcNum_iter end = Intersect( RowEx, i, ColEx, j, NZonProcs);
 
                     for (ProcNum_iter proc= NZonProcs.begin(); proc!=end; ++proc){
                         // mark the non-zero, that this non-zero should be sent to neighbor *proc
@@ -37,6 +37,7 @@
 #include "num/spmat.h"
 #include "geom/multigrid.h"
 #include "misc/problem.h"
+#include "misc/profiler.h"
 
 namespace DROPS{
 
@@ -132,6 +133,54 @@ class ExchangeDataCL : public ExchangeDataSendCL
     void DebugInfo(std::ostream&) const;
 };
 
+/****************************************************************************
+* P E R S I S T E N T  E X C H A N G E  C L A S S                           *
+****************************************************************************/
+/// \brief Persistent requests on packed buffers for accumulating vectors
+/** The send and receive requests to all neighbor processes are created once
+    (MPI_Send_init/MPI_Recv_init) on contiguous buffers and are only restarted
+    for each accumulation. So neither MPI datatypes nor new requests are set
+    up per message. A copy of this class does not share the requests with the
+    original one, i.e. it is empty and has to be created again.
+ */
+/****************************************************************************
+* P E R S I S T E N T  E X C H A N G E  C L A S S                           *
+****************************************************************************/
+class PersistentExchangeCL
+{
+  public:
+    typedef VectorBaseCL<ProcCL::RequestT> RequestCT;   ///< Type for storage of the requests
+    typedef std::vector<IdxT>              OffsetCT;    ///< Offsets of the neighbors in the buffers
+
+  private:
+    VectorCL  sendBuf_;     // packed entries, that are sent to all neighbors
+    VectorCL  recvBuf_;     // entries received from all neighbors
+    RequestCT req_;         // persistent send requests followed by persistent receive requests
+    bool      created_;     // requests have been created
+    bool      active_;      // communication has been started but not finished
+
+  public:
+    PersistentExchangeCL() : created_(false), active_(false) {}
+    PersistentExchangeCL(const PersistentExchangeCL&) : created_(false), active_(false) {}
+    PersistentExchangeCL& operator= (const PersistentExchangeCL&) { clear(); return *this; }
+    ~PersistentExchangeCL() { clear(); }
+
+    /// \brief Create the requests for the given neighbors, the offsets have one more entry than procs
+    void Create(const std::vector<int>& procs, const OffsetCT& sendOffsets, const OffsetCT& recvOffsets, int tag);
+    /// \brief Free all requests and buffers
+    void clear();
+
+    bool      Created() const { return created_; }  ///< Check if the requests have been created
+    bool      Active()  const { return active_; }   ///< Check if a communication is in progress
+    VectorCL& SendBuf()       { return sendBuf_; }  ///< Buffer to be filled before calling Start
+    VectorCL& RecvBuf()       { return recvBuf_; }  ///< Received entries after calling Wait
+
+    /// \brief Start all sends and receives
+    inline void Start();
+    /// \brief Wait until all sends and receives are completed
+    inline void Wait();
+};
+
 /****************************************************************************
 * E X C H A N G E  C L A S S                                                *
 ****************************************************************************/
@@ -160,6 +209,7 @@ class ExchangeCL
     typedef VectorBaseCL<ProcCL::RequestT> RequestCT;           ///< Type for storage Request for all neighbor procs
     typedef int ProcNumT;                                       ///< Type for number of procs
     typedef std::list<ProcNumT>            ProcNumCT;           ///< List of procs
+    typedef const ProcNumT*                ProcNum_const_iterator; ///< Iterator over the procs of a sysnum, see GetProcsBegin()
     typedef std::vector<IdxT>              IdxVecT;             ///< Vector of indices
 
     IndexT  LocalIndex;                                         ///< Indices of local sysnums
@@ -169,14 +219,13 @@ class ExchangeCL
   private:
       // types for internal handling of exchanging numerical data and mapping of sysnums of proc-boundary
     typedef std::list< ExchangeDataCL >          CommListCT;        // Store information about one index
-    typedef std::map<IdxT, IdxT>                 ProcMappingIdxCT;  // all local idx to external idx according to one proc
-    typedef std::map<ProcNumT, ProcMappingIdxCT> MappingIdxCT;      // all idx mappings for all neighbor procs
-    typedef std::vector<ProcNumCT>               SysnumProcCT;      // procs of a sysnum
+    typedef std::vector<ProcNumT>                SysnumProcCT;      // procs of all sysnums, stored consecutively
 
       // internal handling of exchanging numerical data and mapping of sysnums of proc-boundary
     CommListCT        ExList_;          // Storage for all ExchangeData-Classes
-    MappingIdxCT      MappingIdx_;      // maps local idx to external idx according to proc
-    SysnumProcCT      SysProc_;         // procs that owns a sysnum
+    IdxVecT           sysProcBegin_;    // the procs of sysnum i are stored in [sysProcBegin_[i], sysProcBegin_[i+1]) of sysProc_ and sysExtIdx_
+    SysnumProcCT      sysProc_;         // procs (except this proc) that own a sysnum, sorted by rank for each sysnum
+    IdxVecT           sysExtIdx_;       // sysnum on the corresponding proc of sysProc_
     ProcNumCT         Neighs_;          // neighbors
     mutable RequestCT SendRecvReq_;     // standard request handle for non-blocking sending and receiving
 
@@ -188,11 +237,23 @@ class ExchangeCL
     typedef std::map<ProcNumT, ExchangeDataCL::SysnumListCT>  RecvSysnumCT;
     typedef std::pair<ProcNumT, ExchangeDataCL::SysnumListCT> RecvSysnumElemT;
 
+    /// \brief Coupling (local sysnum, proc) -> sysnum on proc, received during TransferSendOrder
+    struct CouplingST
+    {
+        IdxT     local;
+        ProcNumT proc;
+        IdxT     remote;
+
+        CouplingST(IdxT l, ProcNumT p, IdxT r) : local(l), proc(p), remote(r) {}
+        bool operator< (const CouplingST& c) const { return local<c.local || (local==c.local && proc<c.proc); }
+        bool operator==(const CouplingST& c) const { return local==c.local && proc==c.proc; }
+    };
+    typedef std::vector<CouplingST>                           CouplingCT;
+
       // members for creating the ExchangeCL (static for DDD)
     static SendList2ProcT SendList_;
     static RecvSysnumCT   RecvSysnums_;
-    static MappingIdxCT   tmpMappingIdx_;
-    static SysnumProcCT   tmpSysProc_;
+    static CouplingCT     tmpCoupl_;
     static IdxDescCL*     RowIdx_;
     static int            maxNeighs_;
 
@@ -203,6 +264,7 @@ class ExchangeCL
       static IdxT findPos(const std::vector<T>& a, const T& elem);
     void CreateExchangeDataMPIType();
     void TransferSendOrder(bool CreateMap);
+    void CreateMapping(Uint numUnk);
     void CreateIndices(IdxDescCL*, const VectorBaseCL<bool>&, bool forAccParDot);
 
       // flags and sizes
@@ -220,6 +282,15 @@ class ExchangeCL
     mutable VectorCL recvBuf_;  // Standard buffer for receiving unknowns
     IdxVecT recvOffsets_;       // offsets for receiving (so each neighbor stores in different positions of the same receive buffer)
 
+      // persistent communication on packed buffers (see UsePersistentRequests)
+    static bool usePersistent_;         // use persistent requests for the standard accumulation
+    IdxVecT sendIdx_;                   // positions of the entries sent to the neighbors, packed in the order of ExList_
+    IdxVecT sendOffsets_;               // offset of each neighbor in sendIdx_ (numNeighs_+1 entries)
+    mutable PersistentExchangeCL pers_; // persistent requests, created on first use
+    void CreatePersistent_() const;
+
+    template <typename IdxContT>
+    static inline double IdxDot_(const VectorCL&, const VectorCL&, const IdxContT&, Ulint);         // sum of x[idx[i]]*y[idx[i]], i<n, OpenMP-parallel
     inline double LocDot_(const VectorCL&, const VectorCL&, VectorCL* x_acc) const;                   // Inner Product of one accumulated and one distributed vector
 
     inline double AccurLocDotNoAcc_(const VectorCL&, const VectorCL&) const;                          // Accure inner product with no accumulation
@@ -269,6 +340,14 @@ class ExchangeCL
     inline void                  Accumulate(VectorBaseCL<T>&) const;                    // Accumulate the Vector
     inline VectorCL              GetAccumulate (const VectorCL&) const;                 // Return accumulated Vector
     inline std::vector<VectorCL> GetAccumulate (const std::vector<VectorCL>&) const;    // Return accumulated vectors
+    inline void                  MulAcc(const MatrixCL&, const VectorCL&, VectorCL&, VectorCL&) const; // y=A*x_acc and y_acc, overlapping the accumulation with the interior rows
+
+    // accumulation with the standard buffers of this class, by persistent requests if enabled
+    inline void   StartAccumulation(const VectorCL&, Ulint offset=0) const;          // pack and send shared entries
+    inline void   FinishAccumulation(VectorCL&, Ulint offset=0) const;               // receive and add shared entries
+    /// \brief Use persistent requests on packed buffers for StartAccumulation and FinishAccumulation (default) or Isend/Irecv with MPI datatypes
+    static void   UsePersistentRequests(bool use) { usePersistent_= use; }
+    static bool   PersistentRequests() { return usePersistent_; }
 
     // Perform inner products (without and with global reduce)
     inline double LocDot    (const VectorCL&, bool, const VectorCL&, bool, bool useAccur=true, VectorCL* x_acc=0, VectorCL* y_acc=0) const;
@@ -301,7 +380,9 @@ class ExchangeCL
     inline IdxT      GetExternalIdxFromProc(IdxT, ProcNumT) const;                      // Get index of a distributed index on another proc
     inline bool      IsDist(IdxT) const;                                                // Check if a sysnum is distributed
     inline bool      IsOnProc(IdxT,ProcNumT);                                           // Check if a sysnum can be found on another proc
-    inline const ProcNumCT& GetProcs(IdxT) const;                                       // Get list of procs that owns a sysnum (except local proc)
+    inline ProcNumCT GetProcs(IdxT) const;                                              // Get list of procs that owns a sysnum (except local proc)
+    inline ProcNum_const_iterator GetProcsBegin(IdxT) const;                            // Begin of the (sorted) procs that own a sysnum (except local proc), does not allocate
+    inline ProcNum_const_iterator GetProcsEnd(IdxT) const;                              // End of the procs that own a sysnum
     inline Uint      GetNumProcs(IdxT) const;                                           // Get number of procs, that owns a sysnum
     inline bool      IsExclusive(IdxT) const;                                           // Is a sysnum on the calling processor exclusive (i.e. this proc has the smallest proc id)
     inline int       GetExclusiveProc(IdxT) const;                                      // Get process that is responsible for the dof
@@ -350,12 +431,18 @@ class ExchangeBlockCL
     IdxDescCT            idxDesc_;      ///< store all index describers to access ExchangeCLs
     BlockOffsetCT        blockOffset_;  ///< store the length of vectors
     mutable VecRequestCT SendRecvReq_;  ///< standard requests for sending and receiving
+    std::vector<bool>    persistent_;   ///< false, if the ExchangeCL of the block is already used by a previous block
+    mutable std::vector<VectorCL> recvBuf_; ///< receive buffers of the blocks, which do not use the buffers of their ExchangeCL
     int                  startTag_;     ///< first Tag to be used for sending and receiving
 
     /// \brief start sending and receiving
     void InitCommunication(const VectorCL&, VecRequestCT&, int tag=-1, std::vector<VectorCL>* recvBuf =0) const;
     /// \brief finish communication and accumulate vector
     void AccFromAllProc(VectorCL&, VecRequestCT&, std::vector<VectorCL>* recvBuf=0) const;
+    /// \brief start sending and receiving by the standard buffers of the ExchangeCLs
+    void StartAcc_(const VectorCL&) const;
+    /// \brief finish communication started by StartAcc_ and accumulate vector
+    void FinishAcc_(VectorCL&) const;
 
     /// \brief Sum up local elements
     inline double SumUpLocal(const VectorCL&, const VectorCL&) const;
@@ -373,7 +460,7 @@ class ExchangeBlockCL
 
   public:
     ExchangeBlockCL()
-      : idxDesc_(), blockOffset_(), SendRecvReq_(), startTag_(1001) {}
+      : idxDesc_(), blockOffset_(), SendRecvReq_(), persistent_(), recvBuf_(), startTag_(1001) {}
 
     /// \brief Attach an index describer
     void AttachTo(const IdxDescCL&);
@@ -384,7 +471,7 @@ class ExchangeBlockCL
     /// \brief Ask for an ExchangeCL
     const ExchangeCL& GetEx( size_t i) const { return idxDesc_[i]->GetEx(); }
 
-    /// \brief Update of datastructure, i.e. blockoffset_
+    /// \brief Update of datastructure, i.e. blockoffset_ and the receive buffers
     void Update();
 
     /// \brief Perform an inner product without global reduction of the sum
@@ -432,13 +519,11 @@ class ExchangeMatrixCL
     /// flag, if non-zero is not stored on local processor
     static size_t NoIdx_;
 
-    /// Determine the intersection of two processor lists
-    inline ProcNum_iter Intersect(ProcNumCT& a, ProcNumCT& b, ProcNumCT& result)
-    /// Sort both lists and use the standard intersection algorithm
+    /// Determine the intersection of the processors owning sysnum i of RowEx and sysnum j of ColEx
+    inline ProcNum_iter Intersect(const ExchangeCL& RowEx, IdxT i, const ExchangeCL& ColEx, IdxT j, ProcNumCT& result)
+    /// The procs of a sysnum are stored sorted by ExchangeCL, so the standard intersection algorithm can be applied directly
     {
-        a.sort();
-        b.sort();
-        return std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), result.begin());
+        return std::set_intersection(RowEx.GetProcsBegin( i), RowEx.GetProcsEnd( i), ColEx.GetProcsBegin( j), ColEx.GetProcsEnd( j), result.begin());
     }
 
     /// Determine the position, where a nonzero is stored
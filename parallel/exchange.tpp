@@ -75,11 +75,38 @@ void ExchangeDataCL::Accumulate(VectorBaseCL<T>& v, Ulint offsetV, VectorBaseCL<
     \pre Communication has to be done before entering this procedure
 */
 {
-    // add the data to the positions described by Sysnums_
-    for (Uint i=0; i<GetNumRecvEntries(); ++i)
+    // add the data to the positions described by Sysnums_, which are distinct
+    // within this list, so the entries can be added by all OpenMP threads
+    const size_t n= GetNumRecvEntries();
+#ifndef DROPS_WIN
+    size_t i;
+#else
+    int i;
+#endif
+#   pragma omp parallel for if (n > omp_min_vector_size)
+    for (i=0; i<n; ++i)
         v[Sysnums_[i]+offsetV] += recvBuf[i+offsetRecv];
 }
 
+// -----------------------------------------------
+// P E R S I S T E N T  E X C H A N G E  C L A S S
+// -----------------------------------------------
+
+void PersistentExchangeCL::Start()
+{
+    Assert(created_, DROPSErrCL("PersistentExchangeCL::Start: Requests have not been created"), DebugParallelNumC);
+    if (req_.size()>0)
+        ProcCL::StartAll(req_);
+    active_= true;
+}
+
+void PersistentExchangeCL::Wait()
+{
+    if (req_.size()>0)
+        ProcCL::WaitAll(req_);
+    active_= false;
+}
+
 // --------------------------
 // E X C H A N G E  C L A S S
 // --------------------------
@@ -201,8 +228,7 @@ template <typename SimplexT>
                     // put these information into the lists
                     for (Uint j=0; j<RowIdx_->NumUnknownsVertex(); ++j){
                         RecvSysnums_[fromProc][sendPos+j]=localSysnum + j;          // where to add received dof
-                        tmpMappingIdx_[fromProc][localSysnum+j]= remoteSysnum +j;   // mapping (proc,localsysnum)->remote sysnum
-                        tmpSysProc_[localSysnum+j].push_back(fromProc);             // mapping localsysnum->[processors, owning sysnum]
+                        tmpCoupl_.push_back( CouplingST(localSysnum+j, fromProc, remoteSysnum+j)); // mapping (proc,localsysnum)->remote sysnum
                     }
                     // check if this is an extended dof
                     if (RowIdx_->IsExtended() && buffer[4]!=NoIdx){
@@ -212,8 +238,7 @@ template <typename SimplexT>
                         localSysnum=RowIdx_->GetXidx()[localSysnum];
                         for (Uint j=0; j<RowIdx_->NumUnknownsVertex(); ++j){
                             RecvSysnums_[fromProc][sendPos+j]=localSysnum + j;
-                            tmpMappingIdx_[fromProc][localSysnum+j]= remoteSysnum +j;
-                            tmpSysProc_[localSysnum+j].push_back(fromProc);
+                            tmpCoupl_.push_back( CouplingST(localSysnum+j, fromProc, remoteSysnum+j));
                         }
                     }
                 }
@@ -395,6 +420,23 @@ void ExchangeCL::AccFromAllProc(VectorBaseCL<T> &vec, RequestCT& req, VectorBase
         lit->Accumulate(vec, offset, recvBuf, recvOffsets_[i]);
 }
 
+/// \brief Sum of x[idx[i]]*y[idx[i]] for 0<=i<n
+/** Long index lists are summed up by all OpenMP threads of this proc.*/
+template <typename IdxContT>
+inline double ExchangeCL::IdxDot_(const VectorCL& x, const VectorCL& y, const IdxContT& idx, Ulint n)
+{
+    double sum=0;
+#ifndef DROPS_WIN
+    Ulint i;
+#else
+    int i;
+#endif
+#   pragma omp parallel for reduction(+: sum) if (n > omp_min_vector_size)
+    for (i=0; i<n; ++i)
+        sum += x[idx[i]] * y[idx[i]];
+    return sum;
+}
+
 /****************************************************
 *   L O C  D O T _                                  *
 *****************************************************
@@ -413,7 +455,7 @@ double ExchangeCL::LocDot_(const VectorCL& x, const VectorCL& y, VectorCL* x_acc
     double loc_sum=0;                       // sum of local entries
     double dist_sum=0;                      // sum of distributed entries
 
-    InitCommunication(x, SendRecvReq_);        // send shared entries of x to all neighbor procs
+    StartAccumulation(x);                   // send shared entries of x to all neighbor procs
 
     // assign all values of x to x_acc
     if (newx)
@@ -423,13 +465,11 @@ double ExchangeCL::LocDot_(const VectorCL& x, const VectorCL& y, VectorCL* x_acc
         *x_acc=x;
     }
 
-    for (Ulint i=0; i<numLocalIdx_; ++i)    // do local summation
-        loc_sum += x[LocalIndex[i]] * y[LocalIndex[i]];
+    loc_sum += IdxDot_(x, y, LocalIndex, numLocalIdx_);    // do local summation
 
-    AccFromAllProc(*x_acc, SendRecvReq_);   // recieve values from neighbors and sum them up
+    FinishAccumulation(*x_acc);             // recieve values from neighbors and sum them up
 
-    for (Ulint i=0; i<numDistrIdx_; ++i)    // do summation of distributed entries
-        dist_sum += (*x_acc)[DistrIndex[i]] * y[DistrIndex[i]];
+    dist_sum += IdxDot_(*x_acc, y, DistrIndex, numDistrIdx_);    // do summation of distributed entries
 
 
     if (newx){                              // if new x_acc where created give memory free
@@ -459,13 +499,11 @@ double ExchangeCL::AccurLocDotNoAcc_(const VectorCL& x, const VectorCL& y) const
            acc_sum=0;       // sum of distributed entries
 
     // do local summation
-    for (Ulint i=0; i<numLocalIdx_; ++i)
-        loc_sum += x[LocalIndex[i]] * y[LocalIndex[i]];
+    loc_sum += IdxDot_(x, y, LocalIndex, numLocalIdx_);
 
 
     // now do the global summation
-    for (Ulint i=0; i<AccDistIndex.size(); ++i)
-        acc_sum += x[AccDistIndex[i]] * y[AccDistIndex[i]];
+    acc_sum += IdxDot_(x, y, AccDistIndex, AccDistIndex.size());
 
     return loc_sum+acc_sum;
 }
@@ -493,7 +531,7 @@ double ExchangeCL::AccurLocDotOneAcc_(const VectorCL& x_acc, const VectorCL& y,
     double loc_sum=0,                       // sum of local entries
            acc_sum=0;                       // sum of distributed entries
 
-    InitCommunication(y, SendRecvReq_);     // send shared entries of x to all neighbor procs
+    StartAccumulation(y);                   // send shared entries of y to all neighbor procs
 
     if (newy)
         y_acc = new VectorCL(y);
@@ -503,14 +541,12 @@ double ExchangeCL::AccurLocDotOneAcc_(const VectorCL& x_acc, const VectorCL& y,
     }
 
     // do local summation
-    for (Ulint i=0; i<numLocalIdx_; ++i)
-        loc_sum += x_acc[LocalIndex[i]] * y[LocalIndex[i]];
+    loc_sum += IdxDot_(x_acc, y, LocalIndex, numLocalIdx_);
 
-    AccFromAllProc(*y_acc, SendRecvReq_);   // recieve values from neighbors and sum them up
+    FinishAccumulation(*y_acc);             // recieve values from neighbors and sum them up
 
     // now do the global summation
-    for (Ulint i=0; i<AccDistIndex.size(); ++i)
-        acc_sum += x_acc[AccDistIndex[i]] * (*y_acc)[AccDistIndex[i]];
+    acc_sum += IdxDot_(x_acc, *y_acc, AccDistIndex, AccDistIndex.size());
 
     // free memory
     if (newy){
@@ -548,7 +584,7 @@ double ExchangeCL::AccurLocDotBothAcc_(const VectorCL& x, const VectorCL& y, Vec
     RequestCT req_y(2*ExList_.size());
     VectorCL  secondRecvBuf(recvBuf_.size());
 
-    InitCommunication(x, SendRecvReq_, tag_);               // send shared entries of x to all neighbor procs
+    StartAccumulation(x);                                   // send shared entries of x to all neighbor procs
     InitCommunication(y, req_y, tag_+1, 0, &secondRecvBuf); // send shared entries of y to all neighbor procs
 
     if (newx)
@@ -566,15 +602,13 @@ double ExchangeCL::AccurLocDotBothAcc_(const VectorCL& x, const VectorCL& y, Vec
     }
 
     // do local summation
-    for (Ulint i=0; i<numLocalIdx_; ++i)
-        loc_sum += x[LocalIndex[i]] * y[LocalIndex[i]];
+    loc_sum += IdxDot_(x, y, LocalIndex, numLocalIdx_);
 
-    AccFromAllProc(*x_acc, SendRecvReq_);                   // recieve values from neighbors and sum them up
+    FinishAccumulation(*x_acc);                             // recieve values from neighbors and sum them up
     AccFromAllProc(*y_acc, req_y, 0, &secondRecvBuf);       // recieve values from neighbors and sum them up
 
     // now do the global summation
-    for (Ulint i=0; i<AccDistIndex.size(); ++i)
-        acc_sum += (*x_acc)[AccDistIndex[i]] * (*y_acc)[AccDistIndex[i]];
+    acc_sum += IdxDot_(*x_acc, *y_acc, AccDistIndex, AccDistIndex.size());
 
     // free memory
     if (newx){
@@ -640,9 +674,9 @@ double ExchangeCL::LocDot (const VectorCL& x, bool acc_x,
         }
         // form here on at least one vector is accumulated
         if (acc_x && !acc_y)
-            return dot(x,y);
+            return omp_dot(x,y);
         if (acc_y && !acc_x)
-            return dot(x,y);
+            return omp_dot(x,y);
         // if both vectors are accumulated, you are not allowed to call this function with useAccur==false
         if (acc_x && acc_y)
             throw DROPSErrCL("ExchangeCL::LocDot: Cannot perform a normal inner product on two accumulated vectors, set useAccur=true");
@@ -667,6 +701,7 @@ double ExchangeCL::ParDot (const VectorCL& x, bool acc_x,
     /// \param[out] y_acc    if not equal zero, pointer on the accumulated form of \a y
     /// \return              inner product of \a x and \a y without global reduce
 {
+    DROPS_PROFILE_REGION("ExchangeCL::ParDot");
     return ProcCL::GlobalSum(LocDot(x, acc_x, y, acc_y, useAccur, x_acc, y_acc));
 }
 
@@ -740,6 +775,7 @@ double ExchangeCL::Norm(const VectorCL &r, bool acc_r, bool useAccur, VectorCL*
     /// \param[out] r_acc   if not equal zero, pointer on the accumulated form of \a r
     /// \return             norm of the vector \a r
 {
+    DROPS_PROFILE_REGION("ExchangeCL::Norm");
     double norm_sq= ProcCL::GlobalSum(LocNorm_sq(r, acc_r, useAccur, r_acc));
     if (norm_sq<0.){
         std::cout << "["<<ProcCL::MyRank()<<"] In function ExchangeCL::Norm:\n Norm of vector smaller than zero: "
@@ -762,6 +798,7 @@ double ExchangeCL::Norm_sq(const VectorCL& r, bool acc_r, bool useAccur, VectorC
     /// \param[out] r_acc   if not equal zero, pointer on the accumulated form of \a r
     /// \return             square norm of the vector \a r
 {
+    DROPS_PROFILE_REGION("ExchangeCL::Norm");
     double norm_sq= ProcCL::GlobalSum(LocNorm_sq(r, acc_r, useAccur, r_acc));
     DROPS_Check_Norm(norm_sq, "ExchangeCL::Norm_sq: negative squared norm because of accumulation!");
     return norm_sq;
@@ -779,20 +816,11 @@ IdxT ExchangeCL::GetExternalIdxFromProc(IdxT myIdx, ProcNumT proc) const
             DROPSErrCL("ExchangeCL::GetExternalIdxFromProc: The mapping: (external idx) -> (my idx) is not created. \nMaybe set flag CreateMapIdx for CreateList()!"),
             DebugParallelNumC);
 
-    MappingIdxCT::const_iterator       proc_it  (MappingIdx_.lower_bound(proc));
-    const MappingIdxCT::const_iterator proc_end (MappingIdx_.end());
-
-    if (proc_it==proc_end)
-        return NoIdx;
-
-    ProcMappingIdxCT::const_iterator       idx_it  ( (proc_it->second).lower_bound(myIdx) );
-    const ProcMappingIdxCT::const_iterator idx_end ( (proc_it->second).end() );
-
-    if (idx_it==idx_end)
-        return NoIdx;
-
-    return idx_it->second;
-    // return MappingIdx_[proc][myIdx];
+    // only a few procs share a sysnum, so a linear search in the sorted range is sufficient
+    for (IdxT pos= sysProcBegin_[myIdx]; pos<sysProcBegin_[myIdx+1] && sysProc_[pos]<=proc; ++pos)
+        if (sysProc_[pos]==proc)
+            return sysExtIdx_[pos];
+    return NoIdx;
 }
 
 /// \brief Check if a sysnum is distributed
@@ -803,7 +831,7 @@ bool ExchangeCL::IsDist(IdxT i) const
     Assert(mapCreated_,
            DROPSErrCL("ExchangeCL::IsDist: The mapping: (external idx) -> (my idx) is not created. \nMaybe set flag CreateMapIdx for CreateList()!"),
            DebugParallelNumC);
-    return SysProc_[i].size()>0;
+    return sysProcBegin_[i+1]>sysProcBegin_[i];
 }
 
 /// \brief Check if a sysnum can be found on another proc
@@ -812,17 +840,34 @@ bool ExchangeCL::IsOnProc(IdxT i, ProcNumT p)
     Assert(mapCreated_,
            DROPSErrCL("ExchangeCL::IsOnProc: The mapping: (external idx) -> (my idx) is not created. \nMaybe set flag CreateMapIdx for CreateList()!"),
            DebugParallelNumC);
-    return std::find(SysProc_[i].begin(),SysProc_[i].end(), p) != SysProc_[i].end();
-
+    return std::binary_search(GetProcsBegin(i), GetProcsEnd(i), p);
 }
 
 /// \brief Get list of procs (except local proc) that owns a sysnum
-const ExchangeCL::ProcNumCT& ExchangeCL::GetProcs(IdxT i) const
+ExchangeCL::ProcNumCT ExchangeCL::GetProcs(IdxT i) const
+/// This function returns a copy, use GetProcsBegin() and GetProcsEnd() to iterate over
+/// the procs without allocating memory.
+{
+    return ProcNumCT(GetProcsBegin(i), GetProcsEnd(i));
+}
+
+/// \brief Get first proc (except local proc) that owns a sysnum
+ExchangeCL::ProcNum_const_iterator ExchangeCL::GetProcsBegin(IdxT i) const
+/// The procs are sorted by rank.
 {
     Assert(mapCreated_,
-           DROPSErrCL("ExchangeCL::GetProcs: The mapping: (external idx) -> (my idx) is not created. \nMaybe set flag CreateMapIdx for CreateList()!"),
+           DROPSErrCL("ExchangeCL::GetProcsBegin: The mapping: (external idx) -> (my idx) is not created. \nMaybe set flag CreateMapIdx for CreateList()!"),
            DebugParallelNumC);
-    return SysProc_[i];
+    return sysProc_.empty() ? 0 : &sysProc_[0] + sysProcBegin_[i];
+}
+
+/// \brief Get end of the procs (except local proc) that owns a sysnum
+ExchangeCL::ProcNum_const_iterator ExchangeCL::GetProcsEnd(IdxT i) const
+{
+    Assert(mapCreated_,
+           DROPSErrCL("ExchangeCL::GetProcsEnd: The mapping: (external idx) -> (my idx) is not created. \nMaybe set flag CreateMapIdx for CreateList()!"),
+           DebugParallelNumC);
+    return sysProc_.empty() ? 0 : &sysProc_[0] + sysProcBegin_[i+1];
 }
 
 /// \brief Get number of procs, that owns a sysnum
@@ -833,7 +878,7 @@ Uint ExchangeCL::GetNumProcs(IdxT i) const
     Assert(mapCreated_,
            DROPSErrCL("ExchangeCL::GetNumProcs: The mapping: (external idx) -> (my idx) is not created. \nMaybe set flag CreateMapIdx for CreateList()!"),
            DebugParallelNumC);
-    return SysProc_[i].size()+1;
+    return sysProcBegin_[i+1]-sysProcBegin_[i]+1;
 }
 
 /// \brief Check if calling processor has smallest rank, that owns a sysnum
@@ -843,26 +888,15 @@ bool ExchangeCL::IsExclusive(IdxT i) const
         return true;
     if (!IsDist(i))
         return true;
-    for (ProcNumCT::const_iterator it(GetProcs(i).begin()); it!=GetProcs(i).end(); ++it)
-        if (*it<ProcCL::MyRank())
-            return false;
-    return true;
+    return *GetProcsBegin(i)>ProcCL::MyRank();
 }
 
 int ExchangeCL::GetExclusiveProc(IdxT i) const
 {
     if ( !IsDist(i))
         return ProcCL::MyRank();
-    else{
-/*        if (ProcCL::MyRank()==1){
-            ProcNumCT procs= GetProcs(i);
-            for (ProcNumCT::const_iterator it(procs.begin()); it!=procs.end(); ++it)
-                std::cerr << "Procs " << *it << ' ';
-            std::cerr << std::endl;
-        }
-*/
-        return *std::min_element( GetProcs(i).begin(), GetProcs(i).end());
-    }
+    else
+        return *GetProcsBegin(i);   // procs are sorted
 }
 
 /// \brief Get procs that shares at least one unknown with this proc
@@ -888,18 +922,16 @@ double ExchangeCL::ParDotAcc(VectorCL& x, const VectorCL& y)const
     double acc_sum=0;   // local sum of all accumulated elements
 
     // first send all shared entries (nonblocking)
-    InitCommunication(x, SendRecvReq_);
+    StartAccumulation(x);
 
     // while sending, we can sum up unshared entries
-    for (Ulint i=0; i<numLocalIdx_; ++i)
-        loc_sum += x[LocalIndex[i]] * y[LocalIndex[i]];
+    loc_sum += IdxDot_(x, y, LocalIndex, numLocalIdx_);
 
     // now we need the accumulated values
-    AccFromAllProc(x, SendRecvReq_);
+    FinishAccumulation(x);
 
     // these has to be sumed up too
-    for (Ulint i=0; i<numDistrIdx_; ++i)
-        acc_sum += x[DistrIndex[i]] * y[DistrIndex[i]];
+    acc_sum += IdxDot_(x, y, DistrIndex, numDistrIdx_);
 
     // now reduce the local_sum's over all procs
     return ProcCL::GlobalSum(loc_sum+acc_sum);
@@ -921,15 +953,13 @@ inline double ExchangeCL::DotAcc(VectorCL& x, const VectorCL& y) const
 
     double loc_sum=0;
     RequestCT req(ExList_.size());
-    InitCommunication(x, SendRecvReq_);
+    StartAccumulation(x);
 
-    for (Ulint i=0; i<numLocalIdx_; ++i)
-        loc_sum += x[LocalIndex[i]] * y[LocalIndex[i]];
+    loc_sum += IdxDot_(x, y, LocalIndex, numLocalIdx_);
 
-    AccFromAllProc(x, SendRecvReq_);
+    FinishAccumulation(x);
 
-    for (Ulint i=0; i<numDistrIdx_; ++i)
-        loc_sum += x[DistrIndex[i]] * y[DistrIndex[i]];
+    loc_sum += IdxDot_(x, y, DistrIndex, numDistrIdx_);
 
     return loc_sum;
 }
@@ -984,23 +1014,21 @@ double ExchangeCL::AccParDot(const VectorCL& x, const VectorCL& y, VectorCL& x_a
     RequestCT req_y(2*ExList_.size());
     VectorCL secondRecvBuf(recvBuf_.size());
 
-    InitCommunication(x, SendRecvReq_, tag_, 0);
+    StartAccumulation(x);
     InitCommunication(y, req_y, tag_+1, 0, &secondRecvBuf);
 
     double loc_sum=0,
            acc_sum=0;
 
     // do local summation
-    for (Ulint i=0; i<numLocalIdx_; ++i)
-        loc_sum += x[LocalIndex[i]] * y[LocalIndex[i]];
+    loc_sum += IdxDot_(x, y, LocalIndex, numLocalIdx_);
 
     // now we need the accumulated values
-    AccFromAllProc(x_acc, SendRecvReq_, 0);
+    FinishAccumulation(x_acc);
     AccFromAllProc(y_acc, req_y, 0, &secondRecvBuf);
 
     // now do the global summation
-    for (Ulint i=0; i<AccDistIndex.size(); ++i)
-        acc_sum += x_acc[AccDistIndex[i]] * y_acc[AccDistIndex[i]];
+    acc_sum += IdxDot_(x_acc, y_acc, AccDistIndex, AccDistIndex.size());
 
     return ProcCL::GlobalSum(loc_sum+acc_sum);
 }
@@ -1018,13 +1046,11 @@ double ExchangeCL::LocAccDot(const VectorCL& x_acc, const VectorCL& y_acc) const
     acc_sum=0;
 
     // do local summation
-    for (Ulint i=0; i<numLocalIdx_; ++i)
-        loc_sum += x_acc[LocalIndex[i]] * y_acc[LocalIndex[i]];
+    loc_sum += IdxDot_(x_acc, y_acc, LocalIndex, numLocalIdx_);
 
 
     // now do the global summation
-    for (Ulint i=0; i<AccDistIndex.size(); ++i)
-        acc_sum += x_acc[AccDistIndex[i]] * y_acc[AccDistIndex[i]];
+    acc_sum += IdxDot_(x_acc, y_acc, AccDistIndex, AccDistIndex.size());
 
     return loc_sum+acc_sum;
 }
@@ -1051,21 +1077,19 @@ double ExchangeCL::LocAccNorm_sq(const VectorCL& r, VectorCL& r_acc) const
         r_acc.resize(r.size());
     r_acc = r;
 
-    InitCommunication(r, SendRecvReq_, tag_, 0);
+    StartAccumulation(r);
 
     double loc_sum=0,
            acc_sum=0;
 
     // do local summation
-    for (Ulint i=0; i<numLocalIdx_; ++i)
-        loc_sum += r[LocalIndex[i]] * r[LocalIndex[i]];
+    loc_sum += IdxDot_(r, r, LocalIndex, numLocalIdx_);
 
     // now we need the accumulated values
-    AccFromAllProc(r_acc, SendRecvReq_, 0);
+    FinishAccumulation(r_acc);
 
     // now do the global summation
-    for (Ulint i=0; i<AccDistIndex.size(); ++i)
-        acc_sum += r_acc[AccDistIndex[i]] * r_acc[AccDistIndex[i]];
+    acc_sum += IdxDot_(r_acc, r_acc, AccDistIndex, AccDistIndex.size());
 
     return loc_sum+acc_sum;
 }
@@ -1078,12 +1102,10 @@ double ExchangeCL::LocAccNorm_sq(const VectorCL& r_acc) const
     double loc_sum=0,
            acc_sum=0;
 
-    for (Ulint i=0; i<numLocalIdx_; ++i)
-        loc_sum += r_acc[LocalIndex[i]] * r_acc[LocalIndex[i]];
+    loc_sum += IdxDot_(r_acc, r_acc, LocalIndex, numLocalIdx_);
 
     // now do the global summation
-    for (Ulint i=0; i<AccDistIndex.size(); ++i)
-        acc_sum += r_acc[AccDistIndex[i]] * r_acc[AccDistIndex[i]];
+    acc_sum += IdxDot_(r_acc, r_acc, AccDistIndex, AccDistIndex.size());
 
     return loc_sum+acc_sum;
 }
@@ -1102,21 +1124,19 @@ double ExchangeCL::AccParDot(const VectorCL &x, const VectorCL& y_acc, VectorCL&
         x_acc.resize(x.size());
     x_acc=x;
 
-    InitCommunication(x, SendRecvReq_, tag_, 0);
+    StartAccumulation(x);
 
     double loc_sum=0,
            acc_sum=0;
 
     // do local summation
-    for (Ulint i=0; i<numLocalIdx_; ++i)
-        loc_sum += x[LocalIndex[i]] * y_acc[LocalIndex[i]];
+    loc_sum += IdxDot_(x, y_acc, LocalIndex, numLocalIdx_);
 
     // now we need the accumulated values
-    AccFromAllProc(x_acc, SendRecvReq_, 0);
+    FinishAccumulation(x_acc);
 
     // now do the global summation
-    for (Ulint i=0; i<AccDistIndex.size(); ++i)
-        acc_sum += x_acc[AccDistIndex[i]] * y_acc[AccDistIndex[i]];
+    acc_sum += IdxDot_(x_acc, y_acc, AccDistIndex, AccDistIndex.size());
 
     return ProcCL::GlobalSum(loc_sum+acc_sum);
 }
@@ -1133,12 +1153,10 @@ double ExchangeCL::AccNorm_sq(const VectorCL& r_acc) const
            acc_sum=0;
 
     // do local summation
-    for (Ulint i=0; i<numLocalIdx_; ++i)
-        loc_sum += r_acc[LocalIndex[i]] * r_acc[LocalIndex[i]];
+    loc_sum += IdxDot_(r_acc, r_acc, LocalIndex, numLocalIdx_);
 
     // now do the global summation
-    for (Ulint i=0; i<AccDistIndex.size(); ++i)
-        acc_sum += r_acc[AccDistIndex[i]] * r_acc[AccDistIndex[i]];
+    acc_sum += IdxDot_(r_acc, r_acc, AccDistIndex, AccDistIndex.size());
 
     double norm_sq = ProcCL::GlobalSum(loc_sum+acc_sum);
     DROPS_Check_Norm(norm_sq, "ExchangeCL::AccNorm_sq: negative squared norm because of accumulation!");
@@ -1169,16 +1187,103 @@ VectorCL ExchangeCL::GetAccumulate (const VectorCL &x) const
     /// \param[in] x vector in distributed form
     /// \return      accumulated form of x
 {
+    DROPS_PROFILE_REGION("ExchangeCL::Accumulate");
     Assert(created_, DROPSErrCL("ExchangeCL::GetAccumulate: Lists have not been created (Maybe use CreateList before!)\n"), DebugParallelNumC);
     Assert(x.size()==vecSize_, DROPSErrCL("ExchangeCL::GetAccumulate: vector length does not fit to the created lists. (Maybe used a wrong IdxDescCL?)"), DebugParallelNumC);
 
     RequestCT req(ExList_.size());
-    InitCommunication(x, SendRecvReq_);
+    StartAccumulation(x);
     VectorCL x_acc(x);
-    AccFromAllProc(x_acc, SendRecvReq_);
+    FinishAccumulation(x_acc);
     return x_acc;
 }
 
+/// \brief Start the accumulation of a vector by the standard buffers
+void ExchangeCL::StartAccumulation(const VectorCL& vec, Ulint offset) const
+/** If persistent requests are used (default), the shared entries of \a vec are
+    packed into a contiguous buffer and the persistent requests are started, so
+    \a vec may be changed afterwards. Otherwise the standard requests and receive
+    buffer are passed to InitCommunication.
+    \param vec    all entries of vec, that are shared, are send to other procs
+    \param offset default 0: For blocked vectors this offset is used to enter a special block
+    \pre the last accumulation by StartAccumulation has been finished
+*/
+{
+    if (!usePersistent_){
+        InitCommunication(vec, SendRecvReq_, tag_, offset);
+        return;
+    }
+    Assert(created_, DROPSErrCL("ExchangeCL::StartAccumulation: Lists have not been created (Maybe use CreateList before!)\n"), DebugParallelNumC);
+    if (pers_.Active())
+        throw DROPSErrCL("ExchangeCL::StartAccumulation: Last accumulation has not been finished");
+    if (!pers_.Created())
+        CreatePersistent_();
+    VectorCL& buf= pers_.SendBuf();
+    const size_t n= sendIdx_.size();
+#ifndef DROPS_WIN
+    size_t k;
+#else
+    int k;
+#endif
+#   pragma omp parallel for if (n > omp_min_vector_size)
+    for (k=0; k<n; ++k)
+        buf[k]= vec[sendIdx_[k]+offset];
+    pers_.Start();
+}
+
+/// \brief Finish the accumulation started by StartAccumulation
+void ExchangeCL::FinishAccumulation(VectorCL& vec, Ulint offset) const
+/** \param vec    receive from other procs the values of the shared entries and add them
+    \param offset default 0: For blocked vectors this offset is used to enter a special block
+*/
+{
+    DROPS_PROFILE_REGION("ExchangeCL::Wait");
+    if (!pers_.Active()){
+        AccFromAllProc(vec, SendRecvReq_, offset);
+        return;
+    }
+    pers_.Wait();
+    CommListCT::const_iterator lit=ExList_.begin(), end=ExList_.end();
+    for (Uint i=0; lit!=end; ++lit, ++i)
+        lit->Accumulate(vec, offset, pers_.RecvBuf(), recvOffsets_[i]);
+}
+
+/// \brief Split-phase matrix-vector product with accumulation of the result
+void ExchangeCL::MulAcc(const MatrixCL& A, const VectorCL& x_acc, VectorCL& y, VectorCL& y_acc) const
+/** Computes y=A*x_acc (distributed form) and y_acc, the accumulated form of y.
+    The rows belonging to distributed sysnums (DistrIndex) are computed first
+    and their entries are sent to the neighbor procs. While the messages are
+    on their way, the rows of the local sysnums (LocalIndex) are computed.
+    So the result is the same as y=A*x_acc; y_acc=GetAccumulate(y), but the
+    communication is hidden behind the work on the interior rows.
+    \param[in]  A     local distributed matrix, whose RowIdx corresponds to this ExchangeCL
+    \param[in]  x_acc accumulated vector
+    \param[out] y     A*x_acc in distributed form
+    \param[out] y_acc A*x_acc in accumulated form
+*/
+{
+    DROPS_PROFILE_REGION("ExchangeCL::MulAcc");
+    Assert(created_, DROPSErrCL("ExchangeCL::MulAcc: Lists have not been created (Maybe use CreateList before!)\n"), DebugParallelNumC);
+    Assert(A.num_rows()==vecSize_, DROPSErrCL("ExchangeCL::MulAcc: matrix does not fit to the created lists. (Maybe used a wrong IdxDescCL?)"), DebugParallelNumC);
+    Assert(A.num_cols()==x_acc.size(), DROPSErrCL("ExchangeCL::MulAcc: incompatible dimensions"), DebugParallelNumC);
+
+    if (y.size()!=A.num_rows())
+        y.resize(A.num_rows());
+    if (y_acc.size()!=A.num_rows())
+        y_acc.resize(A.num_rows());
+
+    // rows at the process boundary, their entries must be sent
+    if (numDistrIdx_>0)
+        y_Ax_rows(Addr(y), Addr(DistrIndex), numDistrIdx_, A.raw_val(), A.raw_row(), A.raw_col(), Addr(x_acc));
+    StartAccumulation(y);
+
+    // interior rows, the distributed entries of y are only read from now on
+    if (numLocalIdx_>0)
+        y_Ax_rows(Addr(y), Addr(LocalIndex), numLocalIdx_, A.raw_val(), A.raw_row(), A.raw_col(), Addr(x_acc));
+    y_acc= y;
+    FinishAccumulation(y_acc);
+}
+
 /// \brief Return accumulated vectors
 std::vector<VectorCL> ExchangeCL::GetAccumulate (const std::vector<VectorCL>& x) const
 {
@@ -1293,7 +1398,7 @@ double ExchangeBlockCL::AccurLocDotOneAcc(const VectorCL& x_acc, const VectorCL&
 */
 {
     // Start sending and receiving as soon as possible (by taking the default receive buffers)
-    InitCommunication( y, SendRecvReq_);
+    StartAcc_( y);
 
     bool newy= (y_acc==0);                 // Check if memory for temporary version of accumulated y must be allocated
     if (newy)
@@ -1302,7 +1407,7 @@ double ExchangeBlockCL::AccurLocDotOneAcc(const VectorCL& x_acc, const VectorCL&
         *y_acc= y;                          // Assign y_acc the values of y
 
     const double locSum= SumUpLocal( x_acc, y);         // do summation on local elements
-    AccFromAllProc( *y_acc, SendRecvReq_);              // accumulate vector y
+    FinishAcc_( *y_acc);                                // accumulate vector y
     const double distSum= SumUpDist( x_acc, *y_acc);    // do summation on distributed elements
 
     if (newy)
@@ -1333,7 +1438,7 @@ double ExchangeBlockCL::AccurLocDotBothAcc(const VectorCL& x, const VectorCL& y,
         recvBuf_y[m].resize( idxDesc_[m]->GetEx().GetNumReceiveElements());
     }
     // Start sending and receiving elements of x and y as soon as possible
-    InitCommunication( x, SendRecvReq_);
+    StartAcc_( x);
     InitCommunication( y, req_y, startTag_+GetNumBlocks(), &recvBuf_y);
 
     // Check if memory for temporary version of accumulated x and/or y must be allocated
@@ -1348,7 +1453,7 @@ double ExchangeBlockCL::AccurLocDotBothAcc(const VectorCL& x, const VectorCL& y,
         *y_acc= y;                          // Assign y_acc the values of y
 
     const double locSum= SumUpLocal( x, y);             // do summation on local elements
-    AccFromAllProc( *x_acc, SendRecvReq_);              // accumulate vector x
+    FinishAcc_( *x_acc);                                // accumulate vector x
     AccFromAllProc( *y_acc, req_y, &recvBuf_y);         // accumulate vector y
     const double distSum= SumUpDist( *x_acc, *y_acc);   // do summation on distributed elements
 
@@ -1426,7 +1531,7 @@ double ExchangeBlockCL::LocNorm_sq( const VectorCL &r, bool isRacc,
         return LocDot(r, true, r, true, useAccurate, r_acc);
     }
     else{
-        InitCommunication( r, SendRecvReq_);
+        StartAcc_( r);
         const bool newR= (r_acc==0);
         if (newR)
             r_acc= new VectorCL(r);
@@ -1434,7 +1539,7 @@ double ExchangeBlockCL::LocNorm_sq( const VectorCL &r, bool isRacc,
             *r_acc= r;
 
         const double locSum= SumUpLocal( r, r);
-        AccFromAllProc( *r_acc, SendRecvReq_);
+        FinishAcc_( *r_acc);
         const double distSum= SumUpDist( *r_acc, *r_acc);
 
         if (newR)
@@ -1464,8 +1569,9 @@ double ExchangeBlockCL::Norm( const VectorCL& r, bool isRacc,
 
 void ExchangeBlockCL::Accumulate( VectorCL& r) const
 {
-    InitCommunication( r, SendRecvReq_);
-    AccFromAllProc( r, SendRecvReq_);
+    DROPS_PROFILE_REGION("ExchangeCL::Accumulate");
+    StartAcc_( r);
+    FinishAcc_( r);
 }
 
 VectorCL ExchangeBlockCL::GetAccumulate( const VectorCL& r) const
@@ -25,7 +25,9 @@
 #include "parallel/loadbal.h"
 #include "parallel/parallel.h"
 #include "num/interfacePatch.h"
+#include "misc/profiler.h"
 #include <iomanip>
+#include <numeric>
 
 namespace DROPS{
 
@@ -48,16 +50,17 @@ extern "C" int HandlerGatherC ( OBJT o, void *d) {return LoadBalCL::HandlerGathe
 
 
 /// \brief Constructor
-LoadBalCL::LoadBalCL(MultiGridCL& mg, int partitioner, int TriLevel, PartMethod meth, int weightFct) : idx_(), lset_(0), weightFct_(weightFct)
+LoadBalCL::LoadBalCL(MultiGridCL& mg, int partitioner, int TriLevel, PartMethod meth, int weightFct) : idx_(), lset_(0), weightFct_(weightFct), meanCost_(0.)
 /// \param mg          Reference on the multigrid
-/// \param partitioner Choose a partitioner: 1 - Metis, 2 - Zoltan, 3 - Scotch
+/// \param partitioner Choose a partitioner: 1 - Metis, 2 - Zoltan, 3 - Scotch, 4 - SFC
 /// \param TriLevel    level that should be balanced
 /// \param meth        Type of method used for partitioning
 /// \param weightFct   Which information for weighting the dual reduced graph should be used. This parameter
-///                    is a binary representation (b2 b1 b0) of the three methods:
+///                    is a binary representation (b3 b2 b1 b0) of the four methods:
 ///                    b0 : use information about children
 ///                    b1 : use information about unknowns
 ///                    b2 : use information about intersected subs
+///                    b3 : use the measured cost of the tetras, see GetCost()
 /// \todo (of) estimate good parameter ubvec for parmetis
 {
     partitioner_ = PartitionerCL::newPartitioner( Partitioner(partitioner), 1.05, meth);   // Pointer to the partitioner class
@@ -322,6 +325,49 @@ void LoadBalCL::GetWeightLset( const TetraCL& t, size_t& wgtpos)
     }
 }
 
+/** Put the weight of a vertex in the array vwgt of the graph structure at
+    the index wgtpos. The weight is the measured cost of the multinode relative to
+    the mean cost of a multinode, so a multinode with mean cost gets the weight 100.
+    \param t parent tetrahedron
+    \param wgtpos  in: where to put the weight in the array vwgt,
+                  out: where to put the next weight in the array vwgt
+*/
+void LoadBalCL::GetWeightCost( const TetraCL& t, size_t& wgtpos)
+{
+    GetPartitioner()->GetGraph().vwgt[wgtpos++]= std::max( 1, static_cast<int>( 100.*nodeCost_[t.GetLbNr()]/meanCost_ + 0.5));
+}
+
+/// \brief Sum up the measured cost of the tetras for each multinode
+void LoadBalCL::ComputeNodeCost()
+/** The costs are recorded for the tetras of the last triangulation level, which is balanced. If they
+    do not belong to the current multigrid on any proc, e.g. after a refinement, nodeCost_ is left empty
+    and meanCost_ is set to 0, so the measured cost is not used as a weight.
+    \pre CreateNumbering has been called
+*/
+{
+    nodeCost_.clear();
+    meanCost_= 0.;
+    if ( ProcCL::GlobalOr( !cost_.valid( *mg_)))
+        return;
+    nodeCost_.resize( partitioner_->GetGraph().myVerts, 0.);
+    size_t pos= 0;
+    for (MultiGridCL::TriangTetraIteratorCL it= mg_->GetTriangTetraBegin( TriangLevel_), end= mg_->GetTriangTetraEnd( TriangLevel_); it!=end; ++it, ++pos)
+        if ( it->HasLbNr())
+            nodeCost_[it->GetLbNr()]+= cost_[pos];
+    const double numNodes= ProcCL::GlobalSum( static_cast<double>( nodeCost_.size()));
+    meanCost_= numNodes>0. ? ProcCL::GlobalSum( std::accumulate( nodeCost_.begin(), nodeCost_.end(), 0.))/numNodes : 0.;
+}
+
+/// \brief Ratio between the maximal and the mean measured cost over all procs
+double LoadBalCL::GetCostImbalance() const
+/// If no costs have been measured for the current multigrid, 1 is returned.
+{
+    const double mycost= cost_.valid( *mg_) ? cost_.sum() : 0.,
+                 maxcost= ProcCL::GlobalMax( mycost),
+                 sumcost= ProcCL::GlobalSum( mycost);
+    return sumcost>0. ? maxcost*ProcCL::Size()/sumcost : 1.;
+}
+
 /// \brief Estimate adjacencies of an unrefined tetra
 void LoadBalCL::AdjUnrefined( TetraCL& t, int& edgecount, size_t& vwgpos)
 /** Put the adjacenzies into adjncy_ and estimate the weight of the node, assoziated with the tetra
@@ -366,6 +412,8 @@ void LoadBalCL::AdjUnrefined( TetraCL& t, int& edgecount, size_t& vwgpos)
         else
             GetWeightLset( t, vwgpos);
     }
+    if ( weightFct_&8 && meanCost_>0.)     // no costs measured so far, e.g. before the first assembly
+        GetWeightCost( t, vwgpos);
 }
 
 
@@ -428,6 +476,8 @@ void LoadBalCL::AdjRefined( TetraCL& t, int& edgecount, size_t& vwgpos)
         else
             GetWeightLset( t, vwgpos);
     }
+    if ( weightFct_&8 && meanCost_>0.)     // no costs measured so far, e.g. before the first assembly
+        GetWeightCost( t, vwgpos);
 }
 
 
@@ -496,7 +546,7 @@ void LoadBalCL::CreateDualRedGraph(bool geom)
 {
     Comment("- Setting up dual, reduced graph with " << partitioner_->GetGraph().myAdjs<< " edges " << std::endl, DebugLoadBalC);
 
-    partitioner_->GetGraph().geom = geom;                                       // sets the attribute geom of the partitioner_
+    partitioner_->GetGraph().geom = geom || partitioner_->UsesGeom();           // sets the attribute geom of the partitioner_
     TriangLevel_= mg_->GetLastLevel();
 
     CreateNumbering();                                                          // Create the numbers of the multinodes and set the number of my verts
@@ -524,6 +574,10 @@ void LoadBalCL::CreateDualRedGraph(bool geom)
     if ( weightFct_&1 || weightFct_==0) ++ncon;
     if ( weightFct_&2 && !idx_.empty()) ++ncon;
     if ( weightFct_&4 && lset_!=0)      ++ncon;
+    if ( weightFct_&8){
+        ComputeNodeCost();
+        if ( meanCost_>0.) ++ncon;
+    }
      // Allocate space for the Arrays
     partitioner_->GetGraph().Resize(numadj, partitioner_->GetGraph().myVerts, partitioner_->GetGraph().geom,  ncon);
 
@@ -799,6 +853,7 @@ LoadBalHandlerCL::LoadBalHandlerCL(MultiGridCL& mg, Partitioner part, float /*ub
     strategy_ = Adaptive;
     xferUnknowns_ = false;
     debugMode_    = false;
+    imbalanceTol_ = 0.;
 }
 
 LoadBalHandlerCL::~LoadBalHandlerCL()
@@ -816,6 +871,7 @@ LoadBalHandlerCL::LoadBalHandlerCL(const MGBuilderCL &builder, int master, Parti
     strategy_ = Adaptive;
     xferUnknowns_ = false;
     debugMode_    = debug;
+    imbalanceTol_ = 0.;
 
     // Create a multigrid
     mg_ = new MultiGridCL(builder);
@@ -879,6 +935,7 @@ void LoadBalHandlerCL::DoMigration()
     and finally do the migration.
 */
 {
+    DROPS_PROFILE_REGION("LoadBalHandlerCL::DoMigration");
     // Just do a migration if this is wished
     if (strategy_ == NoMig) return;
     if (ProcCL::Size() == 1){
@@ -929,6 +986,7 @@ void LoadBalHandlerCL::DoMigration()
 //         ParMultiGridCL::DeleteUnksOnGhosts();
 //     }
     ParMultiGridCL::MarkSimplicesForUnknowns();
+    lb_->GetCost().clear();     // the measured costs refer to the tetras before the migration
 
     movedNodes_ = lb_->GetMovedMultiNodes();
     edgeCut_    = lb_->GetEdgeCut();
@@ -947,6 +1005,49 @@ void LoadBalHandlerCL::DoMigration()
 }
 
 
+void LoadBalHandlerCL::SetMeasuredCost(double tol)
+/** Use the measured cost of the tetras as an additional weight for the graph partitioning. A migration by
+    DoMigrationIfImbalanced and NeedsMigration is then only performed, if the measured cost of the most loaded
+    process exceeds the mean cost by the factor tol. The costs are recorded by the accumulations, for which
+    GetCost() has been registered by AccumulatorTupleCL::set_cost_recorder, e.g. by
+    InstatStokes2PhaseP2P1CL::SetCostRecorder.
+    \param[in] tol tolerance of the measured imbalance, e.g. 1.1; tol<=0 turns the measurement off
+*/
+{
+    imbalanceTol_= tol;
+    if (tol>0.)
+        lb_->SetWeightFnct( lb_->GetWeightFnct() | 8);
+    else
+        lb_->SetWeightFnct( lb_->GetWeightFnct() & ~8);
+    lb_->GetCost().clear();
+}
+
+bool LoadBalHandlerCL::NeedsMigration() const
+/** Without measured costs, i.e. SetMeasuredCost has not been called or no accumulation has been
+    recorded since the last change of the multigrid, a migration is always considered to pay off.
+    This function must be called by all processes.
+*/
+{
+    if (strategy_ == NoMig || ProcCL::Size() == 1)
+        return false;
+    if (imbalanceTol_<=0. || ProcCL::GlobalOr( !lb_->GetCost().valid( *mg_)))
+        return true;
+    const double imbalance= lb_->GetCostImbalance();
+    if (debugMode_ && ProcCL::IamMaster())
+        std::cout << "  - Measured imbalance " << imbalance << " (tolerance " << imbalanceTol_ << ")\n";
+    return imbalance > imbalanceTol_;
+}
+
+bool LoadBalHandlerCL::DoMigrationIfImbalanced()
+/// \return true, if a migration has been performed
+{
+    if (!NeedsMigration())
+        return false;
+    DoMigration();
+    return true;
+}
+
+
 void LoadBalHandlerCL::DoInitDistribution(int)
 /** This function encapsulate all necessary steps to distribute the initial
     grid, that is stored on the master processor. So it create the graph, call
@@ -30,6 +30,7 @@
 #include "geom/multigrid.h"
 #include "misc/problem.h"
 #include "parallel/partitioner.h"
+#include "num/accumulator.h"
 #include <map>
 #include <set>
 #include <iostream>
@@ -139,6 +140,9 @@ class LoadBalCL
     static idxtype*               myfirstVert_;             // first vertex on this proc (static for HandlerGather!)
     static IFT                    FaceIF_;                  // Interface, for compute the adjacencies over Proc-Boundaries
     int                           weightFct_;               // which weighting function should be used
+    TetraCostCL                   cost_;                    // measured cost of the tetras, recorded by the accumulators
+    std::vector<double>           nodeCost_;                // measured cost of each multinode of the LoadBalSet
+    double                        meanCost_;                // global mean of the measured cost of a multinode
 
     void InitIF();                                          // Init the Interfaces
     static void CommunicateAdjacency();                     // Communicate the adjacencies over proc boundaries
@@ -159,6 +163,8 @@ class LoadBalCL
     void UnkOnSimplex(const SimplexT& s, UnkWghtListT& list, const IdxDescCL* idxDesc) const;   // number of dof on a single vertex/edge
     void UnkOnSingleTetra( const TetraCL&, UnkWghtListT& ) const;                               // number of dof on a single tetrahedron
     void GetWeightUnk( const TetraCL&, size_t& wgtpos);         // Weighting function by determining number of degrees of freedom
+    void GetWeightCost( const TetraCL&, size_t& wgtpos);        // Weighting function by the measured cost of the tetras
+    void ComputeNodeCost();                                     // Sum up the measured cost of the tetras for each multinode
 
   public:
     LoadBalCL(MultiGridCL&, int partitioner, int TriLevel=-1, PartMethod meth = KWay, int weightFct=1);// Constructor
@@ -183,6 +189,10 @@ class LoadBalCL
     void SetLset( const VecDescCL& lset, const BndDataCL<>& lsetbnd) { lset_=&lset; lsetbnd_=&lsetbnd;}
     void RemoveLset() { lset_=0; } 
 
+    TetraCostCL&       GetCost()       { return cost_; }                        ///< Measured cost of the tetras, see AccumulatorTupleCL::set_cost_recorder
+    const TetraCostCL& GetCost() const { return cost_; }                        ///< Measured cost of the tetras
+    double GetCostImbalance() const;                                            // ratio between maximal and mean measured cost over all procs
+
     ///\name for debug purpose
     //{@
     inline int   GetNumAllVerts() const;                    // number of vertices on all procs
@@ -223,6 +233,7 @@ class LoadBalHandlerCL
     bool           debugMode_;                          // flag if information about each step should be given
     Uint           movedNodes_;                         // number of moved multinodes
     Uint           edgeCut_;                            // number of cutted edges
+    double         imbalanceTol_;                       // if >0, weight by measured cost and migrate only if the measured imbalance exceeds this tolerance
 
 
   public:
@@ -237,6 +248,10 @@ class LoadBalHandlerCL
     void DoMigration();
     /// \brief Distribute a multigrid, that is stored on a single processor
     void DoInitDistribution(int master=Drops_MasterC);
+    /// \brief Check if a migration pays off according to the measured cost
+    bool NeedsMigration() const;
+    /// \brief Do a complete migration, if the measured imbalance exceeds the tolerance
+    bool DoMigrationIfImbalanced();
 
     /// \name Set and get routines
     //@{
@@ -252,6 +267,9 @@ class LoadBalHandlerCL
     inline Uint         GetEdgeCut()            const;    ///< Get number of cutted edges
     inline Uint         GetMovedMultiNodes()    const;    ///< Get number of moved multi nodes
     inline double       GetTetraBalance()       const;    ///< Get ratio between maximal tetra number and minimal tetra number
+    void                SetMeasuredCost(double tol);      ///< Weight the tetras by the measured assembly cost and migrate only if the imbalance exceeds tol (tol<=0: turn off)
+    inline double       GetImbalanceTol()       const;    ///< Get tolerance of the measured imbalance
+    inline double       GetCostImbalance()      const;    ///< Get ratio between maximal and mean measured cost
     //@}
 };
 
@@ -454,6 +472,14 @@ double LoadBalHandlerCL::GetTetraBalance() const
     return static_cast<double>(maxtetras)/(static_cast<double>(mintetras));
 }
 
+double LoadBalHandlerCL::GetImbalanceTol() const{
+    return imbalanceTol_;
+}
+
+double LoadBalHandlerCL::GetCostImbalance() const{
+    return lb_->GetCostImbalance();
+}
+
 } // end of namespace DROPS
 
 #endif // _LOADBAL_H_
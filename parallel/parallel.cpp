@@ -41,6 +41,7 @@ MuteStdOstreamCL* ProcCL::mute_=0;
 #ifdef _MPICXX_INTERFACE
     const ProcCL::CommunicatorT& ProcCL::Communicator_ = MPI::COMM_WORLD;
     const ProcCL::DatatypeT      ProcCL::NullDataType  = MPI::Datatype(MPI_DATATYPE_NULL);
+    const ProcCL::SubCommT       ProcCL::NullComm      = MPI::Intracomm(MPI_COMM_NULL);
 
     const ProcCL::DatatypeT& ProcCL::MPI_TT<int>::dtype    = MPI::INT;
     const ProcCL::DatatypeT& ProcCL::MPI_TT<Uint>::dtype   = MPI::UNSIGNED;
@@ -56,6 +57,7 @@ MuteStdOstreamCL* ProcCL::mute_=0;
 #else
     const ProcCL::CommunicatorT& ProcCL::Communicator_ = MPI_COMM_WORLD;
     const ProcCL::DatatypeT      ProcCL::NullDataType  = MPI_DATATYPE_NULL;
+    const ProcCL::SubCommT       ProcCL::NullComm      = MPI_COMM_NULL;
 
     const ProcCL::DatatypeT& ProcCL::MPI_TT<int>::dtype    = MPI_INT;
     const ProcCL::DatatypeT& ProcCL::MPI_TT<Uint>::dtype   = MPI_UNSIGNED;
@@ -85,6 +87,13 @@ ProcCL::ProcCL(int* argc, char*** argv)
         ++procDigits_; procs/=10;
     }
     mute_    = new MuteStdOstreamCL();
+#ifdef _OPENMP
+    // In the hybrid mode, all MPI calls are issued by the master thread outside
+    // of OpenMP-parallel regions, i.e., MPI_THREAD_FUNNELED is sufficient.
+    if (omp_get_max_threads()>1 && !FunneledThreads() && IamMaster())
+        std::cerr << "ProcCL: Warning: MPI does not guarantee MPI_THREAD_FUNNELED, but "
+                  << omp_get_max_threads() << " OpenMP threads per process are used\n";
+#endif
     MuteStdOstreams();
 }
 
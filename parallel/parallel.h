@@ -88,21 +88,28 @@ class ProcCL
     typedef ::MPI::Request  RequestT;           ///< type of requests
     typedef ::MPI::Datatype DatatypeT;          ///< type of data-types
     typedef ::MPI::Comm     CommunicatorT;      ///< type of communicator
+    typedef ::MPI::Intracomm SubCommT;          ///< type of communicator of a subset of procs
     typedef ::MPI::Aint     AintT;              ///< type of addresses
     typedef ::MPI::User_function FunctionT;     ///< type of user defined functions
+    typedef ::MPI::File     FileT;              ///< type of (parallel) files
+    typedef ::MPI::Offset   OffsetT;            ///< type of file offsets
 #else
     typedef MPI_Op          OperationT;         ///< type of operations
     typedef MPI_Status      StatusT;            ///< type of stati
     typedef MPI_Request     RequestT;           ///< type of requests
     typedef MPI_Datatype    DatatypeT;          ///< type of data-types
     typedef MPI_Comm        CommunicatorT;      ///< type of communicator
+    typedef MPI_Comm        SubCommT;           ///< type of communicator of a subset of procs
     typedef MPI_Aint        AintT;              ///< type of addresses
     typedef MPI_User_function FunctionT;        ///< type of user defined functions
+    typedef MPI_File        FileT;              ///< type of (parallel) files
+    typedef MPI_Offset      OffsetT;            ///< type of file offsets
 #endif
 
     template<typename> struct MPI_TT;           ///< Traits to determine the corresponding MPI_Datatype
                                                 /// constant for a given type.
     static const DatatypeT  NullDataType;       ///< MPI-Datatype, which is not set
+    static const SubCommT   NullComm;           ///< communicator of procs, that are not member of a sub-communicator
 
   private:
     static Uint my_rank_;                       // Which Id do I have?
@@ -160,6 +167,12 @@ class ProcCL
       /// \brief MPI-Gatherv-wrapper or MPI-Allgatherv wrapper if root<0 (both data-types are the same)
     template<typename T>
     static inline void Scatterv( const T*, const int*, const int*, T*, int, int root=Drops_MasterC);
+      /// \brief MPI-Alltoall-wrapper (both data-types are the same)
+    template<typename T>
+    static inline void Alltoall( const T*, int, T*);
+      /// \brief MPI-Alltoallv-wrapper (both data-types are the same)
+    template<typename T>
+    static inline void Alltoallv( const T*, const int*, const int*, T*, const int*, const int*);
       /// \brief MPI-Probe-wrapper
     static inline void Probe(int, int, StatusT&);
       /// \brief MPI-Get_count-wrapper
@@ -180,6 +193,16 @@ class ProcCL
       /// \brief MPI-Isend-wrapper with given datatype
     template <typename T>
     static inline RequestT Isend(const T*, int, const DatatypeT&, int, int);
+      /// \brief MPI-Send_init-wrapper (persistent request)
+    template <typename T>
+    static inline RequestT SendInit(const T*, int, int, int);
+      /// \brief MPI-Recv_init-wrapper (persistent request)
+    template <typename T>
+    static inline RequestT RecvInit(T*, int, int, int);
+      /// \brief MPI-Startall-wrapper for persistent requests
+    static inline void StartAll(int, RequestT*);
+      /// \brief MPI-Request_free-wrapper
+    static inline void RequestFree(RequestT&);
       /// \brief MPI-Get_address-wrapper
     template <typename T>
     static inline AintT Get_address(T*);
@@ -205,6 +228,40 @@ class ProcCL
     static inline void Barrier();
       /// \brief Abort MPI
     static inline void Abort(int);
+      /// \brief Level of thread support provided by MPI (MPI_THREAD_SINGLE, ..., MPI_THREAD_MULTIPLE)
+    static inline int ThreadSupport();
+      /// \brief Check, if MPI may be called by the master thread of OpenMP-parallel procs (MPI_THREAD_FUNNELED)
+    static inline bool FunneledThreads();
+    //@}
+
+    /// \name Sub-communicators (collective operations on a subset of procs)
+    //@{
+      /// \brief MPI-Comm_split-wrapper, called by all procs; procs with color<0 get NullComm
+    static inline SubCommT SplitComm(int color, int key);
+      /// \brief Check if the calling proc is member of the sub-communicator
+    static inline bool IsMember(const SubCommT&);
+      /// \brief MPI-Comm_free-wrapper, sets the communicator to NullComm
+    static inline void FreeComm(SubCommT&);
+      /// \brief MPI-Allreduce-wrapper within a sub-communicator
+    template <typename T>
+    static inline void AllReduce(const SubCommT&, const T*, T*, int, const OperationT&);
+      /// \brief MPI-Allgather-wrapper within a sub-communicator (both data-types are the same)
+    template <typename T>
+    static inline void Allgather(const SubCommT&, const T*, int, T*);
+      /// \brief MPI-Allgatherv-wrapper within a sub-communicator (both data-types are the same)
+    template <typename T>
+    static inline void Allgatherv(const SubCommT&, const T*, int, T*, const int*, const int*);
+    //@}
+
+    /// \name MPI-IO (collective file access by all procs)
+    //@{
+      /// \brief MPI-File_open-wrapper, opens (and truncates) a file for writing by all procs
+    static inline FileT FileOpenWrite(const std::string&);
+      /// \brief MPI-File_write_at_all-wrapper, each proc writes its data at its own offset
+    template <typename T>
+    static inline void FileWriteAtAll(FileT&, OffsetT, const T*, int);
+      /// \brief MPI-File_close-wrapper
+    static inline void FileClose(FileT&);
     //@}
 
     /// \name Wrapper for MPI commands (no direct call of MPI-functions)
@@ -219,6 +276,8 @@ class ProcCL
     static inline void WaitAll(std::valarray<RequestT>&);
       /// \brief MPI-Waitall-wrapper for all requests in a vector
     static inline void WaitAll(std::vector<RequestT>&);
+      /// \brief MPI-Startall-wrapper for all persistent requests in a valarray
+    static inline void StartAll(std::valarray<RequestT>&);
       /// \brief MPI-Recv-wrapper
     template <typename T>
     static inline void Recv(T*, int, int, int);
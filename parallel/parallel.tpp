@@ -119,6 +119,18 @@ template<typename T>
     Communicator_.Scatterv( sendDatam sendcount, displs, ProcCL::MPI_TT<T>::dtype, recvData, recvcount, ProcCL::MPI_TT<T>::dtype, root);
 }
 
+template<typename T>
+  inline void ProcCL::Alltoall( const T* sendData, int count, T* recvData)
+{
+    Communicator_.Alltoall( sendData, count, ProcCL::MPI_TT<T>::dtype, recvData, count, ProcCL::MPI_TT<T>::dtype);
+}
+
+template<typename T>
+  inline void ProcCL::Alltoallv( const T* sendData, const int* sendcount, const int* sdispls, T* recvData, const int* recvcount, const int* rdispls)
+{
+    Communicator_.Alltoallv( sendData, sendcount, sdispls, ProcCL::MPI_TT<T>::dtype, recvData, recvcount, rdispls, ProcCL::MPI_TT<T>::dtype);
+}
+
 inline void ProcCL::Probe(int source, int tag, ProcCL::StatusT& status)
   { Communicator_.Probe(source, tag, status); }
 
@@ -147,6 +159,20 @@ template <typename T>
   inline ProcCL::RequestT ProcCL::Isend(const T* data, int count, const ProcCL::DatatypeT& datatype, int dest, int tag)
   { return Communicator_.Isend(data, count, datatype, dest, tag); }
 
+template <typename T>
+  inline ProcCL::RequestT ProcCL::SendInit(const T* data, int count, int dest, int tag)
+  { return Communicator_.Send_init(data, count, ProcCL::MPI_TT<T>::dtype, dest, tag); }
+
+template <typename T>
+  inline ProcCL::RequestT ProcCL::RecvInit(T* data, int count, int source, int tag)
+  { return Communicator_.Recv_init(data, count, ProcCL::MPI_TT<T>::dtype, source, tag); }
+
+inline void ProcCL::StartAll(int count, RequestT* req)
+  { for (int i=0; i<count; ++i) ::MPI::Prequest(req[i]).Start(); }
+
+inline void ProcCL::RequestFree(RequestT& req)
+  { req.Free(); }
+
 template <typename T>
   inline ProcCL::AintT ProcCL::Get_address(T* data)
   { return MPI::Get_address(data); }
@@ -182,6 +208,51 @@ inline void ProcCL::Barrier()
 
 inline void ProcCL::Abort(int code)
   { MPI::COMM_WORLD.Abort(code); }
+
+inline int ProcCL::ThreadSupport()
+  { return MPI::Query_thread(); }
+
+inline bool ProcCL::FunneledThreads()
+  { return ThreadSupport()>=MPI::THREAD_FUNNELED; }
+
+inline ProcCL::SubCommT ProcCL::SplitComm(int color, int key)
+  { return MPI::COMM_WORLD.Split( color<0 ? MPI::UNDEFINED : color, key); }
+
+inline bool ProcCL::IsMember(const SubCommT& comm)
+  { return comm!=MPI::COMM_NULL; }
+
+inline void ProcCL::FreeComm(SubCommT& comm)
+{
+    if (IsMember(comm))
+        comm.Free();
+    comm= NullComm;
+}
+
+template <typename T>
+  inline void ProcCL::AllReduce(const SubCommT& comm, const T* myData, T* globalData, int size, const OperationT& op)
+  { comm.Allreduce(myData, globalData, size, ProcCL::MPI_TT<T>::dtype, op); }
+
+template <typename T>
+  inline void ProcCL::Allgather(const SubCommT& comm, const T* myData, int size, T* globalData)
+  { comm.Allgather(myData, size, ProcCL::MPI_TT<T>::dtype, globalData, size, ProcCL::MPI_TT<T>::dtype); }
+
+template <typename T>
+  inline void ProcCL::Allgatherv(const SubCommT& comm, const T* myData, int size, T* globalData, const int* recvcount, const int* displs)
+  { comm.Allgatherv(myData, size, ProcCL::MPI_TT<T>::dtype, globalData, recvcount, displs, ProcCL::MPI_TT<T>::dtype); }
+
+inline ProcCL::FileT ProcCL::FileOpenWrite(const std::string& name)
+{
+    FileT fh= FileT::Open( Communicator_, name.c_str(), MPI::MODE_CREATE | MPI::MODE_WRONLY, MPI::INFO_NULL);
+    fh.Set_size( 0);
+    return fh;
+}
+
+template <typename T>
+  inline void ProcCL::FileWriteAtAll(FileT& fh, OffsetT offset, const T* data, int count)
+  { fh.Write_at_all( offset, data, count, ProcCL::MPI_TT<T>::dtype); }
+
+inline void ProcCL::FileClose(FileT& fh)
+  { fh.Close(); }
 //@}
 
 
@@ -223,6 +294,19 @@ template<typename T>
     MPI_Scatterv( const_cast<T*>(sendData), const_cast<int*>(sendcount), const_cast<int*>(displs), ProcCL::MPI_TT<T>::dtype, recvData, recvcount, ProcCL::MPI_TT<T>::dtype, root, Communicator_);
 }
 
+template<typename T>
+  inline void ProcCL::Alltoall( const T* sendData, int count, T* recvData)
+{
+    MPI_Alltoall( const_cast<T*>(sendData), count, ProcCL::MPI_TT<T>::dtype, recvData, count, ProcCL::MPI_TT<T>::dtype, Communicator_);
+}
+
+template<typename T>
+  inline void ProcCL::Alltoallv( const T* sendData, const int* sendcount, const int* sdispls, T* recvData, const int* recvcount, const int* rdispls)
+{
+    MPI_Alltoallv( const_cast<T*>(sendData), const_cast<int*>(sendcount), const_cast<int*>(sdispls), ProcCL::MPI_TT<T>::dtype,
+                   recvData, const_cast<int*>(recvcount), const_cast<int*>(rdispls), ProcCL::MPI_TT<T>::dtype, Communicator_);
+}
+
 inline void ProcCL::Probe(int source, int tag, ProcCL::StatusT& status)
   { MPI_Probe(source, tag, Communicator_, &status);}
 
@@ -266,6 +350,26 @@ template <typename T>
     return req;
 }
 
+template <typename T>
+  inline ProcCL::RequestT ProcCL::SendInit(const T* data, int count, int dest, int tag){
+    RequestT req;
+    MPI_Send_init(const_cast<T*>(data), count, ProcCL::MPI_TT<T>::dtype, dest, tag, Communicator_, &req);
+    return req;
+}
+
+template <typename T>
+  inline ProcCL::RequestT ProcCL::RecvInit(T* data, int count, int source, int tag){
+    RequestT req;
+    MPI_Recv_init(data, count, ProcCL::MPI_TT<T>::dtype, source, tag, Communicator_, &req);
+    return req;
+}
+
+inline void ProcCL::StartAll(int count, RequestT* req)
+  { MPI_Startall(count, req); }
+
+inline void ProcCL::RequestFree(RequestT& req)
+  { MPI_Request_free(&req); }
+
 template <typename T>
   inline ProcCL::AintT ProcCL::Get_address(T* data){
     AintT addr;
@@ -310,6 +414,64 @@ inline void ProcCL::Barrier()
 
 inline void ProcCL::Abort(int code)
   { MPI_Abort(Communicator_, code); }
+
+inline int ProcCL::ThreadSupport()
+{
+    int provided;
+    MPI_Query_thread(&provided);
+    return provided;
+}
+
+inline bool ProcCL::FunneledThreads()
+  { return ThreadSupport()>=MPI_THREAD_FUNNELED; }
+
+inline ProcCL::SubCommT ProcCL::SplitComm(int color, int key)
+{
+    SubCommT comm;
+    MPI_Comm_split(Communicator_, color<0 ? MPI_UNDEFINED : color, key, &comm);
+    return comm;
+}
+
+inline bool ProcCL::IsMember(const SubCommT& comm)
+  { return comm!=MPI_COMM_NULL; }
+
+inline void ProcCL::FreeComm(SubCommT& comm)
+{
+    if (IsMember(comm))
+        MPI_Comm_free(&comm);
+    comm= NullComm;
+}
+
+template <typename T>
+  inline void ProcCL::AllReduce(const SubCommT& comm, const T* myData, T* globalData, int size, const OperationT& op)
+  { MPI_Allreduce(const_cast<T*>(myData), globalData, size, ProcCL::MPI_TT<T>::dtype, op, comm); }
+
+template <typename T>
+  inline void ProcCL::Allgather(const SubCommT& comm, const T* myData, int size, T* globalData)
+  { MPI_Allgather(const_cast<T*>(myData), size, ProcCL::MPI_TT<T>::dtype, globalData, size, ProcCL::MPI_TT<T>::dtype, comm); }
+
+template <typename T>
+  inline void ProcCL::Allgatherv(const SubCommT& comm, const T* myData, int size, T* globalData, const int* recvcount, const int* displs)
+  { MPI_Allgatherv(const_cast<T*>(myData), size, ProcCL::MPI_TT<T>::dtype, globalData, const_cast<int*>(recvcount), const_cast<int*>(displs), ProcCL::MPI_TT<T>::dtype, comm); }
+
+inline ProcCL::FileT ProcCL::FileOpenWrite(const std::string& name)
+{
+    FileT fh;
+    if (MPI_File_open( Communicator_, const_cast<char*>(name.c_str()), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh)!=MPI_SUCCESS)
+        throw DROPSErrCL("ProcCL::FileOpenWrite: Cannot open file "+name);
+    MPI_File_set_size( fh, 0);
+    return fh;
+}
+
+template <typename T>
+  inline void ProcCL::FileWriteAtAll(FileT& fh, OffsetT offset, const T* data, int count)
+{
+    StatusT tmpStat;
+    MPI_File_write_at_all( fh, offset, const_cast<T*>(data), count, ProcCL::MPI_TT<T>::dtype, &tmpStat);
+}
+
+inline void ProcCL::FileClose(FileT& fh)
+  { MPI_File_close( &fh); }
 //@}
 
 #endif  // _MPICXX_INTERFACE
@@ -339,6 +501,9 @@ inline void ProcCL::WaitAll(std::valarray<ProcCL::RequestT>& reqs)
 inline void ProcCL::WaitAll(std::vector<ProcCL::RequestT>& reqs)
   { WaitAll((int)reqs.size(), Addr(reqs)); }
 
+inline void ProcCL::StartAll(std::valarray<ProcCL::RequestT>& reqs)
+  { StartAll((int)reqs.size(), Addr(reqs)); }
+
 template <typename T>
   inline void ProcCL::Recv(T* data, int count, int source, int tag)
   /// as MPI-datatype "MPI_TT<T>::dtype" is used
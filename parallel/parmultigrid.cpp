@@ -49,6 +49,12 @@ bool ParMultiGridCL::_UnkOnSimplex[3]={false, false, false};
 
 VecDescCL* ParMultiGridCL::_actualVec=0;
 
+bool                            ParMultiGridCL::bulkUnk_    = false;
+ParMultiGridCL::BulkSendCT      ParMultiGridCL::bulkSend_   = BulkSendCT();
+ParMultiGridCL::BulkBufCT       ParMultiGridCL::bulkSendBuf_= BulkBufCT();
+ParMultiGridCL::BulkBufCT       ParMultiGridCL::bulkRecvBuf_= BulkBufCT();
+std::vector<ProcCL::RequestT>   ParMultiGridCL::bulkReq_    = std::vector<ProcCL::RequestT>();
+
 std::ostream *ParMultiGridCL::_os   = 0;
 bool          ParMultiGridCL::_sane = true;
 ParMultiGridCL* ParMultiGridCL::instance_ = 0;
@@ -326,6 +332,7 @@ void ParMultiGridCL::HandleNewIdx(IdxDescCL* oldIdxDesc, VecDescCL* newVecDesc)
 /*  This routine iterates over all vertices, edges and tetras and calls the routine PutData.
     PutData collects the data and put it into the new vector at the right position.*/
 {
+    DROPS_PROFILE_REGION("ParMultiGridCL::HandleNewIdx");
     Assert(VecDescRecv(), DROPSErrCL("ParMultiGridCL::HandleNewIdx: No Indices recieved before transfer"), DebugParallelNumC);
 
     // old and new index
@@ -580,6 +587,114 @@ void ParMultiGridCL::EnlargeRecieveBuffer()
     }
 }
 
+/// \brief Pack the unknowns of all transferred simplices and send them by one message per proc
+void ParMultiGridCL::PostBulkUnknowns()
+/** The simplices remembered by AddBulkUnknowns are packed into one buffer
+    per destination proc. Simplices, that are sent several times to the same
+    proc (e.g. vertices of several transferred tetras), are packed only once.
+    An entry of a buffer consists of the kind of the simplex, its global id,
+    a bit mask of the VecDescCL with unknowns on this simplex and the values
+    of these unknowns. The messages are posted before DDD transfers the
+    simplices, so the communication overlaps with the DDD transfer. */
+{
+    const int size= ProcCL::Size();
+    std::vector<int> sendCnt( size, 0), recvCnt( size, 0);
+    bulkSendBuf_.resize( size);
+    bulkRecvBuf_.resize( size);
+    bulkReq_.clear();
+
+    for (int p=0; p<size; ++p){
+        std::vector<BulkUnkST>& simplices= bulkSend_[p];
+        std::sort( simplices.begin(), simplices.end());
+        simplices.erase( std::unique( simplices.begin(), simplices.end()), simplices.end());
+
+        BufferCT& buf= bulkSendBuf_[p];
+        buf.clear();
+        for (std::vector<BulkUnkST>::const_iterator it= simplices.begin(); it!=simplices.end(); ++it){
+            const size_t entry= buf.size();
+            buf.push_back( it->kind);
+            buf.push_back( it->gid);
+            buf.push_back( 0.);
+            Uint mask= 0;
+            for (size_t i=0; i<_VecDesc.size(); ++i){
+                const Uint idx= _VecDesc[i]->RowIdx->GetIdx();
+                if (!it->unk->Exist( idx))
+                    continue;
+                mask|= 1u<<i;
+                const IdxT sysnum= (*it->unk)(idx);
+                const Uint numUnk= NumUnknownsOnKind( _VecDesc[i]->RowIdx, it->kind);
+                const double* val= it->unk->UnkRecieved( idx) ? &_RecvBuf[sysnum] : &_VecDesc[i]->Data[sysnum];
+                buf.insert( buf.end(), val, val+numUnk);
+            }
+            if (mask==0)
+                buf.resize( entry);
+            else
+                buf[entry+2]= mask;
+        }
+        sendCnt[p]= buf.size();
+        std::vector<BulkUnkST>().swap( simplices);
+    }
+
+    ProcCL::Alltoall( Addr( sendCnt), 1, Addr( recvCnt));
+    for (int p=0; p<size; ++p)
+        if (recvCnt[p]>0){
+            bulkRecvBuf_[p].resize( recvCnt[p]);
+            bulkReq_.push_back( ProcCL::Irecv( Addr( bulkRecvBuf_[p]), recvCnt[p], p, bulkTag_));
+        }
+    for (int p=0; p<size; ++p)
+        if (sendCnt[p]>0)
+            bulkReq_.push_back( ProcCL::Isend( Addr( bulkSendBuf_[p]), sendCnt[p], p, bulkTag_));
+}
+
+/// \brief Put the received unknowns onto all simplices of one kind given by an iterator range
+template<class IterT>
+  void ParMultiGridCL::PutBulkUnknowns(IterT begin, IterT end, Uint kind, const std::vector<BulkRecvST>& recv)
+{
+    for (IterT sit= begin; sit!=end; ++sit){
+        const std::vector<BulkRecvST>::const_iterator it= std::lower_bound( recv.begin(), recv.end(), BulkRecvST( kind, sit->GetGID(), 0));
+        if (it!=recv.end() && it->kind==kind && it->gid==sit->GetGID())
+            PutBulkUnknowns( *sit, it->data);
+    }
+}
+
+/// \brief Receive the unknowns sent by PostBulkUnknowns and put them into the receive buffer
+void ParMultiGridCL::RecvBulkUnknowns()
+/** After DDD has transferred the simplices, the received entries are sorted
+    by the kind and global id of the simplices. Then, one sweep over all
+    simplices puts the unknowns into the receive buffer, as RecvUnknowns does
+    for unknowns sent as DDD added data. If a simplex has been received from
+    several procs, the values from the proc with the smallest rank are taken. */
+{
+    if (!bulkReq_.empty())
+        ProcCL::WaitAll( bulkReq_);
+    bulkReq_.clear();
+
+    std::vector<BulkRecvST> recv;
+    for (size_t p=0; p<bulkRecvBuf_.size(); ++p){
+        const BufferCT& buf= bulkRecvBuf_[p];
+        for (size_t pos=0; pos<buf.size(); ){
+            const Uint kind= static_cast<Uint>( buf[pos]),
+                       mask= static_cast<Uint>( buf[pos+2]);
+            recv.push_back( BulkRecvST( kind, static_cast<GIDT>( buf[pos+1]), &buf[pos+2]));
+            pos+= 3;
+            for (size_t i=0; i<_VecDesc.size(); ++i)
+                if (mask & (1u<<i))
+                    pos+= NumUnknownsOnKind( _VecDesc[i]->RowIdx, kind);
+        }
+    }
+
+    if (!recv.empty()){
+        std::stable_sort( recv.begin(), recv.end());
+        for (Uint l=0; l<=_mg->GetLastLevel(); ++l){
+            PutBulkUnknowns( _mg->GetVerticesBegin(l), _mg->GetVerticesEnd(l), 0, recv);
+            PutBulkUnknowns( _mg->GetEdgesBegin(l),    _mg->GetEdgesEnd(l),    1, recv);
+            PutBulkUnknowns( _mg->GetTetrasBegin(l),   _mg->GetTetrasEnd(l),   2, recv);
+        }
+    }
+    BulkBufCT().swap( bulkSendBuf_);
+    BulkBufCT().swap( bulkRecvBuf_);
+}
+
 /// \brief Gather unknowns on ghost tetras for sending these to master the tetra
 int ParMultiGridCL::GatherUnknownsRef (OBJT obj, void* buf)
 /** Get all values on a ghost tetrahedron, that will be deleted, and put these values into the
@@ -945,6 +1060,9 @@ void ParMultiGridCL::XferStart(int Level)
 
     _level = (Level==-1) ? _mg->GetLastLevel() : Level;
 
+    if (bulkUnk_)
+        bulkSend_.resize( ProcCL::Size());
+
     Comment("- Starting Xfer"<<std::endl, DebugParallelC);
     DynamicDataInterfaceCL::XferBegin();
 }
@@ -953,8 +1071,14 @@ void ParMultiGridCL::XferStart(int Level)
 /** */
 void ParMultiGridCL::XferEnd()
 {
+    DROPS_PROFILE_REGION("ParMultiGridCL::XferEnd");
     Assert(TransferMode && _level!=-1, DROPSErrCL("ParMultiGridCL: XferEnd: Not in Transfer-Mode"), DebugParallelC);
+    const bool bulk= bulkUnk_ && VecDescRecv();
+    if (bulk)
+        PostBulkUnknowns();         // send unknowns while DDD transfers the simplices
     DynamicDataInterfaceCL::XferEnd();
+    if (bulk)
+        RecvBulkUnknowns();
 
     // All Tetraeders, that are marked for removement, should be removed now!
     // All Subsimplices are marked for removement
@@ -1039,6 +1163,7 @@ void ParMultiGridCL::XferEnd()
     _level=-1;                  // and so _level is also set on no transfer active!
     _mg->FinalizeModify();      // No more elements may be added
     _mg->ClearTriangCache();
+    _mg->IncrementVersion();    // the triangulations have changed
 
     Comment("- Xfer finished"<<std::endl,DebugParallelC);
 }
@@ -1752,7 +1877,7 @@ OBJT ParMultiGridCL::HandlerTConstructor( size_t, PrioT, ATTRT level){
 /** Check if numerical data have to be transfered too. If this case happens, tell DDD that additional
     data will be transfered. Than DDD calls the Gather and Scatter functions <p>
     The Recylce-Bin is also destroyed and boundary information are send too*/
-void ParMultiGridCL::HandlerVXfer( OBJT obj, __UNUSED__ PROCT proc, __UNUSED__ PrioT prio)
+void ParMultiGridCL::HandlerVXfer( OBJT obj, PROCT proc, __UNUSED__ PrioT prio)
 {
     VertexCL* const vp= ddd_cast<VertexCL*>(obj);
     int numSendScalUnk= 0,
@@ -1765,7 +1890,7 @@ void ParMultiGridCL::HandlerVXfer( OBJT obj, __UNUSED__ PROCT proc, __UNUSED__ P
     	DynamicDataInterfaceCL::XferAddData( vp->_BndVerts->size(), _BndPtT);
 
     // if there this ParMultiGridCL knowns about unknowns, ther are unknwons on this vertex and this vertex is marked for removement, count the unknowns and give this Information to DDD!
-    if (VecDescRecv() && vp->Unknowns.Exist())
+    if (VecDescRecv() && vp->Unknowns.Exist() && !AddBulkUnknowns( 0, vp->GetGID(), vp->Unknowns, proc))
     {
         for (size_t i=0; i<_VecDesc.size(); ++i)
         {
@@ -1792,7 +1917,7 @@ void ParMultiGridCL::HandlerVXfer( OBJT obj, __UNUSED__ PROCT proc, __UNUSED__ P
 /// \brief transfer an edge
 /** Check if numerical data have to be transfered too. If this case happens, tell DDD that additional
     data will be transfered. Than DDD calls the Gather and Scatter functions <p>*/
-void ParMultiGridCL::HandlerEXfer(OBJT obj, __UNUSED__ PROCT proc, PrioT)
+void ParMultiGridCL::HandlerEXfer(OBJT obj, PROCT proc, PrioT)
 {
     EdgeCL* const ep= ddd_cast<EdgeCL*>(obj);
 
@@ -1801,7 +1926,7 @@ void ParMultiGridCL::HandlerEXfer(OBJT obj, __UNUSED__ PROCT proc, PrioT)
 
     // if ParMultiGridCL knowns about unknowns and there are unknowns on this
     // edge count the unknowns and give this information to DDD
-    if (VecDescRecv() && ep->Unknowns.Exist())
+    if (VecDescRecv() && ep->Unknowns.Exist() && !AddBulkUnknowns( 1, ep->GetGID(), ep->Unknowns, proc))
     {
         for (size_t i=0; i<_VecDesc.size(); ++i)
         {
@@ -1849,7 +1974,7 @@ void ParMultiGridCL::HandlerTXfer(OBJT obj, PROCT proc, PrioT prio)
         numSendVecUnk = 0;
 
     // if there this ParMultiGridCL knowns about unknowns, ther are unknwons on this tetra, count the unknowns and give this Information to DDD!
-    if (VecDescRecv() && tp->Unknowns.Exist())
+    if (VecDescRecv() && tp->Unknowns.Exist() && !AddBulkUnknowns( 2, tp->GetGID(), tp->Unknowns, proc))
     {
         for (size_t i=0; i<_VecDesc.size(); ++i)
         {
@@ -92,6 +92,31 @@ class ParMultiGridCL
     /// \brief Vector of vectorial boundary conditions
     typedef std::vector< const BndDataCL<Point3DCL>* > VecBndCT;
 
+  private: // types for the bulk transfer of unknowns
+    /// \brief Simplex, whose unknowns are sent to another proc within a bulk transfer
+    struct BulkUnkST
+    {
+        Uint                   kind;    ///< 0: vertex, 1: edge, 2: tetra
+        GIDT                   gid;     ///< global id of the simplex
+        const UnknownHandleCL* unk;     ///< unknowns on the simplex
+
+        BulkUnkST( Uint k, GIDT g, const UnknownHandleCL* u) : kind( k), gid( g), unk( u) {}
+        bool operator< ( const BulkUnkST& b) const { return kind<b.kind || (kind==b.kind && gid<b.gid); }
+        bool operator==( const BulkUnkST& b) const { return kind==b.kind && gid==b.gid; }
+    };
+    /// \brief Received unknowns of a simplex within a bulk transfer
+    struct BulkRecvST
+    {
+        Uint          kind;             ///< 0: vertex, 1: edge, 2: tetra
+        GIDT          gid;              ///< global id of the simplex
+        const double* data;             ///< mask of the transferred VecDescCL followed by the values
+
+        BulkRecvST( Uint k, GIDT g, const double* d) : kind( k), gid( g), data( d) {}
+        bool operator< ( const BulkRecvST& b) const { return kind<b.kind || (kind==b.kind && gid<b.gid); }
+    };
+    typedef std::vector< std::vector<BulkUnkST> > BulkSendCT;     ///< simplices to be sent for each proc
+    typedef std::vector< BufferCT >               BulkBufCT;      ///< packed unknowns for each proc
+
   private:    // variables
     static IFT _EdgeIF;                  // Interface for accumulate the "Marked for Refinement"
     static IFT _TetraIF;                 // Interface for communicateRefMarks() and TreatGhosts()
@@ -130,6 +155,13 @@ class ParMultiGridCL
 
     static VecDescCL* _actualVec;           // actual index within HandleNewIdx (used within DDD-Gather and DDD-Scatter operation)
 
+    static bool       bulkUnk_;             // transfer unknowns by one message per neighbor proc instead of DDD added data
+    static BulkSendCT bulkSend_;            // simplices, whose unknowns are sent to each proc within the actual transfer
+    static BulkBufCT  bulkSendBuf_,         // packed unknowns sent to each proc
+                      bulkRecvBuf_;         // packed unknowns received from each proc
+    static std::vector<ProcCL::RequestT> bulkReq_; // requests of the bulk transfer
+    static const int  bulkTag_= 2001;       // tag for the messages of the bulk transfer
+
     static ParMultiGridCL* instance_;       // only one instance of ParMultiGridCL may exist (Singleton-Pattern)
 
   private:
@@ -160,6 +192,8 @@ class ParMultiGridCL
     static void XferStart(int Level=-1);                                    // Call this everytime before using an transfer command!
     static void XferEnd();                                                  // Call this everytime after all tetras are marked for xfer
     static void TXfer(TetraCL&, PROCT, PrioT, bool del);              // Transfer a tetra to another proc
+    static void SetBulkUnknowns(bool bulk=true) { bulkUnk_= bulk; }         // Transfer unknowns by one message per neighbor proc
+    static bool BulkUnknowns() { return bulkUnk_; }                         // Are unknowns transferred by one message per neighbor proc
     // @}
 
 
@@ -292,6 +326,14 @@ class ParMultiGridCL
     template<class SimplexT>
     static inline void RecvUnknowns(SimplexT*, TypeT, void*, int);       // Recieve Unknwons within the Handler<SimplexT>Gather
     static void EnlargeRecieveBuffer();                                     // Enlarge the _RecvBuf
+    static inline Uint NumUnknownsOnKind(const IdxDescCL*, Uint kind);      // Number of unknowns on a vertex (0), edge (1) or tetra (2)
+    static inline bool AddBulkUnknowns(Uint kind, GIDT, const UnknownHandleCL&, PROCT); // Remember unknowns on a transferred simplex for the bulk transfer
+    static void PostBulkUnknowns();                                         // Pack and send the unknowns of all transferred simplices
+    static void RecvBulkUnknowns();                                         // Receive the unknowns and put them into the _RecvBuf
+    template<class SimplexT>
+    static void PutBulkUnknowns(SimplexT&, const double*);                  // Put bulk transferred unknowns of a simplex into the _RecvBuf
+    template<class IterT>
+    static void PutBulkUnknowns(IterT, IterT, Uint kind, const std::vector<BulkRecvST>&); // Put bulk transferred unknowns onto all simplices of a range
     //@}
 
 
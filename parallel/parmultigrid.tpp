@@ -320,6 +320,54 @@ template<class SimplexT>
     }
 }
 
+/****************************************************************************
+* B U L K   T R A N S F E R   O F   U N K N O W N S                         *
+*****************************************************************************
+*   Instead of attaching the unknowns to each transferred simplex as DDD    *
+*   added data, the unknowns of all simplices sent to one proc are packed   *
+*   into one contiguous buffer and sent by one message (see                 *
+*   PostBulkUnknowns and RecvBulkUnknowns).                                 *
+****************************************************************************/
+Uint ParMultiGridCL::NumUnknownsOnKind(const IdxDescCL* idxDesc, Uint kind)
+{
+    return kind==0 ? idxDesc->NumUnknownsVertex() : (kind==1 ? idxDesc->NumUnknownsEdge() : idxDesc->NumUnknownsTetra());
+}
+
+bool ParMultiGridCL::AddBulkUnknowns(Uint kind, GIDT gid, const UnknownHandleCL& unk, PROCT dest)
+/** Remember the simplex for packing its unknowns at the end of the transfer.
+    \return true, if the unknowns are sent by the bulk transfer, i.e., they must not be added to the DDD message*/
+{
+    if (!bulkUnk_ || !TransferMode)
+        return false;
+    bulkSend_[dest].push_back( BulkUnkST( kind, gid, &unk));
+    return true;
+}
+
+template<class SimplexT>
+  void ParMultiGridCL::PutBulkUnknowns(SimplexT& s, const double* data)
+/** The first entry of \a data is a bit mask of the transferred VecDescCL, the
+    values of these VecDescCL follow. As in RecvUnknowns, the values are only
+    stored, if this simplex does not know the unknowns so far.*/
+{
+    const Uint mask= static_cast<Uint>( *data++);
+    for (size_t i=0; i<_VecDesc.size(); ++i){
+        if (!(mask & (1u<<i)))
+            continue;
+        const Uint idx   = _VecDesc[i]->RowIdx->GetIdx(),
+                   numUnk= _VecDesc[i]->RowIdx->GetNumUnknownsOnSimplex<SimplexT>();
+        if (!s.Unknowns.Exist(idx) && !s.Unknowns.UnkRecieved(idx)){
+            if (_RecvBufPos+numUnk>_RecvBuf.size())
+                EnlargeRecieveBuffer();
+            s.Unknowns.Prepare(idx);
+            s.Unknowns(idx)= _RecvBufPos;
+            s.Unknowns.SetUnkRecieved(idx);
+            std::copy( data, data+numUnk, _RecvBuf.begin()+_RecvBufPos);
+            _RecvBufPos+= numUnk;
+        }
+        data+= numUnk;
+    }
+}
+
 /****************************************************************************
 * L I N E A R   I N T E R P O L A T I O N                                   *
 *****************************************************************************
@@ -24,6 +24,8 @@
 */
 
 #include "parallel/partitioner.h"
+#include <numeric>
+#include <limits>
 
 namespace DROPS
 {
@@ -115,7 +117,7 @@ GraphST& PartitionerCL::GetGraph()
 
 /**Factory method that based on the partOption parameter allocates memory for the chosen type of object
   (it implements the Factory design pattern)
- \param partitioner type of partitioner used( 0 - Metis, 1 - Zoltan, 2 - Scotch)
+ \param partitioner type of partitioner used( 1 - Metis, 2 - Zoltan, 3 - Scotch, 4 - SFC)
  \param quality     quality of the partitioning
  \param method      partition method invoked by the partitioner
  */
@@ -126,7 +128,11 @@ PartitionerCL* PartitionerCL::newPartitioner(Partitioner partitioner, float qual
      {
          case metis:
          {
+#ifdef _PARMETIS
              pa = new ParMetisCL( method, quality);
+#else
+             throw DROPSErrCL("PartitionerCL::newPartitioner: ParMETIS library is not included");
+#endif
              break;
          }
          case zoltan:
@@ -147,6 +153,11 @@ PartitionerCL* PartitionerCL::newPartitioner(Partitioner partitioner, float qual
 #endif
              break;
          }
+         case sfc:
+         {
+             pa = new SFCPartitionerCL( method, quality);
+             break;
+         }
      }
      return pa;
 }
@@ -158,6 +169,7 @@ void PartitionerCL::ApplyIdentity()
 }
 
 
+#ifdef _PARMETIS
 //Implementation of the methods in the derived class ParMetisCL
 //=================================================================================================
 
@@ -270,6 +282,370 @@ void ParMetisCL::PartGraphPar()
     }
     timer.Stop(); time_= timer.GetTime();
 }
+#endif
+
+//Implementation of the methods in the derived class SFCPartitionerCL
+//=================================================================================================
+
+/// \brief Compare positions by the associated Hilbert keys
+struct SFCKeyLessCL
+{
+    const std::vector<SFCPartitionerCL::KeyT>& keys;
+    SFCKeyLessCL( const std::vector<SFCPartitionerCL::KeyT>& k) : keys( k) {}
+    bool operator() ( size_t a, size_t b) const { return keys[a]<keys[b]; }
+};
+
+/** Constructor of the derived class SFCPartitionerCL (parent PartitionerCL)
+ \param meth        partition method
+ \param ubvec       allowed imbalance, used by the method Adaptive
+ */
+SFCPartitionerCL::SFCPartitionerCL( PartMethod meth, float ubvec) : PartitionerCL( meth)
+{
+    GetGraph().ubvec= ubvec;
+}
+
+/** The partitioning only uses the barycenters and the weights of the vertices*/
+void SFCPartitionerCL::CreateGraph()
+{
+    if (GetGraph().myVerts>0 && GetGraph().xyz==0)
+        throw DROPSErrCL("SFCPartitionerCL::CreateGraph: The barycenters of the vertices are required");
+}
+
+/** Compute the Hilbert key by the algorithm of J. Skilling, Programming the Hilbert curve, AIP Conf. Proc. 707, 2004.
+ \param x,y,z   coordinates in [0, 2^bits)
+ \param bits    number of bits per coordinate
+ */
+SFCPartitionerCL::KeyT SFCPartitionerCL::HilbertKey( Uint x, Uint y, Uint z, Uint bits)
+{
+    Uint X[3]= { x, y, z };
+    const Uint M= 1u << (bits-1);
+    // inverse undo excess work
+    for (Uint Q= M; Q>1; Q>>=1) {
+        const Uint P= Q-1;
+        for (int i=0; i<3; ++i) {
+            if (X[i] & Q)
+                X[0]^= P;
+            else {
+                const Uint t= (X[0]^X[i]) & P;
+                X[0]^= t;
+                X[i]^= t;
+            }
+        }
+    }
+    // Gray encode
+    for (int i=1; i<3; ++i)
+        X[i]^= X[i-1];
+    Uint t= 0;
+    for (Uint Q= M; Q>1; Q>>=1)
+        if (X[2] & Q)
+            t^= Q-1;
+    for (int i=0; i<3; ++i)
+        X[i]^= t;
+    // interleave the transposed key
+    KeyT key= 0;
+    for (int b= (int)bits-1; b>=0; --b)
+        for (int i=0; i<3; ++i)
+            key= (key<<1) | ((X[i]>>b) & 1u);
+    return key;
+}
+
+/** \param bbox lower (bbox[0..2]) and upper (bbox[3..5]) corner of the bounding box of all barycenters
+    \param keys Hilbert key of each vertex*/
+void SFCPartitionerCL::ComputeKeys( const double bbox[6], std::vector<KeyT>& keys)
+{
+    const Uint maxcoord= (1u << bits_) - 1;
+    double scale= 0.;
+    for (int i=0; i<3; ++i)
+        scale= std::max( scale, bbox[3+i]-bbox[i]);
+    scale= scale>0. ? maxcoord/scale : 0.;
+
+    const float* xyz= GetGraph().xyz;
+    keys.resize( GetGraph().myVerts);
+    for (int v=0; v<GetGraph().myVerts; ++v) {
+        Uint c[3];
+        for (int i=0; i<3; ++i)
+            c[i]= std::min( maxcoord, static_cast<Uint>( (xyz[3*v+i]-bbox[i])*scale));
+        keys[v]= HilbertKey( c[0], c[1], c[2], bits_);
+    }
+}
+
+/** Each balance condition is normalized by its sum, so all conditions contribute equally. If no
+    weights are given, all vertices get the weight 1.
+    \param wgt    combined weight of each vertex
+    \param global normalize by the sum over all processes*/
+void SFCPartitionerCL::ComputeWeights( std::vector<double>& wgt, bool global)
+{
+    const GraphST& graph= GetGraph();
+    const int n= graph.myVerts, ncon= graph.ncon;
+    wgt.assign( n, 0.);
+    if (graph.vwgt==0 || ncon<1) {
+        wgt.assign( n, 1.);
+        return;
+    }
+    std::vector<double> sum( ncon, 0.), allsum( ncon);
+    for (int v=0; v<n; ++v)
+        for (int c=0; c<ncon; ++c)
+            sum[c]+= graph.vwgt[v*ncon+c];
+    if (global)
+        ProcCL::GlobalSum( Addr(sum), Addr(allsum), ncon);
+    else
+        allsum= sum;
+
+    bool hasWeight= false;
+    for (int c=0; c<ncon; ++c) {
+        if (allsum[c]<=0.)
+            continue;
+        hasWeight= true;
+        for (int v=0; v<n; ++v)
+            wgt[v]+= graph.vwgt[v*ncon+c]/allsum[c];
+    }
+    if (!hasWeight)
+        wgt.assign( n, 1.);
+}
+
+/** \param wgt    weights of the vertices
+    \param order  vertices sorted by their keys
+    \param offset weight of all vertices, that are located before order[0] on the curve
+    \param total  weight of all vertices
+    \param piece  number of the piece of the curve, each vertex belongs to*/
+void SFCPartitionerCL::CutCurve( const std::vector<double>& wgt, const std::vector<size_t>& order,
+                                 double offset, double total, std::vector<int>& piece) const
+{
+    const int numParts= ProcCL::Size();
+    piece.resize( wgt.size());
+    double prefix= offset;
+    for (size_t k=0; k<order.size(); ++k) {
+        const double w= wgt[order[k]];
+        const int p= total>0. ? static_cast<int>( numParts*(prefix+0.5*w)/total) : 0;
+        piece[order[k]]= std::min( std::max( p, 0), numParts-1);
+        prefix+= w;
+    }
+}
+
+/** Greedy assignment: The pairs (piece, process) are assigned in the order of decreasing overlap.
+    All processes compute the same assignment.
+    \param overlap     overlap[piece*P+proc] is the weight of the piece, that is currently stored by proc
+    \param pieceToProc process, that gets the piece*/
+void SFCPartitionerCL::AssignPieces( const std::vector<double>& overlap, std::vector<int>& pieceToProc) const
+{
+    const int numParts= ProcCL::Size();
+    std::vector<std::pair<double, int> > pairs;
+    for (int i=0; i<numParts*numParts; ++i)
+        if (overlap[i]>0.)
+            pairs.push_back( std::make_pair( -overlap[i], i));
+    std::sort( pairs.begin(), pairs.end());
+
+    pieceToProc.assign( numParts, -1);
+    std::vector<bool> procUsed( numParts, false);
+    for (size_t i=0; i<pairs.size(); ++i) {
+        const int piece= pairs[i].second/numParts, proc= pairs[i].second%numParts;
+        if (pieceToProc[piece]<0 && !procUsed[proc]) {
+            pieceToProc[piece]= proc;
+            procUsed[proc]= true;
+        }
+    }
+    // pieces without overlap get the remaining processes
+    int proc= 0;
+    for (int piece=0; piece<numParts; ++piece) {
+        if (pieceToProc[piece]>=0)
+            continue;
+        while (procUsed[proc])
+            ++proc;
+        pieceToProc[piece]= proc;
+        procUsed[proc]= true;
+    }
+}
+
+/** Serial partitioning
+ \param master      rank of the master thread
+ */
+void SFCPartitionerCL::PartGraphSer( int master)
+{
+    if ( ProcCL::MyRank()!=master)
+        return;
+
+    Comment("- Start calculate LoadBalanace with SFC"<<std::endl, DebugLoadBalC);
+    TimerCL timer; timer.Reset();
+
+    GraphST& graph= GetGraph();
+    const int n= graph.myVerts;
+    if (graph.part==0)
+        graph.part= new idxtype[n];
+
+    double bbox[6];
+    for (int i=0; i<3; ++i) {
+        bbox[i]  =  std::numeric_limits<double>::max();
+        bbox[3+i]= -std::numeric_limits<double>::max();
+    }
+    for (int v=0; v<n; ++v)
+        for (int i=0; i<3; ++i) {
+            bbox[i]  = std::min( bbox[i],   (double)graph.xyz[3*v+i]);
+            bbox[3+i]= std::max( bbox[3+i], (double)graph.xyz[3*v+i]);
+        }
+
+    std::vector<KeyT> keys;
+    ComputeKeys( bbox, keys);
+    std::vector<double> wgt;
+    ComputeWeights( wgt, false);
+    std::vector<size_t> order( n);
+    for (int v=0; v<n; ++v)
+        order[v]= v;
+    std::sort( order.begin(), order.end(), SFCKeyLessCL( keys));
+
+    std::vector<int> piece;
+    CutCurve( wgt, order, 0., std::accumulate( wgt.begin(), wgt.end(), 0.), piece);
+    std::copy( piece.begin(), piece.end(), graph.part);
+
+    // all vertices are stored by the master, so the edge cut can be computed
+    graph.edgecut= 0;
+    for (int v=0; v<n; ++v)
+        for (idxtype j=graph.xadj[v]; j<graph.xadj[v+1]; ++j)
+            if (graph.part[v]!=graph.part[graph.adjncy[j]-graph.myfirstVert])
+                ++graph.edgecut;
+    graph.edgecut/= 2;
+
+    timer.Stop(); time_= timer.GetTime();
+    Comment("  * Number of Edgecut: "<<graph.edgecut<<std::endl, DebugLoadBalC);
+}
+
+/// \brief Parallel partitioning
+void SFCPartitionerCL::PartGraphPar()
+/** The keys are ordered by a sample sort: Each process sorts its keys and contributes
+    ProcCL::Size()-1 regular samples. The samples determine the splitters, by which the
+    keys are sent to the processes. Each process cuts its part of the curve, and sends the
+    resulting partition back.
+    \pre Setup of the graph
+*/
+{
+    Comment("- Start calculate LoadBalanace with SFC-"<<(meth_ == Adaptive ? "Adaptive" : (meth_ == Identity ? "Identity" : "KWay"))<<std::endl,
+            DebugLoadBalC);
+
+    GraphST& graph= GetGraph();
+    const int n= graph.myVerts, numParts= ProcCL::Size();
+    if (graph.part == 0)
+        graph.part = new idxtype[n];
+
+    ParTimerCL timer; timer.Reset();
+    if (meth_==NoMig){
+        timer.Stop(); time_= timer.GetTime();
+        return;
+    }
+    if (meth_==Identity){
+        ApplyIdentity();
+        timer.Stop(); time_= timer.GetTime();
+        return;
+    }
+
+    std::vector<double> wgt;
+    ComputeWeights( wgt, true);
+    const double mywgt= std::accumulate( wgt.begin(), wgt.end(), 0.),
+                 total= ProcCL::GlobalSum( mywgt);
+
+    // keep the distribution, if it is balanced well enough
+    if (meth_==Adaptive && ProcCL::GlobalMax( mywgt)*numParts <= graph.ubvec*total){
+        ApplyIdentity();
+        timer.Stop(); time_= timer.GetTime();
+        Comment("  * Distribution is balanced, no migration"<<std::endl, DebugLoadBalC);
+        return;
+    }
+
+    // Hilbert keys with respect to the global bounding box
+    double bbox[6], mybbox[6];
+    for (int i=0; i<3; ++i) {
+        mybbox[i]  =  std::numeric_limits<double>::max();
+        mybbox[3+i]= -std::numeric_limits<double>::max();
+    }
+    for (int v=0; v<n; ++v)
+        for (int i=0; i<3; ++i) {
+            mybbox[i]  = std::min( mybbox[i],   (double)graph.xyz[3*v+i]);
+            mybbox[3+i]= std::max( mybbox[3+i], (double)graph.xyz[3*v+i]);
+        }
+    ProcCL::GlobalMin( mybbox,   bbox,   3);
+    ProcCL::GlobalMax( mybbox+3, bbox+3, 3);
+
+    std::vector<KeyT> keys;
+    ComputeKeys( bbox, keys);
+    std::vector<size_t> order( n);
+    for (int v=0; v<n; ++v)
+        order[v]= v;
+    std::sort( order.begin(), order.end(), SFCKeyLessCL( keys));
+
+    // regular samples and splitters
+    std::vector<KeyT> samples;
+    for (int k=1; k<numParts && n>0; ++k)
+        samples.push_back( keys[order[(size_t)k*n/numParts]]);
+    const int mySamples= samples.size();
+    samples.resize( std::max( mySamples, 1));
+    std::vector<int> numSamples( numParts), sampleDispl( numParts+1, 0);
+    ProcCL::Gather( mySamples, Addr(numSamples), -1);
+    for (int p=0; p<numParts; ++p)
+        sampleDispl[p+1]= sampleDispl[p]+numSamples[p];
+    std::vector<KeyT> allSamples( std::max( sampleDispl[numParts], 1));
+    ProcCL::Gatherv( Addr(samples), mySamples, Addr(allSamples), Addr(numSamples), Addr(sampleDispl), -1);
+    allSamples.resize( sampleDispl[numParts]);
+    std::sort( allSamples.begin(), allSamples.end());
+    std::vector<KeyT> splitters;
+    for (int k=1; k<numParts && !allSamples.empty(); ++k)
+        splitters.push_back( allSamples[(size_t)k*allSamples.size()/numParts]);
+
+    // send the sorted keys and weights to the process owning the bucket
+    std::vector<int> sendCnt( numParts, 0), sendDispl( numParts, 0), recvCnt( numParts), recvDispl( numParts, 0);
+    std::vector<KeyT>   sendKeys( std::max( n, 1));
+    std::vector<double> sendWgt( std::max( n, 1));
+    for (int k=0; k<n; ++k) {
+        const KeyT key= keys[order[k]];
+        ++sendCnt[ std::upper_bound( splitters.begin(), splitters.end(), key) - splitters.begin()];
+        sendKeys[k]= key;
+        sendWgt[k] = wgt[order[k]];
+    }
+    ProcCL::Alltoall( Addr(sendCnt), 1, Addr(recvCnt));
+    for (int p=1; p<numParts; ++p) {
+        sendDispl[p]= sendDispl[p-1]+sendCnt[p-1];
+        recvDispl[p]= recvDispl[p-1]+recvCnt[p-1];
+    }
+    const int numRecv= recvDispl[numParts-1]+recvCnt[numParts-1];
+    std::vector<KeyT>   recvKeys( std::max( numRecv, 1));
+    std::vector<double> recvWgt( std::max( numRecv, 1));
+    ProcCL::Alltoallv( Addr(sendKeys), Addr(sendCnt), Addr(sendDispl), Addr(recvKeys), Addr(recvCnt), Addr(recvDispl));
+    ProcCL::Alltoallv( Addr(sendWgt),  Addr(sendCnt), Addr(sendDispl), Addr(recvWgt),  Addr(recvCnt), Addr(recvDispl));
+    recvKeys.resize( numRecv);
+    recvWgt.resize( numRecv);
+
+    // cut the local part of the curve
+    std::vector<size_t> recvOrder( numRecv);
+    for (int k=0; k<numRecv; ++k)
+        recvOrder[k]= k;
+    std::stable_sort( recvOrder.begin(), recvOrder.end(), SFCKeyLessCL( recvKeys));
+    std::vector<double> bucketWgt( numParts);
+    ProcCL::Gather( std::accumulate( recvWgt.begin(), recvWgt.end(), 0.), Addr(bucketWgt), -1);
+    const double offset= std::accumulate( bucketWgt.begin(), bucketWgt.begin()+ProcCL::MyRank(), 0.);
+    std::vector<int> piece;
+    CutCurve( recvWgt, recvOrder, offset, total, piece);
+
+    // assign the pieces to the processes
+    std::vector<int> pieceToProc( numParts);
+    for (int p=0; p<numParts; ++p)
+        pieceToProc[p]= p;
+    if (meth_==Adaptive) {
+        std::vector<double> overlap( numParts*numParts, 0.), allOverlap( numParts*numParts);
+        for (int p=0; p<numParts; ++p)
+            for (int k=recvDispl[p]; k<recvDispl[p]+recvCnt[p]; ++k)
+                overlap[piece[k]*numParts+p]+= recvWgt[k];
+        ProcCL::GlobalSum( Addr(overlap), Addr(allOverlap), numParts*numParts);
+        AssignPieces( allOverlap, pieceToProc);
+    }
+    std::vector<int> recvPart( std::max( numRecv, 1)), sendPart( std::max( n, 1));
+    for (int k=0; k<numRecv; ++k)
+        recvPart[k]= pieceToProc[piece[k]];
+
+    // send the partition back
+    ProcCL::Alltoallv( Addr(recvPart), Addr(recvCnt), Addr(recvDispl), Addr(sendPart), Addr(sendCnt), Addr(sendDispl));
+    for (int k=0; k<n; ++k)
+        graph.part[order[k]]= sendPart[k];
+    graph.edgecut= 0;
+
+    timer.Stop(); time_= timer.GetTime();
+}
 
 
 #ifdef _ZOLTAN
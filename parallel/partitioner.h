@@ -40,8 +40,10 @@
 #ifdef _SCOTCH
 #  include <ptscotch.h>
 #endif
-#include <parmetis.h>
-#include <metis.h>
+#ifdef _PARMETIS
+#  include <parmetis.h>
+#  include <metis.h>
+#endif
 
 namespace DROPS
 {
@@ -51,7 +53,8 @@ typedef idxtype* IndexArray;        ///< idxtype is defined as Integer
 enum Partitioner{
     metis=1,        ///< Parmetis
     zoltan=2,       ///< Zoltan
-    scotch=3       ///< Scotch
+    scotch=3,       ///< Scotch
+    sfc=4           ///< built-in space-filling curve (Hilbert), see SFCPartitionerCL
 };
 
 /// \enum PartMethod tells which method should be used to compute graph partition problem
@@ -127,10 +130,12 @@ class PartitionerCL
     /// \brief Factory function for the factory design pattern implementation
     static PartitionerCL* newPartitioner( Partitioner partitioner, float quality, PartMethod method);
     GraphST& GetGraph();                        ///< Getter for the graph structure
+    virtual bool UsesGeom() const { return false; } ///< Check, if the partitioner needs the barycenters of the vertices (GraphST::xyz)
     double   GetTime() const { return time_; }  ///< Check, how long the partitioning took
     virtual std::string GetName() const { return std::string("No name specified"); }
 };
 
+#ifdef _PARMETIS
 /// \brief Derived partitioner class from the PartitionerCL class ===> implements the ParMetis graph partitioner
 class ParMetisCL : public PartitionerCL
 {
@@ -146,6 +151,43 @@ class ParMetisCL : public PartitionerCL
     void PartGraphSer( int master);     ///< Implemented virtual method of the abstract parent class PartitionerCL
     std::string GetName() const { return std::string("METIS"); }
 };
+#endif
+
+/// \brief Derived partitioner class from the PartitionerCL class ===> built-in partitioner by a Hilbert space-filling curve
+/** The vertices of the graph are ordered by the Hilbert key of their barycenter, and the curve is
+    cut into ProcCL::Size() pieces of equal weight. Multiple balance conditions are combined into one
+    weight by normalizing each condition by its global sum. The adjacencies are not used, so no
+    external library is needed. In parallel, the keys are ordered by a sample sort.
+    With the method Adaptive, the current distribution is kept, if it is balanced within ubvec, and
+    otherwise each piece of the curve is assigned to the process, that already stores most of its
+    weight, so only the vertices near the cuts are migrated.
+    The edge cut is only computed by PartGraphSer.*/
+class SFCPartitionerCL : public PartitionerCL
+{
+  public:
+    typedef Ulint KeyT;                 ///< type of the Hilbert keys
+
+  private:
+    static const Uint bits_= (sizeof(KeyT)*8)/3 < 21 ? (sizeof(KeyT)*8)/3 : 21;   ///< number of bits per coordinate
+
+    void ComputeKeys( const double bbox[6], std::vector<KeyT>& keys);        ///< Hilbert keys of the barycenters, scaled to the bounding box
+    void ComputeWeights( std::vector<double>& wgt, bool global);             ///< combined weight of each vertex
+    void CutCurve( const std::vector<double>& wgt, const std::vector<size_t>& order, double offset, double total,
+                   std::vector<int>& piece) const;                           ///< assign the sorted vertices to the pieces of the curve
+    void AssignPieces( const std::vector<double>& overlap, std::vector<int>& pieceToProc) const; ///< map the pieces to the processes with least migration
+
+  public:
+    SFCPartitionerCL( PartMethod meth, float ubvec);
+    ~SFCPartitionerCL() {}
+    void CreateGraph();                 ///< See PartitionerCL for documentation
+    void PartGraphPar();                ///< See PartitionerCL for documentation
+    void PartGraphSer( int master);     ///< See PartitionerCL for documentation
+    bool UsesGeom() const { return true; }
+    std::string GetName() const { return std::string("SFC"); }
+
+    /// \brief Hilbert key of a point given by integer coordinates in [0, 2^bits)
+    static KeyT HilbertKey( Uint x, Uint y, Uint z, Uint bits= bits_);
+};
 
 #ifdef _ZOLTAN
 /// \brief Derived partitioner from the Partitioner class ===> implements the Zoltan graph partitioner
@@ -0,0 +1,205 @@
+/// \file TestCoarsePar.cpp
+/// \brief Testing the agglomerated direct solver for coarse problems against a solver on all procs
+/// \author LNM RWTH Aachen: Joerg Grande; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2009 LNM/SC RWTH Aachen, Germany
+*/
+
+ // include parallel computing!
+#include "parallel/parallel.h"
+#include "parallel/parmultigrid.h"
+#include "parallel/loadbal.h"
+#include "parallel/exchange.h"
+#include "misc/params.h"
+
+ // include geometric computing
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+
+ // include numeric computing!
+#include "num/discretize.h"
+#include "num/parsolver.h"
+#include "num/parprecond.h"
+#include "num/parcoarse.h"
+#include "num/sparseldlt.h"
+
+ // include standards
+#include <iostream>
+#include <fstream>
+#include <cmath>
+
+/****************************************************************************
+* G L O B A L  V A R I B L E S                                              *
+****************************************************************************/
+DROPS::NoBndDataCL<double> Bnd;     // no boundary conditions
+DROPS::ParamCL P;                   // parameters
+const char line[] ="-----------------------------------------------------------------------------";
+
+namespace DROPS
+{
+/****************************************************************************
+* S E T U P  S Y S T E M                                                    *
+*****************************************************************************
+*   P1 discretization of -Laplace u + u = 1 with natural boundary           *
+*   conditions. Each proc assembles its tetras, i.e., A and b are           *
+*   distributed.                                                            *
+****************************************************************************/
+void SetupSystem( const MultiGridCL& mg, const IdxDescCL& idx, MatrixCL& A, VectorCL& b)
+{
+    const Uint num= idx.GetIdx();
+    SparseMatBuilderCL<double> M( &A, idx.NumUnknowns(), idx.NumUnknowns());
+    b.resize( idx.NumUnknowns());
+    b= 0.;
+    SMatrixCL<3,4> G;
+    double det;
+    IdxT unk[4];
+    DROPS_FOR_TRIANG_CONST_TETRA( mg, idx.TriangLevel(), it) {
+        P1DiscCL::GetGradients( G, det, *it);
+        const double absdet= std::fabs( det);
+        for (int i=0; i<4; ++i)
+            unk[i]= it->GetVertex( i)->Unknowns( num);
+        for (int i=0; i<4; ++i) {
+            for (int j=0; j<4; ++j)
+                M( unk[i], unk[j])+= (G( 0, i)*G( 0, j) + G( 1, i)*G( 1, j) + G( 2, i)*G( 2, j))*absdet/6.
+                                   + (i==j ? 2. : 1.)*absdet/120.;
+            b[unk[i]]+= absdet/24.;
+        }
+    }
+    M.Build();
+}
+
+/****************************************************************************
+* C H E C K  C O A R S E  S O L V E R                                       *
+*****************************************************************************
+*   Solve the system by ParAgglomeratedDirectSolverCL, the first time with  *
+*   a new factorization, the second time with the old one. Return the       *
+*   maximal difference to the reference solution relative to its size.      *
+****************************************************************************/
+double CheckCoarseSolver( const IdxDescCL& idx, IdxT numUnk, size_t minUnkPerProc, const MatrixCL& A,
+    const VectorCL& b, const VectorCL& xref)
+{
+    ParAgglomeratedDirectSolverCL<DirectLDLtSolverCL> coarse( idx, minUnkPerProc);
+    VectorCL x( b.size()), x2( b.size());
+    coarse.Solve( A, x, b);
+    coarse.Solve( A, x2, VectorCL( 2.*b));
+    const double size= ProcCL::GlobalMax( supnorm( xref)),
+                 diff= ProcCL::GlobalMax( supnorm( VectorCL( x - xref)))/size,
+                 diff2= ProcCL::GlobalMax( supnorm( VectorCL( x2 - 2.*x)))/size;
+    const int hosts= coarse.GetNumHosts();
+    if (ProcCL::IamMaster())
+        std::cout << "   - " << hosts << " of " << ProcCL::Size() << " procs store the coarse problem:\n"
+                  << "     + difference to the solution on all procs: " << diff << '\n'
+                  << "     + difference of the second solve with the old factorization: " << diff2 << std::endl;
+
+    if (coarse.GetLifecycle().GetCount( PcLifecycleCL::PC_Rebuild)!=1 || coarse.GetLifecycle().GetCount( PcLifecycleCL::PC_Current)!=1)
+        throw DROPSErrCL("CheckCoarseSolver: the matrix has been factorized more than once");
+    if (hosts<1 || hosts>ProcCL::Size() || (minUnkPerProc>numUnk && hosts!=1))
+        throw DROPSErrCL("CheckCoarseSolver: wrong number of hosts");
+    return std::max( diff, diff2);
+}
+
+/****************************************************************************
+* S T R A T E G Y                                                           *
+****************************************************************************/
+void Strategy( ParMultiGridCL& pmg)
+{
+    MultiGridCL& mg= pmg.GetMG();
+    MLIdxDescCL idx( P1_FE);
+    idx.CreateNumbering( mg.GetLastLevel(), mg, Bnd);
+    const IdxDescCL& fidx= idx.GetFinest();
+    const IdxT numUnk= fidx.GetGlobalNumUnknowns( mg);
+
+    MatrixCL A;
+    VectorCL b;
+    SetupSystem( mg, fidx, A, b);
+
+    if (ProcCL::IamMaster())
+        std::cout << line << std::endl << " * Solve the system with " << numUnk << " unknowns by PCG on all procs ..." << std::endl;
+    ParJac0CL jac( fidx);
+    ParPCGSolverCL<ParJac0CL> cg( P.get<int>("Solver.Iter"), P.get<double>("Solver.Tol"), fidx, jac, /*relative*/ true, /*accure*/ true);
+    VectorCL xref( b.size());
+    cg.Solve( A, xref, b);
+    if (ProcCL::IamMaster())
+        std::cout << "   - iterations: " << cg.GetIter() << ", residual: " << cg.GetResid() << std::endl;
+
+    if (ProcCL::IamMaster())
+        std::cout << line << std::endl << " * Solve the system by the agglomerated direct solver ..." << std::endl;
+    // the hosts given by the parameter file and a single host, i.e., a shrunk communicator for more than one proc
+    const double diff= CheckCoarseSolver( fidx, numUnk, P.get<int>("Coarse.MinUnkPerProc"), A, b, xref),
+                 diff1= CheckCoarseSolver( fidx, numUnk, numUnk + 1, A, b, xref);
+    if (std::max( diff, diff1)>P.get<double>("Coarse.Tol"))
+        throw DROPSErrCL("Strategy: solution of the agglomerated direct solver differs");
+    if (ProcCL::IamMaster())
+        std::cout << "    --> OK !" << std::endl;
+}
+} // end of namespace DROPS
+
+int main (int argc, char** argv)
+{
+    DROPS::ProcInitCL procinit(&argc, &argv);
+    DROPS::ParMultiGridInitCL pmginit;
+    try
+    {
+        if (argc!=2){
+            std::cout << "You have to specify one parameter:\n\t" << argv[0] << " <param_file>" << std::endl; return 1;
+        }
+        std::ifstream param( argv[1]);
+        if (!param){
+            std::cout << "error while opening parameter file\n"; return 1;
+        }
+        param >> P;
+        param.close();
+        if (DROPS::ProcCL::IamMaster())
+            std::cout << P << std::endl;
+
+        DROPS::ParMultiGridCL pmg= DROPS::ParMultiGridCL::Instance();
+        DROPS::MultiGridCL   *mg;
+
+        DROPS::Point3DCL orig(0.);
+        DROPS::Point3DCL e1(0.0), e2(0.0), e3(0.0);
+        e1[0]= e2[1]= e3[2]= 1.;
+        const int n= P.get<int>("Refining.BasicRef");
+        if (DROPS::ProcCL::IamMaster())
+        {
+            DROPS::BrickBuilderCL brick(orig, e1, e2, e3, n, n, n);
+            mg = new DROPS::MultiGridCL(brick);
+        }
+        else
+        {
+            DROPS::EmptyBrickBuilderCL emptyBrick( orig, e1, e2, e3, n);
+            mg = new DROPS::MultiGridCL(emptyBrick);
+        }
+        pmg.AttachTo(*mg);
+
+        DROPS::LoadBalHandlerCL lb(*mg, DROPS::metis);
+        lb.DoInitDistribution(DROPS::ProcCL::Master());
+        lb.SetStrategy(DROPS::Adaptive);
+        for (int ref=0; ref<P.get<int>("Refining.RefAll"); ++ref)
+        {
+            DROPS::MarkAll(*mg);
+            pmg.Refine();
+            lb.DoMigration();
+        }
+
+        DROPS::Strategy(pmg);
+        return 0;
+    }
+    catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
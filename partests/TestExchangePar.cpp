@@ -599,6 +599,8 @@ bool TestCorrectnessExchangeCL(MultiGridCL& mg, MLIdxDescCL* idx1, MLIdxDescCL*
     bool check= true;
     for (int i=0; i<2; ++i)
     {
+        // first run with MPI datatypes, second run with persistent requests
+        ExchangeCL::UsePersistentRequests(i==1);
         VecDescCL y_acc1; y_acc1.SetIdx(idx1);
         VecDescCL y_acc2; y_acc2.SetIdx(idx2);
         VecDescCL y_acc3; y_acc3.SetIdx(xidx);
@@ -615,6 +617,7 @@ bool TestCorrectnessExchangeCL(MultiGridCL& mg, MLIdxDescCL* idx1, MLIdxDescCL*
             throw DROPSErrCL("ExchangeCL has not exchanged values correct");
 
     }
+    ExchangeCL::UsePersistentRequests(true);
     if (check && ProcCL::IamMaster())
         std::cout << "    --> OK !" << std::endl;
 
@@ -728,6 +731,38 @@ bool TestCorrectnessExchangeBlockCL(MultiGridCL& mg, const ExchangeBlockCL& ExBl
     return check;
 }
 
+/// \brief Check an ExchangeBlockCL, which uses the same index describer for both blocks
+void TestSharedExchangeBlockCL(MLIdxDescCL* idx)
+{
+    if (ProcCL::IamMaster())
+        std::cout << "   - Checke Block-Exchange Klasse mit zweimal demselben Index ... " << std::endl;
+
+    ExchangeBlockCL ExBlock;
+    ExBlock.AttachTo(idx->GetFinest());
+    ExBlock.AttachTo(idx->GetFinest());
+    const ExchangeCL& ex= idx->GetEx();
+    const IdxT n= ex.GetNum();
+
+    VectorCL x(n), xB(2*n);
+    for (IdxT i=0; i<n; ++i)
+        x[i]= 0.1 + std::sin( i + 0.5*ProcCL::MyRank());
+    xB[std::slice(0, n, 1)]= x;
+    xB[std::slice(n, n, 1)]= 2.*x;
+
+    const VectorCL x_acc( ex.GetAccumulate(x));
+    const double prod= ex.ParDot(x, false, x, false, true), prodB= ExBlock.ParDot(xB, false, xB, false, true);
+    ExBlock.Accumulate(xB);
+    VectorCL x1(n), x2(n);
+    x1= xB[std::slice(0, n, 1)];
+    x2= xB[std::slice(n, n, 1)];
+    const double dist= ProcCL::GlobalMax( std::max( norm( VectorCL( x1 - x_acc)), norm( VectorCL( x2 - 2.*x_acc))));
+
+    if (dist>1e-12 || std::abs( 5.*prod - prodB)>1e-10*std::abs( prodB))
+        throw DROPSErrCL("ExchangeBlockCL with a shared ExchangeCL has not exchanged values correct");
+    if (ProcCL::IamMaster())
+        std::cout << "    --> OK !" << std::endl;
+}
+
 /// \brief Test whether all accumulation strategies and inner products give the same result
 void TestInnerProducts(const ExchangeCL& ex1, const ExchangeCL& ex2, const ExchangeBlockCL& exBlock)
 {
@@ -916,6 +951,7 @@ void Strategy(ParMultiGridCL &pmg, const LsetBndDataCL& lsetbnd)
     CreateExchangeBlockCL(ExBlock, &idx1, &idx2);
     TestCorrectnessExchangeBlockCL(mg, ExBlock, &idx1, &idx2);
     TestEquality( idx1.GetEx(), idx2.GetEx(), ExBlock);
+    TestSharedExchangeBlockCL(&idx1);
 
     if (ProcCL::IamMaster())
         std::cout << line << std::endl << " * Checke Paralleles InnereProduct ... " << std::endl;
@@ -204,6 +204,8 @@ void TransportP1CL::Update()
     oldcplA.SetIdx( cidx);
     oldcplC.SetIdx( cidx);
 
+    guess_.Clear();
+
     M.Data.clear();
     M.SetIdx( cidx, cidx);
     A.Data.clear();
@@ -240,6 +242,7 @@ void TransportP1CL::DoStep (const VectorCL& rhs)
     // std::cout << "ct:\n" << ct.Data << "\ncplC:\n" << cplC.Data << "\nC:\n" << C.Data << std::endl;
     // std::cout << "\ncplM:\n" << cplM.Data << "\nM:\n" << M.Data << std::endl;
     // std::cout << "\ncplA:\n" << cplA.Data << "\nA:\n" << A.Data << std::endl;
+    guess_.Project( L_, ct.Data, rhs);
     gm_.Solve( L_, ct.Data, rhs);
     std::cout << "res = " << gm_.GetResid() << ", iter = " << gm_.GetIter() << std::endl;
 }
@@ -255,8 +258,10 @@ void TransportP1CL::CommitStep ()
 void TransportP1CL::DoStep (double new_t)
 {
     VectorCL rhs( c.Data.size());
+    guess_.Push( ct.Data, c.t);
     c.t= new_t;
     InitStep( rhs);
+    guess_.Extrapolate( ct.Data, new_t);
     DoStep( rhs);
     CommitStep();
 }
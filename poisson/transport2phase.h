@@ -31,6 +31,7 @@
 #include "num/fe.h"
 #include "num/discretize.h"
 #include "num/solver.h"
+#include "num/initialguess.h"
 #include "num/bndData.h"
 #include <iostream>
 #include <numeric>
@@ -71,6 +72,7 @@ class TransportP1CL
 
     GSPcCL                  pc_;
     GMResSolverCL<GSPcCL>   gm_;
+    InitialGuessCL          guess_;  ///< history of ct for the initial guess
 
     void SetupInstatSystem (MatrixCL& matA, VecDescCL* cplA,
                         MatrixCL& matM, VecDescCL* cplM, MatrixCL& matC, VecDescCL* cplC,
@@ -86,6 +88,8 @@ class TransportP1CL
 
     const MultiGridCL& GetMG() const { return MG_; }
     GMResSolverCL<GSPcCL>& GetSolver() { return gm_; }
+    /// history for the initial guess of ct; switched off by default
+    InitialGuessCL& GetInitialGuess() { return guess_; }
     const BndDataT& GetBndData() const { return Bnd_; }
 
     /// \name Numbering
@@ -31,6 +31,60 @@ extern DROPS::ParamCL P;
 
 namespace DROPS
 {
+// -----------------------------------------------------------------------------
+//                        TwoPhaseTetraContextCL
+// -----------------------------------------------------------------------------
+
+void TwoPhaseTetraContextCL::begin_accumulation ()
+{
+    data_->resize( omp_get_max_threads());
+    for (size_t i= 0; i < data_->size(); ++i)
+        (*data_)[i].tet= 0;
+}
+
+void TwoPhaseTetraContextCL::visit (const TetraCL& tet)
+{
+    TwoPhaseTetraDataCL& d= (*data_)[tid_];
+    d.tet= &tet;
+    GetTrafoTr( d.T, d.det, tet);
+    d.absdet= std::fabs( d.det);
+    d.ls.assign( tet, lset_.Phi, lset_.GetBndData());
+    d.cut= !equal_signs( d.ls);
+    d.has_partition= false;
+}
+
+TetraAccumulatorCL* TwoPhaseTetraContextCL::clone (int tid)
+{
+    TwoPhaseTetraContextCL* p= new TwoPhaseTetraContextCL( *this);
+    p->tid_= tid;
+    p->owner_= false;
+    return p;
+}
+
+const TwoPhaseTetraDataCL& TwoPhaseTetraContextCL::partition (int tid) const
+{
+    TwoPhaseTetraDataCL& d= (*data_)[tid];
+    if (!d.has_partition) {
+        const PrincipalLatticeCL& lat= PrincipalLatticeCL::instance( 2);
+        evaluate_on_vertexes( d.ls, lat, Addr( d.ls_lat));
+        d.partition.make_partition<SortedVertexPolicyCL, MergeCutPolicyCL>( lat, d.ls_lat);
+        d.has_partition= true;
+    }
+    return d;
+}
+
+MLTetraAccumulatorTupleCL&
+InstatStokes2PhaseP2P1CL::context_accu (MLTetraAccumulatorTupleCL& accus, MLTwoPhaseTetraContextCL& ctx, const LevelsetP2CL& lset) const
+{
+    ctx.clear();
+    for (MLTetraAccumulatorTupleCL::iterator itaccu= accus.begin(); itaccu != accus.end(); ++itaccu) {
+        TwoPhaseTetraContextCL* c= new TwoPhaseTetraContextCL( lset);
+        itaccu->push_back_acquire( c);
+        ctx.push_back( c);
+    }
+    return accus;
+}
+
 // -----------------------------------------------------------------------------
 //                        Routines for SetupSystem2
 // -----------------------------------------------------------------------------
@@ -129,6 +183,9 @@ class System2Accumulator_P2P1XCL : public System2Accumulator_P2P1CL<TwoPhaseFlow
     using base_::RowIdx;
     const ExtIdxDescCL* Xidx_;
 
+    const TwoPhaseTetraContextCL* ctx_; ///< if not 0, the level set and its partition are taken from here
+    int tid_;                           ///< clone id for ctx_
+
     ///\brief Computes the mapping from local to global data "n", the local matrices in loc and, if required, the Dirichlet-values needed to eliminate the boundary-dof from the global system.
     void local_setup ();
     ///\brief Update the global system.
@@ -137,7 +194,7 @@ class System2Accumulator_P2P1XCL : public System2Accumulator_P2P1CL<TwoPhaseFlow
   public:
     System2Accumulator_P2P1XCL ( const TwoPhaseFlowCoeffCL& coeff_arg, const StokesBndDataCL& BndData_arg,
         const LevelsetP2CL& lset, const IdxDescCL& RowIdx_arg, const IdxDescCL& ColIdx_arg,
-        MatrixCL& B_arg, VecDescCL* c_arg, double t_arg);
+        MatrixCL& B_arg, VecDescCL* c_arg, double t_arg, const TwoPhaseTetraContextCL* ctx= 0);
 
     ///\brief Initializes matrix-builders and load-vectors
     void begin_accumulation ();
@@ -146,13 +203,14 @@ class System2Accumulator_P2P1XCL : public System2Accumulator_P2P1CL<TwoPhaseFlow
 
     void visit (const TetraCL& tet);
 
-    TetraAccumulatorCL* clone (int /*tid*/){ return new System2Accumulator_P2P1XCL ( *this); };
+    TetraAccumulatorCL* clone (int tid){ System2Accumulator_P2P1XCL* p= new System2Accumulator_P2P1XCL ( *this); p->tid_= tid; return p; };
 };
 
 System2Accumulator_P2P1XCL::System2Accumulator_P2P1XCL (const TwoPhaseFlowCoeffCL& coeff_arg, const StokesBndDataCL& BndData_arg,
 		const LevelsetP2CL& lset, const IdxDescCL& RowIdx_arg, const IdxDescCL& ColIdx_arg,
-	    MatrixCL& B_arg, VecDescCL* c_arg, double t_arg)
-    :  base_( coeff_arg, BndData_arg, RowIdx_arg, ColIdx_arg, B_arg, c_arg, t_arg), lset_( lset), ls_loc_( 10)
+	    MatrixCL& B_arg, VecDescCL* c_arg, double t_arg, const TwoPhaseTetraContextCL* ctx)
+    :  base_( coeff_arg, BndData_arg, RowIdx_arg, ColIdx_arg, B_arg, c_arg, t_arg), lset_( lset), ls_loc_( 10),
+       ctx_( ctx), tid_( 0)
 {
     P2DiscCL::GetGradientsOnRef( GradRefLP1_);
 }
@@ -171,11 +229,20 @@ void System2Accumulator_P2P1XCL::finalize_accumulation ()
 void System2Accumulator_P2P1XCL::visit (const TetraCL& tet)
 {
     base_::visit( tet);
-    evaluate_on_vertexes( lset_.GetSolution(), tet, lat, Addr( ls_loc_));
-    if (equal_signs( ls_loc_)) return; // extended basis functions have only support on tetra intersecting Gamma.
+    const TwoPhaseTetraDataCL* d= ctx_ != 0 ? ctx_->get( tet, tid_) : 0;
+    if (d != 0) {
+        if (!d->cut) return; // extended basis functions have only support on tetra intersecting Gamma.
+        d= &ctx_->partition( tid_);
+        ls_loc_= d->ls_lat;
+        make_CompositeQuad2Domain( q2dom_, d->partition);
+    }
+    else {
+        evaluate_on_vertexes( lset_.GetSolution(), tet, lat, Addr( ls_loc_));
+        if (equal_signs( ls_loc_)) return; // extended basis functions have only support on tetra intersecting Gamma.
 
-    partition_.make_partition<SortedVertexPolicyCL, MergeCutPolicyCL>( lat, ls_loc_);
-    make_CompositeQuad2Domain( q2dom_, partition_);
+        partition_.make_partition<SortedVertexPolicyCL, MergeCutPolicyCL>( lat, ls_loc_);
+        make_CompositeQuad2Domain( q2dom_, partition_);
+    }
     local_setup();
     update_global_system();
 }
@@ -768,13 +835,17 @@ class PrMassAccumulator_P1CL : public TetraAccumulatorCL
     LocalP2CL<> loc_phi;
     
     bool useXFEM;
+
+    const TwoPhaseTetraContextCL* ctx_; ///< if not 0, the level set and its partition are taken from here
+    int tid_;                           ///< clone id for ctx_
     
     void local_setup ();
     void update_global_system ();
     
 
   public:
-    PrMassAccumulator_P1CL (const MultiGridCL& MG_, const TwoPhaseFlowCoeffCL& Coeff_, MatrixCL& matM_, IdxDescCL& RowIdx_, const LevelsetP2CL& lset_, bool XFEM=true);
+    PrMassAccumulator_P1CL (const MultiGridCL& MG_, const TwoPhaseFlowCoeffCL& Coeff_, MatrixCL& matM_, IdxDescCL& RowIdx_, const LevelsetP2CL& lset_, bool XFEM=true,
+                            const TwoPhaseTetraContextCL* ctx= 0);
 
     ///\brief Initializes matrix-builders and load-vectors
     void begin_accumulation ();
@@ -783,13 +854,15 @@ class PrMassAccumulator_P1CL : public TetraAccumulatorCL
 
     void visit (const TetraCL& sit);
     
-    TetraAccumulatorCL* clone (int /*tid*/){ return new PrMassAccumulator_P1CL ( *this); };
+    TetraAccumulatorCL* clone (int tid){ PrMassAccumulator_P1CL* p= new PrMassAccumulator_P1CL ( *this); p->tid_= tid; return p; };
 };
 
-PrMassAccumulator_P1CL::PrMassAccumulator_P1CL (const MultiGridCL& MG_, const TwoPhaseFlowCoeffCL& Coeff_, MatrixCL& matM_, IdxDescCL& RowIdx_, const LevelsetP2CL& lset_, bool XFEM)
+PrMassAccumulator_P1CL::PrMassAccumulator_P1CL (const MultiGridCL& MG_, const TwoPhaseFlowCoeffCL& Coeff_, MatrixCL& matM_, IdxDescCL& RowIdx_, const LevelsetP2CL& lset_, bool XFEM,
+                                                const TwoPhaseTetraContextCL* ctx)
     : MG(MG_), lat( PrincipalLatticeCL::instance( 2)), Coeff(Coeff_), matM(matM_), RowIdx(RowIdx_),
       lset(lset_), ls_loc_( 10), num_unks_pr(RowIdx_.NumUnknowns()),
-      lvl(RowIdx_.TriangLevel()), nu_inv_p(1./Coeff_.mu( 1.0)), nu_inv_n(1./Coeff_.mu( -1.0)), useXFEM( XFEM)
+      lvl(RowIdx_.TriangLevel()), nu_inv_p(1./Coeff_.mu( 1.0)), nu_inv_n(1./Coeff_.mu( -1.0)), useXFEM( XFEM),
+      ctx_( ctx), tid_( 0)
 {
     for(int i= 0; i < 4; ++i) {
         for(int j= 0; j < i; ++j) {
@@ -817,7 +890,11 @@ void PrMassAccumulator_P1CL::visit (const TetraCL& sit)
 {
     const ExtIdxDescCL& Xidx= RowIdx.GetXidx();
     const double absdet= sit.GetVolume()*6.;
-    loc_phi.assign( sit, lset.Phi, lset.GetBndData());
+    const TwoPhaseTetraDataCL* d= ctx_ != 0 ? ctx_->get( sit, tid_) : 0;
+    if (d != 0)
+        loc_phi= d->ls;
+    else
+        loc_phi.assign( sit, lset.Phi, lset.GetBndData());
     cut.Init( sit, loc_phi);
     const bool nocut= !cut.Intersects();
     GetLocalNumbP1NoBnd( prNumb, sit, RowIdx);
@@ -825,10 +902,6 @@ void PrMassAccumulator_P1CL::visit (const TetraCL& sit)
     QuadDomainCL q2dom_;
     bool sign[4];
 
-    evaluate_on_vertexes( lset.GetSolution(), sit, lat, Addr( ls_loc_));
-    partition_.make_partition<SortedVertexPolicyCL, MergeCutPolicyCL>( lat, ls_loc_);
-    make_CompositeQuad2Domain( q2dom_, partition_);
-
     if (nocut) { // nu is constant in tetra
         const double nu_inv= cut.GetSign( 0) == 1 ? nu_inv_p : nu_inv_n;
         // write values into matrix
@@ -837,6 +910,13 @@ void PrMassAccumulator_P1CL::visit (const TetraCL& sit)
                 (*M_pr)( prNumb[i], prNumb[j])+= nu_inv*P1DiscCL::GetMass( i, j)*absdet;
     }
     else { // nu is discontinuous in tetra
+        if (d != 0)
+            make_CompositeQuad2Domain( q2dom_, ctx_->partition( tid_).partition);
+        else {
+            evaluate_on_vertexes( lset.GetSolution(), sit, lat, Addr( ls_loc_));
+            partition_.make_partition<SortedVertexPolicyCL, MergeCutPolicyCL>( lat, ls_loc_);
+            make_CompositeQuad2Domain( q2dom_, partition_);
+        }
         for(int i=0; i<4; ++i) {
             sign[i]= cut.GetSign(i) == 1;
             for(int j=0; j<=i; ++j) {
@@ -934,146 +1014,135 @@ void SetupPrMass_P1D(const MultiGridCL& MG, const TwoPhaseFlowCoeffCL& Coeff, Ma
 // -----------------------------------------------------------------------------
 
 
-void SetupPrStiff_P1( const MultiGridCL& MG, const TwoPhaseFlowCoeffCL& Coeff, MatrixCL& A_pr, IdxDescCL& RowIdx, IdxDescCL& ColIdx, const LevelsetP2CL& lset)
-{
-    MatrixBuilderCL A( &A_pr, RowIdx.NumUnknowns(), ColIdx.NumUnknowns());
-    const Uint lvl= RowIdx.TriangLevel();
-    const Uint idx= RowIdx.GetIdx();
-    SMatrixCL<3,4> G;
-    double coup[4][4];
-    double det, absdet, IntRhoInv;
-    IdxT UnknownIdx[4];
-
-    const double rho_inv_p= 1./Coeff.rho(1.),
-                 rho_inv_n= 1./Coeff.rho(-1.);
-    LevelsetP2CL::const_DiscSolCL ls= lset.GetSolution();
-    LocalP2CL<> loc_phi, ones( 1.);
-    InterfaceTetraCL cut;
-
-    for (MultiGridCL::const_TriangTetraIteratorCL sit= MG.GetTriangTetraBegin( lvl),
-         send= MG.GetTriangTetraEnd( lvl); sit != send; ++sit)
-    {
-        P1DiscCL::GetGradients( G,det,*sit);
-        absdet= std::fabs( det);
-        loc_phi.assign( *sit, ls);
-        cut.Init( *sit, loc_phi);
-        if (!cut.Intersects()) {
-            IntRhoInv= absdet/6*(cut.GetSign( 0) == 1 ? rho_inv_p : rho_inv_n);
-        } else {
-            double Vol_p=0, Vol_n=0;
-            for (int ch= 0; ch < 8; ++ch) {
-                cut.ComputeCutForChild( ch);
-                Vol_p+= cut.quad( ones, absdet, true);  // integrate on positive part
-                Vol_n+= cut.quad( ones, absdet, false); // integrate on negative part
-            }
-            IntRhoInv= Vol_p*rho_inv_p + Vol_n*rho_inv_n;
-        }
-        for(int i=0; i<4; ++i)
-        {
-            for(int j=0; j<=i; ++j)
-            {
-                // dot-product of the gradients
-                coup[i][j]= ( G( 0, i)*G( 0, j) + G( 1, i)*G( 1, j) + G( 2, i)*G( 2, j) )*IntRhoInv;
-                coup[j][i]= coup[i][j];
-            }
-            UnknownIdx[i]= sit->GetVertex( i)->Unknowns( idx);
-        }
-        for(int i=0; i<4; ++i)    // assemble row i
-            for(int j=0; j<4;++j)
-                A(UnknownIdx[i], UnknownIdx[j])+= coup[j][i];
-    }
-    A.Build();
-}
-
+/// \brief Accumulator to set up the pressure stiffness matrix for P1/P1-XFEM.
 /// \todo: As in SetupPrMass_P1X, replace the smoothed density-function with integration
 ///        over the inner and outer part.
-void SetupPrStiff_P1X( const MultiGridCL& MG, const TwoPhaseFlowCoeffCL& Coeff, MatrixCL& A_pr, IdxDescCL& RowIdx, IdxDescCL& ColIdx, const LevelsetP2CL& lset)
+class PrStiffAccumulator_P1CL : public TetraAccumulatorCL
 {
-    const ExtIdxDescCL& Xidx= RowIdx.GetXidx();
-    MatrixBuilderCL A( &A_pr, RowIdx.NumUnknowns(), ColIdx.NumUnknowns());
-    const Uint lvl= RowIdx.TriangLevel();
-    const Uint idx= RowIdx.GetIdx();
+  private:
+    MatrixCL& A_pr;
+    IdxDescCL& RowIdx;
+    IdxDescCL& ColIdx;
+    const LevelsetP2CL& lset;
+    const double rho_inv_p, rho_inv_n;
+    const bool useXFEM;
+
+    MatrixBuilderCL* A_;
     SMatrixCL<3,4> G;
     double coup[4][4], coupT2[4][4];
-    double det;
-    double absdet;
     IdxT UnknownIdx[4];
     bool sign[4];
     InterfaceTetraCL cut;
+    LocalP2CL<> loc_phi, ones;
 
-    const double rho_inv_p= 1./Coeff.rho(1.),
-                 rho_inv_n= 1./Coeff.rho(-1.);
-    LevelsetP2CL::const_DiscSolCL ls= lset.GetSolution();
-    LocalP2CL<> locallset, ones( 1.);
+    const TwoPhaseTetraContextCL* ctx_; ///< if not 0, the level set is taken from here
+    int tid_;                           ///< clone id for ctx_
 
-    for (MultiGridCL::const_TriangTetraIteratorCL sit= MG.GetTriangTetraBegin( lvl),
-         send= MG.GetTriangTetraEnd( lvl); sit != send; ++sit)
-    {
-        locallset.assign( *sit, ls);
-        cut.Init( *sit, locallset);
-        const bool nocut= !cut.Intersects();
+  public:
+    PrStiffAccumulator_P1CL (const TwoPhaseFlowCoeffCL& Coeff, MatrixCL& A_pr_, IdxDescCL& RowIdx_, IdxDescCL& ColIdx_, const LevelsetP2CL& lset_,
+                             bool XFEM= true, const TwoPhaseTetraContextCL* ctx= 0)
+        : A_pr( A_pr_), RowIdx( RowIdx_), ColIdx( ColIdx_), lset( lset_), rho_inv_p( 1./Coeff.rho( 1.)), rho_inv_n( 1./Coeff.rho( -1.)),
+          useXFEM( XFEM), A_( 0), ones( 1.), ctx_( ctx), tid_( 0) {}
 
-        P1DiscCL::GetGradients( G,det,*sit);
-        absdet= std::fabs( det);
-        double IntRhoInv, IntRhoInv_p;
+    ///\brief Initializes the matrix-builder
+    void begin_accumulation () { A_= new MatrixBuilderCL( &A_pr, RowIdx.NumUnknowns(), ColIdx.NumUnknowns()); }
+    ///\brief Builds the matrix
+    void finalize_accumulation() { A_->Build(); delete A_; }
 
+    void visit (const TetraCL& tet);
 
-        if (nocut) {
-            IntRhoInv_p= cut.GetSign( 0) == 1 ? absdet/6*rho_inv_p : 0;
-            IntRhoInv= absdet/6*(cut.GetSign( 0) == 1 ? rho_inv_p : rho_inv_n);
-        } else {
-            double Vol_p=0, Vol_n=0;
-            for (int ch= 0; ch < 8; ++ch) {
-                cut.ComputeCutForChild( ch);
-                Vol_p+= cut.quad( ones, absdet, true);  // integrate on positive part
-                Vol_n+= cut.quad( ones, absdet, false); // integrate on negative part
-            }
-            IntRhoInv_p= Vol_p*rho_inv_p;
-            IntRhoInv=   Vol_p*rho_inv_p + Vol_n*rho_inv_n;
+    TetraAccumulatorCL* clone (int tid) { PrStiffAccumulator_P1CL* p= new PrStiffAccumulator_P1CL( *this); p->tid_= tid; return p; }
+};
+
+void PrStiffAccumulator_P1CL::visit (const TetraCL& tet)
+{
+    MatrixBuilderCL& A= *A_;
+    const Uint idx= RowIdx.GetIdx();
+    const TwoPhaseTetraDataCL* d= ctx_ != 0 ? ctx_->get( tet, tid_) : 0;
+    if (d != 0)
+        loc_phi= d->ls;
+    else
+        loc_phi.assign( tet, lset.Phi, lset.GetBndData());
+    cut.Init( tet, loc_phi);
+    const bool nocut= !cut.Intersects();
+
+    double det;
+    P1DiscCL::GetGradients( G, det, tet);
+    const double absdet= std::fabs( det);
+    double IntRhoInv, IntRhoInv_p;
+
+    if (nocut) {
+        IntRhoInv_p= cut.GetSign( 0) == 1 ? absdet/6*rho_inv_p : 0;
+        IntRhoInv= absdet/6*(cut.GetSign( 0) == 1 ? rho_inv_p : rho_inv_n);
+    } else {
+        double Vol_p=0, Vol_n=0;
+        for (int ch= 0; ch < 8; ++ch) {
+            cut.ComputeCutForChild( ch);
+            Vol_p+= cut.quad( ones, absdet, true);  // integrate on positive part
+            Vol_n+= cut.quad( ones, absdet, false); // integrate on negative part
         }
+        IntRhoInv_p= Vol_p*rho_inv_p;
+        IntRhoInv=   Vol_p*rho_inv_p + Vol_n*rho_inv_n;
+    }
+    const bool extended= useXFEM && !nocut; // extended basis functions have only support on tetra intersecting Gamma!
 
-        // compute local matrices
-        for(int i=0; i<4; ++i)
+    // compute local matrices
+    for(int i=0; i<4; ++i)
+    {
+        for(int j=0; j<=i; ++j)
         {
-            for(int j=0; j<=i; ++j)
-            {
-                // dot-product of the gradients
-                coup[i][j]= ( G( 0, i)*G( 0, j) + G( 1, i)*G( 1, j) + G( 2, i)*G( 2, j) )*IntRhoInv;
-                coup[j][i]= coup[i][j];
-            }
-            UnknownIdx[i]= sit->GetVertex( i)->Unknowns( idx);
-            if (nocut) continue; // extended basis functions have only support on tetra intersecting Gamma!
+            // dot-product of the gradients
+            coup[i][j]= ( G( 0, i)*G( 0, j) + G( 1, i)*G( 1, j) + G( 2, i)*G( 2, j) )*IntRhoInv;
+            coup[j][i]= coup[i][j];
+        }
+        UnknownIdx[i]= tet.GetVertex( i)->Unknowns( idx);
+        if (!extended) continue;
 
-            sign[i]= cut.GetSign(i)==1;
-            for(int j=0; j<=i; ++j) {
-                // compute the integrals
-                // \int_{T_2} grad_i grad_j dx,    where T_2 = T \cap \Omega_2
-                coupT2[j][i]= ( G( 0, i)*G( 0, j) + G( 1, i)*G( 1, j) + G( 2, i)*G( 2, j) )*IntRhoInv_p;
-                coupT2[i][j]= coupT2[j][i];
-            }
+        sign[i]= cut.GetSign(i)==1;
+        for(int j=0; j<=i; ++j) {
+            // compute the integrals
+            // \int_{T_2} grad_i grad_j dx,    where T_2 = T \cap \Omega_2
+            coupT2[j][i]= ( G( 0, i)*G( 0, j) + G( 1, i)*G( 1, j) + G( 2, i)*G( 2, j) )*IntRhoInv_p;
+            coupT2[i][j]= coupT2[j][i];
         }
+    }
 
-        // write values into matrix
-        for(int i=0; i<4; ++i)
-        {
-            for(int j=0; j<4; ++j)
-                A(UnknownIdx[i], UnknownIdx[j])+= coup[j][i];
-            if (nocut) continue; // extended basis functions have only support on tetra intersecting Gamma!
+    // write values into matrix
+    for(int i=0; i<4; ++i)
+    {
+        for(int j=0; j<4; ++j)
+            A(UnknownIdx[i], UnknownIdx[j])+= coup[j][i];
+        if (!extended) continue;
 
-            const IdxT xidx_i= Xidx[UnknownIdx[i]];
-            for(int j=0; j<4; ++j) // write values for extended basis functions
-            {
-                const IdxT xidx_j= Xidx[UnknownIdx[j]];
-                if (xidx_j!=NoIdx)
-                    A( UnknownIdx[i], xidx_j)+= coupT2[i][j] - sign[j]*coup[i][j];
-                if (xidx_i!=NoIdx)
-                    A( xidx_i, UnknownIdx[j])+= coupT2[i][j] - sign[i]*coup[i][j];
-                if (xidx_i!=NoIdx && xidx_j!=NoIdx && sign[i]==sign[j])
-                    A( xidx_i, xidx_j)+= sign[i] ? coup[i][j] - coupT2[i][j] : coupT2[i][j];
-            }
+        const ExtIdxDescCL& Xidx= RowIdx.GetXidx();
+        const IdxT xidx_i= Xidx[UnknownIdx[i]];
+        for(int j=0; j<4; ++j) // write values for extended basis functions
+        {
+            const IdxT xidx_j= Xidx[UnknownIdx[j]];
+            if (xidx_j!=NoIdx)
+                A( UnknownIdx[i], xidx_j)+= coupT2[i][j] - sign[j]*coup[i][j];
+            if (xidx_i!=NoIdx)
+                A( xidx_i, UnknownIdx[j])+= coupT2[i][j] - sign[i]*coup[i][j];
+            if (xidx_i!=NoIdx && xidx_j!=NoIdx && sign[i]==sign[j])
+                A( xidx_i, xidx_j)+= sign[i] ? coup[i][j] - coupT2[i][j] : coupT2[i][j];
         }
     }
-    A.Build();
+}
+
+void SetupPrStiff_P1( const MultiGridCL& MG, const TwoPhaseFlowCoeffCL& Coeff, MatrixCL& A_pr, IdxDescCL& RowIdx, IdxDescCL& ColIdx, const LevelsetP2CL& lset)
+{
+    PrStiffAccumulator_P1CL p1_accu( Coeff, A_pr, RowIdx, ColIdx, lset, false);
+    TetraAccumulatorTupleCL accus;
+    accus.push_back( &p1_accu);
+    accus( MG.GetTriangTetraBegin( RowIdx.TriangLevel()), MG.GetTriangTetraEnd( RowIdx.TriangLevel()));
+}
+
+void SetupPrStiff_P1X( const MultiGridCL& MG, const TwoPhaseFlowCoeffCL& Coeff, MatrixCL& A_pr, IdxDescCL& RowIdx, IdxDescCL& ColIdx, const LevelsetP2CL& lset)
+{
+    PrStiffAccumulator_P1CL p1x_accu( Coeff, A_pr, RowIdx, ColIdx, lset, true);
+    TetraAccumulatorTupleCL accus;
+    accus.push_back( &p1x_accu);
+    accus( MG.GetTriangTetraBegin( RowIdx.TriangLevel()), MG.GetTriangTetraEnd( RowIdx.TriangLevel()));
 }
 
 
@@ -1177,6 +1246,31 @@ void InstatStokes2PhaseP2P1CL::SetupPrMass( MLMatDescCL* matM, const LevelsetP2C
     }
 }
 
+MLTetraAccumulatorTupleCL&
+InstatStokes2PhaseP2P1CL::prmass_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* matM, const LevelsetP2CL& lset, const MLTwoPhaseTetraContextCL* ctx) const
+/// The pressure levels are matched with the finest levels of accus.
+{
+    if (matM->Data.size() > accus.size())
+        throw DROPSErrCL("InstatStokes2PhaseP2P1CL::prmass_accu: more pressure levels than accumulator levels");
+    const MLTwoPhaseTetraContextCL        ctxs= context_levels( accus, ctx);
+    MLMatrixCL::iterator                   itM= matM->Data.begin();
+    MLIdxDescCL::iterator                itIdx= matM->RowIdx->begin();
+    MLTetraAccumulatorTupleCL::iterator itaccu= accus.begin();
+    MLTwoPhaseTetraContextCL::const_iterator itctx= ctxs.begin();
+    std::advance( itaccu, accus.size() - matM->Data.size());
+    std::advance( itctx,  accus.size() - matM->Data.size());
+    for (; itM != matM->Data.end(); ++itM, ++itIdx, ++itaccu, ++itctx)
+        switch (GetPrFE()) {
+          case P1_FE:
+            itaccu->push_back_acquire( new PrMassAccumulator_P1CL( MG_, Coeff_, *itM, *itIdx, lset, false, *itctx)); break;
+          case P1X_FE:
+            itaccu->push_back_acquire( new PrMassAccumulator_P1CL( MG_, Coeff_, *itM, *itIdx, lset, true,  *itctx)); break;
+          default:
+            throw DROPSErrCL("InstatStokes2PhaseP2P1CL::prmass_accu: not implemented for this FE type");
+        }
+    return accus;
+}
+
 
 void InstatStokes2PhaseP2P1CL::SetupPrStiff( MLMatDescCL* A_pr, const LevelsetP2CL& lset) const
 /// Needed for preconditioning of the Schur complement. Uses natural
@@ -1201,6 +1295,32 @@ void InstatStokes2PhaseP2P1CL::SetupPrStiff( MLMatDescCL* A_pr, const LevelsetP2
     }
 }
 
+MLTetraAccumulatorTupleCL&
+InstatStokes2PhaseP2P1CL::prstiff_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* A_pr, const LevelsetP2CL& lset, const MLTwoPhaseTetraContextCL* ctx) const
+/// The pressure levels are matched with the finest levels of accus.
+{
+    if (A_pr->Data.size() > accus.size())
+        throw DROPSErrCL("InstatStokes2PhaseP2P1CL::prstiff_accu: more pressure levels than accumulator levels");
+    const MLTwoPhaseTetraContextCL        ctxs= context_levels( accus, ctx);
+    MLMatrixCL::iterator                   itM= A_pr->Data.begin();
+    MLIdxDescCL::iterator             itRowIdx= A_pr->RowIdx->begin();
+    MLIdxDescCL::iterator             itColIdx= A_pr->ColIdx->begin();
+    MLTetraAccumulatorTupleCL::iterator itaccu= accus.begin();
+    MLTwoPhaseTetraContextCL::const_iterator itctx= ctxs.begin();
+    std::advance( itaccu, accus.size() - A_pr->Data.size());
+    std::advance( itctx,  accus.size() - A_pr->Data.size());
+    for (; itM != A_pr->Data.end(); ++itM, ++itRowIdx, ++itColIdx, ++itaccu, ++itctx)
+        switch (GetPrFE()) {
+          case P1_FE:
+            itaccu->push_back_acquire( new PrStiffAccumulator_P1CL( Coeff_, *itM, *itRowIdx, *itColIdx, lset, false, *itctx)); break;
+          case P1X_FE:
+            itaccu->push_back_acquire( new PrStiffAccumulator_P1CL( Coeff_, *itM, *itRowIdx, *itColIdx, lset, true,  *itctx)); break;
+          default:
+            throw DROPSErrCL("InstatStokes2PhaseP2P1CL::prstiff_accu: not implemented for this FE type");
+        }
+    return accus;
+}
+
 
 void InstatStokes2PhaseP2P1CL::InitVel(VelVecDescCL* vec, instat_vector_fun_ptr LsgVel, double t0) const
 {
@@ -1315,16 +1435,23 @@ class LocalSystem1TwoPhase_P2CL
     double rho (int sign) const { return sign > 0 ? rho_p : rho_n; }
 
     void setup (const SMatrixCL<3,3>& T, double absdet, const LocalP2CL<>& ls, LocalSystem1DataCL& loc);
+    /// \brief Same as above with the partition of the principal lattice of degree 2 given.
+    void setup (const SMatrixCL<3,3>& T, double absdet, const TetraPartitionCL& p, LocalSystem1DataCL& loc);
 };
 
 void LocalSystem1TwoPhase_P2CL::setup (const SMatrixCL<3,3>& T, double absdet, const LocalP2CL<>& ls, LocalSystem1DataCL& loc)
 {
-    P2DiscCL::GetGradients( GradLP1, GradRefLP1, T);
-
     evaluate_on_vertexes( ls, lat, Addr( ls_loc));
     partition.make_partition<SortedVertexPolicyCL, MergeCutPolicyCL>( lat, ls_loc);
-    make_CompositeQuad5Domain( q5dom, partition);
-    make_CompositeQuad2Domain( q2dom, partition);
+    setup( T, absdet, partition, loc);
+}
+
+void LocalSystem1TwoPhase_P2CL::setup (const SMatrixCL<3,3>& T, double absdet, const TetraPartitionCL& p, LocalSystem1DataCL& loc)
+{
+    P2DiscCL::GetGradients( GradLP1, GradRefLP1, T);
+
+    make_CompositeQuad5Domain( q5dom, p);
+    make_CompositeQuad2Domain( q2dom, p);
     double phi_neg, phi_pos;
     for (int i= 0; i < 10; ++i) {
         p2[i]= 1.; p2[i==0 ? 9 : i - 1]= 0.;
@@ -1382,6 +1509,9 @@ class System1Accumulator_P2CL : public TetraAccumulatorCL
     Quad2CL<Point3DCL> rhs;
     Point3DCL loc_b[10], dirichlet_val[10]; ///< Used to transfer boundary-values from local_setup() update_global_system().
 
+    const TwoPhaseTetraContextCL* ctx_; ///< if not 0, the geometry, the level set and its partition are taken from here
+    int tid_;                           ///< clone id for ctx_
+
     ///\brief Computes the mapping from local to global data "n", the local matrices in loc and, if required, the Dirichlet-values needed to eliminate the boundary-dof from the global system.
     void local_setup (const TetraCL& tet);
     ///\brief Update the global system.
@@ -1390,7 +1520,7 @@ class System1Accumulator_P2CL : public TetraAccumulatorCL
   public:
     System1Accumulator_P2CL (const TwoPhaseFlowCoeffCL& Coeff, const StokesBndDataCL& BndData_,
         const LevelsetP2CL& ls, IdxDescCL& RowIdx_, MatrixCL& A_, MatrixCL& M_,
-        VecDescCL* b_, VecDescCL* cplA_, VecDescCL* cplM_, double t);
+        VecDescCL* b_, VecDescCL* cplA_, VecDescCL* cplM_, double t, const TwoPhaseTetraContextCL* ctx= 0);
 
     ///\brief Initializes matrix-builders and load-vectors
     void begin_accumulation ();
@@ -1399,15 +1529,16 @@ class System1Accumulator_P2CL : public TetraAccumulatorCL
 
     void visit (const TetraCL& sit);
 
-    TetraAccumulatorCL* clone (int /*tid*/) { return new System1Accumulator_P2CL ( *this); };
+    TetraAccumulatorCL* clone (int tid) { System1Accumulator_P2CL* p= new System1Accumulator_P2CL ( *this); p->tid_= tid; return p; };
 };
 
 System1Accumulator_P2CL::System1Accumulator_P2CL (const TwoPhaseFlowCoeffCL& Coeff_, const StokesBndDataCL& BndData_,
     const LevelsetP2CL& lset_arg, IdxDescCL& RowIdx_, MatrixCL& A_, MatrixCL& M_,
-    VecDescCL* b_, VecDescCL* cplA_, VecDescCL* cplM_, double t_)
+    VecDescCL* b_, VecDescCL* cplA_, VecDescCL* cplM_, double t_, const TwoPhaseTetraContextCL* ctx)
     : Coeff( Coeff_), BndData( BndData_), lset( lset_arg), t( t_),
       RowIdx( RowIdx_), A( A_), M( M_), cplA( cplA_), cplM( cplM_), b( b_),
-      local_twophase( Coeff.mu( 1.0), Coeff.mu( -1.0), Coeff.rho( 1.0), Coeff.rho( -1.0))
+      local_twophase( Coeff.mu( 1.0), Coeff.mu( -1.0), Coeff.rho( 1.0), Coeff.rho( -1.0)),
+      ctx_( ctx), tid_( 0)
 {}
 
 void System1Accumulator_P2CL::begin_accumulation ()
@@ -1444,18 +1575,29 @@ void System1Accumulator_P2CL::visit (const TetraCL& tet)
 
 void System1Accumulator_P2CL::local_setup (const TetraCL& tet)
 {
-    GetTrafoTr( T, det, tet);
-    absdet= std::fabs( det);
+    const TwoPhaseTetraDataCL* d= ctx_ != 0 ? ctx_->get( tet, tid_) : 0;
+    if (d != 0) {
+        T= d->T;
+        det= d->det;
+        absdet= d->absdet;
+        ls_loc= d->ls;
+    }
+    else {
+        GetTrafoTr( T, det, tet);
+        absdet= std::fabs( det);
+        ls_loc.assign( tet, lset.Phi, lset.GetBndData());
+    }
 
     rhs.assign( tet, Coeff.volforce, t);
     n.assign( tet, RowIdx, BndData.Vel);
 
-    ls_loc.assign( tet, lset.Phi, lset.GetBndData());
-    if (equal_signs( ls_loc)) {
+    if (d != 0 ? !d->cut : equal_signs( ls_loc)) {
         local_onephase.mu(  local_twophase.mu(  sign( ls_loc[0])));
         local_onephase.rho( local_twophase.rho( sign( ls_loc[0])));
         local_onephase.setup( T, absdet, loc);
     }
+    else if (d != 0)
+        local_twophase.setup( T, absdet, ctx_->partition( tid_).partition, loc);
     else
         local_twophase.setup( T, absdet, ls_loc, loc);
     add_transpose_kronecker_id( loc.Ak, loc.A);
@@ -1497,8 +1639,8 @@ void System1Accumulator_P2CL::update_global_system ()
 }
 
 void SetupSystem1_P2( const MultiGridCL& MG_, const TwoPhaseFlowCoeffCL& Coeff_, const StokesBndDataCL& BndData_, MatrixCL& A, MatrixCL& M,
-                      VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM, const LevelsetP2CL& lset, IdxDescCL& RowIdx, double t)
-/// Set up matrices A, M and rhs b (depending on phase bnd)
+                      VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM, const LevelsetP2CL& lset, IdxDescCL& RowIdx, double t, TetraCostCL* cost= 0)
+/// Set up matrices A, M and rhs b (depending on phase bnd); if cost!=0, the time spent for each tetra is recorded there
 {
     // TimerCL time;
     // time.Start();
@@ -1506,6 +1648,7 @@ void SetupSystem1_P2( const MultiGridCL& MG_, const TwoPhaseFlowCoeffCL& Coeff_,
     System1Accumulator_P2CL accu( Coeff_, BndData_, lset, RowIdx, A, M, b, cplA, cplM, t);
     TetraAccumulatorTupleCL accus;
     accus.push_back( &accu);
+    accus.set_cost_recorder( cost);
     accumulate( accus, MG_, RowIdx.TriangLevel(), RowIdx.GetMatchingFunction(), RowIdx.GetBndInfo());
     // time.Stop();
     // std::cout << "setup: " << time.GetTime() << " seconds" << std::endl;
@@ -1818,7 +1961,7 @@ void InstatStokes2PhaseP2P1CL::SetupSystem1( MLMatDescCL* A, MLMatDescCL* M, Vec
     MLIdxDescCL::iterator it = A->RowIdx->begin();
     for (size_t lvl=0; lvl < A->Data.size(); ++lvl, ++itA, ++itM, ++it)
         if (it->GetFE()==vecP2_FE)
-            SetupSystem1_P2 ( MG_, Coeff_, BndData_, *itA, *itM, lvl == A->Data.size()-1 ? b : 0, cplA, cplM, lset, *it, t);
+            SetupSystem1_P2 ( MG_, Coeff_, BndData_, *itA, *itM, lvl == A->Data.size()-1 ? b : 0, cplA, cplM, lset, *it, t, lvl == A->Data.size()-1 ? cost_ : 0);
         else if (it->GetFE()==vecP2R_FE)
             SetupSystem1_P2R( MG_, Coeff_, BndData_, *itA, *itM, lvl == A->Data.size()-1 ? b : 0, cplA, cplM, lset, *it, t);
         else
@@ -1826,17 +1969,19 @@ void InstatStokes2PhaseP2P1CL::SetupSystem1( MLMatDescCL* A, MLMatDescCL* M, Vec
 }
 
 MLTetraAccumulatorTupleCL&
-InstatStokes2PhaseP2P1CL::system1_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* A, MLMatDescCL* M, VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM, const LevelsetP2CL& lset, double t) const
+InstatStokes2PhaseP2P1CL::system1_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* A, MLMatDescCL* M, VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM, const LevelsetP2CL& lset, double t, const MLTwoPhaseTetraContextCL* ctx) const
 {
+    const MLTwoPhaseTetraContextCL        ctxs= context_levels( accus, ctx);
     MLMatrixCL::iterator                   itA= A->Data.begin();
     MLMatrixCL::iterator                   itM= M->Data.begin();
     MLIdxDescCL::iterator                   it= A->RowIdx->begin();
     MLTetraAccumulatorTupleCL::iterator itaccu= accus.begin();
-    for (size_t lvl= 0; lvl < A->Data.size(); ++lvl, ++itA, ++itM, ++it, ++itaccu)
+    MLTwoPhaseTetraContextCL::const_iterator itctx= ctxs.begin();
+    for (size_t lvl= 0; lvl < A->Data.size(); ++lvl, ++itA, ++itM, ++it, ++itaccu, ++itctx)
         switch (it->GetFE()) {
           case vecP2_FE:
             itaccu->push_back_acquire( new System1Accumulator_P2CL( GetCoeff(), GetBndData(), lset,
-                *it, *itA, *itM, lvl == A->Data.size() - 1 ? b : 0, cplA, cplM, t));
+                *it, *itA, *itM, lvl == A->Data.size() - 1 ? b : 0, cplA, cplM, t, *itctx));
             break;
 
           default:
@@ -2164,6 +2309,9 @@ class LBAccumulator_P2CL : public TetraAccumulatorCL
 
     Point3DCL dirichlet_val[10];
 
+    const TwoPhaseTetraContextCL* ctx_; ///< if not 0, the geometry and the level set are taken from here
+    int tid_;                           ///< clone id for ctx_
+
     ///\brief Computes the mapping from local to global data "n", the local matrices in loc and, if required, the Dirichlet-values needed to eliminate the boundary-dof from the global system.
     void local_setup (const TetraCL& tet);
     ///\brief Update the global system.
@@ -2171,7 +2319,7 @@ class LBAccumulator_P2CL : public TetraAccumulatorCL
 
   public:
     LBAccumulator_P2CL (const TwoPhaseFlowCoeffCL& Coeff, const StokesBndDataCL& BndData_,
-        const LevelsetP2CL& ls, IdxDescCL& RowIdx_, MatrixCL& A_, VecDescCL* cplA_, double t );
+        const LevelsetP2CL& ls, IdxDescCL& RowIdx_, MatrixCL& A_, VecDescCL* cplA_, double t, const TwoPhaseTetraContextCL* ctx= 0);
 
     ///\brief Initializes matrix-builders and load-vectors
     void begin_accumulation ();
@@ -2180,13 +2328,13 @@ class LBAccumulator_P2CL : public TetraAccumulatorCL
 
     void visit (const TetraCL& sit);
 
-    TetraAccumulatorCL* clone (int /*tid*/) { return new LBAccumulator_P2CL ( *this); };
+    TetraAccumulatorCL* clone (int tid) { LBAccumulator_P2CL* p= new LBAccumulator_P2CL ( *this); p->tid_= tid; return p; };
 };
 
 LBAccumulator_P2CL::LBAccumulator_P2CL (const TwoPhaseFlowCoeffCL& Coeff_, const StokesBndDataCL& BndData_,
-    const LevelsetP2CL& lset_arg, IdxDescCL& RowIdx_, MatrixCL& A_, VecDescCL* cplA_, double t_)
+    const LevelsetP2CL& lset_arg, IdxDescCL& RowIdx_, MatrixCL& A_, VecDescCL* cplA_, double t_, const TwoPhaseTetraContextCL* ctx)
     : Coeff( Coeff_), BndData( BndData_), lset( lset_arg), t( t_), 
-      RowIdx( RowIdx_), A( A_), cplA( cplA_), local_twophase( Coeff.SurfTens)
+      RowIdx( RowIdx_), A( A_), cplA( cplA_), local_twophase( Coeff.SurfTens), ctx_( ctx), tid_( 0)
 {}
 
 void LBAccumulator_P2CL::begin_accumulation ()
@@ -2211,7 +2359,11 @@ void LBAccumulator_P2CL::finalize_accumulation ()
 
 void LBAccumulator_P2CL::visit (const TetraCL& tet)
 {
-    ls_loc.assign( tet, lset.Phi, lset.GetBndData());
+    const TwoPhaseTetraDataCL* d= ctx_ != 0 ? ctx_->get( tet, tid_) : 0;
+    if (d != 0)
+        ls_loc= d->ls;
+    else
+        ls_loc.assign( tet, lset.Phi, lset.GetBndData());
 
     if (!equal_signs( ls_loc)) 
     {
@@ -2223,7 +2375,11 @@ void LBAccumulator_P2CL::visit (const TetraCL& tet)
 
 void LBAccumulator_P2CL::local_setup (const TetraCL& tet)
 {
-    GetTrafoTr( T, det, tet);
+    const TwoPhaseTetraDataCL* d= ctx_ != 0 ? ctx_->get( tet, tid_) : 0;
+    if (d != 0)
+        T= d->T;
+    else
+        GetTrafoTr( T, det, tet);
 
     n.assign( tet, RowIdx, BndData.Vel);
     local_twophase.setup( T, ls_loc, tet, locA);
@@ -2278,6 +2434,20 @@ void InstatStokes2PhaseP2P1CL::SetupLB (MLMatDescCL* A, VecDescCL* cplA, const L
 
 }
 
+MLTetraAccumulatorTupleCL&
+InstatStokes2PhaseP2P1CL::lb_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* A, VecDescCL* cplA, const LevelsetP2CL& lset, double t, const MLTwoPhaseTetraContextCL* ctx) const
+{
+    const MLTwoPhaseTetraContextCL        ctxs= context_levels( accus, ctx);
+    MLMatrixCL::iterator                   itA= A->Data.begin();
+    MLIdxDescCL::iterator                   it= A->RowIdx->begin();
+    MLTetraAccumulatorTupleCL::iterator itaccu= accus.begin();
+    MLTwoPhaseTetraContextCL::const_iterator itctx= ctxs.begin();
+    for (size_t lvl= 0; lvl < A->Data.size(); ++lvl, ++itA, ++it, ++itaccu, ++itctx)
+        itaccu->push_back_acquire( new LBAccumulator_P2CL( Coeff_, BndData_, lset, *it, *itA,
+            lvl == A->Data.size() - 1 ? cplA : 0, t, *itctx));
+    return accus;
+}
+
 
 void InstatStokes2PhaseP2P1CL::SetupSystem2( MLMatDescCL* B, VecDescCL* c, const LevelsetP2CL& lset, double t) const
 // Set up matrix B and rhs c
@@ -2331,21 +2501,24 @@ void InstatStokes2PhaseP2P1CL::SetupSystem2( MLMatDescCL* B, VecDescCL* c, const
 }
 
 MLTetraAccumulatorTupleCL&
-InstatStokes2PhaseP2P1CL::system2_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* B, VecDescCL* c, const LevelsetP2CL& lset, double t) const
+InstatStokes2PhaseP2P1CL::system2_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* B, VecDescCL* c, const LevelsetP2CL& lset, double t, const MLTwoPhaseTetraContextCL* ctx) const
 // Set up matrix B and rhs c
 {
+    const MLTwoPhaseTetraContextCL     ctxs  = context_levels( accus, ctx);
     MLMatrixCL::iterator                itB   = B->Data.begin();
     MLIdxDescCL::iterator               itRow = B->RowIdx->begin();
     MLIdxDescCL::iterator               itCol = B->ColIdx->begin();
     MLTetraAccumulatorTupleCL::iterator itaccu= accus.begin();
+    MLTwoPhaseTetraContextCL::const_iterator itctx= ctxs.begin();
     if ( B->RowIdx->size() == 1 || B->ColIdx->size() == 1)
     { // setup B only on finest level, if row or column index has only 1 level
         itCol = B->ColIdx->GetFinestIter();
         itRow = B->RowIdx->GetFinestIter();
         itB   = B->Data.GetFinestIter();
         itaccu= accus.GetFinestIter();
+        itctx = ctxs.GetFinestIter();
     }
-    for (; itB!=B->Data.end() && itRow!=B->RowIdx->end() && itCol!=B->ColIdx->end(); ++itB, ++itRow, ++itCol, ++itaccu)
+    for (; itB!=B->Data.end() && itRow!=B->RowIdx->end() && itCol!=B->ColIdx->end(); ++itB, ++itRow, ++itCol, ++itaccu, ++itctx)
     {
 #ifndef _PAR
         std::cout << "entering SetupSystem2: " << itRow->NumUnknowns() << " prs, " << itCol->NumUnknowns() << " vels. ";
@@ -2357,7 +2530,7 @@ InstatStokes2PhaseP2P1CL::system2_accu (MLTetraAccumulatorTupleCL& accus, MLMatD
                     itaccu->push_back_acquire( new System2Accumulator_P2P1CL<TwoPhaseFlowCoeffCL>( Coeff_, BndData_, *itRow, *itCol, *itB, rhsPtr, t));
                     break;
                 case P1X_FE:
-                    itaccu->push_back_acquire( new System2Accumulator_P2P1XCL(Coeff_, BndData_, lset, *itRow, *itCol, *itB, rhsPtr, t));
+                    itaccu->push_back_acquire( new System2Accumulator_P2P1XCL(Coeff_, BndData_, lset, *itRow, *itCol, *itB, rhsPtr, t, *itctx));
                     break;
                 default:
                     throw DROPSErrCL("InstatStokes2PhaseP2P1CL<Coeff>::SetupSystem2 not implemented for this pressure FE type");
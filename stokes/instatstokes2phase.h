@@ -133,6 +133,65 @@ class TwoPhaseFlowCoeffCL
         }
 };
 
+/// \brief Local data of a tetra, which are shared by the accumulators of one sweep, see TwoPhaseTetraContextCL.
+struct TwoPhaseTetraDataCL
+{
+    const TetraCL*        tet;       ///< the tetra, to which the data belong; 0, if invalid
+    SMatrixCL<3,3>        T;         ///< as computed by GetTrafoTr
+    double                det, absdet;
+    LocalP2CL<>           ls;        ///< local level set function
+    bool                  cut;       ///< true, if ls has no common sign in the P2-dof
+    std::valarray<double> ls_lat;    ///< ls on the vertexes of PrincipalLatticeCL::instance( 2); valid, if has_partition
+    TetraPartitionCL      partition; ///< partition of this lattice; valid, if has_partition
+    bool                  has_partition;
+
+    TwoPhaseTetraDataCL () : tet( 0), det( 0.), absdet( 0.), cut( false), ls_lat( 10), has_partition( false) {}
+};
+
+/// \brief Computes the geometry and the local level set of each tetra once for all accumulators of a sweep.
+///
+/// Register the context in front of the accumulators, which use it. The data are kept per thread:
+/// The clone with clone_id tid writes slot tid, which is read by the accumulators cloned with the
+/// same id. The partition of the principal lattice of degree 2 is only computed on request.
+/// Accumulators without a context compute these data themselves.
+class TwoPhaseTetraContextCL : public TetraAccumulatorCL
+{
+  private:
+    const LevelsetP2CL& lset_;
+    std::vector<TwoPhaseTetraDataCL>* data_; ///< one slot per thread; shared by all clones
+    int  tid_;
+    bool owner_;
+
+  public:
+    TwoPhaseTetraContextCL (const LevelsetP2CL& lset)
+        : lset_( lset), data_( new std::vector<TwoPhaseTetraDataCL>( 1)), tid_( 0), owner_( true) {}
+    ~TwoPhaseTetraContextCL () { if (owner_) delete data_; }
+
+    void begin_accumulation ();
+    void visit (const TetraCL& tet);
+    TetraAccumulatorCL* clone (int tid);
+
+    /// \brief The data of tet for the clone id tid; 0, if tet is not the tetra visited last by this clone.
+    const TwoPhaseTetraDataCL* get (const TetraCL& tet, int tid) const {
+        const TwoPhaseTetraDataCL& d= (*data_)[tid];
+        return d.tet == &tet ? &d : 0;
+    }
+    /// \brief The data of the tetra visited last by the clone tid with ls_lat and partition; these are computed on first use.
+    const TwoPhaseTetraDataCL& partition (int tid) const;
+};
+
+/// \brief The contexts of the levels of a MLTetraAccumulatorTupleCL, see InstatStokes2PhaseP2P1CL::context_accu.
+typedef MLDataCL<const TwoPhaseTetraContextCL*> MLTwoPhaseTetraContextCL;
+
+/// \brief The contexts for the levels of accus; all entries are 0, if ctx == 0.
+inline MLTwoPhaseTetraContextCL
+context_levels (const MLTetraAccumulatorTupleCL& accus, const MLTwoPhaseTetraContextCL* ctx)
+{
+    if (ctx != 0 && ctx->size() != accus.size())
+        throw DROPSErrCL( "context_levels: The contexts do not match the levels of the accumulators");
+    return ctx != 0 ? *ctx : MLTwoPhaseTetraContextCL( accus.size(), 0);
+}
+
 /// problem class for instationary two-pase Stokes flow
 
 
@@ -165,11 +224,14 @@ class InstatStokes2PhaseP2P1CL : public ProblemCL<TwoPhaseFlowCoeffCL, StokesBnd
                  prA,
                  prM;
 
+  protected:
+    TetraCostCL* cost_; ///< if not 0, the cost of each tetra of the finest level is recorded here during the assembly of A and M
+
   public:
     InstatStokes2PhaseP2P1CL( const MGBuilderCL& mgb, const TwoPhaseFlowCoeffCL& coeff, const BndDataCL& bdata, FiniteElementT prFE= P1_FE, double XFEMstab=0.1, FiniteElementT velFE= vecP2_FE)
-        : base_(mgb, coeff, bdata), vel_idx(velFE, 1, bdata.Vel, 0, XFEMstab), pr_idx(prFE, 1, bdata.Pr, 0, XFEMstab) {}
+        : base_(mgb, coeff, bdata), vel_idx(velFE, 1, bdata.Vel, 0, XFEMstab), pr_idx(prFE, 1, bdata.Pr, 0, XFEMstab), cost_( 0) {}
     InstatStokes2PhaseP2P1CL( MultiGridCL& mg, const TwoPhaseFlowCoeffCL& coeff, const BndDataCL& bdata, FiniteElementT prFE= P1_FE, double XFEMstab=0.1, FiniteElementT velFE= vecP2_FE)
-        : base_(mg, coeff, bdata),  vel_idx(velFE, 1, bdata.Vel, 0, XFEMstab), pr_idx(prFE, 1, bdata.Pr, 0, XFEMstab) {}
+        : base_(mg, coeff, bdata),  vel_idx(velFE, 1, bdata.Vel, 0, XFEMstab), pr_idx(prFE, 1, bdata.Pr, 0, XFEMstab), cost_( 0) {}
 
     /// \name Numbering
     //@{
@@ -196,22 +258,29 @@ class InstatStokes2PhaseP2P1CL : public ProblemCL<TwoPhaseFlowCoeffCL, StokesBnd
     bool UsesXFEM() const { return pr_idx.GetFinest().IsExtended(); }
     /// Set up matrices A, M and rhs b (depending on phase bnd)
     void SetupSystem1( MLMatDescCL* A, MLMatDescCL* M, VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM, const LevelsetP2CL& lset, double t) const;
-    MLTetraAccumulatorTupleCL& system1_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* A, MLMatDescCL* M, VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM, const LevelsetP2CL& lset, double t) const;
+    MLTetraAccumulatorTupleCL& system1_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* A, MLMatDescCL* M, VecDescCL* b, VecDescCL* cplA, VecDescCL* cplM, const LevelsetP2CL& lset, double t, const MLTwoPhaseTetraContextCL* ctx= 0) const;
+    /// \brief Record the time spent in SetupSystem1 for each tetra of the finest level in c, e.g. for the load balancing; c==0 turns the recording off.
+    void SetCostRecorder (TetraCostCL* c) { cost_= c; }
     /// Set up rhs b (depending on phase bnd)
     void SetupRhs1( VecDescCL* b, const LevelsetP2CL& lset, double t) const;
     /// Set up the Laplace-Beltrami-Operator
     void SetupLB( MLMatDescCL* A, VecDescCL* cplA, const LevelsetP2CL& lset, double t) const;
+    MLTetraAccumulatorTupleCL& lb_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* A, VecDescCL* cplA, const LevelsetP2CL& lset, double t, const MLTwoPhaseTetraContextCL* ctx= 0) const;
     /// Set up matrix B and rhs c
     void SetupSystem2( MLMatDescCL* B, VecDescCL* c, const LevelsetP2CL& lset, double t) const;
-    MLTetraAccumulatorTupleCL& system2_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* B, VecDescCL* c, const LevelsetP2CL& lset, double t) const;
+    MLTetraAccumulatorTupleCL& system2_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* B, VecDescCL* c, const LevelsetP2CL& lset, double t, const MLTwoPhaseTetraContextCL* ctx= 0) const;
     /// Set up rhs c
     void SetupRhs2( VecDescCL* c, const LevelsetP2CL& lset, double t) const;
     /// Set up the time-derivative of B times velocity
     void SetupBdotv (VecDescCL* Bdotv, const VelVecDescCL* vel, const LevelsetP2CL& lset, double t) const;
     /// Set up the mass matrix for the pressure, scaled by \f$\mu^{-1}\f$.
     void SetupPrMass( MLMatDescCL* prM, const LevelsetP2CL& lset) const;
+    MLTetraAccumulatorTupleCL& prmass_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* prM, const LevelsetP2CL& lset, const MLTwoPhaseTetraContextCL* ctx= 0) const;
     /// Set up the stiffness matrix for the pressure, scaled by \f$\rho^{-1}\f$.
     void SetupPrStiff(MLMatDescCL* prA, const LevelsetP2CL& lset) const;
+    MLTetraAccumulatorTupleCL& prstiff_accu (MLTetraAccumulatorTupleCL& accus, MLMatDescCL* prA, const LevelsetP2CL& lset, const MLTwoPhaseTetraContextCL* ctx= 0) const;
+    /// \brief Register a TwoPhaseTetraContextCL on each level of accus; call this before registering the accumulators, which receive ctx.
+    MLTetraAccumulatorTupleCL& context_accu (MLTetraAccumulatorTupleCL& accus, MLTwoPhaseTetraContextCL& ctx, const LevelsetP2CL& lset) const;
     //@}
 
     /// Initialize velocity field
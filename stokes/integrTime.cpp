@@ -41,6 +41,20 @@ static void Regularize (MatrixCL& Bs, const IdxDescCL& rowidx, VectorCL ker0, co
 }
 #endif
 
+// Copy B to Bs. For a refresh, the pattern of B is unchanged and only the values are copied into
+// the existing Bs. A regularized Bs has an additional column and is always copied entirely.
+static void CopyToScaled (const MatrixCL& B, MatrixCL*& Bs, bool refresh)
+{
+    if (refresh && Bs != 0 && Bs->num_cols() == B.num_cols() && Bs->num_nonzeros() == B.num_nonzeros()) {
+        std::copy( B.raw_val(), B.raw_val() + B.num_nonzeros(), Bs->raw_val());
+        Bs->IncrementVersion();
+    }
+    else {
+        delete Bs;
+        Bs= new MatrixCL( B);
+    }
+}
+
 void ISMGPreCL::MaybeInitOnes() const
 {
     if (Mpr_.size() == ones_.size()) return;
@@ -53,13 +67,13 @@ void ISMGPreCL::MaybeInitOnes() const
     }
 }
 
-void ISBBTPreCL::Update() const
+void ISBBTPreCL::Update(bool refresh) const
 {
     IF_MASTER
       std::cout << "ISBBTPreCL::Update: old version: " << Bversion_
-                << "\tnew version: " << B_->Version() << '\n';
-    delete Bs_;
-    Bs_= new MatrixCL( *B_);
+                << "\tnew version: " << B_->Version() << (refresh ? "\t(refresh)" : "") << '\n';
+    refresh= refresh && Bs_ != 0 && Bs_->num_cols() == B_->num_cols();
+    CopyToScaled( *B_, Bs_, refresh);
     Bversion_= B_->Version();
 
 #ifndef _PAR
@@ -85,17 +99,30 @@ void ISBBTPreCL::Update() const
 #ifndef _PAR
     if (regularize_ != 0.)
         Regularize( *Bs_, *pr_idx_, Dprsqrt, spc_, regularize_);
+
+    if (explicit_) {
+        if (refresh) { // Bs^T and Bs*Bs^T keep their patterns, only the values are recomputed
+            SparseMatBuilderCL<double> BsT( &BsT_, Bs_->num_cols(), Bs_->num_rows(), /*reuse*/ true);
+            for (size_t i= 0; i < Bs_->num_rows(); ++i)
+                for (size_t nz= Bs_->row_beg( i); nz < Bs_->row_beg( i + 1); ++nz)
+                    BsT( Bs_->col_ind( nz), i)= Bs_->val( nz);
+            BsBsT_.MatMulValues( *Bs_, BsT_);
+        }
+        else {
+            transpose( *Bs_, BsT_);
+            BsBsT_.MatMul( *Bs_, BsT_);
+        }
+    }
 #endif
 }
 
 #ifndef _PAR
-void MinCommPreCL::Update() const
+void MinCommPreCL::Update(bool refresh) const
 {
     std::cout << "MinCommPreCL::Update: old/new versions: " << Aversion_  << '/' << A_->Version()
         << '\t' << Bversion_ << '/' << B_->Version() << '\t' << Mversion_ << '/' << M_->Version()
         << '\t' << Mvelversion_ << '/' << Mvel_->Version() << '\n';
-    delete Bs_;
-    Bs_= new MatrixCL( *B_);
+    CopyToScaled( *B_, Bs_, refresh);
     Aversion_= A_->Version();
     Bversion_= B_->Version();
     Mversion_= M_->Version();
@@ -118,13 +145,12 @@ void MinCommPreCL::Update() const
 }
 
 
-void BDinvBTPreCL::Update() const
+void BDinvBTPreCL::Update(bool refresh) const
 {
     std::cout << "BDinvBTPreCL::Update: old/new versions: " << Lversion_  << '/' << L_->Version()
         << '\t' << Bversion_ << '/' << B_->Version() << '\t' << Mversion_ << '/' << M_->Version()
         << '\t' << Mvelversion_ << '/' << Mvel_->Version() << '\n';
-    delete Bs_;
-    Bs_= new MatrixCL( *B_);
+    CopyToScaled( *B_, Bs_, refresh);
     Lversion_= L_->Version();
     Bversion_= B_->Version();
     Mversion_= M_->Version();
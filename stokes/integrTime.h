@@ -28,6 +28,8 @@
 #include "stokes/stokes.h"
 #include "num/MGsolver.h"
 #include "num/spblockmat.h"
+#include "num/initialguess.h"
+#include "num/pclifecycle.h"
 #ifdef _PAR
 # include "num/parprecond.h"
 # include "num/parsolver.h"
@@ -48,6 +50,7 @@ class TimeDiscStokesCL
     VelVecDescCL *_cplM, *_old_cplM;  // couplings with mass matrix M
     VectorCL      _rhs;
     MLMatrixCL    _mat;               // M + theta*dt*A
+    InitialGuessCL _guess;            // history of (v,p) for the initial guess
 
     double _theta, _dt;
 
@@ -79,6 +82,9 @@ class TimeDiscStokesCL
     /// \brief Get reference on solver
     SolverT& GetSolver()       { return _solver; }
 
+    /// \brief Get reference on the history for the initial guess of (v,p); switched off by default.
+    InitialGuessCL& GetInitialGuess() { return _guess; }
+
     virtual void SetTimeStep( double dt)= 0;
 
     virtual void SetTimeStep( double dt, double theta)= 0;
@@ -112,6 +118,7 @@ class InstatStokesThetaSchemeCL : public TimeDiscStokesCL< StokesT, SolverT>
     using base_:: _cplM;     using base_::_old_cplM;  // couplings with mass matrix M
     using base_:: _rhs;
     using base_:: _mat;               // M + theta*dt*A
+    using base_:: _guess;
 
     using base_:: _theta;    using base_:: _dt;
 
@@ -198,11 +205,17 @@ class SchurPreBaseCL: public PreBaseCL
   protected:
     double kA_,   ///< scaling factor for pressure stiffness matrix or equivalent
            kM_;   ///< scaling factor for pressure mass matrix
+    mutable PcLifecycleCL lifecycle_; ///< decides on the update, if the matrices have changed
 
   public:
     SchurPreBaseCL( double kA, double kM, std::ostream* output=0) : PreBaseCL( output), kA_( kA), kM_( kM) {}
     virtual ~SchurPreBaseCL() {}
     void SetWeights( double kA, double kM) { kA_ = kA; kM_ = kM; }
+    double GetKA() const { return kA_; }
+    double GetKM() const { return kM_; }
+    /// policy for the update of preconditioners which depend on changing matrices
+    PcLifecycleCL&       GetLifecycle()       { return lifecycle_; }
+    const PcLifecycleCL& GetLifecycle() const { return lifecycle_; }
 
     virtual void Apply( const MatrixCL& A,   VectorCL& x, const VectorCL& b) const = 0;
     virtual void Apply( const MLMatrixCL& A, VectorCL& x, const VectorCL& b) const = 0;
@@ -390,6 +403,10 @@ class ISBBTPreCL : public SchurPreBaseCL
     JACPcCL          jacpc_;
     mutable PCGNESolverCL<SPcT_> solver_;
     mutable PCGSolverCL<JACPcCL> solver2_;
+    bool             explicit_;                                 ///< form Bs*Bs^T explicitly instead of applying Bs and Bs^T in each step
+    mutable MatrixCL BsT_, BsBsT_;                              ///< Bs^T and Bs*Bs^T, if explicit_ is set
+    SSORPcCL         ssorpc_;
+    mutable PCGSolverCL<SSORPcCL> explsolver_;                  ///< solver for the explicit Bs*Bs^T
 #else
     mutable CompositeMatrixCL BBT_;
     typedef ParJacNEG0CL    PCSolver1T;                         ///< type of the preconditioner for solver 1
@@ -403,7 +420,14 @@ class ISBBTPreCL : public SchurPreBaseCL
 #endif
     const IdxDescCL* pr_idx_;                                   ///< Accessing ExchangeCL for pressure; also used to determine, how to represent the kernel of BB^T in case of pure Dirichlet-BCs.
     double regularize_;                                         ///< If regularize_==0. no regularization is performed. Otherwise, a column is attached to Bs.
-    void Update () const;                                       ///< Updating the diagonal matrices D and Dprsqrtinv
+    void Update (bool refresh= false) const;                    ///< Updating the diagonal matrices D and Dprsqrtinv; refresh: the pattern of B is unchanged
+    void MaybeUpdate () const {                                 ///< Update according to the lifecycle policy
+        const PcLifecycleCL::ActionT a= lifecycle_.Decide( "ISBBTPreCL", B_->Version(), *B_);
+        if (a < PcLifecycleCL::PC_Refresh) return;
+        lifecycle_.BeginUpdate();
+        Update( a == PcLifecycleCL::PC_Refresh);
+        lifecycle_.EndUpdate( a, B_->Version(), *B_);
+    }
 
   public:
 #ifndef _PAR
@@ -414,6 +438,7 @@ class ISBBTPreCL : public SchurPreBaseCL
           M_( M_pr), Mvel_( Mvel), tolA_(tolA), tolM_(tolM),
           solver_( spc_, 500, tolA_, /*relative*/ true),
           solver2_( jacpc_, 500, tolM_, /*relative*/ true),
+          explicit_( false), explsolver_( ssorpc_, 500, tolA_, /*relative*/ true),
           pr_idx_( &pr_idx), regularize_( regularize) {}
 
     ISBBTPreCL (const ISBBTPreCL& pc)
@@ -425,7 +450,17 @@ class ISBBTPreCL : public SchurPreBaseCL
           spc_( pc.spc_),
           solver_( spc_, 500, tolA_, /*relative*/ true),
           solver2_( jacpc_, 500, tolM_, /*relative*/ true),
+          explicit_( pc.explicit_), BsT_( pc.BsT_), BsBsT_( pc.BsBsT_),
+          explsolver_( ssorpc_, 500, tolA_, /*relative*/ true),
           pr_idx_( pc.pr_idx_), regularize_( pc.regularize_) {}
+
+    /// \brief Form Bs*Bs^T explicitly by a sparse matrix-matrix product.
+    /** One multiplication with the product is cheaper than the multiplication
+        with Bs and Bs^T done by the CGNE-solver. The product is recomputed with
+        the next update, only the numeric phase is performed, if the sparsity
+        pattern of B has not changed.*/
+    void SetExplicitBBT( bool e) { explicit_= e; Bversion_= 0; lifecycle_.Invalidate(); }
+    bool GetExplicitBBT() const  { return explicit_; }
 #else
     ISBBTPreCL (const MatrixCL* B, const MatrixCL* M_pr, const MatrixCL* Mvel,
         const IdxDescCL& pr_idx, const IdxDescCL& vel_idx,
@@ -476,28 +511,34 @@ class ISBBTPreCL : public SchurPreBaseCL
         M_= M;
         pr_idx_= pr_idx;
         Bversion_ = 0;
+        lifecycle_.Invalidate();
     }
 };
 
 template <typename Mat, typename Vec>
 void ISBBTPreCL::Apply(const Mat&, Vec& p, const Vec& c) const
 {
-    if (B_->Version() != Bversion_)
-        Update();
+    MaybeUpdate();
+    lifecycle_.BeginApply();
 
     p= 0.0;
     if (kA_ != 0.0) {
 #ifndef _PAR
-        solver_.Solve( *Bs_, p, VectorCL( Dprsqrtinv_*c));
+        if (explicit_)
+            explsolver_.Solve( BsBsT_, p, VectorCL( Dprsqrtinv_*c));
+        else
+            solver_.Solve( *Bs_, p, VectorCL( Dprsqrtinv_*c));
+        const SolverBaseCL& bbtsolver= explicit_ ? static_cast<const SolverBaseCL&>( explsolver_) : solver_;
 #else
         solver_.Solve( BBT_, p, VectorCL( Dprsqrtinv_*c));
+        const SolverBaseCL& bbtsolver= solver_;
 #endif
 //            std::cout << "ISBBTPreCL p: iterations: " << solver_.GetIter()
 //                       << "\tresidual: " <<  solver_.GetResid();
-        if (solver_.GetIter() == solver_.GetMaxIter()){
+        if (bbtsolver.GetIter() == bbtsolver.GetMaxIter()){
           IF_MASTER
-            std::cout << "ISBBTPreCL::Apply: BBT-solve: " << solver_.GetIter()
-                    << '\t' << solver_.GetResid() << '\n';
+            std::cout << "ISBBTPreCL::Apply: BBT-solve: " << bbtsolver.GetIter()
+                    << '\t' << bbtsolver.GetResid() << '\n';
         }
         p= kA_*(Dprsqrtinv_*p);
     }
@@ -515,6 +556,7 @@ void ISBBTPreCL::Apply(const Mat&, Vec& p, const Vec& c) const
 
         p+= kM_*p2_;
     }
+    lifecycle_.EndApply();
 }
 
 //**************************************************************************
@@ -538,7 +580,15 @@ class MinCommPreCL : public SchurPreBaseCL
     const IdxDescCL* pr_idx_;                                   ///< Used to determine, how to represent the kernel of BB^T in case of pure Dirichlet-BCs.
     double regularize_;
 
-    void Update () const;
+    void Update (bool refresh= false) const;                    ///< refresh: the pattern of B is unchanged
+    void MaybeUpdate () const {                                 ///< Update according to the lifecycle policy
+        const size_t version= A_->Version() + Mvel_->Version() + B_->Version();
+        const PcLifecycleCL::ActionT a= lifecycle_.Decide( "MinCommPreCL", version, *B_);
+        if (a < PcLifecycleCL::PC_Refresh) return;
+        lifecycle_.BeginUpdate();
+        Update( a == PcLifecycleCL::PC_Refresh);
+        lifecycle_.EndUpdate( a, version, *B_);
+    }
 
   public:
     MinCommPreCL (const MatrixCL* A, MatrixCL* B, MatrixCL* Mvel, MatrixCL* M_pr, const IdxDescCL& pr_idx,
@@ -569,7 +619,7 @@ class MinCommPreCL : public SchurPreBaseCL
     void Apply(const MatrixCL& A,   VectorCL& x, const VectorCL& b) const { Apply<>( A, x, b); }
     void Apply(const MLMatrixCL& A, VectorCL& x, const VectorCL& b) const { Apply<>( A, x, b); }
 
-    void SetMatrixA  (const MatrixCL* A) { A_= A; }
+    void SetMatrixA  (const MatrixCL* A) { A_= A; lifecycle_.Invalidate(); }
     void SetMatrices (const MatrixCL* A, const MatrixCL* B, const MatrixCL* Mvel, const MatrixCL* M,
                       const IdxDescCL* pr_idx) {
         A_= A;
@@ -578,6 +628,7 @@ class MinCommPreCL : public SchurPreBaseCL
         M_= M;
         pr_idx_= pr_idx;
         Aversion_ = Bversion_ = Mvelversion_ = Mversion_ = 0;
+        lifecycle_.Invalidate();
     }
 };
 
@@ -585,8 +636,8 @@ template <typename Mat, typename Vec>
   void
   MinCommPreCL::Apply (const Mat&, Vec& x, const Vec& b) const
 {
-    if ((A_->Version() != Aversion_) || (Mvel_->Version() != Mvelversion_) || (B_->Version() != Bversion_))
-        Update();
+    MaybeUpdate();
+    lifecycle_.BeginApply();
 
     VectorCL y( b.size());
     solver_.Solve( *Bs_, y, VectorCL( Dprsqrtinv_*b));
@@ -602,6 +653,7 @@ template <typename Mat, typename Vec>
         std::cout << "MinCommPreCL::Apply: 2nd BBT-solve: " << solver_.GetIter()
                   << '\t' << solver_.GetResid() << '\n';
     x= Dprsqrtinv_*t;
+    lifecycle_.EndApply();
 }
 
 //**************************************************************************
@@ -626,7 +678,15 @@ class BDinvBTPreCL: public SchurPreBaseCL
     double regularize_;
     bool lumped_;
 
-    void Update () const;
+    void Update (bool refresh= false) const;                    ///< refresh: the pattern of B is unchanged
+    void MaybeUpdate () const {                                 ///< Update according to the lifecycle policy
+        const size_t version= L_->Version() + Mvel_->Version() + M_->Version() + B_->Version();
+        const PcLifecycleCL::ActionT a= lifecycle_.Decide( "BDinvBTPreCL", version, *B_);
+        if (a < PcLifecycleCL::PC_Refresh) return;
+        lifecycle_.BeginUpdate();
+        Update( a == PcLifecycleCL::PC_Refresh);
+        lifecycle_.EndUpdate( a, version, *B_);
+    }
 
   public:
     BDinvBTPreCL (const MatrixCL* L, MatrixCL* B, MatrixCL* M_vel, MatrixCL* M_pr, const IdxDescCL& pr_idx,
@@ -657,7 +717,7 @@ class BDinvBTPreCL: public SchurPreBaseCL
     void Apply(const MatrixCL& A,   VectorCL& x, const VectorCL& b) const { Apply<>( A, x, b); }
     void Apply(const MLMatrixCL& A, VectorCL& x, const VectorCL& b) const { Apply<>( A, x, b); }
 
-    void SetMatrixA  (const MatrixCL* L) { L_= L; }
+    void SetMatrixA  (const MatrixCL* L) { L_= L; lifecycle_.Invalidate(); }
     void SetMatrices (const MatrixCL* L, const MatrixCL* B, const MatrixCL* M_vel, const MatrixCL* M_pr,
                       const IdxDescCL* pr_idx) {
         L_= L;
@@ -666,6 +726,7 @@ class BDinvBTPreCL: public SchurPreBaseCL
         M_= M_pr;
         pr_idx_= pr_idx;
         Lversion_ = Bversion_ = Mvelversion_= Mversion_ = 0;
+        lifecycle_.Invalidate();
     }
     /// Returns true, if the lumped diag of the velocity mass matrix is used, and false, if the diagonal of the velocity convection-diffusion-reaction matrix is considered.
     bool UsesMassLumping() const { return lumped_; }
@@ -673,8 +734,7 @@ class BDinvBTPreCL: public SchurPreBaseCL
     void SetMassLumping( bool lump) { lumped_= lump; }
     /// If lumping is switched on, the lumped diag of the velocity mass matrix is returned. Otherwise the diagonal of the velocity convection-diffusion-reaction matrix is returned.
     VectorCL GetVelDiag() const { 
-        if ((L_->Version() != Lversion_) || (Mvel_->Version() != Mvelversion_))
-            Update();
+        MaybeUpdate();
         return VectorCL(1.0/Dvelinv_); 
     }
 };
@@ -683,8 +743,8 @@ template <typename Mat, typename Vec>
   void
   BDinvBTPreCL::Apply (const Mat&, Vec& x, const Vec& b) const
 {
-    if ((L_->Version() != Lversion_) || (Mvel_->Version() != Mvelversion_) || (M_->Version() != Mversion_) || (B_->Version() != Bversion_))
-        Update();
+    MaybeUpdate();
+    lifecycle_.BeginApply();
 
     Vec y( b.size());
     solver_.Solve( *BDinvBT_, y, Vec( Dprsqrtinv_*b));
@@ -692,6 +752,7 @@ template <typename Mat, typename Vec>
         std::cout << "BDinvBTPreCL::Apply: BLBT-solve: " << solver_.GetIter()
                   << '\t' << solver_.GetResid() << '\n';
     x= Dprsqrtinv_*y;
+    lifecycle_.EndApply();
 }
 #endif
 
@@ -702,6 +763,7 @@ template <typename Mat, typename Vec>
 template <class StokesT, class SolverT>
 void InstatStokesThetaSchemeCL<StokesT,SolverT>::DoStep( VectorCL& v, VectorCL& p)
 {
+    _guess.Push( v, p, _Stokes.v.t);
     _Stokes.v.t+= _dt;
     _Stokes.SetupInstatRhs( _b, &_Stokes.c, _cplM, _Stokes.v.t, _b, _Stokes.v.t);
 
@@ -710,6 +772,8 @@ void InstatStokesThetaSchemeCL<StokesT,SolverT>::DoStep( VectorCL& v, VectorCL&
     _rhs+= (1./_dt)*(_Stokes.M.Data*v + _cplM->Data - _old_cplM->Data)
          +  _theta*_b->Data + (1.-_theta)*_old_b->Data;
 
+    _guess.Extrapolate( v, p, _Stokes.v.t);
+    _guess.Project( _mat, _Stokes.B.Data, v, p, _rhs, _Stokes.c.Data);
     _solver.Solve( _mat, _Stokes.B.Data, v, p, _rhs, _Stokes.c.Data);
 
     std::swap( _b, _old_b);
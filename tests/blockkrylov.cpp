@@ -0,0 +1,109 @@
+/// \file blockkrylov.cpp
+/// \brief tests the block solvers BlockPCG and BlockGMRES for several right-hand sides
+/// \author LNM RWTH Aachen: Joerg Grande; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2009 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "num/solver.h"
+#include "tests/laplacematrix.h"
+#include <iostream>
+#include <cmath>
+
+/// maximal 2-norm of the error over the columns of X
+double MaxError( const DROPS::VectorCL& X, const DROPS::VectorCL& Xe, size_t m)
+{
+    std::vector<double> err;
+    DROPS::VectorCL D( X - Xe);
+    DROPS::dot_multi( D, D, m, err);
+    return std::sqrt( *std::max_element( err.begin(), err.end()));
+}
+
+/// compare the fused block SSOR step with the column-wise application
+int TestBlockApply()
+{
+    std::cout << "BlockApply SSOR:\n";
+    DROPS::MatrixCL A;
+    SetupLaplace( A, 6, 0.);
+    const size_t n= A.num_rows(), m= 3;
+    DROPS::VectorCL B( n*m), X( n*m), x( n), b( n);
+    for (size_t i= 0; i < n*m; ++i)
+        B[i]= std::cos( 0.3*i);
+    DROPS::SSORPcCL pc( 1.2);
+    DROPS::BlockApply( pc, A, X, B, m);
+    double err= 0.;
+    for (size_t j= 0; j < m; ++j) {
+        b= B[std::slice( j, n, m)];
+        pc.Apply( A, x, b);
+        err= std::max( err, DROPS::norm( DROPS::VectorCL( x - DROPS::VectorCL( X[std::slice( j, n, m)]))));
+    }
+    std::cout << "difference to column-wise SSOR: " << err << std::endl;
+    return err < 1e-12 ? 0 : 1;
+}
+
+int TestPCG()
+{
+    std::cout << "BlockPCG:\n";
+    DROPS::MatrixCL A;
+    SetupLaplace( A, 12, 0.1);
+    const size_t n= A.num_rows(), m= 4;
+    DROPS::VectorCL Xe( n*m), X( 0., n*m);
+    for (size_t i= 0; i < n; ++i)
+        for (size_t j= 0; j < m; ++j)
+            Xe[i*m+j]= std::sin( 0.1*(j + 1)*i);
+    const DROPS::VectorCL B( DROPS::mul_multi( A, Xe, m));
+
+    DROPS::SSORPcCL pc;
+    DROPS::BlockPCGSolverCL<DROPS::SSORPcCL> solver( pc, 500, 1e-10, true);
+    solver.Solve( A, X, B, m);
+    const double err= MaxError( X, Xe, m);
+    std::cout << "iterations: " << solver.GetIter() << "\tresidual: " << solver.GetResid()
+              << "\terror: " << err << std::endl;
+    return (solver.GetResid() <= 1e-10 && err < 1e-7) ? 0 : 1;
+}
+
+int TestGMRES()
+{
+    std::cout << "BlockGMRES:\n";
+    DROPS::MatrixCL A;
+    SetupLaplace( A, 12, 0., 2.);
+    const size_t n= A.num_rows(), m= 3;
+    DROPS::VectorCL Xe( n*m), X( 0., n*m);
+    for (size_t i= 0; i < n; ++i)
+        for (size_t j= 0; j < m; ++j)
+            Xe[i*m+j]= j == 0 ? 0. : std::cos( 0.05*j*i); // column 0 is solved by the initial guess
+    const DROPS::VectorCL B( DROPS::mul_multi( A, Xe, m));
+
+    DROPS::JACPcCL pc;
+    DROPS::BlockGMResSolverCL<DROPS::JACPcCL> solver( pc, 20, 1000, 1e-10, true);
+    solver.Solve( A, X, B, m);
+    const double err= MaxError( X, Xe, m);
+    std::cout << "iterations: " << solver.GetIter() << "\tresidual: " << solver.GetResid()
+              << "\terror: " << err << std::endl;
+    return (solver.GetResid() <= 1e-10 && err < 1e-7) ? 0 : 1;
+}
+
+int main (int, char**)
+{
+  try {
+    return TestBlockApply() + TestPCG() + TestGMRES();
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
@@ -359,6 +359,41 @@ TestTarjanDownwind ()
     print_frobeniusnorm( M);
 }
 
+void
+TestCachedDownwind ()
+{
+    // chain 0 -> 1 -> 2 -> 3
+    MatrixCL M;
+    MatrixBuilderCL Mb( &M, 4, 4);
+    Mb( 0, 1)= 1.0;
+    Mb( 1, 2)= 1.0;
+    Mb( 2, 3)= 1.0;
+    Mb( 3, 3)= 0.0;
+    Mb.Build();
+    MatrixCL M2( M), M3( M);
+
+    CachedDownwindCL dw( IteratedDownwindCL( 0.5), 0.5);
+    PermutationT p= dw.downwind_numbering( M);
+    seq_out( p.begin(), p.end(), std::cout);
+    std::cout << "reused: " << dw.WasReused() << '\n';
+
+    // same strong edges with other weights: the numbering is reused
+    M2.raw_val()[0]= 2.0;
+    p= dw.downwind_numbering( M2);
+    std::cout << "reused: " << dw.WasReused() << '\n';
+
+    // reversed edge 2 -> 1 points upwind in the old numbering: the numbering is recomputed
+    MatrixBuilderCL Mb3( &M3, 4, 4);
+    Mb3( 0, 1)= 1.0;
+    Mb3( 2, 1)= 1.0;
+    Mb3( 2, 3)= 1.0;
+    Mb3( 3, 3)= 0.0;
+    Mb3.Build();
+    p= dw.downwind_numbering( M3);
+    seq_out( p.begin(), p.end(), std::cout);
+    std::cout << "reused: " << dw.WasReused() << '\n';
+}
+
 int main ()
 {
 try {
@@ -380,6 +415,7 @@ try {
 
 //    Test_rcm();
     TestTarjanDownwind();
+    TestCachedDownwind();
 
 }
 catch (DROPSErrCL d) {
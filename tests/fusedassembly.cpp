@@ -0,0 +1,149 @@
+/// \file fusedassembly.cpp
+/// \brief tests the single-pass assembly of the two-phase time step against the separate setup routines
+/// \author LNM RWTH Aachen: Joerg Grande; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2009 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "navstokes/instatnavstokes2phase.h"
+#include "levelset/surfacetension.h"
+#include "misc/params.h"
+#include <iostream>
+#include <cmath>
+
+DROPS::ParamCL P;
+
+using namespace DROPS;
+
+Point3DCL Inflow (const Point3DCL& p, double)
+{
+    Point3DCL ret( 0.);
+    ret[2]= 4.*p[0]*(1. - p[0]);
+    return ret;
+}
+
+Point3DCL Vel (const Point3DCL& p, double)
+{
+    Point3DCL ret;
+    ret[0]= std::sin( p[1]);
+    ret[1]= p[0]*p[2];
+    ret[2]= 4.*p[0]*(1. - p[0]);
+    return ret;
+}
+
+double DistanceFct (const Point3DCL& p)
+{
+    Point3DCL c( 0.5);
+    c[2]= 0.45;
+    return (p - c).norm() - 0.27;
+}
+
+double sigmaf (const Point3DCL&, double) { return 0.1; }
+
+/// relative difference of the matrices on all levels, measured by their action on a fixed vector
+double MatDiff (const MLMatDescCL& a, const MLMatDescCL& b)
+{
+    double d= 0.;
+    for (MLMatrixCL::const_iterator ia= a.Data.begin(), ib= b.Data.begin(); ia != a.Data.end(); ++ia, ++ib) {
+        if (ia->num_rows() != ib->num_rows() || ia->num_nonzeros() != ib->num_nonzeros())
+            return 1.;
+        VectorCL x( ia->num_cols());
+        for (size_t i= 0; i < x.size(); ++i)
+            x[i]= std::sin( 1. + i);
+        d= std::max( d, norm( VectorCL( (*ia)*x - (*ib)*x))/(1e-300 + norm( VectorCL( (*ia)*x))));
+    }
+    return d;
+}
+
+double VecDiff (const VecDescCL& a, const VecDescCL& b)
+{
+    return norm( VectorCL( a.Data - b.Data))/(1e-300 + norm( a.Data));
+}
+
+int Test (FiniteElementT prFE)
+{
+    Point3DCL null( 0.), e1( 0.), e2( 0.), e3( 0.);
+    e1[0]= e2[1]= e3[2]= 1.;
+    BrickBuilderCL brick( null, e1, e2, e3, 4, 4, 4);
+    const bool IsNeumann[6]= { false, false, false, false, false, false };
+    StokesVelBndDataCL::bnd_val_fun ZeroVel = InVecMap::getInstance().find("ZeroVel")->second;
+    const StokesVelBndDataCL::bnd_val_fun bnd_fun[6]= { ZeroVel, ZeroVel, ZeroVel, ZeroVel, &Inflow, &Inflow };
+    const BndCondT bcls[6]= { NoBC, NoBC, NoBC, NoBC, NoBC, NoBC };
+    const LsetBndDataCL::bnd_val_fun bfunls[6]= { 0, 0, 0, 0, 0, 0 };
+    LsetBndDataCL lsbnd( 6, bcls, bfunls);
+    TwoPhaseFlowCoeffCL coeff( 1., 3., 2., 0.5, 0.1, Point3DCL( 0.));
+    InstatNavierStokes2PhaseP2P1CL S( brick, coeff, StokesBndDataCL( 6, IsNeumann, bnd_fun), prFE, 0.1);
+    MultiGridCL& MG= S.GetMG();
+    SurfaceTensionCL sf( sigmaf);
+    LevelsetP2CL lset( MG, lsbnd, sf, 0.1);
+    lset.CreateNumbering( MG.GetLastLevel(), &lset.idx);
+    lset.Phi.SetIdx( &lset.idx);
+    lset.Init( DistanceFct);
+    S.CreateNumberingVel( MG.GetLastLevel(), &S.vel_idx);
+    S.CreateNumberingPr ( MG.GetLastLevel(), &S.pr_idx, 0, &lset);
+    S.v.SetIdx( &S.vel_idx);
+    S.p.SetIdx( &S.pr_idx);
+    S.InitVel( &S.v, Vel);
+    S.SetIdx();
+
+    MLMatDescCL A, M, B, N, prA, prM, LB1, LB2;
+    A.SetIdx( &S.vel_idx, &S.vel_idx);
+    M.SetIdx( &S.vel_idx, &S.vel_idx);
+    N.SetIdx( &S.vel_idx, &S.vel_idx);
+    B.SetIdx( &S.pr_idx, &S.vel_idx);
+    prA.SetIdx( &S.pr_idx, &S.pr_idx);
+    prM.SetIdx( &S.pr_idx, &S.pr_idx);
+    LB1.SetIdx( &S.vel_idx, &S.vel_idx);
+    LB2.SetIdx( &S.vel_idx, &S.vel_idx);
+    VecDescCL b1, b2, cA1, cA2, cM1, cM2, c1, c2, cN1, cN2, cLB1, cLB2;
+    VecDescCL* velvec[]= { &b1, &b2, &cA1, &cA2, &cM1, &cM2, &cN1, &cN2, &cLB1, &cLB2 };
+    for (int i= 0; i < 10; ++i)
+        velvec[i]->SetIdx( &S.vel_idx);
+    c1.SetIdx( &S.pr_idx);
+    c2.SetIdx( &S.pr_idx);
+
+    S.SetupSystem1( &S.A, &S.M, &b1, &cA1, &cM1, lset, 0.);
+    S.SetupSystem2( &S.B, &c1, lset, 0.);
+    S.SetupNonlinear( &S.N, &S.v, &cN1, lset, 0.);
+    S.SetupPrStiff( &S.prA, lset);
+    S.SetupPrMass( &S.prM, lset);
+    S.SetupLB( &LB1, &cLB1, lset, 0.);
+
+    S.SetupStep( &A, &M, &b2, &cA2, &cM2, &B, &c2, &N, &S.v, &cN2, &prA, &prM, &LB2, &cLB2, lset, 0.);
+
+    const double d[13]= { MatDiff( S.A, A), MatDiff( S.M, M), MatDiff( S.B, B), MatDiff( S.N, N),
+        MatDiff( S.prA, prA), MatDiff( S.prM, prM), MatDiff( LB1, LB2),
+        VecDiff( b1, b2), VecDiff( cA1, cA2), VecDiff( cM1, cM2), VecDiff( c1, c2), VecDiff( cN1, cN2), VecDiff( cLB1, cLB2) };
+    double maxdiff= 0.;
+    for (int i= 0; i < 13; ++i)
+        maxdiff= std::max( maxdiff, d[i]);
+    std::cout << (prFE == P1X_FE ? "P1X" : "P1") << " pressure: max. relative difference " << maxdiff << std::endl;
+    return maxdiff < 1e-12 ? 0 : 1;
+}
+
+int main (int, char**)
+{
+  try {
+    return Test( P1_FE) + Test( P1X_FE);
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
@@ -0,0 +1,128 @@
+/// \file initialguess.cpp
+/// \brief tests the initial guesses from the solution history
+/// \author LNM RWTH Aachen: Joerg Grande; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2009 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "num/initialguess.h"
+#include "tests/laplacematrix.h"
+#include <iostream>
+#include <cmath>
+
+using DROPS::VectorCL;
+using DROPS::InitialGuessCL;
+
+/// x(t)= a + t*b + t^2*c
+VectorCL Curve( size_t n, double t)
+{
+    VectorCL x( n);
+    for (size_t i= 0; i < n; ++i)
+        x[i]= std::sin( 0.1*i) + t*std::cos( 0.3*i) + t*t*0.5*i/n;
+    return x;
+}
+
+int TestExtrapolation()
+{
+    std::cout << "Extrapolation:\n";
+    const size_t n= 50;
+    InitialGuessCL g( InitialGuessCL::IG_Extrapolation, 3, 2);
+    VectorCL x( n);
+    const bool empty= g.Extrapolate( x, 0.);
+    g.Push( Curve( n, 0.), 0.);
+    g.Push( Curve( n, 0.5), 0.5);
+    g.Push( Curve( n, 0.7), 0.7);
+    g.Extrapolate( x, 1.);
+    const double err2= DROPS::norm( VectorCL( x - Curve( n, 1.)));
+
+    // a repeated step replaces the solutions at later times
+    g.Push( Curve( n, 0.9), 0.9);
+    g.Discard( 0.7);
+    g.Push( Curve( n, 0.6), 0.6);
+    g.SetOrder( 1);
+    g.Extrapolate( x, 0.6);
+    const double err1= DROPS::norm( VectorCL( x - Curve( n, 0.6)));
+
+    // a new numbering drops the history
+    g.Push( Curve( n + 1, 1.), 1.);
+    std::cout << "empty: " << empty << "\terror order 2: " << err2 << "\terror after discard: " << err1
+              << "\tsize after resize: " << g.size() << std::endl;
+    return (!empty && err2 < 1e-12 && err1 < 1e-12 && g.size() == 1) ? 0 : 1;
+}
+
+int TestProjection()
+{
+    std::cout << "Projection:\n";
+    DROPS::MatrixCL A;
+    SetupLaplace( A, 8, 0.1, 0.5);
+    const size_t n= A.num_rows();
+    const VectorCL xe( Curve( n, 1.)), b( A*xe);
+
+    // the solution is in the span of the history: the projection solves the system
+    InitialGuessCL g( InitialGuessCL::IG_Projection, 3);
+    g.Push( Curve( n, 0.), 0.);
+    g.Push( Curve( n, 0.5), 0.5);
+    g.Push( Curve( n, 0.7), 0.7);
+    VectorCL x( n);
+    g.Project( A, x, b);
+    const double res1= DROPS::norm( VectorCL( b - A*x))/DROPS::norm( b);
+
+    // otherwise the residual of the current guess does not grow
+    InitialGuessCL g2( InitialGuessCL::IG_Projection, 2);
+    g2.Push( Curve( n, 0.), 0.);
+    g2.Push( Curve( n, 0.5), 0.5);
+    VectorCL y( n);
+    for (size_t i= 0; i < n; ++i)
+        y[i]= std::cos( 0.7*i);
+    const double res0= DROPS::norm( VectorCL( b - A*y));
+    g2.Project( A, y, b);
+    const double res2= DROPS::norm( VectorCL( b - A*y));
+
+    // saddle point system ( A B^T; B 0)
+    const size_t m= n/4;
+    DROPS::MatrixCL B;
+    DROPS::MatrixBuilderCL BB( &B, m, n);
+    for (size_t i= 0; i < m; ++i) {
+        BB( i, 4*i)= 1.;
+        BB( i, 4*i + 1)= -1.;
+    }
+    BB.Build();
+    const VectorCL pe( Curve( m, 1.)),
+                   bv( A*xe + transp_mul( B, pe)), c( B*xe);
+    g2.SetSize( 3);
+    g2.Push( Curve( n, 0.), Curve( m, 0.), 0.);
+    g2.Push( Curve( n, 0.5), Curve( m, 0.5), 0.5);
+    g2.Push( Curve( n, 0.7), Curve( m, 0.7), 0.7);
+    VectorCL v( n), pr( m);
+    const bool projected= g2.Project( A, B, v, pr, bv, c);
+    const double res3= std::sqrt( DROPS::norm_sq( VectorCL( bv - A*v - transp_mul( B, pr))) + DROPS::norm_sq( VectorCL( c - B*v)));
+
+    std::cout << "residual in the span: " << res1 << "\tresidual before: " << res0 << "\tafter: " << res2
+              << "\tsaddle point residual: " << res3 << std::endl;
+    return (res1 < 1e-10 && res2 <= res0 && projected && res3 < 1e-10*DROPS::norm( bv)) ? 0 : 1;
+}
+
+int main (int, char**)
+{
+  try {
+    return TestExtrapolation() + TestProjection();
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
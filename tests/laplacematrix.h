@@ -0,0 +1,50 @@
+/// \file laplacematrix.h
+/// \brief finite difference Laplacian on a cube as test matrix for the solver tests
+/// \author LNM RWTH Aachen: Joerg Grande; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2009 LNM/SC RWTH Aachen, Germany
+*/
+
+#ifndef DROPS_LAPLACEMATRIX_H
+#define DROPS_LAPLACEMATRIX_H
+
+#include "num/spmat.h"
+
+/// 7-point Laplacian plus shift on a k x k x k grid; conv adds an upwind convection in x-direction
+inline void SetupLaplace( DROPS::MatrixCL& A, size_t k, double shift, double conv= 0.)
+{
+    const size_t n= k*k*k;
+    DROPS::MatrixBuilderCL AB( &A, n, n);
+    for (size_t i= 0; i < k; ++i)
+        for (size_t j= 0; j < k; ++j)
+            for (size_t l= 0; l < k; ++l) {
+                const size_t r= (i*k + j)*k + l;
+                AB( r, r)= 6. + shift + conv;
+                if (i > 0)   AB( r, r - k*k)= -1.;
+                if (i < k-1) AB( r, r + k*k)= -1.;
+                if (j > 0)   AB( r, r - k)= -1.;
+                if (j < k-1) AB( r, r + k)= -1.;
+                if (l > 0)   AB( r, r - 1)= -1. - conv;
+                if (l < k-1) AB( r, r + 1)= -1.;
+            }
+    AB.Build();
+}
+
+#endif
@@ -0,0 +1,127 @@
+/// \file narrowband.cpp
+/// \brief tests the assembly and the restricted solve of the level set system in narrow band mode
+/// \author LNM RWTH Aachen: Joerg Grande; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2009 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "navstokes/instatnavstokes2phase.h"
+#include "levelset/surfacetension.h"
+#include "num/solver.h"
+#include "misc/params.h"
+#include <iostream>
+#include <cmath>
+
+DROPS::ParamCL P;
+
+using namespace DROPS;
+
+Point3DCL Vel (const Point3DCL& p, double)
+{
+    Point3DCL ret;
+    ret[0]= 1. + 0.2*std::sin( p[1]);
+    ret[1]= 0.5*p[2];
+    ret[2]= -0.3;
+    return ret;
+}
+
+double DistanceFct (const Point3DCL& p)
+{
+    return (p - Point3DCL( 0.5)).norm() - 0.3;
+}
+
+double sigmaf (const Point3DCL&, double) { return 0.1; }
+
+int main (int, char**)
+{
+  try {
+    Point3DCL null( 0.), e1( 0.), e2( 0.), e3( 0.);
+    e1[0]= e2[1]= e3[2]= 1.;
+    BrickBuilderCL brick( null, e1, e2, e3, 16, 16, 16);
+    const bool IsNeumann[6]= { false, false, false, false, false, false };
+    StokesVelBndDataCL::bnd_val_fun ZeroVel = InVecMap::getInstance().find("ZeroVel")->second;
+    const StokesVelBndDataCL::bnd_val_fun bnd_fun[6]= { ZeroVel, ZeroVel, ZeroVel, ZeroVel, ZeroVel, ZeroVel };
+    const BndCondT bcls[6]= { NoBC, NoBC, NoBC, NoBC, NoBC, NoBC };
+    const LsetBndDataCL::bnd_val_fun bfunls[6]= { 0, 0, 0, 0, 0, 0 };
+    LsetBndDataCL lsbnd( 6, bcls, bfunls);
+    TwoPhaseFlowCoeffCL coeff( 1., 3., 2., 0.5, 0.1, Point3DCL( 0.));
+    InstatNavierStokes2PhaseP2P1CL S( brick, coeff, StokesBndDataCL( 6, IsNeumann, bnd_fun));
+    MultiGridCL& MG= S.GetMG();
+    SurfaceTensionCL sf( sigmaf);
+    LevelsetP2CL lset( MG, lsbnd, sf, 0.1);
+    lset.CreateNumbering( MG.GetLastLevel(), &lset.idx);
+    lset.Phi.SetIdx( &lset.idx);
+    lset.Init( DistanceFct);
+    S.CreateNumberingVel( MG.GetLastLevel(), &S.vel_idx);
+    S.v.SetIdx( &S.vel_idx);
+    S.InitVel( &S.v, Vel);
+    const size_t n= lset.Phi.Data.size();
+    const double dt= 0.01;
+
+    // full assembly
+    lset.SetupSystem( S.GetVelSolution(), dt);
+    const MatrixCL Efull( lset.E), Hfull( lset.H);
+
+    // band assembly: the rows of the inner dofs coincide with the full assembly
+    lset.SetNarrowBand( 0.1);
+    lset.SetupSystem( S.GetVelSolution(), dt);
+    const NarrowBandCL& band= lset.GetNarrowBand();
+    size_t numtetra= 0, numbandtetra= 0;
+    DROPS_FOR_TRIANG_CONST_TETRA( const_cast<const MultiGridCL&>( MG), MG.GetLastLevel(), it)
+        ++numtetra;
+    for (NarrowBandCL::const_tetra_iterator it= band.GetTetraBegin(); it != band.GetTetraEnd(); ++it)
+        ++numbandtetra;
+    VectorCL x( n);
+    for (size_t i= 0; i < n; ++i)
+        x[i]= std::sin( 1. + i);
+    const VectorCL de( VectorCL( lset.E*x - Efull*x)), dh( VectorCL( lset.H*x - Hfull*x));
+    double rowdiff= 0.;
+    for (size_t i= 0; i < n; ++i)
+        if (band.IsInner( i))
+            rowdiff= std::max( rowdiff, std::max( std::abs( de[i]), std::abs( dh[i])));
+    rowdiff/= norm( VectorCL( Hfull*x));
+
+    // restricted solve vs. solve of the full system with frozen rows
+    MatrixCL L;
+    L.LinComb( 1./dt, lset.E, 1., lset.H);
+    const VectorCL rhs( (1./dt)*VectorCL( lset.E*lset.Phi.Data));
+    SSORPcCL pc;
+    GMResSolverCL<SSORPcCL> solver( pc, 100, 1000, 1e-13, /*relative=*/ true);
+    VectorCL phifull( lset.Phi.Data);
+    solver.Solve( L, phifull, rhs);
+    const int iterfull= solver.GetIter();
+    VectorCL phiband( lset.Phi.Data);
+    lset.SolveSystem( solver, L, phiband, rhs);
+    const double soldiff= norm( VectorCL( phifull - phiband))/norm( phifull);
+    double frozendiff= 0.;
+    for (size_t i= 0; i < n; ++i)
+        if (!band.IsInner( i))
+            frozendiff= std::max( frozendiff, std::abs( phiband[i] - lset.Phi.Data[i]));
+
+    std::cout << "inner dofs: " << band.NumInnerUnknowns() << " of " << n << "\tband tetras: " << numbandtetra << " of " << numtetra
+              << "\nrelative difference of the inner rows: " << rowdiff
+              << "\nrelative difference of the solutions: " << soldiff << "\tchange of the frozen values: " << frozendiff
+              << "\niterations: full system: " << iterfull << "\tband: " << solver.GetIter() << std::endl;
+    return (band.NumInnerUnknowns() < n/2 && numbandtetra < numtetra/2 && rowdiff < 1e-14 && soldiff < 1e-10 && frozendiff == 0.) ? 0 : 1;
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}
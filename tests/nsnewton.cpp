@@ -0,0 +1,165 @@
+/// \file nsnewton.cpp
+/// \brief tests the Jacobian of the convection term and the Newton linearization of AdaptFixedPtDefectCorrCL
+/// \author LNM RWTH Aachen: Joerg Grande; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2009 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "geom/multigrid.h"
+#include "geom/builder.h"
+#include "navstokes/navstokes.h"
+#include "num/stokessolver.h"
+#include "num/nssolver.h"
+#include "stokes/integrTime.h"
+#include <iostream>
+#include <cmath>
+
+using namespace DROPS;
+
+Point3DCL Zero (const Point3DCL&, double)
+{
+    return Point3DCL( 0.);
+}
+
+double ZeroScalar (const Point3DCL&, double)
+{
+    return 0.;
+}
+
+/// \brief Smooth lid velocity on the face z=1.
+Point3DCL Lid (const Point3DCL& p, double)
+{
+    Point3DCL ret( 0.);
+    if (p[2] > 1. - 1e-10)
+        ret[0]= 16.*p[0]*(1. - p[0])*p[1]*(1. - p[1]);
+    return ret;
+}
+
+class CoeffCL
+{
+  public:
+    static instat_scalar_fun_ptr q;
+    static instat_vector_fun_ptr f;
+    const double nu;
+
+    CoeffCL( double nuarg) : nu( nuarg) {}
+};
+
+instat_scalar_fun_ptr CoeffCL::q= &ZeroScalar;
+instat_vector_fun_ptr CoeffCL::f= &Zero;
+
+typedef NavierStokesP2P1CL<CoeffCL> NSCL;
+
+/// \brief Compares (N(u) + R(u))w with the central difference quotient of u -> N(u)u - cplN(u).
+/// The convection term is quadratic in u, thus the quotient is exact up to rounding.
+int TestJacobian (NSCL& ns)
+{
+    std::cout << "Jacobian:\n";
+    IdxDescCL& idx= ns.vel_idx.GetFinest();
+    const size_t n= idx.NumUnknowns();
+    VelVecDescCL u( &ns.vel_idx), up( &ns.vel_idx), um( &ns.vel_idx),
+                 cplN( &ns.vel_idx), cplNp( &ns.vel_idx), cplNm( &ns.vel_idx);
+    VectorCL w( n);
+    for (size_t i= 0; i < n; ++i) {
+        u.Data[i]= std::sin( 0.1*i);
+        w[i]= std::cos( 0.3*i);
+    }
+    const double eps= 1e-3;
+    up.Data= u.Data + eps*w;
+    um.Data= u.Data - eps*w;
+
+    MatrixCL N, Np, Nm, R, J;
+    ns.SetupNonlinear( N, &u, &cplN, idx);
+    ns.SetupNonlinearJacobian( R, &u, idx);
+    ns.SetupNonlinear( Np, &up, &cplNp, idx);
+    ns.SetupNonlinear( Nm, &um, &cplNm, idx);
+    J.LinComb( 1., N, 1., R);
+
+    const VectorCL Jw( J*w),
+        dq( VectorCL( Np*up.Data - cplNp.Data - Nm*um.Data + cplNm.Data)/(2.*eps));
+    const double err= norm( VectorCL( Jw - dq))/norm( Jw);
+    std::cout << "relative error of the Jacobian: " << err << std::endl;
+    return err < 1e-8 ? 0 : 1;
+}
+
+/// \brief Solves the stationary driven cavity from zero; returns the number of nonlinear iterations or -1 without convergence.
+int Solve (NSCL& ns, NSLinearizationT lin, double& res)
+{
+    std::cout << "Linearization " << lin << ":\n";
+    typedef GMResSolverCL<JACPcCL> APcSolverT;
+    JACPcCL jacpc;
+    APcSolverT apcsolver( jacpc, 50, 200, 1e-2, /*relative=*/ true);
+    typedef SolverAsPreCL<APcSolverT> APcT;
+    APcT apc( apcsolver);
+    ISPreCL spc( ns.prM.Data, ns.prM.Data, 0., ns.GetCoeff().nu);
+    InexactUzawaCL<APcT, ISPreCL, APC_OTHER> oseensolver( apc, spc, 500, 1e-10, 0.3, 500);
+
+    const int maxiter= 50;
+    AdaptFixedPtDefectCorrCL<NSCL> nssolver( ns, oseensolver, maxiter, 1e-9, 0.1);
+    nssolver.SetLinearization( lin, 0.1);
+    ns.v.Data= 0.;
+    ns.p.Data= 0.;
+    VelVecDescCL cplN( &ns.vel_idx);
+    nssolver.Solve( ns.A.Data, ns.B.Data, ns.v, ns.p.Data, ns.b.Data, cplN, ns.c.Data, 1.);
+    res= nssolver.GetResid();
+    return res < 1e-9 ? nssolver.GetIter() : -1;
+}
+
+int main (int, char**)
+{
+  try {
+    Point3DCL orig( 0.), e1( 0.), e2( 0.), e3( 0.);
+    e1[0]= e2[1]= e3[2]= 1.;
+    BrickBuilderCL brick( orig, e1, e2, e3, 3, 3, 3);
+    const bool isneumann[6]= { false, false, false, false, false, false };
+    const StokesBndDataCL::VelBndDataCL::bnd_val_fun bnd_fun[6]= { &Lid, &Lid, &Lid, &Lid, &Lid, &Lid };
+    NSCL ns( brick, CoeffCL( 0.01), StokesBndDataCL( 6, isneumann, bnd_fun));
+    MultiGridCL& mg= ns.GetMG();
+
+    ns.CreateNumberingVel( mg.GetLastLevel(), &ns.vel_idx);
+    ns.CreateNumberingPr ( mg.GetLastLevel(), &ns.pr_idx);
+    ns.v.SetIdx( &ns.vel_idx);
+    ns.p.SetIdx( &ns.pr_idx);
+    ns.b.SetIdx( &ns.vel_idx);
+    ns.c.SetIdx( &ns.pr_idx);
+    ns.A.SetIdx( &ns.vel_idx, &ns.vel_idx);
+    ns.M.SetIdx( &ns.vel_idx, &ns.vel_idx);
+    ns.B.SetIdx( &ns.pr_idx, &ns.vel_idx);
+    ns.N.SetIdx( &ns.vel_idx, &ns.vel_idx);
+    ns.prM.SetIdx( &ns.pr_idx, &ns.pr_idx);
+    VelVecDescCL cplM( &ns.vel_idx);
+    ns.SetupSystem1( &ns.A, &ns.M, &ns.b, &ns.b, &cplM, 0.);
+    ns.SetupSystem2( &ns.B, &ns.c, 0.);
+    ns.SetupPrMass( &ns.prM);
+
+    int status= TestJacobian( ns);
+
+    double respicard, resnewton, resadaptive;
+    const int picard= Solve( ns, NS_Picard, respicard),
+              newton= Solve( ns, NS_Newton, resnewton),
+              adaptive= Solve( ns, NS_AdaptiveNewton, resadaptive);
+    std::cout << "iterations: Picard: " << picard << " (res " << respicard << ")\tNewton: " << newton
+              << " (res " << resnewton << ")\tadaptive Newton: " << adaptive << " (res " << resadaptive << ")" << std::endl;
+    if (picard < 0 || newton < 0 || adaptive < 0 || newton >= picard || adaptive >= picard)
+        status+= 1;
+    return status;
+  }
+  catch (DROPSErrCL err) { err.handle(); }
+}
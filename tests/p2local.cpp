@@ -28,6 +28,7 @@
 #include "out/output.h"
 #include "geom/builder.h"
 #include "num/discretize.h"
+#include "num/lattice-eval.h"
 #include "num/fe.h"
 #include "misc/problem.h"
 #include "num/bndData.h"
@@ -260,6 +261,65 @@ double Tests(DROPS::MultiGridCL& mg, VecDescCL& vd0, VecDescCL& vd1)
 }
 
 
+// Compares the batched evaluation of local P2-functions via P2ShapeTableCL with the pointwise evaluation.
+// Lattice 17 is finer than the cached shape tables and checks the pointwise fallback.
+// Returns the maximal difference relative to the maximal magnitude of the functions.
+double ShapeTableTest(DROPS::MultiGridCL& mg, VecDescCL& vd, VecDescCL& vvd)
+{
+    std::cout << "\n-----------------------------------------------------------------"
+                 "\nShapeTableTest:\n";
+    double maxdiff= 0., maxval= 0.;
+    P2FuncT lsfun( &vd, &theBnd, &mg);
+    P2EvalCL<Point3DCL, VBndCL, VecDescCL> vfun( &vvd, &theVBnd, &mg);
+    LocalP2CL<> ls;
+    LocalP2CL<Point3DCL> v;
+    Quad3CL<> q3ls, q3lsfun;
+    Quad3CL<Point3DCL> q3v, q3vfun;
+    Quad5CL<> q5ls, q5lsfun;
+    Quad5CL<Point3DCL> q5v, q5vfun;
+    for (MultiGridCL::TriangTetraIteratorCL sit= mg.GetTriangTetraBegin(),
+         end=mg.GetTriangTetraEnd(); sit != end; ++sit) {
+        ls.assign( *sit, vd, theBnd);
+        v.assign( *sit, vvd, theVBnd);
+        for (Uint n= 7; n <= 17; n+= 10) {
+            const PrincipalLatticeCL& lat= PrincipalLatticeCL::instance( n);
+            std::valarray<double> ls_val( lat.vertex_size());
+            std::valarray<Point3DCL> v_val( lat.vertex_size());
+            evaluate_on_vertexes( ls, lat, Addr( ls_val));
+            evaluate_on_vertexes( v, lat, Addr( v_val));
+            for (Uint k= 0; k < lat.vertex_size(); ++k) {
+                maxval= std::max( maxval, std::max( std::abs( ls_val[k]), v_val[k].norm()));
+                maxdiff= std::max( maxdiff, std::abs( ls_val[k] - ls( lat.vertex_begin()[k])));
+                maxdiff= std::max( maxdiff, (v_val[k] - v( lat.vertex_begin()[k])).norm());
+            }
+        }
+        q3ls.assign( ls);
+        q3v.assign( v);
+        q3lsfun.assign( *sit, lsfun);
+        q3vfun.assign( *sit, vfun);
+        for (Uint k= 0; k < Quad3DataCL::NumNodesC; ++k) {
+            const double lsk= ls( Quad3DataCL::Node[k]);
+            const Point3DCL vk= v( Quad3DataCL::Node[k]);
+            maxdiff= std::max( maxdiff, std::max( std::abs( q3ls[k] - lsk), std::abs( q3lsfun[k] - lsk)));
+            maxdiff= std::max( maxdiff, std::max( (q3v[k] - vk).norm(), (q3vfun[k] - vk).norm()));
+        }
+        q5ls.assign( ls);
+        q5v.assign( v);
+        q5lsfun.assign( *sit, lsfun);
+        q5vfun.assign( *sit, vfun);
+        for (Uint k= 0; k < Quad5DataCL::NumNodesC; ++k) {
+            const double lsk= ls( Quad5DataCL::Node[k]);
+            const Point3DCL vk= v( Quad5DataCL::Node[k]);
+            maxdiff= std::max( maxdiff, std::max( std::abs( q5ls[k] - lsk), std::abs( q5lsfun[k] - lsk)));
+            maxdiff= std::max( maxdiff, std::max( (q5v[k] - vk).norm(), (q5vfun[k] - vk).norm()));
+        }
+    }
+    std::cout << "max. difference batched vs. pointwise evaluation: " << maxdiff
+              << "\trelative: " << maxdiff/maxval << std::endl;
+    return maxdiff/maxval;
+}
+
+
 class MulCL
 {
   public:
@@ -324,6 +384,8 @@ int main ()
     std::cout << "Tests: " << q2 << "\ttime: " << time.GetTime() << " seconds"
         << std::endl;
     time.Reset();
+    if (ShapeTableTest( mg, vd2, vd3) > 1e-14)
+        std::cout << "ShapeTableTest: FAILED" << std::endl;
 
     MarkAll( mg);
     mg.Refine();
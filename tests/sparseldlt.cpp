@@ -0,0 +1,103 @@
+/// \file sparseldlt.cpp
+/// \brief tests the sparse LDL^T solver with nested dissection ordering
+/// \author LNM RWTH Aachen: Joerg Grande; SC RWTH Aachen:
+
+/*
+ * This file is part of DROPS.
+ *
+ * DROPS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * DROPS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DROPS. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Copyright 2009 LNM/SC RWTH Aachen, Germany
+*/
+
+#include "num/sparseldlt.h"
+#include "tests/laplacematrix.h"
+#include <iostream>
+#include <cmath>
+
+int Test()
+{
+    std::cout << "LDL^T 4x4:\n" << std::endl;
+    DROPS::MatrixCL A;
+    DROPS::MatrixBuilderCL AB(&A, 4, 4);
+    AB( 0, 0)= -249.;
+    AB( 0, 1)= -453.;
+    AB( 0, 2)= -397.;
+    AB( 0, 3)= -52.;
+
+    AB( 1, 0)= -453.;
+    AB( 1, 1)= -731.;
+    AB( 1, 2)= -601.;
+    AB( 1, 3)= -78.;
+
+    AB( 2, 0)= -397.;
+    AB( 2, 1)= -601.;
+    AB( 2, 2)= -648.;
+    AB( 2, 3)= -91.;
+
+    AB( 3, 0)= -52.;
+    AB( 3, 1)= -78.;
+    AB( 3, 2)= -91.;
+    AB( 3, 3)= -13.;
+    AB.Build();
+    DROPS::VectorCL b( 0., 4);
+    b[0]= -1277./2/1.;
+    b[1]= -2015./2.;
+    b[2]= -3907./4.;
+    b[3]= -533./4.;
+    DROPS::VectorCL x(0., 4);
+
+    DROPS::DirectLDLtSolverCL solver( A);
+    solver.Solve( A, x, b);
+    const double res= DROPS::norm( DROPS::VectorCL( A*x - b));
+    std::cout << "x\n" << x << "residual: " << res << std::endl;
+    return res < 1e-10*DROPS::norm( b) ? 0 : 1;
+}
+
+int Test2()
+{
+    std::cout << "LDL^T 3D Laplacian, numeric refactorization:\n" << std::endl;
+    DROPS::MatrixCL A;
+    SetupLaplace( A, 15, 0.1);
+    const size_t n= A.num_rows();
+    DROPS::VectorCL xe( n), x( n);
+    for (size_t i= 0; i < n; ++i)
+        xe[i]= std::sin( 0.1*i);
+
+    DROPS::DirectLDLtSolverCL solver;
+    solver.Solve( A, x, DROPS::VectorCL( A*xe));
+    const double err1= DROPS::norm( DROPS::VectorCL( x - xe));
+
+    // new values, same pattern: no new analysis
+    A.raw_val()[0]*= 2.;
+    A.IncrementVersion();
+    solver.Solve( A, x, DROPS::VectorCL( A*xe));
+    const double err2= DROPS::norm( DROPS::VectorCL( x - xe));
+
+    std::cout << "unknowns: " << n << "\tnon-zeros of L: " << solver.GetNumNonzerosL()
+              << "\terrors: " << err1 << ' ' << err2
+              << "\tanalyses: " << solver.GetNumAnalyses()
+              << "\tfactorizations: " << solver.GetNumFactorizations() << std::endl;
+    return (err1 < 1e-10 && err2 < 1e-10 && solver.GetNumAnalyses() == 1
+            && solver.GetNumFactorizations() == 2) ? 0 : 1;
+}
+
+int main (int, char**)
+{
+  try {
+    return Test() + Test2();
+  }
+  catch (DROPS::DROPSErrCL err) { err.handle(); }
+}